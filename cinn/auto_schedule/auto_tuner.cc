@@ -21,7 +21,9 @@
 #include <memory>
 #include <utility>
 
+#include "cinn/auto_schedule/cost_model/cost_model_trainer.h"
 #include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/measure/process_runner.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 #include "cinn/auto_schedule/measure/simple_builder.h"
 #include "cinn/auto_schedule/measure/simple_runner.h"
@@ -33,8 +35,11 @@
 #include "cinn/common/type.h"
 #include "cinn/hlir/framework/op.h"
 #include "cinn/hlir/framework/visualize_helper.h"
+#include "cinn/runtime/flags.h"
 #include "cinn/utils/string.h"
 
+DECLARE_bool(auto_schedule_use_cost_model);
+
 namespace cinn {
 namespace auto_schedule {
 
@@ -42,9 +47,23 @@ AutoTuner::AutoTuner(const common::Target& target, hlir::framework::Graph* graph
 
 void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler* graph_compiler) {
   // create builder, runner, and schedule measurer
-  builder_           = std::make_unique<SimpleBuilder>(graph_compiler);
-  runner_            = std::make_unique<SimpleRunner>(config.runner_repeat_times);
-  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get());
+  builder_        = std::make_unique<SimpleBuilder>(graph_compiler);
+  int num_runners = 1;
+  if (config.use_process_runner) {
+    ProcessRunner::Config runner_config;
+    runner_config.repeat_times = config.runner_repeat_times;
+    runner_config.timeout_ms   = config.runner_timeout_ms;
+    runner_config.cpu_cores    = config.runner_cpu_cores;
+    auto runner                = std::make_unique<ProcessRunner>(runner_config);
+    // the candidates on the host are run by the workers at the same time, one per core
+    if (target_ == common::DefaultHostTarget()) {
+      num_runners = runner->NumWorkers();
+    }
+    runner_ = std::move(runner);
+  } else {
+    runner_ = std::make_unique<SimpleRunner>(config.runner_repeat_times);
+  }
+  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get(), num_runners);
 
   // initialize database
   database_ = std::move(Database::Make(config.database_config));
@@ -73,9 +92,16 @@ void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler*
     return std::make_unique<TaskOptimizer>(
         &task, schedule_measurer_.get(), database_.get(), utils::ForkRandomState(&initial_seed));
   });
+  if (FLAGS_auto_schedule_use_cost_model && !config.pretrained_cost_model_path.empty()) {
+    VLOG(3) << "Warm-start the cost models from " << config.pretrained_cost_model_path;
+    for (auto&& optimizer : task_optimizers_) {
+      optimizer->LoadCostModel(config.pretrained_cost_model_path);
+    }
+  }
 
   // create task scheduler
-  task_scheduler_ = TaskScheduler::Make(tasks_, config.task_schedule_config, config.task_schedule_strategy);
+  task_scheduler_ =
+      TaskScheduler::Make(tasks_, config.task_schedule_config, config.task_schedule_strategy, database_.get());
 }
 
 void PrintResult(std::shared_ptr<hlir::framework::Graph::Group> group) {
@@ -125,6 +151,18 @@ void PrintResult(const TuningResult& result) {
   VLOG(3) << "###### TuningResult End ######";
 }
 
+int AutoTuner::PretrainCostModel(const std::string& save_path) {
+  CHECK(database_) << "AutoTuner should be initialized before pre-training the cost model";
+  CostModelTrainer trainer(target_);
+  int num_samples = trainer.AddRecords(database_.get());
+  if (num_samples == 0) {
+    LOG(WARNING) << "No valid tuning record to pre-train the cost model";
+    return 0;
+  }
+  trainer.TrainAndSave(save_path);
+  return num_samples;
+}
+
 TuningResult AutoTuner::Tune(const TuningOptions& options) {
   CHECK_GT(options.num_tuning_rounds, 0) << "Invalid config";
   VLOG(3) << "Begin tuning with round num=" << options.num_tuning_rounds << ", tasks size=" << tasks_.size();
@@ -152,6 +190,11 @@ TuningResult AutoTuner::Tune(const TuningOptions& options) {
       PrintResult(function_group);
       // update the best schedules searched so far.
       result.function_groups.at(run_id) = std::move(function_group);
+      // the identical tasks apply the best result of this one instead of being tuned again
+      for (int identical_id : task_scheduler_->IdenticalTasks(run_id)) {
+        VLOG(3) << "Task-" << identical_id << " applies the result of Task-" << run_id;
+        result.function_groups.at(identical_id) = task_optimizers_.at(identical_id)->OptimizeAs(*opt, options);
+      }
     }
   }
 
@@ -43,7 +43,18 @@ class AutoTuner {
     std::string task_schedule_strategy = "round_robin";
     TaskScheduler::Config task_schedule_config;
     int runner_repeat_times = 1;
+    // Whether to run candidates in isolated worker processes, see ProcessRunner,
+    // the AutoTuner should be initialized before starting any thread in this case
+    bool use_process_runner = false;
+    // The time limit of running a candidate in a worker process, unit: ms
+    int runner_timeout_ms = 10000;
+    // The CPU cores that worker processes are pinned to, one worker per core,
+    // the candidates on the host are run on all of them at the same time
+    std::vector<int> runner_cpu_cores;
     DatabaseConfig database_config;
+    // The path of a cost model trained offline, see CostModelTrainer,
+    // the cost model of each task is warm-started from it if not empty
+    std::string pretrained_cost_model_path;
   };
 
   AutoTuner(const common::Target& target, hlir::framework::Graph* graph);
@@ -54,6 +65,13 @@ class AutoTuner {
   // Perform the tuning process and return the final result
   TuningResult Tune(const TuningOptions& options);
 
+  // Train a cost model offline with all the records stored in the database,
+  // including the ones of earlier sessions, and save it to the path for later
+  // warm-start. See PretrainCostModel in cost_model_trainer.h to train on a
+  // record file without any graph.
+  // Return the number of samples used.
+  int PretrainCostModel(const std::string& save_path);
+
  private:
   const common::Target& target_;
   hlir::framework::Graph* graph_;
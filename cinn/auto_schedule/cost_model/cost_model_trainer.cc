@@ -0,0 +1,106 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/cost_model_trainer.h"
+
+#include <glog/logging.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/cost_model/feature.h"
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
+#include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/ir/schedule_desc.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+CostModelTrainer::CostModelTrainer(const common::Target& target) : target_(target) {}
+
+int CostModelTrainer::AddRecords(const std::vector<TuningRecord>& records) {
+  InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
+  int added                          = 0;
+  for (auto&& record : records) {
+    // the candidates failed to build or run are recorded with the max cost, which can't be a label
+    if (record.execution_cost >= std::numeric_limits<float>::max()) {
+      VLOG(6) << "Skip a failed record of task:" << record.task_key;
+      continue;
+    }
+    if (!record.features.empty()) {
+      samples_.emplace_back(record.features);
+      labels_.emplace_back(record.execution_cost);
+      ++added;
+      continue;
+    }
+    if (!task_registry->Has(record.task_key)) {
+      VLOG(4) << "Skip a record without features whose initial ModuleExpr is not registered, task:" << record.task_key;
+      continue;
+    }
+    ir::IRSchedule ir_sch(optim::IRCopy(task_registry->Get(record.task_key)->module_expr));
+    ir::ScheduleDesc::ReplayWithProto(record.trace, &ir_sch);
+    FeatureExtractor extractor;
+    samples_.emplace_back(extractor.Extract(ir_sch.GetModule(), target_).ToFixedSizeVector());
+    labels_.emplace_back(record.execution_cost);
+    ++added;
+  }
+  return added;
+}
+
+int CostModelTrainer::AddRecords(Database* database, const std::vector<std::string>& task_keys) {
+  CHECK(database != nullptr) << "database can't be nullptr";
+  int added = 0;
+  for (auto&& task_key : task_keys) {
+    added += AddRecords(database->LookUp(task_key));
+  }
+  VLOG(3) << "CostModelTrainer added " << added << " samples from database, total samples:" << samples_.size();
+  return added;
+}
+
+int CostModelTrainer::AddRecords(Database* database) {
+  CHECK(database != nullptr) << "database can't be nullptr";
+  return AddRecords(database, database->GetTaskKeys());
+}
+
+void CostModelTrainer::Train(ExprCostModel* cost_model) const {
+  CHECK(cost_model != nullptr) << "cost_model can't be nullptr";
+  CHECK(!samples_.empty()) << "No valid sample to train the cost model";
+  cost_model->Train(samples_, labels_);
+}
+
+void CostModelTrainer::TrainAndSave(const std::string& path) const {
+  ExprCostModel cost_model;
+  Train(&cost_model);
+  cost_model.Save(path);
+  LOG(INFO) << "Save the cost model trained with " << samples_.size() << " samples to " << path;
+}
+
+int PretrainCostModel(const std::string& record_file_path, const std::string& save_path, const common::Target& target) {
+  // keep all the records of each task, not only the best ones
+  JSONFileDatabase database(std::numeric_limits<int>::max(), record_file_path, false, true);
+  CostModelTrainer trainer(target);
+  int num_samples = trainer.AddRecords(&database);
+  if (num_samples == 0) {
+    LOG(WARNING) << "No valid tuning record in " << record_file_path << " to pre-train the cost model";
+    return 0;
+  }
+  trainer.TrainAndSave(save_path);
+  return num_samples;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,71 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/common/target.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// This class trains an ExprCostModel offline with the tuning records saved before,
+// each record is a sample labeled with the measured cost. The features of a record
+// are the ones stored with it, which need neither the graph nor the task it was
+// tuned for; the records saved without features are replayed on the initial
+// ModuleExpr of their tasks to regenerate the scheduled IR and extract them.
+// The trained model can be saved and loaded to warm-start later tuning sessions.
+//
+// Note: the records without features are skipped unless the initial ModuleExpr
+// of their tasks are registered in InitialTaskRegistry.
+class CostModelTrainer {
+ public:
+  explicit CostModelTrainer(const common::Target& target);
+
+  // Add the valid records as samples, return the number of samples added
+  int AddRecords(const std::vector<TuningRecord>& records);
+
+  // Add the records of the specified tasks stored in the database, return the number of samples added
+  int AddRecords(Database* database, const std::vector<std::string>& task_keys);
+
+  // Add all the records stored in the database, return the number of samples added
+  int AddRecords(Database* database);
+
+  // Train the cost model with all the samples added
+  void Train(ExprCostModel* cost_model) const;
+
+  // Train a cost model with all the samples added and save it to the path
+  void TrainAndSave(const std::string& path) const;
+
+  size_t num_samples() const { return samples_.size(); }
+
+ private:
+  const common::Target& target_;
+  // the features of the samples
+  std::vector<std::vector<float>> samples_;
+  std::vector<float> labels_;
+};
+
+// Train a cost model with all the records in the json file of a JSONFileDatabase and
+// save it to the path, it is the offline entry that runs without any graph.
+// Return the number of samples used.
+int PretrainCostModel(const std::string& record_file_path, const std::string& save_path, const common::Target& target);
+
+}  // namespace auto_schedule
+}  // namespace cinn
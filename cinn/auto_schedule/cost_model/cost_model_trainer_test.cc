@@ -0,0 +1,168 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/cost_model_trainer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "cinn/auto_schedule/cost_model/feature.h"
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
+#include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/common/context.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/compute.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+TEST(CostModelTrainer, TrainFromRecords) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  ir::Expr M(64);
+  ir::Expr N(64);
+
+  lang::Placeholder<float> A("A", {M, N});
+  ir::Tensor B = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * 2.f; }, "B");
+
+  poly::StageMap stages              = poly::CreateStages({A, B});
+  std::vector<ir::LoweredFunc> funcs = lang::LowerVec("TestTrainer", stages, {A, B}, {}, {}, nullptr, target, true);
+  ir::ModuleExpr mod_expr(std::vector<Expr>{funcs[0]->body});
+
+  const std::string task_key = "CostModelTrainer.TrainFromRecords";
+  InitialTaskRegistry::Global()->Regist(task_key, mod_expr);
+
+  // the records with different split factors, and a failed one
+  std::vector<TuningRecord> records;
+  std::vector<int> factors = {2, 4, 8, 16, 32};
+  for (size_t i = 0; i <= factors.size(); ++i) {
+    ir::IRSchedule ir_sch(optim::IRCopy(mod_expr));
+    auto loops = ir_sch.GetLoops("B");
+    ir_sch.Split(loops[0], std::vector<int>{-1, i < factors.size() ? factors[i] : 64});
+
+    TuningRecord record;
+    record.task_key       = task_key;
+    record.predicted_cost = SearchState::NOT_INIT_COST;
+    record.trace          = ir_sch.GetTraceDesc().ToProto();
+    record.execution_cost = i < factors.size() ? 10.0 * (i + 1) : std::numeric_limits<double>::max();
+    records.emplace_back(std::move(record));
+  }
+  // records of an unregistered task are skipped
+  TuningRecord unknown_record = records.front();
+  unknown_record.task_key     = "CostModelTrainer.UnknownTask";
+  records.emplace_back(unknown_record);
+
+  CostModelTrainer trainer(target);
+  ASSERT_EQ(trainer.AddRecords(records), static_cast<int>(factors.size()));
+  ASSERT_EQ(trainer.num_samples(), factors.size());
+
+  // all the records in a database are used, whichever task they belong to
+  const std::string other_task_key = "CostModelTrainer.OtherTask";
+  InitialTaskRegistry::Global()->Regist(other_task_key, mod_expr);
+  Database database(factors.size() + 1);
+  for (size_t i = 0; i <= factors.size(); ++i) {
+    TuningRecord record = records[i];
+    database.AddRecord(record);
+    record.task_key = other_task_key;
+    database.AddRecord(record);
+  }
+  CostModelTrainer database_trainer(target);
+  ASSERT_EQ(database_trainer.AddRecords(&database), static_cast<int>(2 * factors.size()));
+
+  std::string path = "./test_cost_model_trainer.cpp_save_model";
+  trainer.TrainAndSave(path);
+
+  // an untrained model can't predict, it can after loading the pre-trained one
+  ExprCostModel cost_model;
+  ASSERT_EQ(cost_model.Predict(mod_expr, target), SearchState::NOT_INIT_COST);
+  cost_model.Load(path);
+  ASSERT_NE(cost_model.Predict(mod_expr, target), SearchState::NOT_INIT_COST);
+  std::remove(path.c_str());
+
+  // update incrementally on top of the loaded model
+  cost_model.Update({&mod_expr}, {5.f}, target);
+  ASSERT_NE(cost_model.Predict(mod_expr, target), SearchState::NOT_INIT_COST);
+}
+
+TEST(CostModelTrainer, TrainFromFeatures) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  ir::Expr M(64);
+  ir::Expr N(64);
+
+  lang::Placeholder<float> A("A", {M, N});
+  ir::Tensor B = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + 1.f; }, "B");
+
+  poly::StageMap stages              = poly::CreateStages({A, B});
+  std::vector<ir::LoweredFunc> funcs = lang::LowerVec("TestFeatures", stages, {A, B}, {}, {}, nullptr, target, true);
+  ir::ModuleExpr mod_expr(std::vector<Expr>{funcs[0]->body});
+
+  // the records carrying their features are learned without registering the initial ModuleExpr,
+  // like the ones of the graphs tuned in earlier sessions
+  const std::string path = "./test_cost_model_trainer_features.json";
+  std::remove(path.c_str());
+  std::vector<int> factors = {2, 4, 8, 16, 32};
+  {
+    JSONFileDatabase database(factors.size(), path, true);
+    FeatureExtractor extractor;
+    for (size_t i = 0; i < factors.size(); ++i) {
+      ir::IRSchedule ir_sch(optim::IRCopy(mod_expr));
+      auto loops = ir_sch.GetLoops("B");
+      ir_sch.Split(loops[1], std::vector<int>{-1, factors[i]});
+
+      TuningRecord record;
+      record.task_key       = "CostModelTrainer.UnregisteredTask";
+      record.predicted_cost = SearchState::NOT_INIT_COST;
+      record.trace          = ir_sch.GetTraceDesc().ToProto();
+      record.execution_cost = 10.0 * (i + 1);
+      record.features       = extractor.Extract(ir_sch.GetModule(), target).ToFixedSizeVector();
+      database.AddRecord(record);
+    }
+    ASSERT_FALSE(InitialTaskRegistry::Global()->Has("CostModelTrainer.UnregisteredTask"));
+  }
+
+  // the database of a tuning session only loads the records of the registered tasks
+  JSONFileDatabase tuning_database(factors.size(), path, false);
+  ASSERT_TRUE(tuning_database.GetTaskKeys().empty());
+  JSONFileDatabase offline_database(factors.size(), path, false, true);
+  std::vector<TuningRecord> records = offline_database.LookUp("CostModelTrainer.UnregisteredTask");
+  ASSERT_EQ(records.size(), factors.size());
+  ASSERT_FALSE(records.front().features.empty());
+
+  CostModelTrainer trainer(target);
+  ASSERT_EQ(trainer.AddRecords(records), static_cast<int>(factors.size()));
+
+  // the offline entry trains on the record file directly
+  std::string model_path = "./test_cost_model_trainer_features.cpp_save_model";
+  ASSERT_EQ(PretrainCostModel(path, model_path, target), static_cast<int>(factors.size()));
+  ExprCostModel cost_model;
+  cost_model.Load(model_path);
+  ASSERT_NE(cost_model.Predict(mod_expr, target), SearchState::NOT_INIT_COST);
+  std::remove(model_path.c_str());
+  std::remove(path.c_str());
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -17,6 +17,7 @@
 #include <glog/logging.h>
 
 #include <atomic>
+#include <string>
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/feature.h"
@@ -56,6 +57,12 @@ void ExprCostModel::Train(const std::vector<const ir::ModuleExpr*>& samples,
   XgbCostModel::Train(train_feature_numbers, labels);
 }
 
+void ExprCostModel::Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
+  trained_times_.store(1);
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  XgbCostModel::Train(samples, labels);
+}
+
 void ExprCostModel::Update(const std::vector<const ir::ModuleExpr*>& samples,
                            const std::vector<float>& labels,
                            const common::Target& target) {
@@ -73,5 +80,10 @@ void ExprCostModel::Update(const std::vector<const ir::ModuleExpr*>& samples,
   XgbCostModel::Update(train_feature_numbers, labels);
 }
 
+void ExprCostModel::Load(const std::string& path) {
+  XgbCostModel::Load(path);
+  trained_times_.store(1);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
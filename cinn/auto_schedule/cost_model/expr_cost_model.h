@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <string>
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/xgb_cost_model.h"
@@ -33,9 +34,14 @@ class ExprCostModel : public XgbCostModel {
   void Train(const std::vector<const ir::ModuleExpr*>& samples,
              const std::vector<float>& labels,
              const common::Target& target);
+  // Train on the features extracted before, such as the ones stored with the tuning records
+  void Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) override;
   void Update(const std::vector<const ir::ModuleExpr*>& samples,
               const std::vector<float>& labels,
               const common::Target& target);
+  // Load a model trained before, such as one trained offline by CostModelTrainer,
+  // so it predicts from the start and is updated incrementally afterwards
+  void Load(const std::string& path) override;
 
  private:
   std::atomic<int> trained_times_{0};
@@ -97,10 +97,12 @@ XgbCostModel::XgbCostModel() {
     AddDistPkgToPythonSysPath();
   }
   xgb_module_  = pybind11::module::import("xgboost");
-  xgb_booster_ = xgb_module_.attr("Booster")();
+  xgb_booster_        = xgb_module_.attr("Booster")();
+  pretrained_booster_ = pybind11::none();
 }
 
 void XgbCostModel::Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
+  pretrained_booster_        = pybind11::none();
   update_samples_            = samples;
   update_labels_             = labels;
   pybind11::array np_samples = VectorToNumpy<float>(samples);
@@ -124,12 +126,18 @@ void XgbCostModel::Update(const std::vector<std::vector<float>>& samples, const
   pybind11::array np_labels  = VectorToNumpy<float>(update_labels_);
 
   pybind11::object dmatrix = xgb_module_.attr("DMatrix")(np_samples, np_labels);
-  xgb_booster_             = xgb_module_.attr("train")(pybind11::dict(), dmatrix, pybind11::int_(kTrainRound_));
+  xgb_booster_             = xgb_module_.attr("train")(
+      pybind11::dict(), dmatrix, pybind11::int_(kTrainRound_), pybind11::arg("xgb_model") = pretrained_booster_);
 }
 
 void XgbCostModel::Save(const std::string& path) { xgb_booster_.attr("save_model")(pybind11::str(path)); }
 
-void XgbCostModel::Load(const std::string& path) { xgb_booster_.attr("load_model")(pybind11::str(path)); }
+void XgbCostModel::Load(const std::string& path) {
+  xgb_booster_.attr("load_model")(pybind11::str(path));
+  pretrained_booster_ = xgb_booster_.attr("copy")();
+  update_samples_.clear();
+  update_labels_.clear();
+}
 
 }  // namespace auto_schedule
 }  // namespace cinn
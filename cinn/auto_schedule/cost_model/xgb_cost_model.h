@@ -62,6 +62,9 @@ class XgbCostModel : public CostModel {
   pybind11::module xgb_module_;
   // Object points to Python xgb.Booster()
   pybind11::object xgb_booster_;
+  // The booster loaded from file, Update() continues boosting from it
+  // instead of training from scratch so the loaded knowledge is kept
+  pybind11::object pretrained_booster_;
   // atomic int to handle python interpreter life time and package dependency
   static std::atomic<int> xgb_cost_model_count_;
   // Default train rounds
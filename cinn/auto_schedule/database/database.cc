@@ -36,6 +36,7 @@ proto::TuningRecord TuningRecord::ToProto() const {
   record_proto.set_execution_cost(execution_cost);
   record_proto.set_predicted_cost(predicted_cost);
   record_proto.mutable_trace()->CopyFrom(trace);
+  record_proto.mutable_features()->Add(features.begin(), features.end());
   return record_proto;
 }
 
@@ -102,6 +103,15 @@ std::vector<TuningRecord> Database::GetTopK(const std::string& task_key, int k)
   return results;
 }
 
+std::vector<std::string> Database::GetTaskKeys() {
+  std::vector<std::string> keys;
+  keys.reserve(key2record_.size());
+  for (auto&& kv : key2record_) {
+    keys.push_back(kv.first);
+  }
+  return keys;
+}
+
 size_t Database::Size() {
   auto res =
       std::accumulate(key2record_.begin(), key2record_.end(), size_t(0), [](size_t res, const auto& kv) -> size_t {
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <unordered_map>
+#include <vector>
 
 #include "cinn/auto_schedule/auto_schedule.pb.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
@@ -32,13 +33,17 @@ struct TuningRecord {
   ir::proto::ScheduleDesc trace;
   // the cost time of the candidate executed during measure
   double execution_cost;  // unit: us
+  // the fixed-size features of the scheduled IR, which label a cost model sample by themselves,
+  // so the record can be learned offline without regenerating the IR of its task
+  std::vector<float> features;
 
   TuningRecord() = default;
   TuningRecord(const proto::TuningRecord& record)
       : task_key(record.task_key()),
         predicted_cost(record.predicted_cost()),
         trace(record.trace()),
-        execution_cost(record.execution_cost()) {}
+        execution_cost(record.execution_cost()),
+        features(record.features().begin(), record.features().end()) {}
   TuningRecord(const std::string& task_key, const SearchState& state, double execution_cost)
       : task_key(task_key),
         predicted_cost(state->predicted_cost),
@@ -81,6 +86,8 @@ class Database {
   std::vector<TuningRecord> LookUp(const std::string& task_key);
   // return the states of the top k in sorted candidates
   std::vector<TuningRecord> GetTopK(const std::string& task_key, int k);
+  // return the keys of all the tasks with stored candidates
+  std::vector<std::string> GetTaskKeys();
   // return the total number of stored candidates
   size_t Size();
   // return the number of stored candidates with specified key
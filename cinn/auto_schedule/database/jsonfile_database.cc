@@ -51,7 +51,10 @@ std::vector<std::string> ReadLinesFromFile(const std::string& file_path, bool al
   return {};
 }
 
-JSONFileDatabase::JSONFileDatabase(int capacity_per_task, const std::string& record_file_path, bool allow_new_file)
+JSONFileDatabase::JSONFileDatabase(int capacity_per_task,
+                                   const std::string& record_file_path,
+                                   bool allow_new_file,
+                                   bool load_all_records)
     : Database(capacity_per_task), record_file_path_(record_file_path) {
   VLOG(3) << "Auto schdule will save/load tuning records on file:" << record_file_path;
   auto json_lines = ReadLinesFromFile(record_file_path_, allow_new_file);
@@ -70,7 +73,7 @@ JSONFileDatabase::JSONFileDatabase(int capacity_per_task, const std::string& rec
 
   for (const auto& record_proto : all_records_proto) {
     std::string task_key = record_proto.task_key();
-    if (task_registry->Has(task_key)) {
+    if (load_all_records || task_registry->Has(task_key)) {
       VLOG(4) << "Add a measured TuningRecord with task_key=" << task_key;
       Insert(TuningRecord(record_proto));
     }
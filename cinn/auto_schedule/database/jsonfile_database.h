@@ -27,8 +27,13 @@ class JSONFileDatabase : public Database {
    * \param capacity_per_task The max number of candidates stored.
    * \param record_file_path The path of the json file.
    * \param allow_new_file Whether to create new file when the given path is not found.
+   * \param load_all_records Whether to load the records of the tasks not registered in InitialTaskRegistry,
+   * such as for training a cost model offline.
    */
-  JSONFileDatabase(int capacity_per_task, const std::string& record_file_path, bool allow_new_file);
+  JSONFileDatabase(int capacity_per_task,
+                   const std::string& record_file_path,
+                   bool allow_new_file,
+                   bool load_all_records = false);
   ~JSONFileDatabase() = default;
 
   // convert a TuningRecord object to string in JSON format
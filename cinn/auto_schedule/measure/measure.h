@@ -57,6 +57,9 @@ struct BuildResult {
   const hlir::framework::Scope* compiled_scope;
   // The executable program
   std::unique_ptr<hlir::framework::Program> runtime_program;
+  // The host objects the functions of runtime_program are compiled into,
+  // used to run the program in another process, see ProcessRunner
+  std::vector<std::string> host_objects;
 };
 
 // This interface defines how to generate executable objects
@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "cinn/auto_schedule/measure/process_runner.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 #include "cinn/auto_schedule/measure/simple_builder.h"
 #include "cinn/auto_schedule/measure/simple_runner.h"
@@ -106,6 +107,22 @@ TEST_F(TestMeasurer, Basic) {
   ASSERT_EQ(inputs.size(), results.size());
 }
 
+#ifndef CINN_WITH_CUDA
+TEST_F(TestMeasurer, RunInWorkersConcurrently) {
+  ProcessRunner::Config config;
+  config.num_workers                 = 2;
+  auto runner                        = std::make_unique<ProcessRunner>(config);
+  auto builder                       = std::make_unique<SimpleBuilder>(graph_compiler.get());
+  auto measurer                      = std::make_unique<ScheduleMeasurer>(builder.get(), runner.get(), 2);
+  std::vector<MeasureResult> results = measurer->Measure(inputs);
+  ASSERT_EQ(inputs.size(), results.size());
+  // all the candidates are built before running, so the workers call the functions of the shipped objects
+  for (auto&& result : results) {
+    ASSERT_TRUE(result.error_msg.empty()) << result.error_msg;
+  }
+}
+#endif
+
 TEST_F(TestMeasurer, CatchException) {
   auto builder                       = std::make_unique<SimpleBuilder>(graph_compiler.get());
   auto runner                        = std::make_unique<SimpleRunner>(1);
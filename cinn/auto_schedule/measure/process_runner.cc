@@ -0,0 +1,593 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/measure/process_runner.h"
+
+#include <dlfcn.h>
+#include <glog/logging.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/common/target.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/scope.h"
+#include "cinn/hlir/framework/tensor.h"
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+using hlir::framework::Instruction;
+using hlir::framework::Scope;
+using hlir::framework::Shape;
+using hlir::framework::Tensor;
+
+namespace {
+
+// The fixed-size header of the message a worker replies, followed by `error_len` bytes of error message
+struct WorkerReply {
+  double execution_cost;
+  double elapsed_time;
+  int32_t error_len;
+};
+
+// How the value of a parameter is shipped to a worker
+enum class ParamKind : int32_t {
+  // allocated and initialized by the worker as SimpleRunner does
+  kAllocated = 0,
+  // a preset value other than a buffer, copied as it is
+  kPresetValue = 1,
+  // a preset buffer, copied with the contents of its memory
+  kPresetBuffer = 2,
+};
+
+// Serialize the fields of a request to a worker in order
+class RequestWriter {
+ public:
+  template <typename T>
+  void Write(const T& value) {
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void WriteBytes(const void* data, uint64_t size) {
+    Write(size);
+    data_.append(static_cast<const char*>(data), size);
+  }
+
+  void WriteString(const std::string& str) { WriteBytes(str.data(), str.size()); }
+
+  void WriteStrings(const std::vector<std::string>& strs) {
+    Write<int32_t>(strs.size());
+    for (auto&& str : strs) {
+      WriteString(str);
+    }
+  }
+
+  std::string& data() { return data_; }
+
+ private:
+  std::string data_;
+};
+
+// Deserialize the fields written by RequestWriter in the same order
+class RequestReader {
+ public:
+  explicit RequestReader(const std::string& data) : data_(data) {}
+
+  template <typename T>
+  T Read() {
+    CHECK_LE(pos_ + sizeof(T), data_.size()) << "Truncated measure request";
+    T value;
+    std::memcpy(&value, data_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString() {
+    auto size = Read<uint64_t>();
+    CHECK_LE(pos_ + size, data_.size()) << "Truncated measure request";
+    std::string str = data_.substr(pos_, size);
+    pos_ += size;
+    return str;
+  }
+
+  std::vector<std::string> ReadStrings() {
+    std::vector<std::string> strs(Read<int32_t>());
+    for (auto& str : strs) {
+      str = ReadString();
+    }
+    return strs;
+  }
+
+ private:
+  const std::string& data_;
+  size_t pos_ = 0;
+};
+
+// All the fds written are sockets, a peer exited is reported as a failure rather than by SIGPIPE
+bool WriteAll(int fd, const void* data, size_t size) {
+  const char* ptr = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = send(fd, ptr, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool ReadAll(int fd, void* data, size_t size) {
+  char* ptr = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, ptr, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Send the value with the fd attached
+bool SendWithFd(int socket_fd, int32_t value, int fd) {
+  char control[CMSG_SPACE(sizeof(int))] = {};
+  struct iovec iov                       = {&value, sizeof(value)};
+  struct msghdr msg                      = {};
+  msg.msg_iov                            = &iov;
+  msg.msg_iovlen                         = 1;
+  msg.msg_control                        = control;
+  msg.msg_controllen                     = sizeof(control);
+  struct cmsghdr* cmsg                   = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level                       = SOL_SOCKET;
+  cmsg->cmsg_type                        = SCM_RIGHTS;
+  cmsg->cmsg_len                         = CMSG_LEN(sizeof(int));
+  std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+  ssize_t n;
+  do {
+    n = sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+  } while (n < 0 && errno == EINTR);
+  return n == sizeof(value);
+}
+
+// Receive the value with the fd attached, the fd is -1 if none is attached
+bool RecvWithFd(int socket_fd, int32_t* value, int* fd) {
+  char control[CMSG_SPACE(sizeof(int))] = {};
+  struct iovec iov                       = {value, sizeof(*value)};
+  struct msghdr msg                      = {};
+  msg.msg_iov                            = &iov;
+  msg.msg_iovlen                         = 1;
+  msg.msg_control                        = control;
+  msg.msg_controllen                     = sizeof(control);
+  ssize_t n;
+  do {
+    n = recvmsg(socket_fd, &msg, 0);
+  } while (n < 0 && errno == EINTR);
+  if (n != sizeof(*value)) return false;
+
+  *fd                  = -1;
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+    std::memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+  }
+  return true;
+}
+
+// Wait until the fd is readable, return false if timeout
+bool WaitReadable(int fd, int timeout_ms) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (true) {
+    int remain =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    if (remain < 0) return false;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int ret           = poll(&pfd, 1, remain);
+    if (ret < 0 && errno == EINTR) continue;
+    // POLLHUP also means readable here: the following read will tell that the worker exited
+    return ret > 0;
+  }
+}
+
+// Whether the code at the address is in an image loaded by the dynamic linker, whose address is the same in a worker
+bool InLoadedImage(void* address) {
+  Dl_info info;
+  return address && dladdr(address, &info) != 0 && info.dli_fname;
+}
+
+MeasureResult FailedResult(const std::string& error_msg) {
+  MeasureResult result;
+  // the TaskOptimizer drops a failed candidate by its error_msg, the max cost only ranks it behind the valid ones
+  result.execution_cost = std::numeric_limits<double>::max();
+  result.error_msg      = error_msg;
+  return result;
+}
+
+}  // namespace
+
+ProcessRunner::ProcessRunner(const Config& config) : config_(config), simple_runner_(config.repeat_times) {
+  CHECK_GT(config_.timeout_ms, 0) << "timeout_ms should be greater than 0";
+  if (config_.cpu_cores.empty()) {
+    CHECK_GT(config_.num_workers, 0) << "num_workers should be greater than 0";
+    workers_.resize(config_.num_workers);
+  } else {
+    workers_.resize(config_.cpu_cores.size());
+    for (int i = 0; i < workers_.size(); ++i) {
+      workers_[i].cpu_core = config_.cpu_cores[i];
+    }
+  }
+  for (int i = 0; i < workers_.size(); ++i) {
+    idle_workers_.push_back(i);
+  }
+
+  int fds[2];
+  CHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0) << "Create socket failed: " << std::strerror(errno);
+  fork_server_pid_ = fork();
+  CHECK_GE(fork_server_pid_, 0) << "Fork the fork server of measure workers failed: " << std::strerror(errno);
+  if (fork_server_pid_ == 0) {
+    close(fds[0]);
+    ServeForks(fds[1]);
+  }
+  close(fds[1]);
+  fork_server_fd_ = fds[0];
+}
+
+ProcessRunner::~ProcessRunner() {
+  // the workers and the fork server exit once their sockets are closed
+  for (auto& worker : workers_) {
+    if (worker.fd >= 0) {
+      close(worker.fd);
+    }
+  }
+  close(fork_server_fd_);
+  while (waitpid(fork_server_pid_, nullptr, 0) < 0 && errno == EINTR) {
+  }
+}
+
+void ProcessRunner::ServeForks(int socket_fd) {
+  // the workers are reaped automatically
+  signal(SIGCHLD, SIG_IGN);
+  int32_t cpu_core;
+  int worker_fd;
+  while (RecvWithFd(socket_fd, &cpu_core, &worker_fd)) {
+    int32_t pid = -1;
+    if (worker_fd >= 0) {
+      pid = fork();
+      if (pid == 0) {
+        close(socket_fd);
+        signal(SIGCHLD, SIG_DFL);
+        ServeCandidates(worker_fd, cpu_core);
+      }
+      close(worker_fd);
+    }
+    if (!WriteAll(socket_fd, &pid, sizeof(pid))) break;
+  }
+  close(socket_fd);
+  // skip the exit handlers and destructors of the state copied from the tuner
+  _exit(0);
+}
+
+void ProcessRunner::ServeCandidates(int socket_fd, int cpu_core) {
+  if (cpu_core >= 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_core, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+      LOG(WARNING) << "Failed to pin the measure worker to core " << cpu_core << ": " << std::strerror(errno);
+    }
+  }
+
+  uint64_t request_size;
+  while (ReadAll(socket_fd, &request_size, sizeof(request_size))) {
+    std::string request(request_size, '\0');
+    if (request_size > 0 && !ReadAll(socket_fd, &request[0], request_size)) break;
+
+    MeasureResult result;
+    try {
+      result = RunSerializedCandidate(request);
+    } catch (std::exception& e) {
+      result.error_msg = utils::StringFormat("Run failed in worker, error: %s\n", e.what());
+    }
+
+    WorkerReply reply{result.execution_cost, result.elapsed_time, static_cast<int32_t>(result.error_msg.size())};
+    if (!WriteAll(socket_fd, &reply, sizeof(reply)) ||
+        !WriteAll(socket_fd, result.error_msg.data(), result.error_msg.size())) {
+      break;
+    }
+  }
+  close(socket_fd);
+  _exit(0);
+}
+
+// The request consists of:
+//  1. the host objects;
+//  2. the parameters of the instructions, each with its name, whether to initialize it with 0 and its value;
+//  3. the instructions, each with the name, the address and the arguments of its functions,
+//     the address is 0 if the function should be looked up from the objects.
+std::string ProcessRunner::SerializeCandidate(const MeasureInput& input, const BuildResult& build_result) const {
+  RequestWriter writer;
+  writer.WriteStrings(build_result.host_objects);
+
+  const auto& instructions = build_result.runtime_program->GetRunInstructions();
+  std::vector<std::string> params;
+  std::unordered_set<std::string> visited;
+  auto collect_params_fn = [&](const std::vector<std::vector<std::string>>& args_list) {
+    for (auto&& args : args_list) {
+      for (auto&& arg : args) {
+        if (visited.insert(arg).second) {
+          params.push_back(arg);
+        }
+      }
+    }
+  };
+  for (auto&& instr : instructions) {
+    collect_params_fn(instr->GetInArgs());
+    collect_params_fn(instr->GetOutArgs());
+  }
+
+  std::unordered_set<std::string> params_need_init_with_zero = SimpleRunner::ParamsNeedInitWithZero(input);
+  writer.Write<int32_t>(params.size());
+  for (auto&& param : params) {
+    writer.WriteString(param);
+    writer.Write<bool>(params_need_init_with_zero.count(param) != 0);
+    if (input.execution_args && input.execution_args->count(param)) {
+      const cinn_pod_value_t& value = input.execution_args->at(param);
+      if (value.type_code() == ::cinn_type_code<cinn_buffer_t*>()) {
+        cinn_buffer_t* buffer = value;
+        writer.Write(ParamKind::kPresetBuffer);
+        writer.Write(*buffer);
+        writer.WriteBytes(buffer->memory, buffer->memory ? buffer->memory_size : 0);
+      } else {
+        writer.Write(ParamKind::kPresetValue);
+        writer.Write(value);
+      }
+    } else {
+      CHECK(build_result.compiled_scope) << "Argument [" << param << "] is neither preset nor compiled";
+      auto tensor = build_result.compiled_scope->GetTensor(param);
+      writer.Write(ParamKind::kAllocated);
+      writer.WriteString(common::Type2Str(tensor->type()));
+      writer.Write<int32_t>(tensor->shape().size());
+      for (int dim : tensor->shape().data()) {
+        writer.Write<int32_t>(dim);
+      }
+    }
+  }
+
+  writer.Write<int32_t>(instructions.size());
+  for (auto&& instr : instructions) {
+    writer.WriteString(instr->GetFunctionName());
+    std::vector<std::string> fn_names = instr->GetFnNames();
+    std::vector<void*> fn_ptrs        = instr->GetFnPtrs();
+    writer.Write<int32_t>(fn_ptrs.size());
+    for (int i = 0; i < fn_ptrs.size(); ++i) {
+      writer.WriteString(fn_names[i]);
+      // a JIT-compiled function is loaded at another address in the worker
+      writer.Write<uint64_t>(InLoadedImage(fn_ptrs[i]) ? reinterpret_cast<uint64_t>(fn_ptrs[i]) : 0);
+    }
+    auto in_args  = instr->GetInArgs();
+    auto out_args = instr->GetOutArgs();
+    writer.Write<int32_t>(in_args.size());
+    for (auto&& args : in_args) {
+      writer.WriteStrings(args);
+    }
+    writer.Write<int32_t>(out_args.size());
+    for (auto&& args : out_args) {
+      writer.WriteStrings(args);
+    }
+  }
+  return std::move(writer.data());
+}
+
+MeasureResult ProcessRunner::RunSerializedCandidate(const std::string& request) {
+  RequestReader reader(request);
+  std::unique_ptr<backends::ExecutionEngine> engine;
+  std::vector<std::string> objects = reader.ReadStrings();
+  if (!objects.empty()) {
+    engine = backends::ExecutionEngine::Create(backends::ExecutionOptions());
+    for (auto&& object : objects) {
+      engine->AddObject(object);
+    }
+  }
+
+  // the scope only holds the shapes and types of the parameters allocated by SimpleRunner
+  auto scope = std::make_shared<Scope>();
+  std::map<std::string, cinn_pod_value_t> preset_args;
+  std::unordered_set<std::string> params_need_init_with_zero;
+  std::vector<std::unique_ptr<cinn_buffer_t>> preset_buffers;
+  std::vector<std::vector<uint8_t>> preset_memory;
+  int num_params = reader.Read<int32_t>();
+  for (int i = 0; i < num_params; ++i) {
+    std::string param = reader.ReadString();
+    if (reader.Read<bool>()) {
+      params_need_init_with_zero.insert(param);
+    }
+    auto kind = reader.Read<ParamKind>();
+    if (kind == ParamKind::kPresetValue) {
+      preset_args.emplace(param, reader.Read<cinn_pod_value_t>());
+    } else if (kind == ParamKind::kPresetBuffer) {
+      preset_buffers.emplace_back(new cinn_buffer_t(reader.Read<cinn_buffer_t>()));
+      std::string memory = reader.ReadString();
+      preset_memory.emplace_back(memory.begin(), memory.end());
+      preset_buffers.back()->memory = memory.empty() ? nullptr : preset_memory.back().data();
+      preset_args.emplace(param, cinn_pod_value_t(preset_buffers.back().get()));
+    } else {
+      common::Type type = common::Str2Type(reader.ReadString());
+      std::vector<int> shape(reader.Read<int32_t>());
+      for (auto& dim : shape) {
+        dim = reader.Read<int32_t>();
+      }
+      scope->Var<Tensor>(param);
+      auto tensor = scope->GetTensor(param);
+      tensor->Resize(Shape(shape));
+      tensor->set_type(type);
+    }
+  }
+
+  std::vector<std::unique_ptr<Instruction>> instructions;
+  int num_instructions = reader.Read<int32_t>();
+  for (int i = 0; i < num_instructions; ++i) {
+    std::unique_ptr<Instruction> instr(
+        new Instruction(common::DefaultHostTarget(), scope.get(), {}, {}, reader.ReadString()));
+    int num_fns = reader.Read<int32_t>();
+    for (int j = 0; j < num_fns; ++j) {
+      std::string fn_name = reader.ReadString();
+      auto* fn_ptr        = reinterpret_cast<void*>(reader.Read<uint64_t>());
+      if (!fn_ptr && engine) {
+        fn_ptr = engine->Lookup(fn_name);
+      }
+      if (!fn_ptr) {
+        return FailedResult(utils::StringFormat(
+            "Function %s is not compiled into the host objects, it can't be run in worker\n", fn_name.c_str()));
+      }
+      instr->SetLoweredFunc(fn_ptr, fn_name);
+    }
+    instr->ClearInArgs();
+    instr->ClearOutArgs();
+    int num_in_args = reader.Read<int32_t>();
+    for (int j = 0; j < num_in_args; ++j) {
+      instr->AddInArgs(reader.ReadStrings());
+    }
+    int num_out_args = reader.Read<int32_t>();
+    for (int j = 0; j < num_out_args; ++j) {
+      instr->AddOutArgs(reader.ReadStrings());
+    }
+    instr->Finalize();
+    instructions.push_back(std::move(instr));
+  }
+
+  TuneTask task;
+  task.target = common::DefaultHostTarget();
+  MeasureInput input;
+  input.task           = &task;
+  input.execution_args = &preset_args;
+  BuildResult build_result;
+  build_result.compiled_scope  = scope.get();
+  build_result.runtime_program = std::make_unique<hlir::framework::Program>(scope, std::move(instructions));
+  return simple_runner_.Run(input, build_result, params_need_init_with_zero);
+}
+
+bool ProcessRunner::SpawnWorker(Worker* worker) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+    LOG(WARNING) << "Create socket failed: " << std::strerror(errno);
+    return false;
+  }
+  int32_t pid = -1;
+  {
+    std::lock_guard<std::mutex> lock(fork_server_mtx_);
+    if (!SendWithFd(fork_server_fd_, worker->cpu_core, fds[1]) || !ReadAll(fork_server_fd_, &pid, sizeof(pid))) {
+      pid = -1;
+    }
+  }
+  close(fds[1]);
+  if (pid < 0) {
+    close(fds[0]);
+    LOG(WARNING) << "Fork measure worker failed";
+    return false;
+  }
+
+  worker->pid = pid;
+  worker->fd  = fds[0];
+  VLOG(4) << "Spawn measure worker " << pid << " pinned to core " << worker->cpu_core;
+  return true;
+}
+
+void ProcessRunner::DiscardWorker(Worker* worker) {
+  // a live worker exits on the socket closed, and the fork server reaps it
+  close(worker->fd);
+  worker->pid = -1;
+  worker->fd  = -1;
+}
+
+int ProcessRunner::AcquireWorker() {
+  std::unique_lock<std::mutex> lock(workers_mtx_);
+  workers_cv_.wait(lock, [this]() { return !idle_workers_.empty(); });
+  int index = idle_workers_.back();
+  idle_workers_.pop_back();
+  return index;
+}
+
+void ProcessRunner::ReleaseWorker(int index) {
+  {
+    std::lock_guard<std::mutex> lock(workers_mtx_);
+    idle_workers_.push_back(index);
+  }
+  workers_cv_.notify_one();
+}
+
+MeasureResult ProcessRunner::Run(const MeasureInput& input, const BuildResult& build_result) {
+  if (input.task->target != common::DefaultHostTarget()) {
+    VLOG(4) << "ProcessRunner runs candidates of target " << input.task->target << " in process";
+    return simple_runner_.Run(input, build_result);
+  }
+
+  std::string request   = SerializeCandidate(input, build_result);
+  uint64_t request_size = request.size();
+  int index             = AcquireWorker();
+  // the worker is only used by this thread until it is released
+  Worker* worker = &workers_[index];
+  MeasureResult result;
+  WorkerReply reply;
+  if (worker->fd < 0 && !SpawnWorker(worker)) {
+    result = FailedResult("Spawn measure worker failed\n");
+  } else if (!WriteAll(worker->fd, &request_size, sizeof(request_size)) ||
+             !WriteAll(worker->fd, request.data(), request.size())) {
+    DiscardWorker(worker);
+    result = FailedResult("Send the candidate to measure worker failed\n");
+  } else if (!WaitReadable(worker->fd, config_.timeout_ms)) {
+    kill(worker->pid, SIGKILL);
+    DiscardWorker(worker);
+    result = FailedResult(utils::StringFormat("Run timeout after %d ms\n", config_.timeout_ms));
+  } else if (!ReadAll(worker->fd, &reply, sizeof(reply))) {
+    DiscardWorker(worker);
+    result = FailedResult("Measure worker exited while running the candidate, the candidate may crash it\n");
+  } else {
+    result.execution_cost = reply.execution_cost;
+    result.elapsed_time   = reply.elapsed_time;
+    result.error_msg.resize(reply.error_len);
+    if (reply.error_len > 0 && !ReadAll(worker->fd, &result.error_msg[0], reply.error_len)) {
+      DiscardWorker(worker);
+      result.error_msg = "Incomplete error message from measure worker\n";
+    }
+    if (!result.error_msg.empty()) {
+      result.execution_cost = std::numeric_limits<double>::max();
+    }
+  }
+  ReleaseWorker(index);
+
+  if (!result.error_msg.empty()) {
+    LOG(WARNING) << "Measure a candidate failed: " << result.error_msg;
+  }
+  return result;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,119 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/measure/measure.h"
+#include "cinn/auto_schedule/measure/simple_runner.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// This class runs each built candidate in an isolated worker process, so a
+// crashing or hanging candidate can't take down the tuning job and the measurement
+// doesn't contend with the threads of the tuner.
+//
+// The workers are a persistent pool forked by a fork server, which is forked by the
+// constructor, so it must be constructed before the tuner starts any thread: a fork of
+// a multithreaded process may inherit the locks held by the other threads.
+// Each worker is optionally pinned to a CPU core and serves the candidates one by one.
+// A candidate is shipped to a worker through a Unix domain socket with the host objects
+// its functions are compiled into, which the worker loads into its own ExecutionEngine,
+// and it runs the candidate with SimpleRunner and sends the timing stats back.
+// A function not compiled into the objects is called at the same address in the worker,
+// which only holds for the code loaded before the fork server, so the candidates built
+// with FLAGS_cinn_lazy_compile, which compiles no object, fail to run in workers.
+//
+// The tuner kills a worker once it runs out of the time limit, and a crashed or killed
+// worker is replaced by a new one from the fork server before its next candidate.
+// With the workers pinned to distinct cores, several candidates can be run at the same
+// time, see NumWorkers and ScheduleMeasurer.
+//
+// Only the host target is run in workers, candidates on other targets are run in process.
+class ProcessRunner : public ScheduleRunner {
+ public:
+  struct Config {
+    // The repeat times of running instructions
+    int repeat_times = 1;
+    // The time limit of running a candidate, unit: ms
+    int timeout_ms = 10000;
+    // The CPU cores that the workers are pinned to, one worker per core
+    std::vector<int> cpu_cores;
+    // The number of workers without pinning, only used if cpu_cores is empty
+    int num_workers = 1;
+  };
+
+  explicit ProcessRunner(const Config& config);
+
+  ~ProcessRunner();
+
+  MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override;
+
+  // The number of candidates that can be run at the same time
+  int NumWorkers() const { return workers_.size(); }
+
+ private:
+  struct Worker {
+    pid_t pid    = -1;
+    // The socket connected to the worker, -1 if the worker is dead
+    int fd       = -1;
+    int cpu_core = -1;
+  };
+
+  // The loop of the fork server, fork a worker for each request until the tuner closes the socket, never return
+  [[noreturn]] void ServeForks(int socket_fd);
+
+  // The loop of a worker, run the candidates sent through the socket until the tuner closes it, never return
+  [[noreturn]] void ServeCandidates(int socket_fd, int cpu_core);
+
+  // Run a candidate serialized by SerializeCandidate in a worker
+  MeasureResult RunSerializedCandidate(const std::string& request);
+
+  // Serialize the candidate to be run by a worker
+  std::string SerializeCandidate(const MeasureInput& input, const BuildResult& build_result) const;
+
+  // Get a worker from the fork server, return false if failed
+  bool SpawnWorker(Worker* worker);
+
+  // Kill the worker and close the socket, a new worker is spawned in its place when it is used next time
+  void DiscardWorker(Worker* worker);
+
+  // Wait for an idle worker and take it, return its index
+  int AcquireWorker();
+
+  void ReleaseWorker(int index);
+
+ private:
+  const Config config_;
+  SimpleRunner simple_runner_;
+  // The fork server and the socket connected to it
+  pid_t fork_server_pid_ = -1;
+  int fork_server_fd_    = -1;
+  std::mutex fork_server_mtx_;
+  std::vector<Worker> workers_;
+  // The indices of the idle workers
+  std::vector<int> idle_workers_;
+  std::mutex workers_mtx_;
+  std::condition_variable workers_cv_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,144 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/measure/process_runner.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/hlir/framework/graph.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+using ::cinn::hlir::framework::Instruction;
+
+class TestProcessRunner : public ::testing::Test {
+ public:
+  TuneTask task;
+  MeasureInput input;
+  std::map<std::string, cinn_pod_value_t> preset_args;
+
+  void SetUp() override {
+    task.target   = common::DefaultHostTarget();
+    task.subgraph = std::make_shared<hlir::framework::Graph::Group>();
+    input.task    = &task;
+    // to skip the condition check of params in Instruction::PreparePodArgs
+    preset_args.emplace("empty_placeholder", cinn_pod_value_t());
+    input.execution_args = &preset_args;
+  }
+
+  // set up a BuildResult object with one instruction of the specified function
+  BuildResult MakeBuildResult(void (*fn)(void*, int32_t)) {
+    BuildResult build_result;
+    build_result.compiled_scope = nullptr;
+    std::vector<std::unique_ptr<Instruction>> instructions;
+    instructions.emplace_back(new Instruction(common::DefaultHostTarget(), nullptr, {}, {"empty_placeholder"}, "fn"));
+    instructions.back()->SetLoweredFunc(reinterpret_cast<void*>(fn));
+    instructions.back()->Finalize();
+    build_result.runtime_program.reset(new hlir::framework::Program(nullptr, std::move(instructions)));
+    return build_result;
+  }
+};
+
+TEST_F(TestProcessRunner, TimeMeasured) {
+  void (*sleep_fn)(void*, int32_t) = [](void*, int32_t) -> void {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  };
+  auto build_result = MakeBuildResult(sleep_fn);
+
+  ProcessRunner::Config config;
+  config.repeat_times          = 2;
+  config.cpu_cores             = {0};
+  auto runner                  = std::make_unique<ProcessRunner>(config);
+  MeasureResult measure_result = runner->Run(input, build_result);
+  ASSERT_TRUE(measure_result.error_msg.empty()) << measure_result.error_msg;
+  ASSERT_GE(measure_result.execution_cost, 100);
+  ASSERT_GE(measure_result.elapsed_time, 200);
+}
+
+TEST_F(TestProcessRunner, CandidateCrashed) {
+  void (*crash_fn)(void*, int32_t) = [](void*, int32_t) -> void { std::abort(); };
+  auto build_result                = MakeBuildResult(crash_fn);
+
+  auto runner                  = std::make_unique<ProcessRunner>(ProcessRunner::Config());
+  MeasureResult measure_result = runner->Run(input, build_result);
+  ASSERT_FALSE(measure_result.error_msg.empty());
+  ASSERT_EQ(measure_result.execution_cost, std::numeric_limits<double>::max());
+
+  // the tuner survives and the crashed worker is replaced for the following candidates
+  void (*empty_fn)(void*, int32_t) = [](void*, int32_t) -> void {};
+  auto valid_result                = MakeBuildResult(empty_fn);
+  ASSERT_TRUE(runner->Run(input, valid_result).error_msg.empty());
+  ASSERT_TRUE(runner->Run(input, valid_result).error_msg.empty());
+}
+
+TEST_F(TestProcessRunner, CandidateTimeout) {
+  void (*hang_fn)(void*, int32_t) = [](void*, int32_t) -> void {
+    std::this_thread::sleep_for(std::chrono::seconds(60));
+  };
+  auto build_result = MakeBuildResult(hang_fn);
+
+  ProcessRunner::Config config;
+  config.timeout_ms            = 200;
+  auto runner                  = std::make_unique<ProcessRunner>(config);
+  auto start                   = std::chrono::steady_clock::now();
+  MeasureResult measure_result = runner->Run(input, build_result);
+  auto cost = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start).count();
+  ASSERT_FALSE(measure_result.error_msg.empty());
+  ASSERT_LT(cost, 10);
+
+  // the killed worker is replaced for the following candidates
+  void (*empty_fn)(void*, int32_t) = [](void*, int32_t) -> void {};
+  auto valid_result                = MakeBuildResult(empty_fn);
+  ASSERT_TRUE(runner->Run(input, valid_result).error_msg.empty());
+}
+
+TEST_F(TestProcessRunner, WorkersRunConcurrently) {
+  void (*sleep_fn)(void*, int32_t) = [](void*, int32_t) -> void {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  };
+  auto build_result = MakeBuildResult(sleep_fn);
+
+  ProcessRunner::Config config;
+  config.num_workers = 2;
+  auto runner        = std::make_unique<ProcessRunner>(config);
+  ASSERT_EQ(runner->NumWorkers(), 2);
+
+  std::vector<MeasureResult> results(2);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&, i]() { results[i] = runner->Run(input, build_result); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  for (auto&& result : results) {
+    ASSERT_TRUE(result.error_msg.empty()) << result.error_msg;
+    ASSERT_GE(result.execution_cost, 500000);
+  }
+  // the two candidates are run by two workers at the same time rather than one after another
+  ASSERT_LT(cost, 1000);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
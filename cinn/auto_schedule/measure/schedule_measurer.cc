@@ -61,13 +61,20 @@ std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureIn
     results[index].elapsed_time += static_cast<double>(time_span.count());
   };
 
-  // measure a candidate by calling build and run successively
-  auto measure_fn = [&build_fn, &run_fn](int index) {
-    build_fn(index);
-    run_fn(index);
-  };
-  // default num_threads_ is 1 and in that case it will perform all measurements sequentially inplace.
-  utils::parallel_run(measure_fn, utils::SequenceDispatcher(0, inputs.size()), num_threads_);
+  if (num_threads_ <= 1) {
+    // measure a candidate by calling build and run successively, so a runner can use the functions compiled by the
+    // builder before they are replaced by the next build
+    for (int index = 0; index < inputs.size(); ++index) {
+      build_fn(index);
+      run_fn(index);
+    }
+  } else {
+    // the builder may share one compiler among the candidates, so they are built one by one, then run concurrently
+    for (int index = 0; index < inputs.size(); ++index) {
+      build_fn(index);
+    }
+    utils::parallel_run(run_fn, utils::SequenceDispatcher(0, inputs.size()), num_threads_);
+  }
 
   VLOG(4) << "Measure " << inputs.size() << " candidates";
   return results;
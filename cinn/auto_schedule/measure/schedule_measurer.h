@@ -35,8 +35,9 @@ class ScheduleMeasurer {
   ScheduleBuilder* builder_;
   // The handle to implemented ScheduleRunner
   ScheduleRunner* runner_;
-  // The number of threads used to perform measurement,
-  // if it is greater than 1 that means parallel measurement.
+  // The number of threads used to run the candidates, if it is greater than 1, the candidates
+  // are all built before running them in parallel, which needs a runner not relying on the
+  // functions compiled by the builder being alive, such as ProcessRunner
   const int num_threads_;
 };
 
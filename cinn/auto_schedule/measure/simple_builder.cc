@@ -14,6 +14,12 @@
 
 #include "cinn/auto_schedule/measure/simple_builder.h"
 
+#include <gflags/gflags.h>
+
+#include "cinn/backends/llvm/llvm_optimizer.h"
+
+DECLARE_string(cinn_tuning_llvm_optimize_profile);
+
 namespace cinn {
 namespace auto_schedule {
 
@@ -27,6 +33,9 @@ BuildResult SimpleBuilder::Build(const MeasureInput& input) {
   compile_options.groups.emplace_back(input.task->subgraph);
   compile_options.lowered_funcs.emplace_back(input.lowered_funcs);
   compile_options.remove_unused_variables = false;
+  // the candidates are only compared with each other, so a cheaper pipeline is used to measure more of them
+  compile_options.llvm_optimize_options.profile =
+      backends::OptimizeProfileFromString(FLAGS_cinn_tuning_llvm_optimize_profile);
   VLOG(5) << "call GraphCompiler to Build with Graph::Group size=" << compile_options.groups.size()
           << ", lowered_funcs group size=" << compile_options.lowered_funcs.size();
   GraphCompiler::CompilationResult compiled_result = graph_compiler_->Build(compile_options);
@@ -34,6 +43,7 @@ BuildResult SimpleBuilder::Build(const MeasureInput& input) {
   BuildResult build_result;
   build_result.compiled_scope  = graph_compiler_->GetScope().get();
   build_result.runtime_program = std::move(compiled_result.runtime_program);
+  build_result.host_objects    = std::move(compiled_result.host_objects);
   return build_result;
 }
 
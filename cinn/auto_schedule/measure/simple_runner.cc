@@ -101,9 +101,7 @@ static void InitTensorData(Tensor tensor, const common::Target& target, bool ini
   }
 }
 
-// Find all parameter names in the task corresponding to the MeasureInput
-// that need to be initialized to 0 when measuring.
-static std::unordered_set<std::string> ParamsNeedInitWithZero(const MeasureInput& input) {
+std::unordered_set<std::string> SimpleRunner::ParamsNeedInitWithZero(const MeasureInput& input) {
   std::unordered_set<std::string> res;
   std::vector<hlir::framework::Node*> nodes = input.task->subgraph->CollectNodes();
   for (auto* node : nodes) {
@@ -128,9 +126,11 @@ SimpleRunner::SimpleRunner(int repeat_times) : repeat_times_(repeat_times) {
 // Prepare execution arguments of all instructions to run, a argument
 // may be obtained from the input of measurement or allocating new buffer
 // with random value.
-std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(const MeasureInput& input,
-                                                                  const BuildResult& build_result,
-                                                                  hlir::framework::Scope* temp_scope) {
+std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(
+    const MeasureInput& input,
+    const BuildResult& build_result,
+    const std::unordered_set<std::string>& params_need_init_with_zero,
+    hlir::framework::Scope* temp_scope) {
   std::map<std::string, cinn_pod_value_t> result;
 
   const auto& target         = input.task->target;
@@ -138,8 +138,6 @@ std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(const MeasureI
   const auto* compiled_scope = build_result.compiled_scope;
   const auto& instructions   = build_result.runtime_program->GetRunInstructions();
 
-  std::unordered_set<std::string> params_need_init_with_zero = ParamsNeedInitWithZero(input);
-
   auto fill_arg_fn = [&](const std::string& param) {
     VLOG(6) << "Filling argument:" << param;
     // the argument is duplicated and has been prepared.
@@ -187,12 +185,18 @@ std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(const MeasureI
 }
 
 MeasureResult SimpleRunner::Run(const MeasureInput& input, const BuildResult& build_result) {
+  return Run(input, build_result, ParamsNeedInitWithZero(input));
+}
+
+MeasureResult SimpleRunner::Run(const MeasureInput& input,
+                                const BuildResult& build_result,
+                                const std::unordered_set<std::string>& params_need_init_with_zero) {
   MeasureResult result;
   auto t_start = std::chrono::steady_clock::now();
   // prepare execution arguments
   VLOG(4) << "SimpleRunner prepare execution arguments";
   hlir::framework::Scope temp_scope;  // used for store temporary allocated data
-  auto execution_args = PrepareArgs(input, build_result, &temp_scope);
+  auto execution_args = PrepareArgs(input, build_result, params_need_init_with_zero, &temp_scope);
 
   // Execute each instruction repeatedly and take the average as cost.
   result.execution_cost    = 0;
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+#include <unordered_set>
+
 #include "cinn/auto_schedule/measure/measure.h"
 #include "cinn/hlir/framework/instruction.h"
 
@@ -28,9 +32,19 @@ class SimpleRunner : public ScheduleRunner {
 
   MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override;
 
+  // Run with the parameters needing to be initialized to 0 given, rather than collected from the subgraph of the task
+  MeasureResult Run(const MeasureInput& input,
+                    const BuildResult& build_result,
+                    const std::unordered_set<std::string>& params_need_init_with_zero);
+
+  // Find all parameter names in the task corresponding to the MeasureInput
+  // that need to be initialized to 0 when measuring.
+  static std::unordered_set<std::string> ParamsNeedInitWithZero(const MeasureInput& input);
+
  private:
   std::map<std::string, cinn_pod_value_t> PrepareArgs(const MeasureInput& input,
                                                       const BuildResult& build_result,
+                                                      const std::unordered_set<std::string>& params_need_init_with_zero,
                                                       hlir::framework::Scope* temp_scope);
 
  private:
@@ -32,6 +32,7 @@
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/optim/ir_copy.h"
 
@@ -86,6 +87,8 @@ void MultiLevelTiling::Apply(int index) {
   Expr block_expr = all_block_realizes_[apply_index];
   ApplyTiling(ir_schedule_, block_expr);
   block_expr = ir_schedule_->GetBlock(block_name);
+  ApplyDecomposeReduction(ir_schedule_, block_expr);
+  block_expr = ir_schedule_->GetBlock(block_name);
   ApplyCacheRead(ir_schedule_, block_expr);
   block_expr = ir_schedule_->GetBlock(block_name);
   ApplyCacheWrite(ir_schedule_, block_expr);
@@ -111,6 +114,8 @@ std::vector<SearchState> MultiLevelTiling::ApplyOnBlock(SearchState state, const
   Expr block_expr        = ir_sch->GetBlock(block_name);
   ApplyTiling(ir_sch, block_expr);
   block_expr = ir_sch->GetBlock(block_name);
+  ApplyDecomposeReduction(ir_sch, block_expr);
+  block_expr = ir_sch->GetBlock(block_name);
   ApplyCacheRead(ir_sch, block_expr);
   block_expr = ir_sch->GetBlock(block_name);
   ApplyCacheWrite(ir_sch, block_expr);
@@ -272,6 +277,35 @@ void MultiLevelTiling::ApplyTiling(ir::IRSchedule* ir_schedule, ir::Expr& block_
   }
 }
 
+void MultiLevelTiling::ApplyDecomposeReduction(ir::IRSchedule* ir_schedule, ir::Expr& block_expr) {
+  // With a write cache, the init of a reduction is placed at the write cache level in ApplyCacheWrite
+  const std::string block_name =
+      block_expr.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name;
+  const std::string reduce_init_block_name = ir::GenReduceInitTensorNameOf(block_name);
+  if (!config_.write_cache_levels.empty() || !ir_schedule->HasBlock(reduce_init_block_name)) {
+    return;
+  }
+  auto r_index =
+      std::find_if(r_indices_.begin(), r_indices_.end(), [this](int index) { return !tile_loops_[index].empty(); });
+  if (r_index == r_indices_.end()) {
+    return;
+  }
+
+  // Otherwise the init stays in its own loop nest, which initializes the whole output before accumulating any tile of
+  // it, so hoisting it right before the outermost reduce tiling loop is sampled to keep each output tile in cache.
+  int decompose = ir_schedule->SampleCategorical({0, 1}, {0.5, 0.5}).as_int32();
+  if (!decompose) {
+    return;
+  }
+  std::string reduce_loop_name = tile_loops_[*r_index].front().As<ir::For>()->loop_var->name;
+  for (const Expr& for_expr : ir_schedule->GetLoops(block_name)) {
+    if (for_expr.As<ir::For>()->loop_var->name == reduce_loop_name) {
+      ir_schedule->DecomposeReduction(ir_schedule->GetBlock(block_name), for_expr);
+      break;
+    }
+  }
+}
+
 void MultiLevelTiling::ApplyCacheRead(ir::IRSchedule* ir_schedule, ir::Expr& block_expr) {
   ir::ScheduleBlockRealize* sch_block_realize = block_expr.As<ir::ScheduleBlockRealize>();
   ir::ScheduleBlock* sch_block                = sch_block_realize->schedule_block.As<ir::ScheduleBlock>();
@@ -340,11 +374,59 @@ void MultiLevelTiling::ApplyCacheRead(ir::IRSchedule* ir_schedule, ir::Expr& blo
       auto fused_buffer_loop = ir_schedule->Fuse(buffer_loops);
       // TODO(BiynXu): Implement vectorize fetching data and pass in vector length
       ir_schedule->Annotate(ir_schedule->GetBlock(cache_block_name), ir::attr::cooperative_process, 0);
+
+      // 5.Sample the layout of the cache buffer
+      ApplyReadCachePacking(ir_schedule, cache_block_name);
+      block_expr = ir_schedule->GetBlock(block_name);
     }
   }
 }
 
+void MultiLevelTiling::ApplyReadCachePacking(ir::IRSchedule* ir_schedule, const std::string& cache_block_name) {
+  if (config_.read_cache_pack_factors.empty()) {
+    return;
+  }
+  // The cache buffer is only accessed by the cache block and the block reading it, so its layout can be changed freely
+  Expr cache_block          = ir_schedule->GetBlock(cache_block_name);
+  Expr store                = ir::GetNthAccessExpr(cache_block, 0, true);
+  const ir::_Tensor_* cache = store.As<ir::Store>()->tensor.as_tensor();
+  if (cache->shape.size() < 2 || !cache->shape.back().is_constant()) {
+    return;
+  }
+  int extent = cache->shape.back().as_int32();
+
+  std::vector<int> candidates = {1};
+  for (int factor : config_.read_cache_pack_factors) {
+    if (factor > 1 && factor < extent && extent % factor == 0) {
+      candidates.push_back(factor);
+    }
+  }
+  if (candidates.size() == 1) {
+    return;
+  }
+  std::vector<float> probs(candidates.size(), 1.0f / candidates.size());
+  int factor = ir_schedule->SampleCategorical(candidates, probs).as_int32();
+  if (factor == 1) {
+    return;
+  }
+
+  int rank = cache->shape.size();
+  std::vector<int> split_factors(rank, 1);
+  split_factors.back() = factor;
+  // the outer part of the innermost axis is the axis `rank - 1` after the split and the inner part is the axis `rank`
+  std::vector<int> axis_order = {rank - 1};
+  for (int i = 0; i < rank - 1; ++i) {
+    axis_order.push_back(i);
+  }
+  axis_order.push_back(rank);
+  ir_schedule->TransformLayout(cache_block, 0, true, split_factors, axis_order);
+}
+
 void MultiLevelTiling::ApplyCacheWrite(ir::IRSchedule* ir_schedule, ir::Expr& block_expr) {
+  // The write cache would be written back only after the whole loop nest without any level to place it at
+  if (config_.write_cache_levels.empty()) {
+    return;
+  }
   ir::Expr cache_block = ir_schedule->CacheWrite(block_expr, 0, config_.write_cache_memory_type);
 
   for (int level : config_.write_cache_levels) {
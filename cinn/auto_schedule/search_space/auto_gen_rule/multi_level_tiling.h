@@ -49,8 +49,14 @@ class MultiLevelTiling : public AutoGenRule {
     std::vector<int> read_cache_levels;
     // The storage type of write cache
     std::string write_cache_memory_type;
-    // Which tiled levels are write cache block inserted at
+    // Which tiled levels are write cache block inserted at.
+    // Without any level, no write cache is inserted, and whether to initialize the
+    // output of a reduction right before its outermost reduce tiling loop is sampled
     std::vector<int> write_cache_levels;
+    // The candidate factors to pack each read cache buffer by, one of them or none is sampled.
+    // Packing splits the innermost axis by the factor and moves the outer part outermost,
+    // such as [K, N] to [N / 8, K, 8]
+    std::vector<int> read_cache_pack_factors;
   };
 
   static const std::unordered_map<common::Target::Arch, Config> kConfigs;
@@ -118,7 +124,9 @@ class MultiLevelTiling : public AutoGenRule {
 
  private:
   void ApplyTiling(ir::IRSchedule* ir_schedule, ir::Expr& block_expr);
+  void ApplyDecomposeReduction(ir::IRSchedule* ir_schedule, ir::Expr& block_expr);
   void ApplyCacheRead(ir::IRSchedule* ir_schedule, ir::Expr& block_expr);
+  void ApplyReadCachePacking(ir::IRSchedule* ir_schedule, const std::string& cache_block_name);
   void ApplyCacheWrite(ir::IRSchedule* ir_schedule, ir::Expr& block_expr);
 
  private:
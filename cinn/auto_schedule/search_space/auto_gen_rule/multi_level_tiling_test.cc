@@ -19,6 +19,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <set>
 #include <vector>
 
 #include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
@@ -29,6 +30,7 @@
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/compute.h"
 #include "cinn/lang/lower.h"
@@ -541,5 +543,89 @@ Expr 1 {
               target_);
 }
 
+TEST_F(TestMultiLevelTiling, DecomposeReductionWithoutWriteCache) {
+  default_input_names            = {"X", "Y"};
+  default_output_names           = {"temp_matmul_out"};
+  std::vector<int32_t> X_shape   = {32, 32};
+  std::vector<int32_t> Y_shape   = {32, 32};
+  std::vector<int32_t> out_shape = {32, 32};
+
+  Initialize(common::DefaultNVGPUTarget());
+  frontend::Program matmul_op         = tests::OpBuilder("matmul").Build({{"X", X_shape}, {"Y", Y_shape}});
+  MultiLevelTiling::Config mlt_config = {
+      /*bind_axis*/ std::vector<std::string>{"blockIdx.x", "threadIdx.x"},
+      /*tile_struct*/ std::string("SSSRRSRS"),
+      /*read_cache_memory_type*/ std::string("shared"),
+      /*read_cache_levels*/ std::vector<int>{},
+      /*write_cache_memory_type*/ std::string("local"),
+      /*write_cache_levels*/ std::vector<int>{},
+  };
+  MultiLevelTiling multi_level_tiling(target_, mlt_config);
+  const std::string init_block_name = default_output_names[0] + "__reduce_init";
+
+  // both decisions are sampled among the seeds, and the output is initialized correctly with either of them
+  std::set<bool> sampled;
+  for (int seed = 0; seed < 32 && sampled.size() < 2; ++seed) {
+    SearchState state(MakeIRSchedule(matmul_op, seed));
+    auto new_states        = multi_level_tiling.ApplyOnBlock(state, default_output_names[0]);
+    ir::IRSchedule& ir_sch = new_states[0]->ir_schedule;
+    // the decomposed init shares the outer tiling loops with the reduction rather than having its own loop nest
+    bool decomposed = ir_sch.GetLoops(init_block_name)[0] == ir_sch.GetLoops(default_output_names[0])[0];
+    if (!sampled.insert(decomposed).second) continue;
+    VLOG(6) << "After MultiLevelTiling with decomposed = " << decomposed << ", state:\n"
+            << new_states[0]->DebugString();
+
+    auto test_func = GenExecutableKernel(BuildIRModule(ir_sch));
+    CheckResult(test_func,
+                GenExecutableKernel(BuildIRModule(MakeIRSchedule(matmul_op, seed, /* apply_manual_schedule*/ true))),
+                default_input_names,
+                default_output_names,
+                {X_shape, Y_shape},
+                {out_shape},
+                target_);
+  }
+  EXPECT_EQ(sampled.size(), 2UL);
+}
+
+TEST_F(TestMultiLevelTiling, PackReadCache) {
+  default_input_names            = {"X", "Y"};
+  default_output_names           = {"temp_matmul_out"};
+  std::vector<int32_t> X_shape   = {32, 32};
+  std::vector<int32_t> Y_shape   = {32, 32};
+  std::vector<int32_t> out_shape = {32, 32};
+
+  Initialize(common::DefaultNVGPUTarget());
+  frontend::Program matmul_op         = tests::OpBuilder("matmul").Build({{"X", X_shape}, {"Y", Y_shape}});
+  MultiLevelTiling::Config mlt_config = MultiLevelTiling::kConfigs.at(target_.arch);
+  mlt_config.read_cache_pack_factors  = {4};
+  MultiLevelTiling multi_level_tiling(target_, mlt_config);
+  auto is_packed = [](ir::IRSchedule* ir_sch, const std::string& cache_block_name) {
+    Expr store = ir::GetNthAccessExpr(ir_sch->GetBlock(cache_block_name), 0, true);
+    return store.As<ir::Store>()->tensor.as_tensor()->shape.size() == 3;
+  };
+
+  bool sampled_packed = false;
+  for (int seed = 0; seed < 32 && !sampled_packed; ++seed) {
+    SearchState state(MakeIRSchedule(matmul_op, seed));
+    auto new_states        = multi_level_tiling.ApplyOnBlock(state, default_output_names[0]);
+    ir::IRSchedule* ir_sch = &new_states[0]->ir_schedule;
+    // a cache buffer [32, 32] is packed to [8, 32, 4] by the only candidate factor
+    sampled_packed =
+        is_packed(ir_sch, "X_reshape_shared_temp_buffer") || is_packed(ir_sch, "Y_reshape_shared_temp_buffer");
+    if (!sampled_packed) continue;
+    VLOG(6) << "After MultiLevelTiling with packed read cache, state:\n" << new_states[0]->DebugString();
+
+    auto test_func = GenExecutableKernel(BuildIRModule(*ir_sch));
+    CheckResult(test_func,
+                GenExecutableKernel(BuildIRModule(MakeIRSchedule(matmul_op, seed, /* apply_manual_schedule*/ true))),
+                default_input_names,
+                default_output_names,
+                {X_shape, Y_shape},
+                {out_shape},
+                target_);
+  }
+  EXPECT_TRUE(sampled_packed);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -16,11 +16,16 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <functional>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+#include "cinn/auto_schedule/cost_model/feature.h"
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
 #include "cinn/auto_schedule/measure/measure.h"
 #include "cinn/auto_schedule/search_strategy/evolutionary_search.h"
 #include "cinn/common/target.h"
@@ -30,6 +35,7 @@
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/schedule_desc.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/transform_gpu_forloop.h"
 #include "cinn/runtime/flags.h"
@@ -90,6 +96,7 @@ FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options) {
   sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) { return lhs.cost < rhs.cost; });
   auto&& best = candidates.front();
   VLOG(4) << "Total candidates=" << candidates.size() << ", the best from=" << best.from << ", cost=" << best.cost;
+  last_best_ = best;
 
   // revert input/output names
   task_->subgraph->input_names  = initial_input_names;
@@ -97,6 +104,107 @@ FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options) {
   return best.functions;
 }
 
+namespace {
+// Rename a block name by the mapping of the variables, which is either a variable or derived from one like
+// `var_1__reduce_init`. The longer variables are matched first.
+std::string RenameByVars(const std::string& name, const std::vector<std::pair<std::string, std::string>>& renamed) {
+  for (auto&& item : renamed) {
+    if (name == item.first) {
+      return item.second;
+    }
+    if (name.size() > item.first.size() && name.compare(0, item.first.size(), item.first) == 0 &&
+        name[item.first.size()] == '_') {
+      return item.second + name.substr(item.first.size());
+    }
+  }
+  return name;
+}
+
+std::vector<std::string> GetBlockNames(const TuneTask& task) {
+  ir::IRSchedule ir_sch(optim::IRCopy(ir::ModuleExpr(task.GetLoweredFuncBodyExprs())));
+  std::vector<std::string> names;
+  for (auto&& block : ir_sch.GetAllBlocks()) {
+    names.push_back(block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name);
+  }
+  return names;
+}
+}  // namespace
+
+FunctionGroup TaskOptimizer::OptimizeAs(const TaskOptimizer& identical, const TuningOptions& options) {
+  const Result& best = identical.last_best_;
+  if (IsForbiddenToTune(task_) || IsWrappedByCustomCall(task_) || best.from.empty()) {
+    return Optimize(options);
+  }
+
+  std::vector<std::pair<std::string, std::string>> renamed;
+  std::vector<std::string> from_vars = identical.task_->GetVarNames();
+  std::vector<std::string> to_vars   = task_->GetVarNames();
+  if (from_vars.size() != to_vars.size()) {
+    VLOG(3) << "The variables of the identical task differ, tune the task separately";
+    return Optimize(options);
+  }
+  for (size_t i = 0; i < from_vars.size(); ++i) {
+    renamed.emplace_back(from_vars[i], to_vars[i]);
+  }
+  std::sort(renamed.begin(), renamed.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first.size() > rhs.first.size();
+  });
+
+  // the trace refers to the blocks by names, so it applies only if the blocks are renamed one to one
+  std::vector<std::string> from_blocks = GetBlockNames(*identical.task_);
+  std::vector<std::string> to_blocks   = GetBlockNames(*task_);
+  for (auto& name : from_blocks) {
+    name = RenameByVars(name, renamed);
+  }
+  if (from_blocks != to_blocks) {
+    VLOG(3) << "The blocks of the identical task can't be renamed to the ones of this task, tune it separately";
+    return Optimize(options);
+  }
+
+  auto initial_input_names  = task_->subgraph->input_names;
+  auto initial_output_names = task_->subgraph->output_names;
+  Result result(best.from);
+  result.cost = best.cost;
+  if (best.from == "Manual") {
+    result.functions = task_->op_lowerer->Lower(task_->subgraph);
+  } else if (best.from == "External") {
+    result.functions = OptimizeByExternal(false).functions;
+  } else {
+    result.trace = best.trace;
+    for (auto& step : *result.trace.mutable_steps()) {
+      for (auto& attr : *step.mutable_attrs()) {
+        if (!attr.s().empty()) {
+          attr.set_s(RenameByVars(attr.s(), renamed));
+        }
+        for (auto& s : *attr.mutable_strings()) {
+          s = RenameByVars(s, renamed);
+        }
+      }
+    }
+    ir::IRSchedule ir_sch(optim::IRCopy(ir::ModuleExpr(task_->GetLoweredFuncBodyExprs())));
+    ir::ScheduleDesc::ReplayWithProto(result.trace, &ir_sch);
+    std::vector<ir::Expr> exprs = ir_sch.GetModule().GetExprs();
+    auto init_funcs             = optim::IRCopy(task_->lowered_funcs);
+    for (size_t i = 0; i < exprs.size(); ++i) {
+      result.functions.emplace_back(UpdateFuncWithNewBody(task_->target, init_funcs[i], exprs[i]));
+    }
+    if (best.cost < std::numeric_limits<double>::max()) {
+      TuningRecord record;
+      record.task_key       = task_->serialized_key;
+      record.predicted_cost = 0.0;
+      record.trace          = result.trace;
+      record.execution_cost = best.cost;
+      database_->AddRecord(record);
+    }
+  }
+  VLOG(4) << "Apply the best result from=" << best.from << " of an identical task, cost=" << best.cost;
+
+  task_->subgraph->input_names  = initial_input_names;
+  task_->subgraph->output_names = initial_output_names;
+  last_best_                    = result;
+  return result.functions;
+}
+
 TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
   static constexpr char* kManualMeasuredKeyPrefix = "@ManualMeasured:\n";
   TaskOptimizer::Result result("Manual");
@@ -120,7 +228,9 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
     inputs.back().lowered_funcs = result.functions;
     VLOG(4) << "Measure manual schedule";
     std::vector<MeasureResult> measure_outputs = schedule_measurer_->Measure(inputs);
-    database_->AddRecord(TuningRecord(measured_key, state, measure_outputs[0].execution_cost));
+    if (measure_outputs[0].error_msg.empty()) {
+      database_->AddRecord(TuningRecord(measured_key, state, measure_outputs[0].execution_cost));
+    }
   }
 
   auto measured_records = database_->LookUp(measured_key);
@@ -152,7 +262,10 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByExternal(bool need_measured) {
     VLOG(4) << "Measure external api";
     std::vector<MeasureResult> measure_outputs = schedule_measurer_->Measure(inputs);
     // the SearchState of external is invalid and will not be used, so we just put a temporary one
-    database_->AddRecord(TuningRecord(measured_key, SearchState(ir::IRSchedule()), measure_outputs[0].execution_cost));
+    if (measure_outputs[0].error_msg.empty()) {
+      database_->AddRecord(
+          TuningRecord(measured_key, SearchState(ir::IRSchedule()), measure_outputs[0].execution_cost));
+    }
   }
 
   auto measured_records = database_->LookUp(measured_key);
@@ -230,6 +343,7 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
         best_cost = cost_model_.Predict(states.front()->ir_schedule.GetModule(), task_->target);
       }
       optimized_funcs = measure_candidates[0].lowered_funcs;
+      result.trace    = states.front()->ir_schedule.GetTraceDesc().ToProto();
     } else {
       LOG(WARNING) << "No valid candidate searched, will return initial state";
     }
@@ -260,19 +374,31 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
     std::vector<MeasureResult> measure_outputs = schedule_measurer_->Measure(measure_inputs);
     CHECK_EQ(measure_outputs.size(), states.size())
         << "ScheduleMeasurer didn't output same number of MeasureOutput of states in TaskOptimizer";
-    // record to database
+    // the candidates failed to build or run have no valid cost, so they are neither recorded nor learned
+    std::vector<size_t> valid_indices;
     for (size_t i = 0; i < states.size(); ++i) {
-      database_->AddRecord(
-          TuningRecord(measure_inputs[i].task->serialized_key, states[i], measure_outputs[i].execution_cost));
+      if (measure_outputs[i].error_msg.empty()) {
+        valid_indices.push_back(i);
+      } else {
+        VLOG(4) << "Drop the failed candidate-" << i << ": " << measure_outputs[i].error_msg;
+      }
+    }
+
+    // record to database, with the features of the candidates so that they can train a cost model offline
+    FeatureExtractor extractor;
+    for (size_t i : valid_indices) {
+      TuningRecord record(measure_inputs[i].task->serialized_key, states[i], measure_outputs[i].execution_cost);
+      record.features = extractor.Extract(states[i]->ir_schedule.GetModule(), task_->target).ToFixedSizeVector();
+      database_->AddRecord(record);
     }
 
     // update cost model
-    if (FLAGS_auto_schedule_use_cost_model) {
-      std::vector<const ir::ModuleExpr*> cost_model_samples(states.size());
-      std::vector<float> cost_model_labels(states.size());
-      for (size_t i = 0; i < states.size(); ++i) {
-        cost_model_samples[i] = &(states[i]->ir_schedule.GetModule());
-        cost_model_labels[i]  = measure_outputs[i].execution_cost;
+    if (FLAGS_auto_schedule_use_cost_model && !valid_indices.empty()) {
+      std::vector<const ir::ModuleExpr*> cost_model_samples;
+      std::vector<float> cost_model_labels;
+      for (size_t i : valid_indices) {
+        cost_model_samples.push_back(&(states[i]->ir_schedule.GetModule()));
+        cost_model_labels.push_back(measure_outputs[i].execution_cost);
       }
       VLOG(4) << utils::StringFormat("Update CostModel with samples size=%lu,labels size=%lu",
                                      cost_model_samples.size(),
@@ -281,11 +407,12 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
     }
 
     // update the best
-    for (size_t i = 0; i < measure_outputs.size(); ++i) {
+    for (size_t i : valid_indices) {
       if (measure_outputs[i].execution_cost < best_cost) {
         VLOG(4) << "Update best candidate with execution_cost:" << measure_outputs[i].execution_cost << "us";
         best_cost       = measure_outputs[i].execution_cost;
         optimized_funcs = measure_inputs[i].lowered_funcs;
+        result.trace    = states[i]->ir_schedule.GetTraceDesc().ToProto();
       }
     }
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
 #include "cinn/auto_schedule/database/database.h"
@@ -40,11 +41,21 @@ class TaskOptimizer {
 
   FunctionGroup Optimize(const TuningOptions& options);
 
+  // Apply the best result of an identical task found in its last Optimize to this task by renaming the
+  // variables, and copy the best record into the database for this task. It falls back to Optimize
+  // if the result can't be applied.
+  FunctionGroup OptimizeAs(const TaskOptimizer& identical, const TuningOptions& options);
+
+  // Warm-start the cost model with a model trained before
+  void LoadCostModel(const std::string& path) { cost_model_.Load(path); }
+
  private:
   struct Result {
     std::string from;
     double cost;
     FunctionGroup functions;
+    // the schedule trace of the functions searched by evolution
+    ir::proto::ScheduleDesc trace;
     Result(const std::string& from_type) : from(from_type), cost(std::numeric_limits<double>::max()) {}
   };
 
@@ -63,6 +74,8 @@ class TaskOptimizer {
   std::unique_ptr<EvolutionarySearch> evolutionary_search_ = nullptr;
   ExprCostModel cost_model_;
   Database* database_;
+  // the best result of the last Optimize, applied to the identical tasks
+  Result last_best_{""};
   utils::LinearRandomEngine::StateType rand_seed_;
 };
 
@@ -16,7 +16,12 @@
 
 #include <glog/logging.h>
 
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <regex>
+#include <unordered_set>
 #include <vector>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
@@ -30,6 +35,26 @@
 namespace cinn {
 namespace auto_schedule {
 
+namespace {
+
+// Print the value of an attribute of a node, with the floats in full precision so that
+// the nodes differing only by a float attribute are serialized differently.
+struct AttrValuePrinter {
+  std::ostream& os;
+  explicit AttrValuePrinter(std::ostream& os) : os(os) {}
+
+  template <typename T>
+  void operator()(const T& v) {
+    os << v;
+  }
+  template <typename T>
+  void operator()(const std::vector<T>& vs) {
+    os << "[" << utils::Join(vs, ",") << "]";
+  }
+};
+
+}  // namespace
+
 void TuneTask::Initialize(const absl::flat_hash_map<std::string, hlir::framework::shape_t>& shape_dict,
                           const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict,
                           hlir::framework::OpLowerer* lower_handler) {
@@ -50,9 +75,25 @@ std::vector<ir::Expr> TuneTask::GetLoweredFuncBodyExprs() const {
   return result;
 }
 
+std::vector<std::string> TuneTask::GetVarNames() const {
+  // the serialized_key contains items like `var_name->float32[32,64]`
+  static const std::regex var_pattern("([^\\s(),]+)->");
+  std::vector<std::string> names;
+  std::unordered_set<std::string> visited;
+  auto begin = std::sregex_iterator(serialized_key.begin(), serialized_key.end(), var_pattern);
+  for (auto it = begin; it != std::sregex_iterator(); ++it) {
+    std::string name = (*it)[1].str();
+    if (visited.insert(name).second) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
 std::string TuneTask::SerializeToString(const absl::flat_hash_map<std::string, hlir::framework::shape_t>& shape_dict,
                                         const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict) {
   std::stringstream ss;
+  ss << std::setprecision(std::numeric_limits<double>::max_digits10);
   ss << target << "\n\n";  // print target
 
   // local function to print dtype,shape of out/in variables of the specified node
@@ -86,7 +127,24 @@ std::string TuneTask::SerializeToString(const absl::flat_hash_map<std::string, h
     print_node_links_fn(node->outlinks_in_order(), false);
     ss << ") = " << node->op()->name << "(";
     print_node_links_fn(node->inlinks_in_order(), true);
-    ss << ")\n";
+    ss << ")";
+    // print the attributes sorted by their names, since the nodes of the same operator with
+    // different attributes are lowered to different functions
+    const auto& attr_store = node->attrs.attr_store;
+    if (!attr_store.empty()) {
+      std::map<std::string, hlir::framework::AttrType> sorted_attrs(attr_store.begin(), attr_store.end());
+      ss << " {";
+      int printed_num = 0;
+      for (auto&& attr : sorted_attrs) {
+        if (printed_num++ > 0) {
+          ss << ", ";
+        }
+        ss << attr.first << "=";
+        absl::visit(AttrValuePrinter(ss), attr.second);
+      }
+      ss << "}";
+    }
+    ss << "\n";
   }
   ss << "}\n";
 
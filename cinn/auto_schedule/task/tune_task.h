@@ -43,6 +43,9 @@ class TuneTask {
                   hlir::framework::OpLowerer* lower_handler);
   // Extract bodies in lowered_funcs() and return
   std::vector<ir::Expr> GetLoweredFuncBodyExprs() const;
+  // Return the names of the variables in serialized_key by the order of their first appearances,
+  // the identical tasks list their variables at the same positions
+  std::vector<std::string> GetVarNames() const;
 
   // In CINN, we use hlir::framework::Graph::Group to represent a fused
   // sub-graph (if an op won't be fused, it will be a Group with size=1).
@@ -55,7 +58,7 @@ class TuneTask {
   std::vector<ir::LoweredFunc> lowered_funcs;
   // names of the output arguments of lowered_funcs_
   std::unordered_set<std::string> output_names;
-  // serialized string of this task, it contain struct,shape,dtype,input/output variable name
+  // serialized string of this task, it contain struct,shape,dtype,attrs,input/output variable name
   // of the subgraph and can be further used to hash
   std::string serialized_key;
 
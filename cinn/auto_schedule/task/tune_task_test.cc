@@ -297,14 +297,14 @@ TEST(TuneTask, SerializeToString) {
   std::string single_add_str = R"ROC(Target<linux,nvgpu,64>
 
 Group {
-  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24])
+  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24]) {axis=-1}
 }
 )ROC";
 #else
   std::string single_add_str     = R"ROC(Target<linux,x86,64>
 
 Group {
-  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24])
+  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24]) {axis=-1}
 }
 )ROC";
 #endif
@@ -319,20 +319,21 @@ Group {
   std::string fused_expected_str = R"ROC(Target<linux,nvgpu,64>
 
 Group {
-  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24])
-  (var_2->float32[32,24]) = elementwise_add(A->float32[32,24], var_1->float32[32,24])
+  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24]) {axis=-1}
+  (var_2->float32[32,24]) = elementwise_add(A->float32[32,24], var_1->float32[32,24]) {axis=-1}
 }
 )ROC";
 #else
   std::string fused_expected_str = R"ROC(Target<linux,x86,64>
 
 Group {
-  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24])
-  (var_2->float32[32,24]) = elementwise_add(A->float32[32,24], var_1->float32[32,24])
+  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[32,24]) {axis=-1}
+  (var_2->float32[32,24]) = elementwise_add(A->float32[32,24], var_1->float32[32,24]) {axis=-1}
 }
 )ROC";
 #endif
   EXPECT_EQ(fused_tasks[0].serialized_key, fused_expected_str);
+  EXPECT_EQ(fused_tasks[0].GetVarNames(), std::vector<std::string>({"var_1", "A", "B", "var_2"}));
 }
 
 }  // namespace auto_schedule
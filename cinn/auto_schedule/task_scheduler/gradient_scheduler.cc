@@ -0,0 +1,163 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/task_scheduler/gradient_scheduler.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+#include <regex>
+#include <unordered_map>
+
+namespace cinn {
+namespace auto_schedule {
+
+GradientScheduler::GradientScheduler(const std::vector<TuneTask>& tasks, const Config& config, Database* database)
+    : TaskScheduler(tasks, config),
+      database_(database),
+      rand_seed_(utils::LinearRandomEngine::NormalizeState(config.rand_seed)) {
+  CHECK_GT(config_.backward_window, 0) << "backward_window should be greater than 0";
+  std::unordered_map<std::string, int> key2weighted;
+  task_to_weighted_.resize(tasks.size());
+  for (int i = 0; i < tasks.size(); ++i) {
+    std::string key = StructuralKey(tasks.at(i));
+    auto it         = key2weighted.find(key);
+    if (it == key2weighted.end()) {
+      it = key2weighted.emplace(key, weighted_tasks_.size()).first;
+      weighted_tasks_.emplace_back();
+    }
+    weighted_tasks_.at(it->second).task_ids.push_back(i);
+    task_to_weighted_[i] = it->second;
+  }
+  VLOG(3) << "GradientScheduler deduplicates " << tasks.size() << " tasks into " << weighted_tasks_.size()
+          << " weighted tasks";
+}
+
+std::string GradientScheduler::StructuralKey(const TuneTask& task) {
+  // The serialized_key contains items like `var_name->float32[32,64]` and the attributes of each node,
+  // rename the variables by the order of their appearances so that identical subgraphs share the same key.
+  static const std::regex var_pattern("([^\\s(),]+)->");
+  std::unordered_map<std::string, int> renamed;
+  std::string result;
+  auto begin = std::sregex_iterator(task.serialized_key.begin(), task.serialized_key.end(), var_pattern);
+  auto end   = std::sregex_iterator();
+  size_t pos = 0;
+  for (auto it = begin; it != end; ++it) {
+    const std::smatch& match = *it;
+    auto rit                 = renamed.emplace(match[1].str(), renamed.size()).first;
+    result += task.serialized_key.substr(pos, match.position(0) - pos);
+    result += "%" + std::to_string(rit->second) + "->";
+    pos = match.position(0) + match.length(0);
+  }
+  result += task.serialized_key.substr(pos);
+  return result;
+}
+
+double GradientScheduler::CurrentLatency(const WeightedTask& weighted_task) const {
+  if (database_ == nullptr) {
+    return -1;
+  }
+  double sum = 0;
+  int known  = 0;
+  for (int task_id : weighted_task.task_ids) {
+    const std::string& key = tasks_->at(task_id).serialized_key;
+    if (key.empty()) {
+      continue;
+    }
+    auto records = database_->GetTopK(key, 1);
+    if (!records.empty()) {
+      sum += records.front().execution_cost;
+      ++known;
+    }
+  }
+  if (known == 0) {
+    return -1;
+  }
+  // members not measured yet are assumed to be as fast as the average of the measured ones
+  return sum / known * weighted_task.task_ids.size();
+}
+
+double GradientScheduler::Gradient(const WeightedTask& weighted_task) const {
+  const auto& history = weighted_task.latency_history;
+  // a task without any known latency is the most worth trying
+  if (history.empty() || history.back() < 0 || weighted_task.num_trials == 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+
+  int latest           = history.size() - 1;
+  int start            = std::max(0, latest - config_.backward_window);
+  double window        = latest - start;
+  double backward_grad = 0.0;
+  if (window > 0 && history.at(start) >= 0) {
+    backward_grad = (history.at(latest) - history.at(start)) / window;
+  }
+  double optimistic_grad = -history.at(latest) / weighted_task.num_trials;
+  return config_.gradient_alpha * backward_grad + (1 - config_.gradient_alpha) * optimistic_grad;
+}
+
+int GradientScheduler::PickWeightedTask() {
+  if (weighted_tasks_.size() > 1 &&
+      utils::SampleUniformDouble(0.0, 1.0, &rand_seed_) < static_cast<double>(config_.exploration_eps)) {
+    return utils::SampleUniformInt(0, weighted_tasks_.size(), &rand_seed_);
+  }
+
+  int best_idx     = 0;
+  double best_grad = Gradient(weighted_tasks_.at(0));
+  for (int i = 1; i < weighted_tasks_.size(); ++i) {
+    double grad = Gradient(weighted_tasks_.at(i));
+    // the one with less trials is preferred if the gradients are equal, so it falls
+    // back to round robin when the latencies are unknown
+    if (grad < best_grad ||
+        (grad == best_grad && weighted_tasks_.at(i).num_trials < weighted_tasks_.at(best_idx).num_trials)) {
+      best_idx  = i;
+      best_grad = grad;
+    }
+  }
+  VLOG(4) << "Pick weighted task-" << best_idx << " with gradient=" << best_grad;
+  return best_idx;
+}
+
+int GradientScheduler::NextTaskId() {
+  // record the latency reached by the previous trial
+  if (last_picked_ != -1) {
+    auto& weighted_task = weighted_tasks_.at(last_picked_);
+    weighted_task.latency_history.push_back(CurrentLatency(weighted_task));
+    last_picked_ = -1;
+  }
+
+  if (cur_task_id_ >= weighted_tasks_.size()) {
+    warmed_up_ = true;
+    return -1;
+  }
+  // the warm-up round visits the weighted tasks in order
+  last_picked_ = warmed_up_ ? PickWeightedTask() : cur_task_id_;
+  ++cur_task_id_;
+
+  // only the representative is tuned, the others reuse its result
+  auto& weighted_task = weighted_tasks_.at(last_picked_);
+  ++weighted_task.num_trials;
+  return weighted_task.task_ids.front();
+}
+
+std::vector<int> GradientScheduler::IdenticalTasks(int task_id) const {
+  const auto& task_ids = weighted_tasks_.at(task_to_weighted_.at(task_id)).task_ids;
+  if (task_ids.front() != task_id) {
+    return {};
+  }
+  return std::vector<int>(task_ids.begin() + 1, task_ids.end());
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
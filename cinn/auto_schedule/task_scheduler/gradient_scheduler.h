@@ -0,0 +1,88 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Schedule tasks by the estimated gradient of the end-to-end latency, that
+// is picking a task which is expected to reduce the total latency most with
+// one more trial.
+//
+// Tasks with the same structure (same ops, dtypes and shapes) are deduplicated
+// into a weighted task whose weight is the number of its appearances in the model.
+// The gradient of a weighted task i at its t-th trial is estimated as
+//   g_i = w_i * (alpha * (B_i(t) - B_i(t - window)) / window + (1 - alpha) * (-B_i(t) / t))
+// where B_i(t) is its best latency after t trials looked up from the Database,
+// the first term is the backward gradient over the latest trials and the second
+// one is an optimistic guess that the latency could continue to reduce at the
+// average speed. A random task is picked with probability `exploration_eps`.
+//
+// Only the first member of a weighted task is tuned as its representative, and the
+// tuner applies the best schedule of it to the other members, see IdenticalTasks.
+//
+// The first round visits every weighted task once to get the initial latencies, then
+// each round picks as many trials as the number of weighted tasks.
+class GradientScheduler : public TaskScheduler {
+ public:
+  GradientScheduler(const std::vector<TuneTask>& tasks, const Config& config, Database* database);
+
+  const char* Name() const override { return "gradient"; };
+
+  int NextTaskId() override;
+
+  std::vector<int> IdenticalTasks(int task_id) const override;
+
+  // Return the number of weighted tasks after deduplication
+  size_t NumWeightedTasks() const { return weighted_tasks_.size(); }
+
+ private:
+  struct WeightedTask {
+    // The ids of the identical tasks
+    std::vector<int> task_ids;
+    // The number of trials allocated
+    int num_trials = 0;
+    // The total latency of the members after each trial, unit: us
+    std::vector<double> latency_history;
+  };
+
+  // Return the structure of a task with its variable names erased
+  static std::string StructuralKey(const TuneTask& task);
+  // Look up the best latencies of the members from the Database, return -1 if unknown
+  double CurrentLatency(const WeightedTask& weighted_task) const;
+  // Estimate the gradient of the end-to-end latency with respect to one more trial
+  double Gradient(const WeightedTask& weighted_task) const;
+  // Pick the next weighted task by the gradients
+  int PickWeightedTask();
+
+  Database* database_;
+  std::vector<WeightedTask> weighted_tasks_;
+  // Map the id of a task to its weighted task
+  std::vector<int> task_to_weighted_;
+  // The weighted task picked last time whose history is pending to update
+  int last_picked_ = -1;
+  // Whether the initial round visiting all tasks has finished
+  bool warmed_up_ = false;
+  utils::LinearRandomEngine::StateType rand_seed_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -18,6 +18,7 @@
 
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
+#include "cinn/auto_schedule/task_scheduler/gradient_scheduler.h"
 #include "cinn/auto_schedule/task_scheduler/round_robin.h"
 
 namespace cinn {
@@ -25,12 +26,15 @@ namespace auto_schedule {
 
 std::unique_ptr<TaskScheduler> TaskScheduler::Make(const std::vector<TuneTask>& tasks,
                                                    const Config& config,
-                                                   const std::string& strategy) {
+                                                   const std::string& strategy,
+                                                   Database* database) {
   CHECK_GT(tasks.size(), 0) << "Empty task list";
   if (strategy == "round_robin") {
     return std::make_unique<RoundRobin>(tasks, config);
   } else if (strategy == "efficiency_priority") {
     return std::make_unique<EfficiencyPriority>(tasks, config);
+  } else if (strategy == "gradient") {
+    return std::make_unique<GradientScheduler>(tasks, config, database);
   }
 
   LOG(FATAL) << "Unimplementd strategy:" << strategy;
@@ -19,9 +19,11 @@
 #include <string>
 #include <vector>
 
+#include "cinn/auto_schedule/database/database.h"
 #include "cinn/auto_schedule/task/task_optimizer.h"
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/tuning.h"
+#include "cinn/utils/random_engine.h"
 
 namespace cinn {
 namespace auto_schedule {
@@ -34,13 +36,23 @@ class TaskScheduler {
   struct Config {
     // The minimum threshold of earnings ratio, used by EfficiencyPriority
     float minimum_gain_threshold = 0.0;
+    // The number of latest trials to estimate the backward gradient, used by GradientScheduler
+    int backward_window = 3;
+    // The weight of the backward gradient against the optimistic one, used by GradientScheduler
+    float gradient_alpha = 0.2;
+    // The probability to pick a random task for exploration, used by GradientScheduler
+    float exploration_eps = 0.05;
+    // The random seed, -1 to generate one from device, used by GradientScheduler
+    utils::LinearRandomEngine::StateType rand_seed = -1;
   };
 
   // Create a TaskScheduler with the specific strategy name
-  // and necessary construct parameters.
+  // and necessary construct parameters. The database provides
+  // the tuning history to strategies relying on it.
   static std::unique_ptr<TaskScheduler> Make(const std::vector<TuneTask>& tasks,
                                              const Config& config,
-                                             const std::string& strategy = "round_robin");
+                                             const std::string& strategy = "round_robin",
+                                             Database* database          = nullptr);
 
   // Reset associated states to schedule at the beginning
   void Reset();
@@ -51,6 +63,10 @@ class TaskScheduler {
   // Select a task to tune
   virtual int NextTaskId() = 0;
 
+  // Return the ids of the tasks identical to the one tuned, which apply its best result
+  // instead of being tuned separately
+  virtual std::vector<int> IdenticalTasks(int task_id) const { return {}; }
+
  protected:
   // A taskScheduler object should be created with the static function Make
   TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config);
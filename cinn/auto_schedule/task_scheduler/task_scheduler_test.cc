@@ -16,10 +16,21 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
 #include <type_traits>
 
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/auto_schedule/task/task_creator.h"
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
+#include "cinn/auto_schedule/task_scheduler/gradient_scheduler.h"
 #include "cinn/auto_schedule/task_scheduler/round_robin.h"
+#include "cinn/common/context.h"
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/op_lowering.h"
+
+DECLARE_bool(cinn_ir_schedule);
 
 namespace cinn {
 namespace auto_schedule {
@@ -32,6 +43,8 @@ TEST(TaskScheduler, Make) {
   ASSERT_STREQ(round_robin->Name(), "round_robin");
   auto efficiency_priority = TaskScheduler::Make(tasks, config, "efficiency_priority");
   ASSERT_STREQ(efficiency_priority->Name(), "efficiency_priority");
+  auto gradient = TaskScheduler::Make(tasks, config, "gradient");
+  ASSERT_STREQ(gradient->Name(), "gradient");
 }
 
 TEST(RoundRobinScheduler, NextTaskId) {
@@ -52,5 +65,104 @@ TEST(EfficiencyPriorityScheduler, NextTaskId) {
   ASSERT_EQ(-1, efficiency_priority->NextTaskId());
 }
 
+TEST(GradientScheduler, NextTaskId) {
+  std::vector<TuneTask> tasks(3);
+  // task-0 and task-1 are identical except variable names
+  tasks[0].serialized_key = "Group {\n  (var_1->float32[32,64]) = relu(var_0->float32[32,64])\n}\n";
+  tasks[1].serialized_key = "Group {\n  (var_3->float32[32,64]) = relu(var_2->float32[32,64])\n}\n";
+  tasks[2].serialized_key = "Group {\n  (var_5->float32[32,64]) = exp(var_4->float32[32,64])\n}\n";
+
+  Database database(2);
+  TuningRecord record;
+  record.predicted_cost = 0.0;
+  for (auto&& cost : std::vector<std::pair<int, double>>{{0, 100.0}, {1, 100.0}, {2, 10.0}}) {
+    record.task_key       = tasks[cost.first].serialized_key;
+    record.execution_cost = cost.second;
+    database.AddRecord(record);
+  }
+
+  TaskScheduler::Config config;
+  config.exploration_eps = 0.0;
+  auto gradient          = TaskScheduler::Make(tasks, config, "gradient", &database);
+  ASSERT_EQ(2, dynamic_cast<GradientScheduler*>(gradient.get())->NumWeightedTasks());
+
+  // the first round visits all weighted tasks by their representatives
+  ASSERT_EQ(0, gradient->NextTaskId());
+  ASSERT_EQ(2, gradient->NextTaskId());
+  ASSERT_EQ(-1, gradient->NextTaskId());
+  // task-1 applies the result of task-0
+  ASSERT_EQ(std::vector<int>({1}), gradient->IdenticalTasks(0));
+  ASSERT_TRUE(gradient->IdenticalTasks(1).empty());
+  ASSERT_TRUE(gradient->IdenticalTasks(2).empty());
+
+  // the following rounds pick 2 trials each, the relu appearing twice and
+  // taking most of the total latency is preferred
+  gradient->Reset();
+  ASSERT_EQ(0, gradient->NextTaskId());
+  ASSERT_EQ(0, gradient->NextTaskId());
+  ASSERT_EQ(-1, gradient->NextTaskId());
+}
+
+TEST(GradientScheduler, WithoutDatabase) {
+  std::vector<TuneTask> tasks(3);
+  tasks[0].serialized_key = "Group {\n  (a->float32[16]) = relu(b->float32[16])\n}\n";
+  tasks[1].serialized_key = "Group {\n  (c->float32[16]) = exp(d->float32[16])\n}\n";
+  tasks[2].serialized_key = "Group {\n  (e->float32[16]) = tanh(f->float32[16])\n}\n";
+  TaskScheduler::Config config;
+  config.exploration_eps = 0.0;
+  auto gradient          = TaskScheduler::Make(tasks, config, "gradient");
+  while (gradient->NextTaskId() != -1) {
+  }
+
+  // it falls back to round robin without any known latency
+  gradient->Reset();
+  ASSERT_EQ(0, gradient->NextTaskId());
+  ASSERT_EQ(1, gradient->NextTaskId());
+  ASSERT_EQ(2, gradient->NextTaskId());
+  ASSERT_EQ(-1, gradient->NextTaskId());
+}
+
+TEST(GradientScheduler, DistinguishAttributes) {
+  FLAGS_cinn_ir_schedule = true;
+  common::Context::Global().ResetNameId();
+#ifdef CINN_WITH_CUDA
+  common::Target target = common::DefaultNVGPUTarget();
+#else
+  common::Target target = common::DefaultHostTarget();
+#endif
+  // three scales of the same shape, the last one differs from the others only by the scale attribute
+  frontend::NetBuilder builder("net_builder");
+  auto a = builder.CreateInput(common::Float(32), {32, 16}, "A");
+  auto b = builder.CreateInput(common::Float(32), {32, 16}, "B");
+  auto c = builder.CreateInput(common::Float(32), {32, 16}, "C");
+  builder.Scale(a, 2.0f);
+  builder.Scale(b, 2.0f);
+  builder.Scale(c, 3.0f);
+  auto program = builder.Build();
+  auto graph   = std::make_shared<hlir::framework::Graph>(program, target);
+
+  TaskCreator task_creator;
+  std::vector<TuneTask> tasks = task_creator.CreateTuneTaskOpLevel(graph.get());
+  ASSERT_EQ(tasks.size(), 3UL);
+  const auto& shape_dict = graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+  const auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  hlir::framework::OpLowerer op_lowerer(dtype_dict, shape_dict, target);
+  std::map<float, std::vector<int>> scale2tasks;
+  for (int i = 0; i < tasks.size(); ++i) {
+    tasks[i].Initialize(shape_dict, dtype_dict, &op_lowerer);
+    auto nodes = tasks[i].subgraph->CollectNodes();
+    ASSERT_EQ(nodes.size(), 1UL);
+    scale2tasks[absl::get<float>(nodes.front()->attrs.attr_store.at("scale"))].push_back(i);
+  }
+  ASSERT_EQ(scale2tasks.at(2.0f).size(), 2UL);
+  ASSERT_EQ(scale2tasks.at(3.0f).size(), 1UL);
+
+  TaskScheduler::Config config;
+  auto gradient = TaskScheduler::Make(tasks, config, "gradient");
+  ASSERT_EQ(2, dynamic_cast<GradientScheduler*>(gradient.get())->NumWeightedTasks());
+  ASSERT_EQ(std::vector<int>({scale2tasks.at(2.0f).back()}), gradient->IdenticalTasks(scale2tasks.at(2.0f).front()));
+  ASSERT_TRUE(gradient->IdenticalTasks(scale2tasks.at(3.0f).front()).empty());
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
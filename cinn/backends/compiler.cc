@@ -66,11 +66,11 @@ void SourceCodePrint::write(const std::string& source_code) {
   }
 }
 
-void Compiler::Build(const Module& module, const std::string& code) {
+void Compiler::Build(const Module& module, const std::string& code, const OptimizeOptions& optimize_options) {
   if (target_.arch == Target::Arch::NVGPU) {
-    CompileCudaModule(module, code);
+    CompileCudaModule(module, code, optimize_options);
   } else if (target_.arch == Target::Arch::X86) {
-    CompileX86Module(module);
+    CompileX86Module(module, optimize_options);
   } else {
     CINN_NOT_IMPLEMENTED
   }
@@ -103,7 +103,9 @@ void Compiler::BuildDefault(const Module& module) {
   }
 }
 
-void Compiler::CompileCudaModule(const Module& module, const std::string& code) {
+void Compiler::CompileCudaModule(const Module& module,
+                                 const std::string& code,
+                                 const OptimizeOptions& optimize_options) {
 #ifdef CINN_WITH_CUDA
   auto _host_module_device_module_ = SplitCudaAndHostModule(module);  // NOLINT
   auto& host_module                = std::get<0>(_host_module_device_module_);
@@ -141,15 +143,17 @@ void Compiler::CompileCudaModule(const Module& module, const std::string& code)
     symbols.RegisterVar(kernel_fn_name + "_ptr_", reinterpret_cast<void*>(fn_kernel));
   }
 
-  engine_ = ExecutionEngine::Create(ExecutionOptions(), std::move(symbols));
-  engine_->Link<CodeGenCUDA_Host>(host_module);
+  engine_ = ExecutionEngine::Create(options_, std::move(symbols));
+  engine_->Link<CodeGenCUDA_Host>(host_module, optimize_options);
 
 #else
   CINN_NOT_IMPLEMENTED
 #endif
 }
 
-void Compiler::CompileX86Module(const Module& module) { engine_->Link<CodeGenX86>(module); }
+void Compiler::CompileX86Module(const Module& module, const OptimizeOptions& optimize_options) {
+  engine_->Link<CodeGenX86>(module, optimize_options);
+}
 
 void Compiler::ExportObject(const std::string& path) { engine_->ExportObject(path); }
 
@@ -161,5 +165,15 @@ void* Compiler::Lookup(absl::string_view fn_name) {
   return nullptr;
 }
 
+void Compiler::CompileAhead(const std::vector<std::string>& fn_names) {
+  CHECK(engine_);
+  engine_->CompileAhead(fn_names);
+}
+
+std::string Compiler::LazyCompileReport() const {
+  CHECK(engine_);
+  return engine_->LazyCompileReport();
+}
+
 }  // namespace backends
 }  // namespace cinn
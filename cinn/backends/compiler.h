@@ -20,6 +20,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "cinn/backends/llvm/codegen_llvm.h"
 #include "cinn/backends/llvm/execution_engine.h"
@@ -51,14 +52,17 @@ class SourceCodePrint {
 
 class Compiler final {
  public:
-  static std::unique_ptr<Compiler> Create(const Target& target) {
-    return std::unique_ptr<Compiler>(new Compiler(target));
+  static std::unique_ptr<Compiler> Create(const Target& target, const ExecutionOptions& options = ExecutionOptions()) {
+    return std::unique_ptr<Compiler>(new Compiler(target, options));
   }
 
   /**
    * Compile and link to a CINN module.
+   * @param optimize_options The LLVM pipeline to optimize the host code with.
    */
-  void Build(const ir::Module& module, const std::string& code = "");
+  void Build(const ir::Module& module,
+             const std::string& code                 = "",
+             const OptimizeOptions& optimize_options = OptimizeOptions());
 
   void ExportObject(const std::string& path);
 
@@ -72,17 +76,30 @@ class Compiler final {
    */
   void* Lookup(absl::string_view fn_name);
 
+  /**
+   * Compile the functions in the background in the order of \p fn_names when the compiler is created with
+   * ExecutionOptions::lazy_compile.
+   */
+  void CompileAhead(const std::vector<std::string>& fn_names);
+
+  //! Report how the functions have been compiled when the compiler is created with ExecutionOptions::lazy_compile.
+  std::string LazyCompileReport() const;
+
  private:
-  void CompileCudaModule(const ir::Module& module, const std::string& code = "");
+  void CompileCudaModule(const ir::Module& module,
+                         const std::string& code                 = "",
+                         const OptimizeOptions& optimize_options = OptimizeOptions());
 
-  void CompileX86Module(const ir::Module& module);
+  void CompileX86Module(const ir::Module& module, const OptimizeOptions& optimize_options = OptimizeOptions());
 
-  explicit Compiler(const Target& target) : target_(target), engine_(ExecutionEngine::Create(ExecutionOptions())) {}
+  Compiler(const Target& target, const ExecutionOptions& options)
+      : target_(target), options_(options), engine_(ExecutionEngine::Create(options)) {}
 
   CINN_DISALLOW_COPY_AND_ASSIGN(Compiler);
 
  private:
   Target target_;
+  ExecutionOptions options_;
   std::unique_ptr<ExecutionEngine> engine_;
 
 #ifdef CINN_WITH_CUDA
@@ -17,15 +17,20 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
+#include <functional>
 #include <tuple>
 #include <vector>
 
 #include "cinn/backends/codegen_c.h"
 #include "cinn/backends/codegen_c_x86.h"
 #include "cinn/backends/codegen_cuda_dev.h"
+#include "cinn/backends/llvm/simple_jit.h"
 #include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
 #include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule_util.h"
 #include "cinn/lang/lower.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/remove_schedule_block.h"
 #include "cinn/optim/unroll_loops.h"
@@ -3043,5 +3048,320 @@ TEST(IrSchedule, SampleCategorical) {
   ASSERT_EQ(result.type(), Int(32));
 }
 
+TEST(IrSchedule, Blockize) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(64);
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + Expr(1.f); }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto funcs  = cinn::lang::LowerVec("test_blockize", stages, {A, B}, {}, {}, nullptr, target, true);
+  auto origin_body = optim::IRCopy(funcs[0]->body);
+
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  auto loops = ir_sch.GetLoops("B");
+  ir_sch.Split(loops[1], {4, 16});
+  loops      = ir_sch.GetLoops("B");
+  auto block = ir_sch.Blockize(loops[2]);
+  ASSERT_TRUE(block.As<ir::ScheduleBlockRealize>());
+  ASSERT_EQ(block.As<ir::ScheduleBlockRealize>()->iter_values.size(), 2U);
+  ASSERT_EQ(ir_sch.GetLoops("B").size(), 3U);
+  ASSERT_TRUE(ir_sch.HasBlock("B"));
+
+  // the new block reads a 1x16 tile of A and writes a 1x16 tile of B
+  auto* schedule_block = block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>();
+  ASSERT_EQ(schedule_block->read_buffers.size(), 1U);
+  ASSERT_EQ(schedule_block->write_buffers.size(), 1U);
+  auto* read_buffer  = schedule_block->read_buffers[0].As<ir::_BufferRange_>();
+  auto* write_buffer = schedule_block->write_buffers[0].As<ir::_BufferRange_>();
+  ASSERT_EQ(read_buffer->buffer.as_buffer()->name, A.tensor()->buffer->name);
+  ASSERT_EQ(write_buffer->buffer.as_buffer()->name, B->buffer->name);
+  for (auto* buffer_range : {read_buffer, write_buffer}) {
+    ASSERT_EQ(buffer_range->ranges.size(), 2U);
+    auto extent = [](const Var& range) { return common::AutoSimplify(range->upper_bound - range->lower_bound); };
+    ASSERT_EQ(extent(buffer_range->ranges[0]).as_int32(), 1);
+    ASSERT_EQ(extent(buffer_range->ranges[1]).as_int32(), 16);
+  }
+
+  // the blockized loop nest computes the same as the split loops
+  auto source_code = [&](const Expr& body) {
+    auto func  = optim::IRCopy(funcs[0]);
+    func->body = optim::IRCopy(body);
+    Module::Builder builder("module1", target);
+    builder.AddFunction(func);
+    CodeGenC codegen(target);
+    codegen.SetInlineBuiltinCodes(false);
+    return codegen.Compile(builder.Build(), CodeGenC::OutputKind::CImpl);
+  };
+  ir::IRSchedule split_sch(ir::ModuleExpr({origin_body}));
+  split_sch.Split(split_sch.GetLoops("B")[1], {4, 16});
+  ASSERT_EQ(source_code(funcs[0]->body), source_code(origin_body));
+}
+
+// Lower the function of the computation, schedule it and run it by JIT.
+void RunScheduled(const std::string& name,
+                  const std::vector<ir::Tensor>& args,
+                  const std::function<void(ir::IRSchedule*)>& schedule,
+                  const std::vector<cinn_buffer_t*>& buffers,
+                  const std::string& expected_code = "") {
+  auto stages = CreateStages(args);
+  auto funcs  = cinn::lang::LowerVec(name, stages, args, {}, {}, nullptr, common::DefaultHostTarget(), true);
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  schedule(&ir_sch);
+  LOG(INFO) << "Scheduled function:\n" << funcs[0];
+
+  Module::Builder builder("module1", common::DefaultHostTarget());
+  builder.AddFunction(funcs[0]);
+  auto module = builder.Build();
+  CodeGenC codegen(common::DefaultHostTarget());
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  ASSERT_NE(source_code.find(expected_code), std::string::npos) << source_code;
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(module);
+  auto fn_ptr = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(name));
+  ASSERT_TRUE(fn_ptr);
+  common::ArgsBuilder args_builder;
+  for (auto* buffer : buffers) args_builder.Add(buffer);
+  auto pod_args = args_builder.Build();
+  fn_ptr(pod_args.data(), pod_args.size());
+}
+
+TEST(IrSchedule, TensorizeGemm) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(32);
+  Expr K(20);
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(20, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  auto* a_buf = common::BufferBuilder(Float(32), {32, 20}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Float(32), {20, 32}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Float(32), {32, 32}).set_random().Build();
+  RunScheduled(
+      "test_tensorize_gemm",
+      {A, B, C},
+      [](ir::IRSchedule* ir_sch) {
+        auto loops = ir_sch->GetLoops("C");
+        ir_sch->Split(loops[0], {4, 8});
+        loops = ir_sch->GetLoops("C");
+        ir_sch->Split(loops[2], {2, 16});
+        loops = ir_sch->GetLoops("C");
+        ir_sch->Reorder({loops[2], loops[1]});
+        loops = ir_sch->GetLoops("C");
+        // the init block of C in the loop nest is done ahead of the microkernel
+        ir_sch->Tensorize(loops[2], "cpu_gemm_8x16_fp32");
+      },
+      {a_buf, b_buf, c_buf},
+      "cinn_host_gemm_8x16_fp32");
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* b = reinterpret_cast<float*>(b_buf->memory);
+  auto* c = reinterpret_cast<float*>(c_buf->memory);
+  for (int i = 0; i < 32; ++i) {
+    for (int j = 0; j < 32; ++j) {
+      float expect = 0.f;
+      for (int p = 0; p < 20; ++p) expect += a[i * 20 + p] * b[p * 32 + j];
+      ASSERT_NEAR(c[i * 32 + j], expect, 1e-4) << "i: " << i << ", j: " << j;
+    }
+  }
+}
+
+TEST(IrSchedule, TensorizeDotInt8) {
+  Context::Global().ResetNameId();
+  Expr M(8);
+  Expr K(40);
+  Placeholder<int8_t> A("A", {M, K});
+  Placeholder<int8_t> B("B", {K});
+  Var k(40, "k0");
+  auto C = Compute(
+      {M},
+      [&](Var i) { return lang::ReduceSum(ir::Cast::Make(Int(32), A(i, k)) * ir::Cast::Make(Int(32), B(k)), {k}); },
+      "C");
+
+  auto* a_buf = common::BufferBuilder(Int(8), {8, 40}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Int(8), {40}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Int(32), {8}).set_random().Build();
+  RunScheduled(
+      "test_tensorize_dot_int8",
+      {A, B, C},
+      [](ir::IRSchedule* ir_sch) { ir_sch->Tensorize(ir_sch->GetLoops("C")[1], "cpu_dot_int8"); },
+      {a_buf, b_buf, c_buf},
+      "cinn_host_dot_int8");
+
+  auto* a = reinterpret_cast<int8_t*>(a_buf->memory);
+  auto* b = reinterpret_cast<int8_t*>(b_buf->memory);
+  auto* c = reinterpret_cast<int32_t*>(c_buf->memory);
+  for (int i = 0; i < 8; ++i) {
+    int32_t expect = 0;
+    for (int p = 0; p < 40; ++p) expect += static_cast<int32_t>(a[i * 40 + p]) * static_cast<int32_t>(b[p]);
+    ASSERT_EQ(c[i], expect) << "i: " << i;
+  }
+}
+
+TEST(IrSchedule, TensorizeReduceSum) {
+  Context::Global().ResetNameId();
+  Expr M(16);
+  Expr K(70);
+  Placeholder<float> A("A", {M, K});
+  Var k(70, "k0");
+  auto B = Compute(
+      {M}, [&](Var i) { return lang::ReduceSum(A(i, k), {k}); }, "B");
+
+  auto* a_buf = common::BufferBuilder(Float(32), {16, 70}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Float(32), {16}).set_random().Build();
+  RunScheduled(
+      "test_tensorize_reduce_sum",
+      {A, B},
+      [](ir::IRSchedule* ir_sch) {
+        // tensorize the block blockized from the reduction loop
+        auto block = ir_sch->Blockize(ir_sch->GetLoops("B")[1]);
+        ir_sch->Tensorize(block, "cpu_reduce_sum_fp32");
+      },
+      {a_buf, b_buf},
+      "cinn_host_reduce_sum_fp32");
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* b = reinterpret_cast<float*>(b_buf->memory);
+  for (int i = 0; i < 16; ++i) {
+    float expect = 0.f;
+    for (int p = 0; p < 70; ++p) expect += a[i * 70 + p];
+    ASSERT_NEAR(b[i], expect, 1e-4) << "i: " << i;
+  }
+}
+
+TEST(IrSchedule, DecomposeReduction) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(32);
+  Expr K(20);
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(20, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  auto* a_buf = common::BufferBuilder(Float(32), {32, 20}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Float(32), {20, 32}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Float(32), {32, 32}).set_random().Build();
+  RunScheduled("test_decompose_reduction",
+               {A, B, C},
+               [](ir::IRSchedule* ir_sch) {
+                 auto loops = ir_sch->GetLoops("C");
+                 ir_sch->Split(loops[2], {4, 5});
+                 loops = ir_sch->GetLoops("C");
+                 ir_sch->Reorder({loops[2], loops[1]});
+                 // C is initialized before each k loop accumulating the row of C
+                 loops           = ir_sch->GetLoops("C");
+                 auto init_block = ir_sch->DecomposeReduction(ir_sch->GetBlock("C"), loops[1]);
+                 ASSERT_EQ(init_block, ir_sch->GetBlock("C__reduce_init"));
+                 auto init_loops = ir_sch->GetLoops("C__reduce_init");
+                 ASSERT_EQ(init_loops.size(), 2U);
+                 ASSERT_EQ(init_loops[0], ir_sch->GetLoops("C")[0]);
+                 ASSERT_EQ(init_loops[1].As<ir::For>()->loop_var->name, "j_init");
+               },
+               {a_buf, b_buf, c_buf});
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* b = reinterpret_cast<float*>(b_buf->memory);
+  auto* c = reinterpret_cast<float*>(c_buf->memory);
+  for (int i = 0; i < 32; ++i) {
+    for (int j = 0; j < 32; ++j) {
+      float expect = 0.f;
+      for (int p = 0; p < 20; ++p) expect += a[i * 20 + p] * b[p * 32 + j];
+      ASSERT_NEAR(c[i * 32 + j], expect, 1e-4) << "i: " << i << ", j: " << j;
+    }
+  }
+}
+
+TEST(IrSchedule, TransformLayout) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(64);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * Expr(2.f); }, "B");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return B(i, j) + Expr(1.f); }, "C");
+
+  auto* a_buf = common::BufferBuilder(Float(32), {32, 64}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Float(32), {32, 64}).set_random().Build();
+  RunScheduled("test_transform_layout",
+               {A, C},
+               [](ir::IRSchedule* ir_sch) {
+                 // pack B[32, 64] to B[4, 64, 8]
+                 ir_sch->TransformLayout(ir_sch->GetBlock("C"), 0, false, {8, 1}, {0, 2, 1});
+                 for (auto& block_name : {"B", "C"}) {
+                   auto block    = ir_sch->GetBlock(block_name);
+                   auto access   = ir::GetNthAccessExpr(block, 0, block_name == std::string("B"));
+                   auto* tensor  = access.As<ir::Store>() ? access.As<ir::Store>()->tensor.as_tensor()
+                                                          : access.As<ir::Load>()->tensor.as_tensor();
+                   auto& indices = access.As<ir::Store>() ? access.As<ir::Store>()->indices
+                                                          : access.As<ir::Load>()->indices;
+                   ASSERT_EQ(tensor->name, "B");
+                   ASSERT_EQ(tensor->shape.size(), 3U);
+                   ASSERT_EQ(tensor->shape[1].as_int32(), 64);
+                   ASSERT_EQ(indices.size(), 3U);
+                 }
+               },
+               {a_buf, c_buf});
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* c = reinterpret_cast<float*>(c_buf->memory);
+  for (int i = 0; i < 32 * 64; ++i) {
+    ASSERT_NEAR(c[i], a[i] * 2.f + 1.f, 1e-5) << "i: " << i;
+  }
+
+  // the layouts of the function arguments A and C can't be transformed
+  auto funcs = cinn::lang::LowerVec(
+      "test_transform_args", CreateStages({A, C}), {A, C}, {}, {}, nullptr, common::DefaultHostTarget(), true);
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  ASSERT_DEATH(ir_sch.TransformLayout(ir_sch.GetBlock("B"), 0, false, {8, 1}, {0, 2, 1}), "function argument");
+  ASSERT_DEATH(ir_sch.TransformLayout(ir_sch.GetBlock("C"), 0, true, {8, 1}, {0, 2, 1}), "function argument");
+}
+
+TEST(IrSchedule, TransformLayoutSharedBuffer) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(16);
+  Expr K(4);
+  Placeholder<float> A("A", {M, N, K});
+  Var k(4, "k0");
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, j, k), {k}); }, "B");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return B(i, j) + Expr(1.f); }, "C");
+
+  auto* a_buf = common::BufferBuilder(Float(32), {32, 16, 4}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Float(32), {32, 16}).set_random().Build();
+  RunScheduled("test_transform_layout_shared_buffer",
+               {A, C},
+               [](ir::IRSchedule* ir_sch) {
+                 // the init of the reduction writes the buffer of B through another tensor, which is rewritten too
+                 ir_sch->TransformLayout(ir_sch->GetBlock("C"), 0, false, {8, 1}, {0, 2, 1});
+                 auto access  = ir::GetNthAccessExpr(ir_sch->GetBlock("B__reduce_init"), 0, true);
+                 auto* tensor = access.As<ir::Store>()->tensor.as_tensor();
+                 ASSERT_EQ(tensor->name, "B__reduce_init");
+                 ASSERT_EQ(tensor->shape.size(), 3U);
+                 ASSERT_EQ(access.As<ir::Store>()->indices.size(), 3U);
+               },
+               {a_buf, c_buf});
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* c = reinterpret_cast<float*>(c_buf->memory);
+  for (int i = 0; i < 32 * 16; ++i) {
+    float expect = 1.f;
+    for (int p = 0; p < 4; ++p) expect += a[i * 4 + p];
+    ASSERT_NEAR(c[i], expect, 1e-4) << "i: " << i;
+  }
+}
+
 }  // namespace backends
 }  // namespace cinn
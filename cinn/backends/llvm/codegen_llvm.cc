@@ -22,13 +22,16 @@
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Metadata.h>
+#include <llvm/Support/MathExtras.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <numeric>
+#include <set>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -43,6 +46,7 @@
 #include "cinn/ir/ir_verify.h"
 #include "cinn/optim/var_mod_simplify.h"
 #include "cinn/runtime/cinn_runtime.h"
+#include "cinn/runtime/flags.h"
 #include "cinn/runtime/intrinsic.h"
 #include "cinn/utils/string.h"
 #include "llvm/IR/BasicBlock.h"
@@ -51,6 +55,8 @@
 #include "llvm/IR/Verifier.h"
 #include "llvm/Support/Alignment.h"
 
+DECLARE_bool(cinn_llvm_buffer_noalias);
+
 namespace cinn {
 namespace backends {
 
@@ -786,12 +792,6 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Load *op) {
       CHECK_GT(alignment, 0);
       load_inst->setAlignment(llvm::Align(std::min(alignment, 8)));
     }
-
-    // TODO(fc500110): tbaa AliasAnalysis
-    // auto md_tbaa_root      = md_builder_->createTBAARoot("cinn-tbaa");
-    // auto md_tbaa_alias_set = md_builder_->createTBAANode("cinn-alias", md_tbaa_root);
-    // llvm::MDNode *meta     = md_tbaa_alias_set;
-    // load_inst->setMetadata("tbaa", md_builder_->createTBAAStructTagNode(meta, meta, 0));
     return load_inst;
   } else {  // vector load
     Expr dense_strided_ramp = detail::StridedRampBase(op->index(), 1);
@@ -848,11 +848,6 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Store *op) {
       CHECK_GT(alignment, 0);
       store_inst->setAlignment(llvm::Align(std::min(alignment, 8)));
     }
-    // TODO(fc500110): tbaa AliasAnalysis
-    // auto md_tbaa_root      = md_builder_->createTBAARoot("cinn-tbaa");
-    // auto md_tbaa_alias_set = md_builder_->createTBAANode("cinn-alias", md_tbaa_root);
-    // llvm::MDNode *meta     = md_tbaa_alias_set;
-    // store_inst->setMetadata("tbaa", md_builder_->createTBAAStructTagNode(meta, meta, 0));
     AddTbaaMetadata(store_inst, op->tensor.as_tensor()->name, op->index());
     return store_inst;
   } else {  // vector store
@@ -939,7 +934,10 @@ void appendBody(std::vector<Expr> &new_body, T &&v) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::_LoweredFunc_ *op) {
-  auto init_function_state = [this]() { alias_vars_.clear(); };
+  auto init_function_state = [this, op]() {
+    alias_vars_.clear();
+    InitBufferAliasScopes(op);
+  };
   init_function_state();
 
   CHECK_EQ(op->alloc_output_buffer_exprs.size(), op->dealloc_output_buffer_exprs.size())
@@ -1283,6 +1281,12 @@ void CodeGenLLVM::AddTbaaMetadata(llvm::Instruction *inst, absl::string_view buf
     }
   }
 
+  // The tensors bound to the same buffer share its type node, or their accesses would be taken as not aliased.
+  auto buffer_it = tensor_buffers_.find(std::string(buffer));
+  if (buffer_it != tensor_buffers_.end()) {
+    buffer = buffer_it->second;
+  }
+
   llvm::MDBuilder builder(b_->getContext());
 
   // Add type-based-alias-analysis metadata to the pointer, so that loads and stores to different buffers can get
@@ -1300,6 +1304,96 @@ void CodeGenLLVM::AddTbaaMetadata(llvm::Instruction *inst, absl::string_view buf
 
   tbaa = builder.createTBAAStructTagNode(tbaa, tbaa, 0);
   inst->setMetadata("tbaa", tbaa);
+
+  auto scopes = md_buffer_alias_scopes_.find(std::string(buffer));
+  if (scopes != md_buffer_alias_scopes_.end()) {
+    inst->setMetadata(llvm::LLVMContext::MD_alias_scope, scopes->second.first);
+    inst->setMetadata(llvm::LLVMContext::MD_noalias, scopes->second.second);
+  }
+}
+
+void CodeGenLLVM::InitBufferAliasScopes(const ir::_LoweredFunc_ *op) {
+  tensor_buffers_.clear();
+  md_buffer_alias_scopes_.clear();
+
+  // The tensors bound to the same buffer are loaded from the same data pointer.
+  std::vector<std::string> buffers;
+  for (auto &expr : op->buffer_data_cast_exprs) {
+    auto *let       = expr.As<ir::Let>();
+    auto *cast      = let ? let->body.As<ir::Cast>() : nullptr;
+    auto *intrinsic = cast ? cast->v().As<ir::IntrinsicOp>() : nullptr;
+    if (!intrinsic) continue;
+    const ir::_Buffer_ *buffer{nullptr};
+    if (auto *handle = llvm::dyn_cast<ir::intrinsics::BufferGetDataHandle>(intrinsic)) {
+      buffer = handle->buffer.as_buffer();
+    } else if (auto *handle = llvm::dyn_cast<ir::intrinsics::BufferGetDataConstHandle>(intrinsic)) {
+      buffer = handle->buffer.as_buffer();
+    }
+    if (!buffer) continue;
+    tensor_buffers_[let->symbol.as_var()->name] = buffer->name;
+    if (std::find(buffers.begin(), buffers.end(), buffer->name) == buffers.end()) {
+      buffers.push_back(buffer->name);
+    }
+  }
+  if (buffers.size() < 2) return;
+
+  // Only the temporary buffers, which the function allocates itself, are proven not to alias any other buffer. The
+  // arguments may share memory, like the buffers bound by the callers or the inplace variables, so they are kept in one
+  // scope, unless FLAGS_cinn_llvm_buffer_noalias asserts that they are distinct.
+  std::set<std::string> temp_buffers;
+  for (auto &buffer : op->temp_bufs) {
+    temp_buffers.insert(buffer->name);
+  }
+  for (auto &arg : op->args) {
+    if (arg.is_buffer()) temp_buffers.erase(arg.buffer_arg()->name);
+  }
+  std::vector<std::string> scope_names;
+  for (auto &buffer : buffers) {
+    bool own_scope = FLAGS_cinn_llvm_buffer_noalias || temp_buffers.count(buffer);
+    scope_names.push_back(own_scope ? buffer : std::string("arguments"));
+  }
+  std::vector<std::string> distinct_names(scope_names.begin(), scope_names.end());
+  std::sort(distinct_names.begin(), distinct_names.end());
+  distinct_names.erase(std::unique(distinct_names.begin(), distinct_names.end()), distinct_names.end());
+  if (distinct_names.size() < 2) return;
+
+  auto &context        = b_->getContext();
+  llvm::MDNode *domain = md_builder_->createAliasScopeDomain("cinn-" + op->name);
+  std::map<std::string, llvm::Metadata *> scopes;
+  for (auto &name : distinct_names) {
+    scopes[name] = md_builder_->createAliasScope(op->name + "." + name, domain);
+  }
+  for (int i = 0; i < buffers.size(); i++) {
+    std::vector<llvm::Metadata *> others;
+    for (auto &scope : scopes) {
+      if (scope.first != scope_names[i]) others.push_back(scope.second);
+    }
+    md_buffer_alias_scopes_[buffers[i]] = {llvm::MDNode::get(context, {scopes.at(scope_names[i])}),
+                                           llvm::MDNode::get(context, others)};
+  }
+}
+
+void CodeGenLLVM::AddBufferDataAttributes(llvm::CallInst *call, const Expr &buffer) {
+  auto *buffer_node = buffer.as_buffer();
+  if (!buffer_node || buffer_node->target.arch == Target::Arch::NVGPU) return;
+  if (buffer_node->data_alignment > 0 && llvm::isPowerOf2_32(buffer_node->data_alignment)) {
+    call->addAttribute(llvm::AttributeList::ReturnIndex,
+                       llvm::Attribute::getWithAlignment(b_->getContext(), llvm::Align(buffer_node->data_alignment)));
+  }
+
+  bool static_shape = !buffer_node->shape.empty() && buffer_node->strides.empty() &&
+                      std::all_of(buffer_node->shape.begin(), buffer_node->shape.end(), [](const Expr &dim) {
+                        return dim.is_constant();
+                      });
+  if (static_shape) {
+    uint64_t memory_size = (buffer_node->dtype.ElementOf().bits() + 7) / 8;
+    for (auto &dim : buffer_node->shape) {
+      memory_size *= dim.as_int32();
+    }
+    if (memory_size > 0) {
+      call->addDereferenceableAttr(llvm::AttributeList::ReturnIndex, memory_size);
+    }
+  }
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::IntrinsicOp *op) {
@@ -1315,13 +1409,17 @@ llvm::Value *CodeGenLLVM::Visit(const ir::IntrinsicOp *op) {
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataHandle *op) {
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_handle");
-  return Call(callee, std::move(args));
+  auto *data   = Call(callee, std::move(args));
+  AddBufferDataAttributes(data, op->buffer);
+  return data;
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataConstHandle *op) {
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_const_handle");
-  return Call(callee, std::move(args));
+  auto *data   = Call(callee, std::move(args));
+  AddBufferDataAttributes(data, op->buffer);
+  return data;
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferCreate *op) {
@@ -1454,6 +1552,9 @@ llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BuiltinIntrin *op) {
       CHECK_GE(op->args.size(), 1U);
       llvm::Value *v = Visit(&op->args[0]);
       return b_->CreateFCmpUNO(v, v);
+    } else if (IsInlineMathIntrin(func_name)) {
+      CHECK_EQ(op->args.size(), 1U);
+      return EmitInlineMath(b_, m_, func_name, Visit(&op->args[0]), math_precision_);
     }
   }
 
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "cinn/backends/llvm/ir_builder_mixin.h"
+#include "cinn/backends/llvm/llvm_math.h"
 #include "cinn/backends/llvm/llvm_util.h"
 #include "cinn/ir/intrinsic_ops.h"
 #include "cinn/ir/ir_visitor.h"
@@ -153,6 +154,9 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
   //! Get the bound LLVM ir builder.
   llvm::IRBuilder<> *b() { return b_; }
 
+  //! Set the precision of the math functions computed by the inline polynomials, strict by default.
+  void set_math_precision(MathPrecision math_precision) { math_precision_ = math_precision; }
+
   void Compile(const ir::Module &module);
 
   using LLVMIRVisitor::Visit;
@@ -218,6 +222,15 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
    */
   void AddTbaaMetadata(llvm::Instruction *inst, absl::string_view buffer, Expr index);
 
+  /**
+   * Create the alias scope of each buffer whose data the function accesses. The buffers of a function never overlap
+   * unless they are both read only, so the loads and stores of a buffer are marked not to alias those of the others.
+   */
+  void InitBufferAliasScopes(const ir::_LoweredFunc_ *op);
+
+  //! Mark the data pointer of a buffer with the alignment and the size of the buffer known at compile time.
+  void AddBufferDataAttributes(llvm::CallInst *call, const Expr &buffer);
+
   void InitTarget(const Target &target);
 
   void Scalarize(const Expr &e, std::function<void(int i, llvm::Value *v)> flambda);
@@ -236,8 +249,14 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
   llvm::MDNode *md_tbaa_root_{nullptr};
   llvm::MDNode *md_tbaa_alias_set_{nullptr};
 
+  //! The buffer each tensor of the current function is stored in.
+  absl::flat_hash_map<std::string, std::string> tensor_buffers_;
+  //! The alias scopes and the noalias scopes of the accesses to each buffer of the current function.
+  absl::flat_hash_map<std::string, std::pair<llvm::MDNode *, llvm::MDNode *>> md_buffer_alias_scopes_;
+
   int naive_vec_alignment_{0};
   Target target_;
+  MathPrecision math_precision_{MathPrecision::kStrict};
 };
 namespace detail {
 Expr StridedRampBase(Expr e, int stride);
@@ -14,6 +14,7 @@
 
 #include "cinn/backends/llvm/codegen_llvm.h"
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <llvm/AsmParser/Parser.h>
@@ -36,6 +37,8 @@
 #include "cinn/lang/lower.h"
 #include "cinn/lang/placeholder.h"
 
+DECLARE_bool(cinn_llvm_buffer_noalias);
+
 namespace cinn {
 namespace backends {
 
@@ -546,6 +549,66 @@ TEST(CodeGenLLVM, LowerFunc) {
   } while (false);
 }
 
+TEST(CodeGenLLVM, BufferAliasScopes) {
+  for (bool noalias : {false, true}) {
+    FLAGS_cinn_llvm_buffer_noalias = noalias;
+    auto context                   = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic error;
+    std::string runtime_ir(backends::kRuntimeLlvmIr);
+    auto m = llvm::parseAssemblyString(runtime_ir, error, *context);
+    ASSERT_TRUE(m);
+    auto b       = std::make_unique<llvm::IRBuilder<>>(*context);
+    auto emitter = std::make_unique<CodeGenLLVM>(m.get(), b.get());
+
+    auto _x_y_z_z_buf_ = CreateTensor();  // NOLINT
+    auto &x            = std::get<0>(_x_y_z_z_buf_);
+    auto &y            = std::get<1>(_x_y_z_z_buf_);
+    auto &z            = std::get<2>(_x_y_z_z_buf_);
+    auto &z_buf        = std::get<3>(_x_y_z_z_buf_);
+    z->Bind(z_buf);
+
+    auto stages   = CreateStages({x, y, z});
+    auto function = lang::Lower("add2", stages, {x, y, z});
+    ir::Expr func_expr(function);
+    emitter->Visit(&func_expr);
+
+    auto *func = m->getFunction("add2");
+    ASSERT_TRUE(func);
+    int num_accesses = 0;
+    int num_handles  = 0;
+    for (auto &block : *func) {
+      for (auto &inst : block) {
+        if (llvm::isa<llvm::LoadInst>(inst) || llvm::isa<llvm::StoreInst>(inst)) {
+          if (!inst.getMetadata(llvm::LLVMContext::MD_tbaa)) continue;
+          auto *scopes    = inst.getMetadata(llvm::LLVMContext::MD_alias_scope);
+          auto *noaliases = inst.getMetadata(llvm::LLVMContext::MD_noalias);
+          num_accesses++;
+          if (!noalias) {
+            // The arguments may be bound to the same memory, so they are not scoped by default.
+            ASSERT_FALSE(scopes);
+            ASSERT_FALSE(noaliases);
+            continue;
+          }
+          // Each access is in the scope of its buffer and not aliased with the other two buffers.
+          ASSERT_TRUE(scopes);
+          ASSERT_TRUE(noaliases);
+          ASSERT_EQ(scopes->getNumOperands(), 1U);
+          ASSERT_EQ(noaliases->getNumOperands(), 2U);
+        } else if (auto *call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+          auto *callee = call->getCalledFunction();
+          if (!callee || !callee->getName().startswith("cinn_buffer_get_data")) continue;
+          // The 3x2 float buffers.
+          ASSERT_EQ(call->getDereferenceableBytes(llvm::AttributeList::ReturnIndex), 24U);
+          num_handles++;
+        }
+      }
+    }
+    ASSERT_EQ(num_accesses, 3);
+    ASSERT_EQ(num_handles, 3);
+  }
+  FLAGS_cinn_llvm_buffer_noalias = false;
+}
+
 TEST(SymbolTable, test) {
   SymbolTable table;
   ASSERT_EQ(table.num_scopes(), 0UL);
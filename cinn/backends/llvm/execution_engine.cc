@@ -41,6 +41,7 @@
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
@@ -48,9 +49,12 @@
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -67,6 +71,12 @@
 
 namespace cinn::backends {
 namespace {
+//! The suffix of the name of a function linked lazily, the function name itself is of the stub calling it.
+constexpr char kLazyImplSuffix[] = "__lazy_impl";
+
+//! Whether the current thread compiles functions ahead of their first calls.
+thread_local bool compiling_ahead = false;
+
 void InitializeLLVMPasses() {
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
@@ -86,13 +96,45 @@ void InitializeLLVMPasses() {
   // llvm::initializeTarget(registry);
   // llvm::initializeCodeGenPreparePass(registry);
 }
+
+void DefineAbsoluteSymbols(llvm::orc::LLJIT *jit, const RuntimeSymbols &symbols) {
+  auto *session = &jit->getExecutionSession();
+  for (const auto &sym : symbols.All()) {
+    llvm::cantFail(jit->define(llvm::orc::absoluteSymbols(
+        {{session->intern(sym.first), {llvm::pointerToJITTargetAddress(sym.second), llvm::JITSymbolFlags::None}}})));
+  }
+}
+
+/**
+ * Every module contains a copy of the runtime definitions, keep them local to the module so that modules linked to
+ * the same JITDylib never define a symbol twice. The unused ones are removed by the optimization then.
+ */
+void InternalizeNonExportedSymbols(llvm::Module *m, const ir::Module &module) {
+  std::set<std::string> exported;
+  for (auto &func : module.functions()) {
+    exported.insert(func->name);
+  }
+  auto internalize = [&](llvm::GlobalValue &gv) {
+    if (gv.isDeclaration() || gv.hasLocalLinkage() || gv.getName().startswith("llvm.")) return;
+    if (exported.count(gv.getName().str())) return;
+    gv.setLinkage(llvm::GlobalValue::InternalLinkage);
+    gv.setVisibility(llvm::GlobalValue::DefaultVisibility);
+    if (auto *go = llvm::dyn_cast<llvm::GlobalObject>(&gv)) {
+      go->setComdat(nullptr);
+    }
+  };
+  for (auto &f : *m) internalize(f);
+  for (auto &gv : m->globals()) internalize(gv);
+}
 }  // namespace
 void NaiveObjectCache::notifyObjectCompiled(const llvm::Module *m, llvm::MemoryBufferRef obj_buffer) {
+  std::lock_guard<std::mutex> lock(mu_);
   cached_objects_[m->getModuleIdentifier()] =
       llvm::MemoryBuffer::getMemBufferCopy(obj_buffer.getBuffer(), obj_buffer.getBufferIdentifier());
 }
 
 std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Module *m) {
+  std::lock_guard<std::mutex> lock(mu_);
   auto it = cached_objects_.find(m->getModuleIdentifier());
   if (it == cached_objects_.end()) {
     VLOG(1) << "No object for " << m->getModuleIdentifier() << " in cache. Compiling.";
@@ -117,10 +159,15 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   static std::once_flag flag;
   std::call_once(flag, InitializeLLVMPasses);
 
-  auto engine = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true, std::move(module_symbols));
+  auto engine           = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true, std::move(module_symbols));
+  engine->lazy_compile_ = config.lazy_compile;
 
   auto compile_layer_creator = [&engine](llvm::orc::JITTargetMachineBuilder jtmb)
       -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+    if (engine->lazy_compile_) {
+      // The functions of a lazy engine are compiled by the threads calling them and the threads compiling ahead.
+      return std::make_unique<llvm::orc::ConcurrentIRCompiler>(std::move(jtmb), engine->cache_.get());
+    }
     auto machine = llvm::cantFail(jtmb.createTargetMachine());
     VLOG(1) << "create llvm compile layer";
     VLOG(1) << "Target Name: " << machine->getTarget().getName();
@@ -149,38 +196,58 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   VLOG(2) << "register runtime call symbols";
 
   engine->RegisterRuntimeSymbols();
+  if (config.lazy_compile) {
+    engine->InitLazyCompile(config);
+  }
 
   VLOG(2) << "===================== Create CINN ExecutionEngine end ====================";
   return engine;
 }
 
 template <typename CodeGenT>
-void ExecutionEngine::Link(const ir::Module &module) {
+void ExecutionEngine::Link(const ir::Module &module, const OptimizeOptions &optimize_options) {
   utils::RecordEvent("ExecutionEngine Link", utils::EventType::kOrdinary);
   llvm::SMDiagnostic error;
   auto ctx        = std::make_unique<llvm::LLVMContext>();
   auto m          = llvm::parseAssemblyString(AsStringRef(backends::kRuntimeLlvmIr), error, *ctx);
   auto b          = std::make_unique<llvm::IRBuilder<>>(*ctx);
   auto ir_emitter = std::make_unique<CodeGenT>(m.get(), b.get());
+  ir_emitter->set_math_precision(optimize_options.math_precision);
   VLOG(3) << "ir_emitter->Compile(module) Begin";
   ir_emitter->Compile(module);
   VLOG(3) << "ir_emitter->Compile(module) Succeed!";
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    // The object cache is keyed by the module identifier.
+    m->setModuleIdentifier(module.name() + "." + std::to_string(num_linked_modules_++));
+  }
+  InternalizeNonExportedSymbols(m.get(), module);
+  if (lazy_compile_) {
+    LinkLazily(std::move(m), std::move(ctx), module, optimize_options);
+    return;
+  }
 
   auto machine =
       std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
-  LLVMModuleOptimizer optimize(machine.get(), 3, {}, true);
+  LLVMModuleOptimizer optimize(machine.get(), optimize_options, {}, true);
   optimize(m.get());
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid optimized module detected";
   for (auto &f : *m) {
     VLOG(5) << "function: " << DumpToString(f);
   }
 
-  llvm::raw_svector_ostream rawstream(buffer_);
+  llvm::SmallString<0> object;
+  llvm::raw_svector_ostream rawstream(object);
   llvm::legacy::PassManager pass_manager;
   machine->addPassesToEmitFile(pass_manager, rawstream, nullptr, llvm::CGFT_ObjectFile);
   pass_manager.run(*m);
+  // Hand the object to the cache, so the JIT loads it instead of compiling the module again in the serialized Lookup.
+  cache_->notifyObjectCompiled(m.get(), llvm::MemoryBufferRef(object.str(), m->getModuleIdentifier()));
 
+  std::lock_guard<std::mutex> lock(mu_);
+  buffer_.append(object.begin(), object.end());
+  objects_.emplace_back(object.begin(), object.end());
   CHECK(AddModule(std::move(m), std::move(ctx)));
 
   if (VLOG_IS_ON(5)) {
@@ -218,6 +285,17 @@ void ExecutionEngine::ExportObject(const std::string &path) {
   fclose(of);
 }
 
+std::vector<std::string> ExecutionEngine::GetObjects() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return objects_;
+}
+
+void ExecutionEngine::AddObject(const std::string &object) {
+  utils::RecordEvent("ExecutionEngine AddObject", utils::EventType::kOrdinary);
+  std::lock_guard<std::mutex> lock(mu_);
+  llvm::cantFail(jit_->addObjectFile(llvm::MemoryBuffer::getMemBufferCopy(object)));
+}
+
 void *ExecutionEngine::Lookup(absl::string_view name) {
   utils::RecordEvent("ExecutionEngine Lookup", utils::EventType::kOrdinary);
   std::lock_guard<std::mutex> lock(mu_);
@@ -231,20 +309,183 @@ void *ExecutionEngine::Lookup(absl::string_view name) {
 
 void ExecutionEngine::RegisterRuntimeSymbols() {
   utils::RecordEvent("ExecutionEngine RegisterRuntimeSymbols", utils::EventType::kOrdinary);
-  const auto &registry = GlobalSymbolRegistry::Global();
-  auto *session        = &jit_->getExecutionSession();
-  for (const auto &sym : registry.All()) {
-    llvm::cantFail(jit_->define(llvm::orc::absoluteSymbols(
-        {{session->intern(sym.first), {llvm::pointerToJITTargetAddress(sym.second), llvm::JITSymbolFlags::None}}})));
+  DefineAbsoluteSymbols(jit_.get(), GlobalSymbolRegistry::Global());
+  DefineAbsoluteSymbols(jit_.get(), module_symbols_);
+}
+
+void ExecutionEngine::RegisterModuleRuntimeSymbols(RuntimeSymbols &&module_symbols) {
+  utils::RecordEvent("ExecutionEngine RegisterModuleRuntimeSymbols", utils::EventType::kOrdinary);
+  std::lock_guard<std::mutex> lock(mu_);
+  linked_module_symbols_.emplace_back(std::make_unique<RuntimeSymbols>(std::move(module_symbols)));
+  DefineAbsoluteSymbols(jit_.get(), *linked_module_symbols_.back());
+}
+
+ExecutionEngine::~ExecutionEngine() {
+  stop_compile_ahead_ = true;
+  for (auto &thread : compile_ahead_threads_) {
+    thread.join();
   }
-  for (const auto &sym : module_symbols_.All()) {
-    llvm::cantFail(jit_->define(llvm::orc::absoluteSymbols(
-        {{session->intern(sym.first), {llvm::pointerToJITTargetAddress(sym.second), llvm::JITSymbolFlags::None}}})));
+  if (lazy_compile_) {
+    VLOG(1) << LazyCompileReport();
+  }
+}
+
+void ExecutionEngine::InitLazyCompile(const ExecutionOptions &config) {
+  num_compile_ahead_threads_ = std::max(config.num_compile_ahead_threads, 1);
+  llvm::Triple triple(llvm::sys::getProcessTriple());
+  lazy_call_through_ = llvm::cantFail(
+      llvm::orc::createLocalLazyCallThroughManager(triple, jit_->getExecutionSession(), /*ErrorHandlerAddr=*/0));
+  indirect_stubs_ = llvm::orc::createLocalIndirectStubsManagerBuilder(triple)();
+  // The modules are optimized when they are materialized instead of in Link.
+  jit_->getIRTransformLayer().setTransform(
+      [this](llvm::orc::ThreadSafeModule tsm,
+             const llvm::orc::MaterializationResponsibility &) -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+        return OptimizeLazyModule(std::move(tsm));
+      });
+}
+
+void ExecutionEngine::LinkLazily(std::unique_ptr<llvm::Module> m,
+                                 std::unique_ptr<llvm::LLVMContext> ctx,
+                                 const ir::Module &module,
+                                 const OptimizeOptions &optimize_options) {
+  utils::RecordEvent("ExecutionEngine LinkLazily", utils::EventType::kOrdinary);
+  // Drop the runtime definitions unused by the functions before copying the module for each of them.
+  llvm::legacy::PassManager pass_manager;
+  pass_manager.add(llvm::createGlobalDCEPass());
+  pass_manager.run(*m);
+
+  std::set<std::string> exported;
+  for (auto &func : module.functions()) {
+    exported.insert(func->name);
+  }
+  std::string module_id = m->getModuleIdentifier();
+  llvm::orc::ThreadSafeModule tsm(std::move(m), std::move(ctx));
+  auto *session = &jit_->getExecutionSession();
+
+  // Each function is copied to a module of its own context with the definitions it uses, so that the functions are
+  // compiled independently and concurrently.
+  std::vector<llvm::orc::ThreadSafeModule> fn_modules;
+  llvm::orc::SymbolAliasMap stubs;
+  for (auto &func : module.functions()) {
+    std::string impl_name = func->name + kLazyImplSuffix;
+    auto fn_tsm           = llvm::orc::cloneToNewContext(tsm, [&](const llvm::GlobalValue &gv) {
+      return gv.getName() == func->name || !exported.count(gv.getName().str());
+    });
+    fn_tsm.withModuleDo([&](llvm::Module &fn_module) {
+      fn_module.setModuleIdentifier(module_id + "." + func->name);
+      fn_module.setDataLayout(jit_->getDataLayout());
+      auto *fn = fn_module.getFunction(func->name);
+      CHECK(fn) << "Function " << func->name << " is not found in the linked module";
+      fn->setName(impl_name);
+    });
+    fn_modules.push_back(std::move(fn_tsm));
+    stubs[session->intern(func->name)] = llvm::orc::SymbolAliasMapEntry(
+        session->intern(impl_name), llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  {
+    std::lock_guard<std::mutex> lazy_lock(lazy_mu_);
+    for (auto &func : module.functions()) {
+      lazy_compile_kinds_[func->name]    = LazyCompileKind::kNotCompiled;
+      lazy_optimize_options_[func->name] = optimize_options;
+    }
+  }
+  for (auto &fn_tsm : fn_modules) {
+    llvm::cantFail(jit_->addIRModule(std::move(fn_tsm)));
+  }
+  auto &main_jd = jit_->getMainJITDylib();
+  llvm::cantFail(
+      main_jd.define(llvm::orc::lazyReexports(*lazy_call_through_, *indirect_stubs_, main_jd, std::move(stubs))));
+}
+
+llvm::orc::ThreadSafeModule ExecutionEngine::OptimizeLazyModule(llvm::orc::ThreadSafeModule tsm) {
+  tsm.withModuleDo([this](llvm::Module &m) {
+    std::string fn_name;
+    for (auto &f : m) {
+      if (!f.isDeclaration() && f.getName().endswith(kLazyImplSuffix)) {
+        fn_name = f.getName().drop_back(sizeof(kLazyImplSuffix) - 1).str();
+      }
+    }
+    VLOG(3) << "Compile " << fn_name << (compiling_ahead ? " ahead" : " on the first call");
+    OptimizeOptions optimize_options;
+    {
+      std::lock_guard<std::mutex> lock(lazy_mu_);
+      if (lazy_optimize_options_.count(fn_name)) {
+        optimize_options = lazy_optimize_options_.at(fn_name);
+      }
+    }
+    auto machine = std::move(
+        llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
+    LLVMModuleOptimizer optimize(machine.get(), optimize_options, {}, true);
+    optimize(&m);
+
+    std::lock_guard<std::mutex> lock(lazy_mu_);
+    if (lazy_compile_kinds_.count(fn_name)) {
+      lazy_compile_kinds_[fn_name] = compiling_ahead ? LazyCompileKind::kSpeculative : LazyCompileKind::kOnFirstCall;
+    }
+  });
+  return tsm;
+}
+
+void ExecutionEngine::CompileAhead(const std::vector<std::string> &fn_names) {
+  CHECK(lazy_compile_) << "Only the functions of a lazy engine could be compiled ahead";
+  auto names = std::make_shared<std::vector<std::string>>(fn_names);
+  auto next  = std::make_shared<std::atomic<int>>(0);
+  for (int i = 0; i < num_compile_ahead_threads_; ++i) {
+    compile_ahead_threads_.emplace_back([this, names, next] {
+      compiling_ahead = true;
+      for (int idx = (*next)++; idx < names->size() && !stop_compile_ahead_; idx = (*next)++) {
+        auto &name = names->at(idx);
+        {
+          std::lock_guard<std::mutex> lock(lazy_mu_);
+          auto it = lazy_compile_kinds_.find(name);
+          if (it == lazy_compile_kinds_.end() || it->second != LazyCompileKind::kNotCompiled) {
+            continue;
+          }
+        }
+        // Looking up the implementation materializes it, the callers of the stub jump to it then.
+        auto symbol = jit_->lookup(name + kLazyImplSuffix);
+        if (!symbol) {
+          LOG(WARNING) << "Failed to compile " << name << " ahead: " << llvm::toString(symbol.takeError());
+        }
+      }
+    });
+  }
+}
+
+std::map<std::string, LazyCompileKind> ExecutionEngine::GetLazyCompileKinds() const {
+  std::lock_guard<std::mutex> lock(lazy_mu_);
+  return lazy_compile_kinds_;
+}
+
+std::string ExecutionEngine::LazyCompileReport() const {
+  auto kinds = GetLazyCompileKinds();
+  std::vector<std::string> on_first_call;
+  int num_speculative = 0, num_not_compiled = 0;
+  for (auto &item : kinds) {
+    if (item.second == LazyCompileKind::kOnFirstCall) {
+      on_first_call.push_back(item.first);
+    } else if (item.second == LazyCompileKind::kSpeculative) {
+      ++num_speculative;
+    } else {
+      ++num_not_compiled;
+    }
+  }
+  std::stringstream ss;
+  ss << "Lazy compile of " << kinds.size() << " functions: " << num_speculative << " compiled ahead, "
+     << on_first_call.size() << " compiled on the first call, " << num_not_compiled << " not compiled yet";
+  for (auto &name : on_first_call) {
+    ss << "\n  compiled on the first call: " << name;
   }
+  return ss.str();
 }
 
-template void ExecutionEngine::Link<CodeGenLLVM>(const ir::Module &module);
-template void ExecutionEngine::Link<CodeGenX86>(const ir::Module &module);
-template void ExecutionEngine::Link<CodeGenCUDA_Host>(const ir::Module &module);
+template void ExecutionEngine::Link<CodeGenLLVM>(const ir::Module &module,
+                                                 const OptimizeOptions &optimize_options);
+template void ExecutionEngine::Link<CodeGenX86>(const ir::Module &module,
+                                                const OptimizeOptions &optimize_options);
+template void ExecutionEngine::Link<CodeGenCUDA_Host>(const ir::Module &module,
+                                                      const OptimizeOptions &optimize_options);
 
 }  // namespace cinn::backends
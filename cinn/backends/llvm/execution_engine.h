@@ -22,8 +22,10 @@
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/LambdaResolver.h>
+#include <llvm/ExecutionEngine/Orc/LazyReexports.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
@@ -36,14 +38,18 @@
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "cinn/backends/llvm/codegen_x86.h"
+#include "cinn/backends/llvm/llvm_optimizer.h"
 #include "cinn/backends/llvm/llvm_util.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/ir/module.h"
@@ -56,30 +62,75 @@ class NaiveObjectCache : public llvm::ObjectCache {
   std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override;
 
  private:
+  std::mutex mu_;
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> cached_objects_;
 };
 
 struct ExecutionOptions {
   int opt_level{3};
   bool enable_debug_info{false};
+  //! Compile each function on its first call instead of in Link, see ExecutionEngine::CompileAhead.
+  bool lazy_compile{false};
+  //! The number of the background threads compiling the functions of a lazy engine ahead of their first calls.
+  int num_compile_ahead_threads{1};
   // TODO(fc500110)
   // int num_compile_threads{1};
   // bool enable_fast_math;
 };
 
+//! How a function linked to a lazy engine has been compiled.
+enum class LazyCompileKind {
+  kNotCompiled,
+  //! Compiled by the stub of the function when it was first called.
+  kOnFirstCall,
+  //! Compiled by CompileAhead in the background.
+  kSpeculative,
+};
+
 class ExecutionEngine {
  public:
   static std::unique_ptr<ExecutionEngine> Create(const ExecutionOptions &config);
 
   static std::unique_ptr<ExecutionEngine> Create(const ExecutionOptions &config, RuntimeSymbols &&module_symbols);
 
+  ~ExecutionEngine();
+
+  /**
+   * Get the address of a function. For a lazy engine, it is the address of a stub which compiles the function on
+   * its first call and jumps to it then.
+   */
   void *Lookup(absl::string_view name);
 
+  /**
+   * Compile a module and add it to the engine. Several modules could be linked concurrently, only the functions of
+   * the ir::Module are exported from each of them.
+   */
   template <typename CodeGenT = CodeGenLLVM>
-  void Link(const ir::Module &module);
+  void Link(const ir::Module &module, const OptimizeOptions &optimize_options = OptimizeOptions());
+
+  //! Register the symbols required by a module linked later, the engine takes the ownership of the symbols.
+  void RegisterModuleRuntimeSymbols(RuntimeSymbols &&module_symbols);
+
+  /**
+   * Compile the functions of a lazy engine by background threads in the order of \p fn_names, usually the order
+   * they are called in, so that most of them are compiled before their first calls.
+   */
+  void CompileAhead(const std::vector<std::string> &fn_names);
+
+  //! Get how each function linked to a lazy engine has been compiled so far.
+  std::map<std::string, LazyCompileKind> GetLazyCompileKinds() const;
+
+  //! Summarize how the functions linked to a lazy engine have been compiled so far.
+  std::string LazyCompileReport() const;
 
   void ExportObject(const std::string &path);
 
+  //! Get the relocatable object of each module linked so far, a lazy engine compiles no object in Link.
+  std::vector<std::string> GetObjects() const;
+
+  //! Load a relocatable object compiled by another engine, such as one got by GetObjects in another process.
+  void AddObject(const std::string &object);
+
   bool AddModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context);
 
  protected:
@@ -88,6 +139,17 @@ class ExecutionEngine {
 
   void RegisterRuntimeSymbols();
 
+  void InitLazyCompile(const ExecutionOptions &config);
+
+  //! Split a module to a module per function, which is compiled when the stub of the function is first called.
+  void LinkLazily(std::unique_ptr<llvm::Module> m,
+                  std::unique_ptr<llvm::LLVMContext> ctx,
+                  const ir::Module &module,
+                  const OptimizeOptions &optimize_options);
+
+  //! Optimize a module split by LinkLazily when it is materialized.
+  llvm::orc::ThreadSafeModule OptimizeLazyModule(llvm::orc::ThreadSafeModule tsm);
+
   bool SetupTargetTriple(llvm::Module *module);
 
   // This may not be a compatible implementation.
@@ -96,9 +158,22 @@ class ExecutionEngine {
  private:
   mutable std::mutex mu_;
   llvm::SmallString<0> buffer_;
+  std::vector<std::string> objects_;
   std::unique_ptr<llvm::orc::LLJIT> jit_;
   std::unique_ptr<NaiveObjectCache> cache_;
   RuntimeSymbols module_symbols_;
+  std::vector<std::unique_ptr<RuntimeSymbols>> linked_module_symbols_;
+  int num_linked_modules_{0};
+
+  bool lazy_compile_{false};
+  int num_compile_ahead_threads_{1};
+  std::unique_ptr<llvm::orc::LazyCallThroughManager> lazy_call_through_;
+  std::unique_ptr<llvm::orc::IndirectStubsManager> indirect_stubs_;
+  mutable std::mutex lazy_mu_;
+  std::map<std::string, LazyCompileKind> lazy_compile_kinds_;
+  std::map<std::string, OptimizeOptions> lazy_optimize_options_;
+  std::atomic<bool> stop_compile_ahead_{false};
+  std::vector<std::thread> compile_ahead_threads_;
 };
 
 }  // namespace cinn::backends
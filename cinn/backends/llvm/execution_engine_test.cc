@@ -21,6 +21,7 @@
 #include <llvm/IR/Argument.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
@@ -28,16 +29,19 @@
 #include <llvm/Support/raw_ostream.h>
 
 #include <algorithm>
+#include <chrono>  // NOLINT
 #include <cmath>
 #include <iomanip>
 #include <memory>
 #include <random>
+#include <thread>  // NOLINT
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
+#include "cinn/backends/llvm/llvm_optimizer.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/cinn.h"
 #include "cinn/ir/ir.h"
@@ -325,5 +329,119 @@ TEST(ExecutionEngine, call_extern) {
   }
 }
 
+TEST(ExecutionEngine, lazy_compile) {
+  ir::Expr M(kM);
+  ir::Expr N(kN);
+  Module::Builder builder("lazy_module", common::DefaultHostTarget());
+  for (auto &name : {std::string("add"), std::string("sub")}) {
+    lang::Placeholder<float> a("A", {M, N});
+    lang::Placeholder<float> b("B", {M, N});
+    auto c = lang::Compute(
+        {M, N}, [&](Var i, Var j) { return name == "add" ? a(i, j) + b(i, j) : a(i, j) - b(i, j); }, "C");
+    auto stages = CreateStages({c});
+    builder.AddFunction(lang::Lower(name, stages, {a, b, c}));
+  }
+
+  ExecutionOptions options;
+  options.lazy_compile = true;
+  auto engine          = backends::ExecutionEngine::Create(options);
+  engine->Link(builder.Build());
+  // Lookup returns the stubs without compiling the functions.
+  auto add = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("add"));
+  auto sub = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("sub"));
+  ASSERT_TRUE(add);
+  ASSERT_TRUE(sub);
+  ASSERT_EQ(engine->GetLazyCompileKinds().at("add"), LazyCompileKind::kNotCompiled);
+  ASSERT_EQ(engine->GetLazyCompileKinds().at("sub"), LazyCompileKind::kNotCompiled);
+
+  auto _ab_bb_cb_ = CreateTestBuffer();  // NOLINT
+  auto &ab        = std::get<0>(_ab_bb_cb_);
+  auto &bb        = std::get<1>(_ab_bb_cb_);
+  auto &cb        = std::get<2>(_ab_bb_cb_);
+  cinn_pod_value_t a_arg(ab), b_arg(bb), c_arg(cb);
+  cinn_pod_value_t args[3] = {a_arg, b_arg, c_arg};
+  add(args, 3);
+  ASSERT_EQ(engine->GetLazyCompileKinds().at("add"), LazyCompileKind::kOnFirstCall);
+
+  engine->CompileAhead({"add", "sub"});
+  for (int i = 0; i < 1000 && engine->GetLazyCompileKinds().at("sub") == LazyCompileKind::kNotCompiled; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(engine->GetLazyCompileKinds().at("sub"), LazyCompileKind::kSpeculative);
+  LOG(INFO) << engine->LazyCompileReport();
+
+  // The stub of a function compiled ahead jumps to it as well.
+  sub(args, 3);
+  auto *ad = reinterpret_cast<float *>(ab->memory);
+  auto *bd = reinterpret_cast<float *>(bb->memory);
+  auto *cd = reinterpret_cast<float *>(cb->memory);
+  for (int i = 0; i < kM * kN; i++) {
+    ASSERT_NEAR(cd[i], ad[i] - bd[i], 1e-5);
+  }
+}
+
+TEST(ExecutionEngine, optimize_profiles) {
+  for (auto profile : {OptimizeProfile::kFastCompile, OptimizeProfile::kBalanced, OptimizeProfile::kMaxPerf}) {
+    OptimizeOptions optimize_options;
+    optimize_options.profile             = profile;
+    optimize_options.skip_loop_vectorize = profile == OptimizeProfile::kBalanced;
+    auto engine                          = backends::ExecutionEngine::Create({1});
+    engine->Link(CreateTestCinnModule(), optimize_options);
+
+    auto _a_b_c_ = CreateTestBuffer();  // NOLINT
+    auto &a      = std::get<0>(_a_b_c_);
+    auto &b      = std::get<1>(_a_b_c_);
+    auto &c      = std::get<2>(_a_b_c_);
+    cinn_pod_value_t a_arg(a), b_arg(b), c_arg(c);
+    cinn_pod_value_t args[3] = {a_arg, b_arg, c_arg};
+    auto elementwise_add     = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("elementwise_add"));
+    ASSERT_TRUE(elementwise_add);
+    elementwise_add(args, 3);
+
+    auto *ad = reinterpret_cast<float *>(a->memory);
+    auto *bd = reinterpret_cast<float *>(b->memory);
+    auto *cd = reinterpret_cast<float *>(c->memory);
+    for (int i = 0; i < c->num_elements(); i++) {
+      ASSERT_NEAR(cd[i], ad[i] + bd[i], 1e-5);
+    }
+  }
+
+  ASSERT_EQ(OptimizeProfileFromString("fast-compile"), OptimizeProfile::kFastCompile);
+  ASSERT_EQ(OptimizeProfileFromString("max-perf"), OptimizeProfile::kMaxPerf);
+}
+
+TEST(LLVMModuleOptimizer, time_passes) {
+  llvm::LLVMContext context;
+  llvm::SMDiagnostic error;
+  auto m = llvm::parseAssemblyString(R"IR(
+define void @scale(float* noalias %x, i32 %n) {
+entry:
+  br label %loop
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %p = getelementptr float, float* %x, i32 %i
+  %v = load float, float* %p
+  %r = fmul float %v, 2.0
+  store float %r, float* %p
+  %i.next = add i32 %i, 1
+  %cond = icmp slt i32 %i.next, %n
+  br i1 %cond, label %loop, label %exit
+exit:
+  ret void
+}
+)IR",
+                                     error,
+                                     context);
+  ASSERT_TRUE(m);
+
+  OptimizeOptions options;
+  options.profile     = OptimizeProfile::kFastCompile;
+  options.time_passes = true;
+  LLVMModuleOptimizer optimize(nullptr, options);
+  optimize(m.get());
+  ASSERT_FALSE(optimize.pass_times_ms().empty());
+  ASSERT_FALSE(llvm::verifyModule(*m, &llvm::errs()));
+}
+
 }  // namespace backends
 }  // namespace cinn
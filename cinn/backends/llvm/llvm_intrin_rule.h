@@ -26,6 +26,7 @@
 #include "cinn/ir/intrinsic_ops.h"
 #include "cinn/ir/registry.h"
 #include "cinn/lang/packed_func.h"
+#include "cinn/optim/lower_intrin.h"
 
 namespace cinn {
 namespace codegen {
@@ -45,13 +46,35 @@ inline void MakeFloatIntrinOp(lang::Args args, lang::RetValue *rv) {
   }
 }
 
+//! The builtin intrinsic computing the math function by the inline polynomials on the host.
+inline Expr MakeInlineMathIntrin(ir::Call *node) {
+  CHECK_EQ(node->read_args.size(), 1U);
+  return ir::intrinsics::BuiltinIntrin::Make(
+      optim::HostInlineMathIntrinName(node->name), node->read_args, -1, 1, node->type());
+}
+
+//! Compute the math function by the inline polynomials of float32, or else by the llvm intrinsic `id`.
+template <int id>
+inline void MakeMathIntrinOp(lang::Args args, lang::RetValue *rv) {
+  CHECK_GE(args.size(), 1U);
+  Expr arg       = args[0];
+  ir::Call *node = arg->as<ir::Call>();
+  CHECK(node);
+  if (optim::IsHostInlineMath(node->name, node->type())) {
+    *rv = MakeInlineMathIntrin(node);
+  } else {
+    MakeFloatIntrinOp<id, 1>(args, rv);
+  }
+}
+
 void RegisterCpuIntrinRule() {
+  ir::Registry::Register("lower_cpu_intrinsic_exp", true).SetBody(MakeMathIntrinOp<::llvm::Intrinsic::exp>);
+  ir::Registry::Register("lower_cpu_intrinsic_log", true).SetBody(MakeMathIntrinOp<::llvm::Intrinsic::log>);
+
 #define __(intrin_name__, id) \
   ir::Registry::Register("lower_cpu_intrinsic_" #intrin_name__, true).SetBody(MakeFloatIntrinOp<id, 1>);
-  __(exp, ::llvm::Intrinsic::exp)
   __(exp2, ::llvm::Intrinsic::exp2)
   __(sqrt, ::llvm::Intrinsic::sqrt)
-  __(log, ::llvm::Intrinsic::log)
   __(log2, ::llvm::Intrinsic::log2)
   __(log10, ::llvm::Intrinsic::log10)
   __(floor, ::llvm::Intrinsic::floor)
@@ -139,6 +162,10 @@ void RegisterCpuIntrinRule() {
     ir::Call *node = arg0->as<ir::Call>();
     CHECK(node);
     CHECK(!node->read_args.empty());
+    if (optim::IsHostInlineMath(node->name, node->type())) {
+      *rv = MakeInlineMathIntrin(node);
+      return;
+    }
     Expr arg     = node->read_args[0];
     Expr zero    = make_const(arg->type(), 0);
     Expr one     = make_const(arg->type(), 1);
@@ -153,6 +180,19 @@ void RegisterCpuIntrinRule() {
     *rv           = ir::Select::Make(arg >= zero, tanh_pos, tanh_neg);
   });
 
+  ir::Registry::Register("lower_cpu_intrinsic_erf", true).SetBody([](lang::Args args, lang::RetValue *rv) {
+    CHECK_GE(args.size(), 1U);
+    Expr arg0      = args[0];
+    ir::Call *node = arg0->as<ir::Call>();
+    CHECK(node);
+    CHECK(!node->read_args.empty());
+    if (optim::IsHostInlineMath(node->name, node->type())) {
+      *rv = MakeInlineMathIntrin(node);
+    } else {
+      *rv = lang::CallExtern("erff", node->read_args);
+    }
+  });
+
   ir::Registry::Register("lower_cpu_intrinsic_cosh", true).SetBody([](lang::Args args, lang::RetValue *rv) {
     CHECK_GE(args.size(), 1U);
     Expr arg0      = args[0];
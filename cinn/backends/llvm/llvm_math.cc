@@ -0,0 +1,287 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/llvm_math.h"
+
+#include <glog/logging.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Intrinsics.h>
+
+#include <initializer_list>
+#include <string>
+
+#include "cinn/optim/lower_intrin.h"
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace backends {
+
+namespace {
+
+/**
+ * Emit the polynomials of float32 into a function body. The coefficients of exp, log and the small tanh are those of
+ * cephes, and the rational approximations of erf and the fast tanh are those of Eigen.
+ */
+class MathEmitter {
+ public:
+  MathEmitter(llvm::IRBuilder<> *b, llvm::Type *type) : b_(b), type_(type) {
+    int_type_ = b_->getInt32Ty();
+    if (auto *vec_type = llvm::dyn_cast<llvm::VectorType>(type_)) {
+      int_type_ = llvm::VectorType::get(int_type_, vec_type->getElementCount());
+    }
+  }
+
+  llvm::Value *Emit(const std::string &func, bool strict, llvm::Value *x) {
+    if (func == "exp") return Exp(x, strict);
+    if (func == "log") return Log(x, strict);
+    if (func == "tanh") return Tanh(x, strict);
+    if (func == "erf") return Erf(x, strict);
+    LOG(FATAL) << "No inline polynomial of " << func;
+    return nullptr;
+  }
+
+ private:
+  llvm::Value *Exp(llvm::Value *x, bool strict) {
+    // exp(x) = 2^n * exp(r), where n = round(x / ln2) and |r| <= ln2 / 2.
+    llvm::Value *xc = strict ? Clamp(x, -104.f, 89.f) : Clamp(x, -87.33654f, 88.37626f);
+    llvm::Value *t  = FMA(xc, Float(1.44269504088896341f), Float(0.5f));
+    llvm::Value *n  = b_->CreateUnaryIntrinsic(llvm::Intrinsic::floor, t);
+    llvm::Value *r  = FMA(n, Float(-0.693359375f), xc);
+    r               = FMA(n, Float(2.12194440e-4f), r);
+
+    llvm::Value *y = Horner(r,
+                            {1.9875691500E-4f,
+                             1.3981999507E-3f,
+                             8.3334519073E-3f,
+                             4.1665795894E-2f,
+                             1.6666665459E-1f,
+                             5.0000001201E-1f});
+    y              = FMA(y, b_->CreateFMul(r, r), r);
+    y              = b_->CreateFAdd(y, Float(1.f));
+
+    llvm::Value *ni = b_->CreateFPToSI(n, int_type_);
+    if (!strict) return b_->CreateFMul(y, Pow2(ni));
+    // Scale by two halves of n, so that the overflow gives infinity and the underflow gives the denormals.
+    llvm::Value *half = b_->CreateAShr(ni, Int(1));
+    llvm::Value *res  = b_->CreateFMul(b_->CreateFMul(y, Pow2(half)), Pow2(b_->CreateSub(ni, half)));
+    return b_->CreateSelect(b_->CreateFCmpUNO(x, x), x, res);
+  }
+
+  llvm::Value *Log(llvm::Value *x, bool strict) {
+    // log(x) = e * ln2 + log(m), where x = 2^e * m and sqrt(1/2) <= m < sqrt(2).
+    llvm::Value *xs  = x;
+    llvm::Value *adj = Int(0);
+    if (strict) {
+      llvm::Value *denormal = b_->CreateFCmpOLT(x, Float(1.17549435e-38f));
+      xs                    = b_->CreateSelect(denormal, b_->CreateFMul(x, Float(8388608.f)), x);
+      adj                   = b_->CreateSelect(denormal, Int(-23), Int(0));
+    }
+    llvm::Value *bits = b_->CreateBitCast(xs, int_type_);
+    llvm::Value *e    = b_->CreateAdd(b_->CreateSub(b_->CreateAShr(bits, Int(23)), Int(127)), adj);
+    llvm::Value *m    = b_->CreateOr(b_->CreateAnd(bits, Int(0x007fffff)), Int(0x3f800000));
+    m                 = b_->CreateBitCast(m, type_);
+
+    llvm::Value *big = b_->CreateFCmpOGT(m, Float(1.41421356237f));
+    m                = b_->CreateSelect(big, b_->CreateFMul(m, Float(0.5f)), m);
+    e                = b_->CreateSelect(big, b_->CreateAdd(e, Int(1)), e);
+
+    llvm::Value *f  = b_->CreateFSub(m, Float(1.f));
+    llvm::Value *fe = b_->CreateSIToFP(e, type_);
+    llvm::Value *z  = b_->CreateFMul(f, f);
+    llvm::Value *y  = Horner(f,
+                            {7.0376836292E-2f,
+                             -1.1514610310E-1f,
+                             1.1676998740E-1f,
+                             -1.2420140846E-1f,
+                             1.4249322787E-1f,
+                             -1.6668057665E-1f,
+                             2.0000714765E-1f,
+                             -2.4999993993E-1f,
+                             3.3333331174E-1f});
+    y               = b_->CreateFMul(b_->CreateFMul(y, f), z);
+    y               = FMA(fe, Float(-2.12194440e-4f), y);
+    y               = FMA(z, Float(-0.5f), y);
+
+    llvm::Value *res = FMA(fe, Float(0.693359375f), b_->CreateFAdd(f, y));
+    if (!strict) return res;
+    res = b_->CreateSelect(b_->CreateFCmpOEQ(x, Infinity()), x, res);
+    res = b_->CreateSelect(b_->CreateFCmpOEQ(x, Float(0.f)), b_->CreateFNeg(Infinity()), res);
+    // The negative inputs and NaN give NaN.
+    return b_->CreateSelect(b_->CreateFCmpULT(x, Float(0.f)), llvm::ConstantFP::getNaN(type_), res);
+  }
+
+  llvm::Value *Tanh(llvm::Value *x, bool strict) {
+    if (!strict) {
+      llvm::Value *xc = Clamp(x, -7.90531110763549805f, 7.90531110763549805f);
+      llvm::Value *x2 = b_->CreateFMul(xc, xc);
+      llvm::Value *p  = Horner(x2,
+                              {-2.76076847742355e-16f,
+                               2.00018790482477e-13f,
+                               -8.60467152213735e-11f,
+                               5.12229709037114e-08f,
+                               1.48572235717979e-05f,
+                               6.37261928875436e-04f,
+                               4.89352455891786e-03f});
+      llvm::Value *q  = Horner(x2,
+                              {1.19825839466702e-06f,
+                               1.18534705686654e-04f,
+                               2.26843463243900e-03f,
+                               4.89352518554385e-03f});
+      return b_->CreateFDiv(b_->CreateFMul(xc, p), q);
+    }
+
+    // x + x^3 * P(x^2) for |x| < 0.625, and 1 - 2 / (exp(2|x|) + 1) with the sign of x otherwise.
+    llvm::Value *ax    = b_->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, x);
+    llvm::Value *z     = b_->CreateFMul(x, x);
+    llvm::Value *p     = Horner(z,
+                               {-5.70498872745E-3f,
+                                2.06390887954E-2f,
+                                -5.37397155531E-2f,
+                                1.33314422036E-1f,
+                                -3.33332819422E-1f});
+    llvm::Value *small = FMA(b_->CreateFMul(p, z), x, x);
+
+    llvm::Value *e     = Exp(b_->CreateFAdd(ax, ax), true);
+    llvm::Value *large = b_->CreateFSub(Float(1.f), b_->CreateFDiv(Float(2.f), b_->CreateFAdd(e, Float(1.f))));
+    large              = b_->CreateBinaryIntrinsic(llvm::Intrinsic::copysign, large, x);
+    return b_->CreateSelect(b_->CreateFCmpOLT(ax, Float(0.625f)), small, large);
+  }
+
+  llvm::Value *Erf(llvm::Value *x, bool strict) {
+    // The inputs out of [-4, 4] are +/-1 in float32.
+    llvm::Value *xc = Clamp(x, -4.f, 4.f);
+    llvm::Value *x2 = b_->CreateFMul(xc, xc);
+    llvm::Value *p  = Horner(x2,
+                            {-2.72614225801306e-10f,
+                             2.77068142495902e-08f,
+                             -2.10102402082508e-06f,
+                             -5.69250639462346e-05f,
+                             -7.34990630326855e-04f,
+                             -2.95459980854025e-03f,
+                             -1.60960333262415e-02f});
+    llvm::Value *q  = Horner(x2,
+                            {-1.45660718464996e-05f,
+                             -2.13374055278905e-04f,
+                             -1.68282697438203e-03f,
+                             -7.37332916720468e-03f,
+                             -1.42647390514189e-02f});
+
+    llvm::Value *res = b_->CreateFDiv(b_->CreateFMul(xc, p), q);
+    if (!strict) return res;
+    // erf(x) = 2x / sqrt(pi) for the tiny inputs, whose squares underflow.
+    llvm::Value *ax   = b_->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, x);
+    llvm::Value *tiny = b_->CreateFMul(x, Float(1.12837916709551257f));
+    res               = b_->CreateSelect(b_->CreateFCmpOLT(ax, Float(1e-4f)), tiny, res);
+    return b_->CreateSelect(b_->CreateFCmpUNO(x, x), x, res);
+  }
+
+  llvm::Value *Float(float v) { return llvm::ConstantFP::get(type_, v); }
+  llvm::Value *Int(int32_t v) { return llvm::ConstantInt::get(int_type_, static_cast<uint64_t>(v), true); }
+  llvm::Value *Infinity() { return llvm::ConstantFP::getInfinity(type_); }
+
+  llvm::Value *FMA(llvm::Value *a, llvm::Value *b, llvm::Value *c) {
+    return b_->CreateIntrinsic(llvm::Intrinsic::fmuladd, {type_}, {a, b, c});
+  }
+
+  //! The polynomial of `x` with the coefficients from the highest degree.
+  llvm::Value *Horner(llvm::Value *x, std::initializer_list<float> coeffs) {
+    auto it        = coeffs.begin();
+    llvm::Value *y = Float(*it++);
+    for (; it != coeffs.end(); ++it) {
+      y = FMA(y, x, Float(*it));
+    }
+    return y;
+  }
+
+  llvm::Value *Clamp(llvm::Value *x, float lo, float hi) {
+    x = b_->CreateSelect(b_->CreateFCmpOLT(x, Float(hi)), x, Float(hi));
+    return b_->CreateSelect(b_->CreateFCmpOGT(x, Float(lo)), x, Float(lo));
+  }
+
+  //! 2^n for the integers n in [-126, 127].
+  llvm::Value *Pow2(llvm::Value *n) {
+    return b_->CreateBitCast(b_->CreateShl(b_->CreateAdd(n, Int(127)), Int(23)), type_);
+  }
+
+  llvm::IRBuilder<> *b_;
+  llvm::Type *type_;
+  llvm::Type *int_type_;
+};
+
+//! Compute `math` by the math library, lane by lane for the vectors.
+llvm::Value *EmitLibmCall(llvm::IRBuilder<> *b, llvm::Module *m, const std::string &math, llvm::Value *x) {
+  if (math == "exp") return b->CreateUnaryIntrinsic(llvm::Intrinsic::exp, x);
+  if (math == "log") return b->CreateUnaryIntrinsic(llvm::Intrinsic::log, x);
+  CHECK(math == "tanh" || math == "erf") << "No libm function of " << math;
+  llvm::Type *float_type = b->getFloatTy();
+  auto callee            = m->getOrInsertFunction(math + "f", llvm::FunctionType::get(float_type, {float_type}, false));
+  auto *vec_type         = llvm::dyn_cast<llvm::VectorType>(x->getType());
+  if (!vec_type) return b->CreateCall(callee, {x});
+  llvm::Value *res = llvm::UndefValue::get(vec_type);
+  for (unsigned i = 0; i < vec_type->getNumElements(); ++i) {
+    res = b->CreateInsertElement(res, b->CreateCall(callee, {b->CreateExtractElement(x, i)}), i);
+  }
+  return res;
+}
+
+}  // namespace
+
+MathPrecision MathPrecisionFromString(const std::string &name) {
+  if (name == "strict") return MathPrecision::kStrict;
+  if (name == "fast") return MathPrecision::kFast;
+  CHECK_EQ(name, "libm") << "The math precision should be strict, fast or libm";
+  return MathPrecision::kLibm;
+}
+
+bool IsInlineMathIntrin(const std::string &name) { return utils::Startswith(name, optim::kHostInlineMathPrefix); }
+
+llvm::Value *EmitInlineMath(
+    llvm::IRBuilder<> *b, llvm::Module *m, const std::string &name, llvm::Value *arg, MathPrecision precision) {
+  CHECK(IsInlineMathIntrin(name));
+  llvm::Type *type = arg->getType();
+  CHECK(type->getScalarType()->isFloatTy()) << "The inline polynomials only compute float32";
+
+  std::string suffix = "f32";
+  if (auto *vec_type = llvm::dyn_cast<llvm::VectorType>(type)) {
+    suffix = "v" + std::to_string(vec_type->getNumElements()) + suffix;
+  }
+  std::string math           = name.substr(std::string(optim::kHostInlineMathPrefix).size());
+  const char *precision_name = precision == MathPrecision::kStrict ? "strict"
+                               : precision == MathPrecision::kFast ? "fast"
+                                                                   : "libm";
+  std::string func_name      = name + "." + precision_name + "." + suffix;
+
+  llvm::Function *func = m->getFunction(func_name);
+  if (!func) {
+    auto *func_type = llvm::FunctionType::get(type, {type}, false);
+    func            = llvm::Function::Create(func_type, llvm::Function::InternalLinkage, func_name, m);
+    func->addFnAttr(llvm::Attribute::AlwaysInline);
+    func->addFnAttr(llvm::Attribute::NoUnwind);
+
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(m->getContext(), "entry", func));
+    if (precision == MathPrecision::kLibm) {
+      builder.CreateRet(EmitLibmCall(&builder, m, math, func->getArg(0)));
+    } else {
+      func->addFnAttr(llvm::Attribute::ReadNone);
+      MathEmitter emitter(&builder, type);
+      builder.CreateRet(emitter.Emit(math, precision == MathPrecision::kStrict, func->getArg(0)));
+    }
+  }
+  return b->CreateCall(func, {arg});
+}
+
+}  // namespace backends
+}  // namespace cinn
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Value.h>
+
+#include <string>
+
+namespace cinn {
+namespace backends {
+
+/**
+ * The precision of the math functions of the host kernels, chosen by OptimizeOptions::math_precision for each compile.
+ *
+ * The inline polynomials are computed by the instructions of the kernel itself, so the math functions vectorize and
+ * fuse with the surrounding element-wise computation instead of calling libm lane by lane. The max errors measured
+ * over the float32 inputs are:
+ *
+ *   function | strict  | fast
+ *   exp      | 1 ulp   | 1 ulp in [-87.3, 88.3]
+ *   log      | 1 ulp   | 1 ulp for the positive normal inputs
+ *   tanh     | 1 ulp   | 5 ulp for |x| >= 1e-30
+ *   erf      | 6 ulp   | 6 ulp for |x| >= 1e-30
+ *
+ * The strict polynomials keep the NaN, infinity and denormal semantics of libm, while the fast ones assume finite
+ * normal inputs, saturate exp out of its range and compute tanh by a rational approximation instead of exp.
+ */
+enum class MathPrecision {
+  kLibm,
+  kStrict,
+  kFast,
+};
+
+//! Get the precision named "strict", "fast" or "libm".
+MathPrecision MathPrecisionFromString(const std::string &name);
+
+//! Whether `name` is the builtin intrinsic of an inline polynomial, see optim::HostInlineMathIntrinName.
+bool IsInlineMathIntrin(const std::string &name);
+
+//! Call the always inline function computing the builtin intrinsic `name` on `arg` in `precision`, the function is
+//! created on the first use for each type.
+llvm::Value *EmitInlineMath(
+    llvm::IRBuilder<> *b, llvm::Module *m, const std::string &name, llvm::Value *arg, MathPrecision precision);
+
+}  // namespace backends
+}  // namespace cinn
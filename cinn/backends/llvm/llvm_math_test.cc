@@ -0,0 +1,189 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/llvm_math.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/runtime/cinn_runtime.h"
+
+namespace cinn {
+namespace backends {
+
+namespace {
+
+//! The inputs over the magnitudes of float32 and both signs, followed by the special values.
+std::vector<float> MathInputs() {
+  std::vector<float> inputs;
+  for (int e = -40; e <= 40; e++) {
+    for (float m : {1.f, 1.1f, 1.37f, 1.5f, 1.77f, 1.9f}) {
+      float x = std::ldexp(m, e);
+      inputs.push_back(x);
+      inputs.push_back(-x);
+    }
+  }
+  for (int i = -1000; i <= 1000; i++) inputs.push_back(i * 0.01f);
+  for (float x : {0.f, -0.f, 88.f, 88.7f, -87.f, -103.f, 1e-40f, std::numeric_limits<float>::min()}) {
+    inputs.push_back(x);
+  }
+  return inputs;
+}
+
+//! Compute `math` of the inputs in `precision` by a host kernel vectorized by 16 lanes.
+std::vector<float> RunMathKernel(const std::string &name,
+                                 std::function<Expr(Expr)> math,
+                                 const std::vector<float> &inputs,
+                                 MathPrecision precision = MathPrecision::kStrict) {
+  Expr M(static_cast<int>(inputs.size()));
+  Placeholder<float> A("A", {M});
+  auto B      = Compute(
+      {M}, [&](Expr i) { return math(A(i)); }, "B");
+  auto stages = CreateStages({B});
+  stages[B]->Vectorize(0, 16);
+
+  auto fn = Lower(name, stages, {A, B});
+  Module::Builder builder("module_" + name, common::DefaultHostTarget());
+  builder.AddFunction(fn);
+
+  OptimizeOptions options;
+  options.math_precision = precision;
+  auto jit               = ExecutionEngine::Create({});
+  jit->Link(builder.Build(), options);
+  auto *fn_ptr = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(name));
+  CHECK(fn_ptr);
+
+  auto *A_buf = common::BufferBuilder(Float(32), {static_cast<int>(inputs.size())}).set_align(64).Build();
+  auto *B_buf = common::BufferBuilder(Float(32), {static_cast<int>(inputs.size())}).set_zero().set_align(64).Build();
+  std::memcpy(A_buf->memory, inputs.data(), inputs.size() * sizeof(float));
+
+  auto args = common::ArgsBuilder().Add(A_buf).Add(B_buf).Build();
+  fn_ptr(reinterpret_cast<void **>(args.data()), args.size());
+
+  auto *B_data = reinterpret_cast<float *>(B_buf->memory);
+  return std::vector<float>(B_data, B_data + inputs.size());
+}
+
+//! The distance of two floats in the units in the last place.
+int64_t UlpDistance(float a, float b) {
+  auto ordered = [](float x) {
+    int32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits < 0 ? static_cast<int64_t>(INT32_MIN) - bits : static_cast<int64_t>(bits);
+  };
+  return std::abs(ordered(a) - ordered(b));
+}
+
+struct MathCase {
+  std::string name;
+  std::function<Expr(Expr)> math;
+  std::function<double(double)> reference;
+  //! The inputs out of the domain the bound holds for are skipped, all the inputs are checked if not set.
+  std::function<bool(float)> in_domain;
+};
+
+void CheckMathPrecision(const MathCase &c, const std::string &precision, int64_t max_ulp) {
+  auto inputs  = MathInputs();
+  auto outputs = RunMathKernel(c.name + "_" + precision, c.math, inputs, MathPrecisionFromString(precision));
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (c.in_domain && !c.in_domain(inputs[i])) continue;
+    float expected = static_cast<float>(c.reference(inputs[i]));
+    ASSERT_LE(UlpDistance(outputs[i], expected), max_ulp)
+        << c.name << "(" << inputs[i] << ") = " << outputs[i] << ", expected " << expected << " in " << precision;
+  }
+}
+
+const MathCase kExp{"exp", [](Expr x) { return lang::Exp(x); }, [](double x) { return std::exp(x); }};
+const MathCase kLog{
+    "log", [](Expr x) { return lang::Log(x); }, [](double x) { return std::log(x); }, [](float x) { return x > 0.f; }};
+const MathCase kTanh{"tanh", [](Expr x) { return lang::Tanh(x); }, [](double x) { return std::tanh(x); }};
+const MathCase kErf{"erf", [](Expr x) { return lang::Erf(x); }, [](double x) { return std::erf(x); }};
+
+}  // namespace
+
+TEST(LLVMMath, strict) {
+  CheckMathPrecision(kExp, "strict", 1);
+  CheckMathPrecision(kLog, "strict", 1);
+  CheckMathPrecision(kTanh, "strict", 1);
+  CheckMathPrecision(kErf, "strict", 6);
+}
+
+TEST(LLVMMath, fast) {
+  auto normal    = [](float x) { return std::fabs(x) >= 1e-30f; };
+  MathCase exp   = kExp;
+  exp.in_domain  = [](float x) { return x >= -87.3f && x <= 88.3f; };
+  MathCase log   = kLog;
+  log.in_domain  = [](float x) { return x >= std::numeric_limits<float>::min(); };
+  MathCase tanh  = kTanh;
+  tanh.in_domain = normal;
+  MathCase erf   = kErf;
+  erf.in_domain  = normal;
+
+  CheckMathPrecision(exp, "fast", 1);
+  CheckMathPrecision(log, "fast", 1);
+  CheckMathPrecision(tanh, "fast", 5);
+  CheckMathPrecision(erf, "fast", 6);
+}
+
+TEST(LLVMMath, libm) {
+  // the bounds of glibc
+  CheckMathPrecision(kExp, "libm", 1);
+  CheckMathPrecision(kLog, "libm", 1);
+  CheckMathPrecision(kTanh, "libm", 2);
+  CheckMathPrecision(kErf, "libm", 2);
+}
+
+TEST(LLVMMath, special_values) {
+  const float inf           = std::numeric_limits<float>::infinity();
+  const float nan           = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> inputs = {inf, -inf, nan, 0.f, -1.f, 100.f, -110.f};
+
+  auto exp = RunMathKernel("exp_special", [](Expr x) { return lang::Exp(x); }, inputs);
+  EXPECT_EQ(exp[0], inf);
+  EXPECT_EQ(exp[1], 0.f);
+  EXPECT_TRUE(std::isnan(exp[2]));
+  EXPECT_EQ(exp[5], inf);
+  EXPECT_EQ(exp[6], 0.f);
+
+  auto log = RunMathKernel("log_special", [](Expr x) { return lang::Log(x); }, inputs);
+  EXPECT_EQ(log[0], inf);
+  EXPECT_TRUE(std::isnan(log[1]));
+  EXPECT_TRUE(std::isnan(log[2]));
+  EXPECT_EQ(log[3], -inf);
+  EXPECT_TRUE(std::isnan(log[4]));
+
+  auto tanh = RunMathKernel("tanh_special", [](Expr x) { return lang::Tanh(x); }, inputs);
+  EXPECT_EQ(tanh[0], 1.f);
+  EXPECT_EQ(tanh[1], -1.f);
+  EXPECT_TRUE(std::isnan(tanh[2]));
+
+  auto erf = RunMathKernel("erf_special", [](Expr x) { return lang::Erf(x); }, inputs);
+  EXPECT_NEAR(erf[0], 1.f, 1e-6);
+  EXPECT_NEAR(erf[1], -1.f, 1e-6);
+  EXPECT_TRUE(std::isnan(erf[2]));
+  EXPECT_EQ(erf[3], 0.f);
+}
+
+}  // namespace backends
+}  // namespace cinn
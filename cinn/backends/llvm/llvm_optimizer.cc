@@ -15,6 +15,7 @@
 #include "cinn/backends/llvm/llvm_optimizer.h"
 
 #include <glog/logging.h>
+#include <llvm/ADT/Any.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CGSCCPassManager.h>
 #include <llvm/AsmParser/Parser.h>
@@ -24,6 +25,7 @@
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/LambdaResolver.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
@@ -31,6 +33,7 @@
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/PassInstrumentation.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Passes/PassBuilder.h>
@@ -54,113 +57,113 @@
 #include <llvm/Transforms/Vectorize.h>
 
 #include <algorithm>
+#include <chrono>  // NOLINT
 #include <memory>
 #include <string>
-#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "llvm/Support/CodeGen.h"
 
 namespace cinn::backends {
 
-namespace {
-template <typename PassManagerT>
-class CustomPassManager : public PassManagerT {
- public:
-  template <typename... Ts>
-  explicit CustomPassManager(bool print_passes, Ts &&...ts)
-      : PassManagerT(std::forward<Ts>(ts)...), print_passes_(print_passes) {}
-
-  void add(llvm::Pass *pass) override {
-    if (print_passes_) {
-      if (is_function_pass_manager_) {
-        VLOG(1) << "llvm run function pass[" << std::string(pass->getPassName()) << "]";
-      }
-
-      if (is_module_pass_manager_) {
-        VLOG(1) << "llvm run module pass[" << std::string(pass->getPassName()) << "]";
-      }
-    }
-    // static bool add_pass = true;
-    // if (add_pass) {
-    //  PassManagerT::add(pass);
-    //}
-
-    // if (std::string(pass->getPassName()) == "Loop Vectorization") {
-    //  return;
-    //}
-    PassManagerT::add(pass);
-  }
-
-  void run(llvm::Function &f) {  // NOLINT
-    if (is_function_pass_manager_) {
-      PassManagerT::run(f);
-    }
+OptimizeProfile OptimizeProfileFromString(const std::string &name) {
+  if (name == "fast-compile") {
+    return OptimizeProfile::kFastCompile;
+  } else if (name == "balanced") {
+    return OptimizeProfile::kBalanced;
+  } else if (name == "max-perf") {
+    return OptimizeProfile::kMaxPerf;
   }
+  LOG(FATAL) << "Unknown LLVM optimize profile: " << name << ", it should be fast-compile, balanced or max-perf";
+  return OptimizeProfile::kMaxPerf;
+}
 
-  void run(llvm::Module &m) {  // NOLINT
-    if (is_module_pass_manager_) {
-      PassManagerT::run(m);
-    }
-  }
-
- private:
-  static constexpr bool is_function_pass_manager_ =
-      std::is_same<llvm::legacy::FunctionPassManager, PassManagerT>::value;
-  static constexpr bool is_module_pass_manager_ = std::is_same<llvm::legacy::PassManager, PassManagerT>::value;
-  bool print_passes_;
-};
-
-using CustomFunctionPassManager = CustomPassManager<llvm::legacy::FunctionPassManager>;
-using CustomModulePassManager   = CustomPassManager<llvm::legacy::PassManager>;
+namespace {
+OptimizeOptions OptimizeOptionsOfLevel(int opt_level) {
+  OptimizeOptions options;
+  options.profile = opt_level >= 3   ? OptimizeProfile::kMaxPerf
+                    : opt_level == 2 ? OptimizeProfile::kBalanced
+                                     : OptimizeProfile::kFastCompile;
+  return options;
+}
 }  // namespace
 
 LLVMModuleOptimizer::LLVMModuleOptimizer(llvm::TargetMachine *machine,
                                          int opt_level,
                                          llvm::FastMathFlags fast_math_flags,
                                          bool print_passes)
-    : opt_level_(opt_level), print_passes_(print_passes), machine_(machine) {}
+    : LLVMModuleOptimizer(machine, OptimizeOptionsOfLevel(opt_level), fast_math_flags, print_passes) {}
+
+LLVMModuleOptimizer::LLVMModuleOptimizer(llvm::TargetMachine *machine,
+                                         const OptimizeOptions &options,
+                                         llvm::FastMathFlags fast_math_flags,
+                                         bool print_passes)
+    : machine_(machine), options_(options), print_passes_(print_passes) {}
 
 void LLVMModuleOptimizer::operator()(llvm::Module *m) {
-  auto machine =
-      std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
-  auto fpm = std::make_unique<CustomFunctionPassManager>(print_passes_, m);
-  // fpm->add(llvm::createTargetTransformInfoWrapperPass(llvm::TargetIRAnalysis()));
-  // fpm->add(llvm::createInstructionCombiningPass());
-  // fpm->add(llvm::createReassociatePass());
-  // fpm->add(llvm::createGVNPass());
-  // fpm->add(llvm::createCFGSimplificationPass());
-  // fpm->add(llvm::createSROAPass());
-  // fpm->add(llvm::createEarlyCSEPass());
-  // fpm->add(llvm::createLowerExpectIntrinsicPass());
-  // fpm->add(llvm::createCallSiteSplittingPass());
-  // fpm->add(llvm::createLoopVectorizePass());
-  // fpm->add(llvm::createSLPVectorizerPass());
-  // fpm->add(llvm::createLoadStoreVectorizerPass());
-  // fpm->add(llvm::createLoopUnrollPass());
-
-  auto mpm = std::make_unique<CustomModulePassManager>(print_passes_);
-  // mpm->add(llvm::createTargetTransformInfoWrapperPass(llvm::TargetIRAnalysis()));
-  // LOG(INFO) << "llvm run pass: target machine: name[" << machine_->getTarget().getName() << "]";
-  // LOG(INFO) << "llvm run pass: target machine: cpu[" << machine_->getTargetCPU().str() << "]";
-  fpm->add(llvm::createTargetTransformInfoWrapperPass(machine->getTargetIRAnalysis()));
-  mpm->add(llvm::createTargetTransformInfoWrapperPass(machine->getTargetIRAnalysis()));
-  auto builder           = std::make_unique<llvm::PassManagerBuilder>();
-  builder->OptLevel      = opt_level_;
-  builder->Inliner       = llvm::createFunctionInliningPass();
-  builder->LoopVectorize = true;
-  builder->SLPVectorize  = true;
-#if LLVM_VERSION_MAJOR >= 11
-  machine->adjustPassManager(*builder);
-#endif
-  builder->populateFunctionPassManager(*fpm);
-  builder->populateModulePassManager(*mpm);
-
-  fpm->doInitialization();
-  std::for_each(m->begin(), m->end(), [&fpm](auto &fn) { fpm->run(fn); });
-  fpm->doFinalization();
-
-  mpm->run(*m);
+  std::unique_ptr<llvm::TargetMachine> host_machine;
+  auto *machine = machine_;
+  if (!machine) {
+    host_machine =
+        llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine());
+    machine = host_machine.get();
+  }
+
+  // The loop nests of CINN are scheduled already, so the light profiles drop the loop transforms costing the most.
+  llvm::PipelineTuningOptions tuning;
+  tuning.LoopUnrolling     = options_.profile != OptimizeProfile::kFastCompile;
+  tuning.LoopInterleaving  = options_.profile != OptimizeProfile::kFastCompile;
+  tuning.LoopVectorization = options_.profile != OptimizeProfile::kFastCompile && !options_.skip_loop_vectorize;
+  tuning.SLPVectorization  = options_.profile == OptimizeProfile::kMaxPerf;
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<std::pair<std::string, Clock::time_point>> running_passes;
+  auto stop_pass = [&](llvm::StringRef pass) {
+    if (running_passes.empty()) return;
+    auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - running_passes.back().second);
+    pass_times_ms_[running_passes.back().first] += elapsed.count();
+    running_passes.pop_back();
+  };
+  llvm::PassInstrumentationCallbacks instrumentation;
+  instrumentation.registerBeforePassCallback([&](llvm::StringRef pass, llvm::Any) {
+    if (print_passes_) {
+      VLOG(1) << "llvm run pass[" << pass.str() << "]";
+    }
+    if (options_.time_passes) {
+      running_passes.emplace_back(pass.str(), Clock::now());
+    }
+    return true;
+  });
+  if (options_.time_passes) {
+    instrumentation.registerAfterPassCallback([&](llvm::StringRef pass, llvm::Any) { stop_pass(pass); });
+    instrumentation.registerAfterPassInvalidatedCallback([&](llvm::StringRef pass) { stop_pass(pass); });
+  }
+
+  llvm::PassBuilder builder(machine, tuning, llvm::None, &instrumentation);
+  llvm::LoopAnalysisManager lam;
+  llvm::FunctionAnalysisManager fam;
+  llvm::CGSCCAnalysisManager cgam;
+  llvm::ModuleAnalysisManager mam;
+  builder.registerModuleAnalyses(mam);
+  builder.registerCGSCCAnalyses(cgam);
+  builder.registerFunctionAnalyses(fam);
+  builder.registerLoopAnalyses(lam);
+  builder.crossRegisterProxies(lam, fam, cgam, mam);
+
+  auto level = options_.profile == OptimizeProfile::kMaxPerf    ? llvm::PassBuilder::OptimizationLevel::O3
+               : options_.profile == OptimizeProfile::kBalanced ? llvm::PassBuilder::OptimizationLevel::O2
+                                                                : llvm::PassBuilder::OptimizationLevel::O1;
+  llvm::ModulePassManager mpm = builder.buildPerModuleDefaultPipeline(level);
+  mpm.run(*m, mam);
+
+  if (options_.time_passes) {
+    std::vector<std::pair<std::string, double>> times(pass_times_ms_.begin(), pass_times_ms_.end());
+    std::sort(times.begin(), times.end(), [](const auto &a, const auto &b) { return a.second > b.second; });
+    for (int i = 0; i < std::min<int>(times.size(), 20); ++i) {
+      LOG(INFO) << "llvm pass[" << times[i].first << "] takes " << times[i].second << " ms";
+    }
+  }
 }
 
 }  // namespace cinn::backends
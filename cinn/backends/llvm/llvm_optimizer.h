@@ -21,23 +21,58 @@
 #include <llvm/Target/TargetMachine.h>
 
 #include <functional>
+#include <map>
+#include <string>
+
+#include "cinn/backends/llvm/llvm_math.h"
 
 namespace cinn::backends {
 
-// TODO(fc500110): define class OptimizeOptions
+//! The named pipelines of LLVMModuleOptimizer, which trade the performance of the code for the compile time.
+enum class OptimizeProfile {
+  //! The O1 pipeline without vectorization or unrolling, e.g. for the candidates measured by the auto-tuner.
+  kFastCompile,
+  //! The O2 pipeline with the loop vectorization.
+  kBalanced,
+  //! The O3 pipeline with the loop and SLP vectorization, for the final build.
+  kMaxPerf,
+};
+
+//! Get the profile named "fast-compile", "balanced" or "max-perf".
+OptimizeProfile OptimizeProfileFromString(const std::string &name);
+
+struct OptimizeOptions {
+  OptimizeProfile profile{OptimizeProfile::kMaxPerf};
+  //! Skip the loop vectorization, which does nothing but costs compile time when CINN has vectorized the loops.
+  bool skip_loop_vectorize{false};
+  //! Time each pass and log the slowest ones, see LLVMModuleOptimizer::pass_times_ms.
+  bool time_passes{false};
+  //! The precision of exp, log, tanh and erf of float32 in the host kernels, applied when the code is emitted.
+  MathPrecision math_precision{MathPrecision::kStrict};
+};
 
 // llvm module optimizer
 class LLVMModuleOptimizer final {
  public:
+  //! Map \p opt_level to a profile: 3 to max-perf, 2 to balanced and the lower ones to fast-compile.
   explicit LLVMModuleOptimizer(llvm::TargetMachine *machine,
                                int opt_level,
                                llvm::FastMathFlags fast_math_flags,
                                bool print_passes = false);
+  LLVMModuleOptimizer(llvm::TargetMachine *machine,
+                      const OptimizeOptions &options,
+                      llvm::FastMathFlags fast_math_flags = {},
+                      bool print_passes                   = false);
   void operator()(llvm::Module *m);
 
+  //! The accumulated time of each pass run with OptimizeOptions::time_passes, the time of a pass manager or an
+  //! adaptor includes the passes it runs.
+  const std::map<std::string, double> &pass_times_ms() const { return pass_times_ms_; }
+
  private:
   llvm::TargetMachine *machine_;
-  int opt_level_{};
+  OptimizeOptions options_;
   bool print_passes_{};
+  std::map<std::string, double> pass_times_ms_;
 };
 }  // namespace cinn::backends
@@ -14,8 +14,12 @@
 
 #include "cinn/common/cas.h"
 
+#include <gflags/gflags.h>
+
 #include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -30,12 +34,235 @@
 #include "cinn/optim/ir_copy.h"
 #include "cinn/utils/string.h"
 
+DECLARE_int32(cinn_cas_simplify_cache_capacity);
+DECLARE_int64(cinn_cas_simplify_step_budget);
+
 namespace cinn {
 namespace common {
 using namespace ir;  // NOLINT
 
-Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
-  VLOG(7) << "Begin AutoSimplify: " << u;
+namespace {
+
+//! Serialize a pure index expression into `fp` and collect the variables it references into `vars`. Return false when
+//! the expression holds a node (e.g. Load or Call) whose identity is not fully described by its serialized form, such
+//! expressions are not cached.
+bool FingerprintIndexExpr(const Expr& e, std::string* fp, absl::flat_hash_map<std::string, Expr>* vars) {
+  if (!e.defined()) return false;
+  auto append_type = [fp](const Type& t) {
+    fp->append(std::to_string(static_cast<int>(t.type())));
+    fp->push_back('.');
+    fp->append(std::to_string(t.bits()));
+    fp->push_back('x');
+    fp->append(std::to_string(t.lanes()));
+  };
+
+  switch (e.node_type()) {
+    case IrNodeTy::IntImm:
+      fp->push_back('i');
+      append_type(e.type());
+      fp->push_back(':');
+      fp->append(std::to_string(e.As<IntImm>()->value));
+      return true;
+    case IrNodeTy::UIntImm:
+      fp->push_back('u');
+      append_type(e.type());
+      fp->push_back(':');
+      fp->append(std::to_string(e.As<UIntImm>()->value));
+      return true;
+    case IrNodeTy::_Var_: {
+      auto* var = e.As<_Var_>();
+      auto it   = vars->find(var->name);
+      // Two different variables sharing a name can not be told apart by the fingerprint.
+      if (it != vars->end() && it->second.type() != e.type()) return false;
+      vars->emplace(var->name, e);
+      fp->push_back('v');
+      append_type(e.type());
+      fp->push_back(':');
+      fp->append(var->name);
+      fp->push_back(';');
+      return true;
+    }
+    case IrNodeTy::Add:
+    case IrNodeTy::Sub:
+    case IrNodeTy::Mul:
+    case IrNodeTy::Div:
+    case IrNodeTy::Mod:
+    case IrNodeTy::Min:
+    case IrNodeTy::Max:
+    case IrNodeTy::EQ:
+    case IrNodeTy::NE:
+    case IrNodeTy::LT:
+    case IrNodeTy::LE:
+    case IrNodeTy::GT:
+    case IrNodeTy::GE:
+    case IrNodeTy::And:
+    case IrNodeTy::Or:
+    case IrNodeTy::Not:
+    case IrNodeTy::Minus:
+    case IrNodeTy::Cast:
+    case IrNodeTy::Sum:
+    case IrNodeTy::Product:
+    case IrNodeTy::FracOp: {
+      fp->push_back('(');
+      fp->append(std::to_string(static_cast<int>(e.node_type())));
+      fp->push_back('#');
+      append_type(e.type());
+      for (auto& operand : e->operands) {
+        fp->push_back(' ');
+        if (!FingerprintIndexExpr(operand, fp, vars)) return false;
+      }
+      fp->push_back(')');
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+//! Build the cache key of AutoSimplify(u, var_intervals). Only the intervals reachable from the variables of `u`
+//! (directly, or through the bound expressions of other intervals) take part in the key, so the same index expression
+//! hits the cache in every function of a module no matter which other loop variables are in scope.
+bool MakeAutoSimplifyCacheKey(Expr u,
+                              const cas_intervals_t& var_intervals,
+                              std::string* key,
+                              absl::flat_hash_map<std::string, Expr>* vars) {
+  if (!FingerprintIndexExpr(u, key, vars)) return false;
+
+  std::vector<std::string> pending;
+  for (auto& item : *vars) pending.push_back(item.first);
+  std::set<std::string> relevant;
+  while (!pending.empty()) {
+    std::string name = pending.back();
+    pending.pop_back();
+    if (relevant.count(name) || !var_intervals.count(name)) continue;
+    relevant.insert(name);
+    auto& interval = var_intervals.at(name);
+    if (interval.e_l.defined() && interval.e_r.defined()) {
+      absl::flat_hash_map<std::string, Expr> bound_vars;
+      std::string unused;
+      if (!FingerprintIndexExpr(interval.e_l, &unused, &bound_vars)) return false;
+      if (!FingerprintIndexExpr(interval.e_r, &unused, &bound_vars)) return false;
+      for (auto& item : bound_vars) {
+        if (vars->count(item.first) && vars->at(item.first).type() != item.second.type()) return false;
+        vars->emplace(item.first, item.second);
+        pending.push_back(item.first);
+      }
+    }
+  }
+
+  // std::set keeps the interval part of the key in a canonical order.
+  for (auto& name : relevant) {
+    auto& interval = var_intervals.at(name);
+    key->append("|");
+    key->append(name);
+    if (interval.e_l.defined() && interval.e_r.defined()) {
+      key->append("=[");
+      FingerprintIndexExpr(interval.e_l, key, vars);
+      key->append(",");
+      FingerprintIndexExpr(interval.e_r, key, vars);
+      key->append("]");
+    } else {
+      key->append("=[" + std::to_string(interval.l) + "," + std::to_string(interval.r) + "]");
+    }
+  }
+  return true;
+}
+
+//! Replace the variables of a cached result with the caller's variables of the same name.
+Expr RebindCachedVars(Expr cached, const absl::flat_hash_map<std::string, Expr>& vars) {
+  Expr copied = optim::IRCopy(cached);
+  struct Mutator : public ir::IRMutator<ir::Expr*> {
+    explicit Mutator(const absl::flat_hash_map<std::string, Expr>& vars) : vars(vars) {}
+    void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+   private:
+    void Visit(const _Var_* op, Expr* expr) override {
+      auto it = vars.find(op->name);
+      if (it != vars.end()) *expr = it->second;
+    }
+    const absl::flat_hash_map<std::string, Expr>& vars;
+  };
+  Mutator{vars}(&copied);
+  return copied;
+}
+
+class AutoSimplifyCache {
+ public:
+  static AutoSimplifyCache& Global() {
+    static AutoSimplifyCache x;
+    return x;
+  }
+
+  bool Lookup(const std::string& key, Expr* result) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      ++stats_.misses;
+      return false;
+    }
+    ++stats_.hits;
+    *result = it->second;
+    return true;
+  }
+
+  void Insert(const std::string& key, Expr result, int capacity) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    // Entries are cheap to rebuild, so dropping the whole table keeps the memory bounded without LRU bookkeeping.
+    if (cache_.size() >= static_cast<size_t>(capacity)) cache_.clear();
+    cache_.emplace(key, result);
+  }
+
+  CasSimplifyCacheStats Stats() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    CasSimplifyCacheStats stats = stats_;
+    stats.size                  = cache_.size();
+    return stats;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    cache_.clear();
+    stats_ = CasSimplifyCacheStats();
+  }
+
+ private:
+  AutoSimplifyCache() = default;
+
+  std::mutex mtx_;
+  absl::flat_hash_map<std::string, Expr> cache_;
+  CasSimplifyCacheStats stats_;
+};
+
+//! The step budget of the outermost simplification running on this thread.
+struct CasSimplifyBudget {
+  bool active{false};
+  int64_t remaining{0};
+  bool exhausted{false};
+};
+
+thread_local CasSimplifyBudget cas_simplify_budget;
+
+//! Install a step budget for the duration of an outermost CAS simplification, nested ones share it.
+class CasSimplifyBudgetGuard {
+ public:
+  CasSimplifyBudgetGuard() {
+    if (cas_simplify_budget.active || FLAGS_cinn_cas_simplify_step_budget <= 0) return;
+    owner_                        = true;
+    cas_simplify_budget.active    = true;
+    cas_simplify_budget.remaining = FLAGS_cinn_cas_simplify_step_budget;
+    cas_simplify_budget.exhausted = false;
+  }
+  ~CasSimplifyBudgetGuard() {
+    if (owner_) cas_simplify_budget = CasSimplifyBudget();
+  }
+
+  bool exhausted() const { return cas_simplify_budget.exhausted; }
+
+ private:
+  bool owner_{false};
+};
+
+Expr AutoSimplifyImpl(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
   u = detail::ConvertCinnToCAS(u);
   absl::flat_hash_map<std::string, CasInterval> s_var_intervals;
   for (auto& item : var_intervals) {
@@ -49,10 +276,49 @@ Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& v
   }
   u = CasSimplify(u, s_var_intervals);
   u = detail::ConvertCasToCinn(u);
+  return u;
+}
+
+}  // namespace
+
+Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
+  VLOG(7) << "Begin AutoSimplify: " << u;
+  const int capacity = FLAGS_cinn_cas_simplify_cache_capacity;
+  std::string key;
+  absl::flat_hash_map<std::string, Expr> vars;
+  bool cacheable = capacity > 0 && MakeAutoSimplifyCacheKey(u, var_intervals, &key, &vars);
+
+  Expr cached;
+  if (cacheable && AutoSimplifyCache::Global().Lookup(key, &cached)) {
+    u = RebindCachedVars(cached, vars);
+    VLOG(7) << "End AutoSimplify(cached) " << u;
+    return u;
+  }
+
+  CasSimplifyBudgetGuard budget;
+  // AutoSimplifyImpl works on a copy, so the input is kept intact to be returned when the budget runs out.
+  Expr origin     = u;
+  Expr simplified = AutoSimplifyImpl(u, var_intervals);
+  if (budget.exhausted()) {
+    // A partially simplified expression is not canonical and may compare unequal to an equivalent one, so the input
+    // is returned as it is.
+    VLOG(3) << "AutoSimplify ran out of its step budget " << FLAGS_cinn_cas_simplify_step_budget
+            << ", return the input expression " << origin;
+    return origin;
+  }
+  u = simplified;
+  if (cacheable) {
+    // Store a private copy, the caller is free to mutate the returned expression in place.
+    AutoSimplifyCache::Global().Insert(key, optim::IRCopy(u), capacity);
+  }
   VLOG(7) << "End AutoSimplify " << u;
   return u;
 }
 
+CasSimplifyCacheStats GetCasSimplifyCacheStats() { return AutoSimplifyCache::Global().Stats(); }
+
+void ClearCasSimplifyCache() { AutoSimplifyCache::Global().Clear(); }
+
 int gcd(int a, int b) {
   // Everything divides 0
   if (a == 0) return b;
@@ -2136,6 +2402,16 @@ Expr CasSimplifyMutator::SimplifyCond(Expr u) {
 }  // namespace detail
 
 Expr CasSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
+  CasSimplifyBudgetGuard budget;
+  if (cas_simplify_budget.active) {
+    // Once the budget is spent, every pending sub-simplification keeps its current (equivalent) form to stop the
+    // search, and the outermost AutoSimplify discards the partial result.
+    if (cas_simplify_budget.remaining <= 0) {
+      cas_simplify_budget.exhausted = true;
+      return u;
+    }
+    --cas_simplify_budget.remaining;
+  }
   return detail::CasSimplifyMutator(var_intervals)(u);
 }
 
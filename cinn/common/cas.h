@@ -82,8 +82,30 @@ struct CasInterval {
 
 using cas_intervals_t = absl::flat_hash_map<std::string, CasInterval>;
 
+/**
+ * \brief Simplify an expression with the CAS.
+ *
+ * Results of pure index expressions are memoized by a fingerprint of the expression and the intervals of the variables
+ * it depends on, so the same index expression is only simplified once across all the functions of a module. The
+ * capacity of the cache is set by FLAGS_cinn_cas_simplify_cache_capacity.
+ *
+ * Each call spends at most FLAGS_cinn_cas_simplify_step_budget simplification steps, when the budget runs out the input
+ * expression is returned unchanged rather than a partially normalized one.
+ */
 Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals = {});
 
+//! Statistics of the AutoSimplify result cache.
+struct CasSimplifyCacheStats {
+  int64_t hits{0};
+  int64_t misses{0};
+  int64_t size{0};
+};
+
+CasSimplifyCacheStats GetCasSimplifyCacheStats();
+
+//! Drop all the cached AutoSimplify results and reset the statistics.
+void ClearCasSimplifyCache();
+
 //! Simplify a CAS expression.
 Expr CasSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals = {});
 
@@ -14,6 +14,7 @@
 
 #include "cinn/common/cas.h"
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 #include "cinn/cinn.h"
@@ -22,6 +23,10 @@
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/utils/string.h"
+#include "cinn/utils/timer.h"
+
+DECLARE_int32(cinn_cas_simplify_cache_capacity);
+DECLARE_int64(cinn_cas_simplify_step_budget);
 
 namespace cinn {
 namespace common {
@@ -420,5 +425,95 @@ TEST(CAS, cond) {
   }
 }
 
+TEST(CAS, AutoSimplifyCache) {
+  ClearCasSimplifyCache();
+  auto make_expr = [](Var x, Var y) { return (Expr(x) * 32 + y) / 32; };
+
+  Var x0 = ir::_Var_::Make("x", Int(32));
+  Var y0 = ir::_Var_::Make("y", Int(32));
+  cas_intervals_t intervals0;
+  intervals0.emplace("y", CasInterval(0, 31));
+  // The interval of an unrelated variable should not take part in the cache key.
+  intervals0.emplace("unused", CasInterval(0, 7));
+  auto res0 = AutoSimplify(make_expr(x0, y0), intervals0);
+  EXPECT_EQ(GetStreamCnt(res0), "x");
+  EXPECT_EQ(GetCasSimplifyCacheStats().misses, 1);
+  EXPECT_EQ(GetCasSimplifyCacheStats().hits, 0);
+
+  // Other variables with the same names and intervals, e.g. from another function of the module, hit the cache.
+  Var x1 = ir::_Var_::Make("x", Int(32));
+  Var y1 = ir::_Var_::Make("y", Int(32));
+  cas_intervals_t intervals1;
+  intervals1.emplace("y", CasInterval(0, 31));
+  auto res1 = AutoSimplify(make_expr(x1, y1), intervals1);
+  EXPECT_EQ(GetStreamCnt(res1), "x");
+  EXPECT_EQ(GetCasSimplifyCacheStats().hits, 1);
+  // The cached result is rebound to the caller's variable.
+  EXPECT_TRUE(res1.same_as(Expr(x1)));
+
+  // A different interval is a different key.
+  cas_intervals_t intervals2;
+  intervals2.emplace("y", CasInterval(0, 63));
+  AutoSimplify(make_expr(x1, y1), intervals2);
+  EXPECT_EQ(GetCasSimplifyCacheStats().misses, 2);
+  EXPECT_EQ(GetCasSimplifyCacheStats().size, 2);
+
+  // Expressions holding a Load are never cached.
+  Placeholder<float> A("A", {Expr(16)});
+  AutoSimplify(A(x1) + 0);
+  EXPECT_EQ(GetCasSimplifyCacheStats().size, 2);
+
+  ClearCasSimplifyCache();
+  EXPECT_EQ(GetCasSimplifyCacheStats().size, 0);
+}
+
+TEST(CAS, AutoSimplifyCacheBenchmark) {
+  Var i = ir::_Var_::Make("i", Int(32));
+  Var j = ir::_Var_::Make("j", Int(32));
+  cas_intervals_t intervals;
+  intervals.emplace("i", CasInterval(0, 1023));
+  intervals.emplace("j", CasInterval(0, 31));
+  auto make_expr = [&]() { return ((Expr(i) * 32 + j) / 32) * 32 + (Expr(i) * 32 + j) % 32; };
+
+  auto run = [&](int capacity) {
+    int old_capacity                       = FLAGS_cinn_cas_simplify_cache_capacity;
+    FLAGS_cinn_cas_simplify_cache_capacity = capacity;
+    ClearCasSimplifyCache();
+    utils::Timer timer;
+    timer.Start();
+    Expr res;
+    for (int k = 0; k < 200; ++k) res = AutoSimplify(make_expr(), intervals);
+    float cost                             = timer.Stop();
+    FLAGS_cinn_cas_simplify_cache_capacity = old_capacity;
+    LOG(INFO) << "AutoSimplify x200 with cache capacity " << capacity << " costs " << cost << " ms, get " << res;
+    return GetStreamCnt(res);
+  };
+  EXPECT_EQ(run(0), run(1024));
+  ClearCasSimplifyCache();
+}
+
+TEST(CAS, AutoSimplifyStepBudget) {
+  ClearCasSimplifyCache();
+  Var x = ir::_Var_::Make("x", Int(32));
+  Var y = ir::_Var_::Make("y", Int(32));
+  cas_intervals_t intervals;
+  intervals.emplace("y", CasInterval(0, 31));
+  auto make_expr = [&]() { return (Expr(x) * 32 + y) / 32; };
+
+  int64_t old_budget                  = FLAGS_cinn_cas_simplify_step_budget;
+  FLAGS_cinn_cas_simplify_step_budget = 1;
+  auto partial                        = AutoSimplify(make_expr(), intervals);
+  FLAGS_cinn_cas_simplify_step_budget = old_budget;
+  // The input is returned unchanged instead of a partially simplified expression.
+  EXPECT_EQ(GetStreamCnt(partial), GetStreamCnt(make_expr()));
+  // A result cut off by the budget is not cached.
+  EXPECT_EQ(GetCasSimplifyCacheStats().size, 0);
+
+  auto full = AutoSimplify(make_expr(), intervals);
+  EXPECT_EQ(GetStreamCnt(full), "x");
+  EXPECT_EQ(GetCasSimplifyCacheStats().size, 1);
+  ClearCasSimplifyCache();
+}
+
 }  // namespace common
 }  // namespace cinn
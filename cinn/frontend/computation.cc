@@ -14,6 +14,9 @@
 
 #include "cinn/frontend/computation.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "cinn/frontend/optimize.h"
 #include "cinn/frontend/program_pass.h"
 #include "cinn/hlir/framework/graph.h"
@@ -219,6 +222,36 @@ void CinnComputation::GetTensorData(const std::string &tname, void *data, size_t
   GetTensorData(t, data, size);
 }
 
+void CinnComputation::BindTensorData(hlir::framework::Tensor &t, void *data, size_t size, std::shared_ptr<void> holder) {
+  CHECK_EQ(size, t->shape().numel() * t->type().bytes());
+  // The kernels assume that an output doesn't overlap the other arguments, which is what the host codegen tells LLVM
+  // when FLAGS_cinn_llvm_buffer_noalias is on, so an output bound to the memory of another argument is rejected.
+  auto is_output   = [&](const hlir::framework::Tensor &tensor) {
+    return std::find(context_->outputs.begin(), context_->outputs.end(), tensor) != context_->outputs.end();
+  };
+  auto *data_begin = static_cast<const char *>(data);
+  for (auto *args : {&context_->inputs, &context_->outputs}) {
+    for (auto &other : *args) {
+      // the tensors sharing one buffer by the compiler are bound together
+      if (other->get_buffer() == t->get_buffer() || (!is_output(t) && !is_output(other))) continue;
+      auto *other_begin = static_cast<const char *>(other->buffer()->memory);
+      size_t other_size = other->shape().numel() * other->type().bytes();
+      CHECK(other_begin == nullptr || data_begin + size <= other_begin || other_begin + other_size <= data_begin)
+          << "Can not bind an output to the memory overlapping another argument of the computation";
+    }
+  }
+  // The buffer is updated in place, so the instructions and the tensors sharing it read the new memory.
+  t->ShareExternalData(data, t->type(), context_->target, std::move(holder));
+}
+
+void CinnComputation::BindTensorData(const std::string &tname,
+                                     void *data,
+                                     size_t size,
+                                     std::shared_ptr<void> holder) {
+  hlir::framework::Tensor t = GetTensor(tname);
+  BindTensorData(t, data, size, std::move(holder));
+}
+
 std::vector<hlir::framework::Tensor> CinnComputation::GetInputTensors() { return context_->inputs; }
 
 std::vector<hlir::framework::Tensor> CinnComputation::GetOutputTensors() { return context_->outputs; }
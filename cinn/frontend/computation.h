@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <iostream>
+#include <memory>
 
 #include "cinn/frontend/net_builder.h"
 #include "cinn/frontend/syntax.h"
@@ -148,6 +149,25 @@ class CinnComputation {
    */
   void GetTensorData(const std::string &tname, void *data, size_t size);
 
+  /**
+   * bind a tensor to user specified buffer without copying, the following executions read and write the buffer
+   * directly. the buffer on host should be aligned to 32 bytes as the kernels assume, and an output should not overlap
+   * the buffers of the other inputs and outputs.
+   * @param t the tensor
+   * @param data address of the memory buffer, which is on the device of the target
+   * @param size size of the memory buffer
+   * @param holder keeps the memory buffer alive until the tensor is bound to another buffer or destroyed
+   */
+  void BindTensorData(hlir::framework::Tensor &t, void *data, size_t size, std::shared_ptr<void> holder = nullptr);
+  /**
+   * bind a tensor (specified by it's name) to user specified buffer without copying.
+   * @param tname name of the tensor
+   * @param data address of the memory buffer, which is on the device of the target
+   * @param size size of the memory buffer
+   * @param holder keeps the memory buffer alive until the tensor is bound to another buffer or destroyed
+   */
+  void BindTensorData(const std::string &tname, void *data, size_t size, std::shared_ptr<void> holder = nullptr);
+
   /**
    * run the compiled program
    */
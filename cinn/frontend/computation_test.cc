@@ -102,6 +102,34 @@ TEST(cinn_computation, basic_cpu) {
   }
 }
 
+TEST(cinn_computation, bind_overlapping_tensors) {
+  NetBuilder builder("bind_overlapping");
+  constexpr int M = 32;
+  constexpr int N = 24;
+
+  auto a = builder.CreateInput(Float(32), {M, N}, "A");
+  auto b = builder.CreateInput(Float(32), {M, N}, "B");
+  auto c = builder.Add(a, b);
+
+  auto target = common::DefaultHostTarget();
+  auto comp   = CinnComputation::BuildAndCompile(target, builder);
+  std::vector<float> hostA(M * N, 1.f);
+  std::vector<float> hostB(M * N, 2.f);
+  std::vector<float> hostC(M * N);
+  size_t size = M * N * sizeof(float);
+  comp->BindTensorData("A", hostA.data(), size);
+  comp->BindTensorData("B", hostB.data(), size);
+  // the inputs may share memory, but the output may not overlap any of them
+  comp->BindTensorData("B", hostA.data(), size);
+  ASSERT_DEATH(comp->BindTensorData(c->id, hostA.data(), size), "overlapping");
+  ASSERT_DEATH(comp->BindTensorData(c->id, hostA.data() + M, size), "overlapping");
+  comp->BindTensorData(c->id, hostC.data(), size);
+  comp->Execute();
+  for (int i = 0; i < M * N; i++) {
+    ASSERT_NEAR(hostC[i], 2.f, 1e-5);
+  }
+}
+
 #ifdef CINN_WITH_CUDA
 TEST(cinn_computation, basic_gpu) {
   NetBuilder builder("basic");
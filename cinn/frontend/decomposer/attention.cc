@@ -0,0 +1,88 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <limits>
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+namespace {
+
+// Broadcast the trailing aligned `x` to `shape`.
+Variable BroadcastTrailing(NetBuilder* builder, const Variable& x, const std::vector<int>& shape) {
+  if (x->shape == shape) {
+    return x;
+  }
+  CHECK_LE(x->shape.size(), shape.size()) << "Can not broadcast " << x->id << " to a lower rank";
+  std::vector<int> axes;
+  for (int i = 0; i < x->shape.size(); ++i) {
+    axes.push_back(shape.size() - x->shape.size() + i);
+  }
+  return builder->BroadcastTo(x, shape, axes);
+}
+
+}  // namespace
+
+void attention(const Instruction& instr, const DecomposerContext& context) {
+  CHECK(instr->inputs.size() == 3UL || instr->inputs.size() == 4UL)
+      << "The " << instr->op_type << " takes q, k, v and an optional mask";
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto q              = instr->inputs[0];
+  auto k              = instr->inputs[1];
+  auto v              = instr->inputs[2];
+  bool causal         = instr.GetAttrs<bool>("causal");
+  NetBuilder* builder = context.builder();
+  // the scale is optional, 1 / sqrt(head_dim) by default
+  float scale = 1.0f / std::sqrt(static_cast<float>(q->shape.back()));
+  if (instr->attrs.count("scale")) {
+    scale = instr.GetAttrs<float>("scale");
+    CHECK(std::isfinite(scale) && scale > 0.0f) << "The scale of attention should be positive, but received " << scale;
+  }
+
+  auto scores       = builder->Matmul(q, k, false, true, scale);
+  const auto& shape = scores->shape;
+  if (instr->inputs.size() == 4UL) {
+    scores = builder->Add(scores, BroadcastTrailing(builder, instr->inputs[3], shape));
+  }
+  if (causal) {
+    int seq_q = shape[shape.size() - 2], seq_kv = shape.back();
+    std::vector<std::vector<float>> causal_mask(seq_q, std::vector<float>(seq_kv, 0.0f));
+    for (int i = 0; i < seq_q; ++i) {
+      for (int j = i + seq_kv - seq_q + 1; j < seq_kv; ++j) {
+        causal_mask[i][j] = std::numeric_limits<float>::lowest();
+      }
+    }
+    auto mask = builder->Constant(causal_mask, common::UniqName("causal_mask"), common::Type2Str(scores->type));
+    scores    = builder->Add(scores, BroadcastTrailing(builder, mask, shape));
+  }
+  auto probs = builder->Softmax(scores, {-1});
+  auto out   = builder->Matmul(probs, v);
+
+  context.MapOutToOrigin(out, instr->outputs[0]);
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(attention_decomposer) {
+  // The host target lowers attention natively with tiled online softmax, see StrategyForAttention.
+  CINN_DECOMPOSER_REGISTER(attention, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::attention);
+  return true;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+void embedding_bag(const Instruction& instr, const DecomposerContext& context) {
+  CHECK(instr->inputs.size() == 2UL || instr->inputs.size() == 3UL)
+      << "The " << instr->op_type << " decomposer only supports the ids of [num_bags, bag_size] without offsets";
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto table          = instr->inputs[0];
+  auto ids            = instr->inputs[1];
+  auto mode           = instr.GetAttrs<std::string>("mode");
+  auto padding_idx    = instr.GetAttrs<int64_t>("padding_idx");
+  NetBuilder* builder = context.builder();
+  CHECK_EQ(ids->shape.size(), 2UL) << "The variable length bags of " << instr->op_type
+                                   << " are only supported on the host target";
+
+  // lookup_table takes the ids of [num_bags, bag_size, 1] and outputs the rows of [num_bags, bag_size, dim]
+  auto rows = builder->LookupTable(table, builder->ExpandDims(ids, {-1}), padding_idx);
+  if (instr->inputs.size() == 3UL) {
+    auto weights = builder->BroadcastTo(instr->inputs[2], rows->shape, {0, 1});
+    rows         = builder->Multiply(rows, weights);
+  }
+
+  Variable out;
+  if (mode == "sum") {
+    out = builder->ReduceSum(rows, {1});
+  } else if (mode == "mean") {
+    out = builder->Scale(builder->ReduceSum(rows, {1}), 1.0f / ids->shape[1]);
+  } else if (mode == "max") {
+    out = builder->ReduceMax(rows, {1});
+  } else {
+    LOG(FATAL) << "The mode of " << instr->op_type << " should be sum, mean or max, but got " << mode;
+  }
+
+  context.MapOutToOrigin(out, instr->outputs[0]);
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(embedding_bag_decomposer) {
+  // The host target reduces the bags natively with a fused gather, see StrategyForEmbeddingBag.
+  CINN_DECOMPOSER_REGISTER(
+      embedding_bag, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::embedding_bag);
+  return true;
+}
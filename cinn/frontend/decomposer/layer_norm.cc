@@ -0,0 +1,116 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+struct NormHelper {
+  NormHelper(NetBuilder* net_builder, const std::vector<int>& x_shape, int begin_norm_axis) : builder(net_builder) {
+    if (begin_norm_axis < 0) {
+      begin_norm_axis += x_shape.size();
+    }
+    CHECK(begin_norm_axis >= 0 && begin_norm_axis < x_shape.size())
+        << "begin_norm_axis is out of the range of the input rank " << x_shape.size();
+    for (int i = 0; i < x_shape.size(); ++i) {
+      (i < begin_norm_axis ? rows : cols) *= x_shape[i];
+    }
+    shape = {rows, cols};
+  }
+
+  // mean = reduce_sum(x) / cols, shape = [rows]
+  Variable Mean(Variable x) {
+    auto sum = builder->ReduceSum(x, {1});
+    return builder->Divide(sum, Constant(sum, static_cast<float>(cols), "norm_cols"));
+  }
+
+  // rsqrt(value + epsilon), broadcast to [rows, cols]
+  Variable RstdBroadcast(Variable value, float epsilon) {
+    auto rstd = builder->Rsqrt(builder->Add(value, Constant(value, epsilon, "norm_epsilon")));
+    return builder->BroadcastTo(rstd, shape, {0});
+  }
+
+  // apply the per column parameter of `cols` elements
+  Variable ColumnBroadcast(Variable param) {
+    return builder->BroadcastTo(builder->Reshape(param, {cols}), shape, {1});
+  }
+
+  Variable Constant(Variable like, float value, const std::string& name) {
+    return builder->FillConstant(like->shape, value, common::UniqName(name), common::Type2Str(like->type));
+  }
+
+  NetBuilder* builder{nullptr};
+  int rows{1};
+  int cols{1};
+  std::vector<int> shape;
+};
+
+void layer_norm(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 3UL) << "3 input tensors for " << instr->op_type;
+  CHECK_EQ(instr->outputs.size(), 3UL) << "3 output tensors for " << instr->op_type;
+  auto x              = instr->inputs[0];
+  auto scale          = instr->inputs[1];
+  auto bias           = instr->inputs[2];
+  float epsilon       = instr.GetAttrs<float>("epsilon");
+  int begin_norm_axis = instr.GetAttrs<int>("begin_norm_axis");
+  NetBuilder* builder = context.builder();
+  NormHelper helper(builder, x->shape, begin_norm_axis);
+
+  // variance = E[(x - E[x])^2], the centered form keeps the precision when |E[x]| is much larger than the deviation
+  auto x_reshape = builder->Reshape(x, helper.shape);
+  auto mean      = helper.Mean(x_reshape);
+  auto x_center  = builder->Subtract(x_reshape, builder->BroadcastTo(mean, helper.shape, {0}));
+  auto variance  = helper.Mean(builder->Multiply(x_center, builder->Identity(x_center)));
+  auto y         = builder->Multiply(x_center, helper.RstdBroadcast(variance, epsilon));
+  y              = builder->Multiply(y, helper.ColumnBroadcast(scale));
+  y              = builder->Add(y, helper.ColumnBroadcast(bias));
+  y              = builder->Reshape(y, x->shape);
+
+  context.MapOutToOrigin(y, instr->outputs[0]);
+  context.MapOutToOrigin(mean, instr->outputs[1]);
+  context.MapOutToOrigin(variance, instr->outputs[2]);
+}
+
+void rms_norm(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 2UL) << "2 input tensors for " << instr->op_type;
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto x              = instr->inputs[0];
+  auto scale          = instr->inputs[1];
+  float epsilon       = instr.GetAttrs<float>("epsilon");
+  int begin_norm_axis = instr.GetAttrs<int>("begin_norm_axis");
+  NetBuilder* builder = context.builder();
+  NormHelper helper(builder, x->shape, begin_norm_axis);
+
+  auto x_reshape   = builder->Reshape(x, helper.shape);
+  auto mean_square = helper.Mean(builder->Multiply(x_reshape, builder->Identity(x_reshape)));
+  auto y           = builder->Multiply(x_reshape, helper.RstdBroadcast(mean_square, epsilon));
+  y                = builder->Multiply(y, helper.ColumnBroadcast(scale));
+  y                = builder->Reshape(y, x->shape);
+
+  context.MapOutToOrigin(y, instr->outputs[0]);
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(layer_norm_decomposer) {
+  // The host target lowers the norms natively with one read for the statistics, see StrategyForLayerNorm.
+  CINN_DECOMPOSER_REGISTER(layer_norm, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::layer_norm);
+  CINN_DECOMPOSER_REGISTER(rms_norm, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::rms_norm);
+  return true;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+namespace cinn::frontend {
+
+TEST(Decomposer, layer_norm) {
+  constexpr int rows = 8, cols = 128;
+  NetBuilder builder("layer_norm");
+  auto x     = builder.CreateInput(Float(32), {rows, 4, 32}, "x");
+  auto scale = builder.CreateInput(Float(32), {cols}, "scale");
+  auto bias  = builder.CreateInput(Float(32), {cols}, "bias");
+  auto outs  = builder.LayerNorm(x, scale, bias, 1e-5f, 1);
+
+  auto layer_norm_cpu = [](const std::vector<size_t>& lengths, const std::vector<void*>& ptrs) {
+    float* x        = static_cast<float*>(ptrs[0]);
+    float* scale    = static_cast<float*>(ptrs[1]);
+    float* bias     = static_cast<float*>(ptrs[2]);
+    float* y        = static_cast<float*>(ptrs[3]);
+    float* mean     = static_cast<float*>(ptrs[4]);
+    float* variance = static_cast<float*>(ptrs[5]);
+    for (int r = 0; r < rows; ++r) {
+      double sum = 0, square_sum = 0;
+      for (int j = 0; j < cols; ++j) sum += x[r * cols + j];
+      mean[r] = sum / cols;
+      for (int j = 0; j < cols; ++j) square_sum += std::pow(x[r * cols + j] - mean[r], 2);
+      variance[r] = square_sum / cols;
+      for (int j = 0; j < cols; ++j) {
+        y[r * cols + j] = (x[r * cols + j] - mean[r]) / std::sqrt(variance[r] + 1e-5f) * scale[j] + bias[j];
+      }
+    }
+  };
+
+  std::vector<std::string> input_names        = {x.id().data(), scale.id().data(), bias.id().data()};
+  std::vector<std::string> output_names       = {outs[0]->id, outs[1]->id, outs[2]->id};
+  std::vector<std::vector<int>> output_shapes = {{rows, 4, 32}, {rows}, {rows}};
+  RunAndCheck<float>(builder, input_names, output_names, output_shapes, layer_norm_cpu, -1, 1, 1e-5, 1e-4);
+}
+
+TEST(Decomposer, rms_norm) {
+  constexpr int rows = 16, cols = 64;
+  NetBuilder builder("rms_norm");
+  auto x     = builder.CreateInput(Float(32), {rows, cols}, "x");
+  auto scale = builder.CreateInput(Float(32), {cols}, "scale");
+  auto out   = builder.RMSNorm(x, scale, 1e-6f, -1);
+
+  auto rms_norm_cpu = [](const std::vector<size_t>& lengths, const std::vector<void*>& ptrs) {
+    float* x     = static_cast<float*>(ptrs[0]);
+    float* scale = static_cast<float*>(ptrs[1]);
+    float* y     = static_cast<float*>(ptrs[2]);
+    for (int r = 0; r < rows; ++r) {
+      double square_sum = 0;
+      for (int j = 0; j < cols; ++j) square_sum += x[r * cols + j] * x[r * cols + j];
+      float rstd = 1.0 / std::sqrt(square_sum / cols + 1e-6f);
+      for (int j = 0; j < cols; ++j) {
+        y[r * cols + j] = x[r * cols + j] * rstd * scale[j];
+      }
+    }
+  };
+
+  std::vector<std::string> input_names        = {x.id().data(), scale.id().data()};
+  std::vector<std::string> output_names       = {out->id};
+  std::vector<std::vector<int>> output_shapes = {{rows, cols}};
+  RunAndCheck<float>(builder, input_names, output_names, output_shapes, rms_norm_cpu, -1, 1, 1e-5, 1e-4);
+}
+
+}  // namespace cinn::frontend
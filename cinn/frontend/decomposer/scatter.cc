@@ -0,0 +1,93 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+namespace {
+
+// The host_scatter externs are registered for these types only.
+bool HasHostScatterExtern(const common::Type& type) {
+  return type == common::F32() || type == common::F64() || type == common::I32() || type == common::I64();
+}
+
+// Scatter with host_scatter, which partitions the destination among the threads instead of searching the index
+// for every element of the output. The other types keep the original op.
+void DecomposeToHostScatter(const Instruction& instr,
+                            const DecomposerContext& context,
+                            const Variable& base,
+                            const Variable& updates,
+                            const Variable& index,
+                            const std::string& kind,
+                            const std::vector<int>& axes,
+                            const std::string& reduce) {
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  NetBuilder* builder = context.builder();
+  if (!HasHostScatterExtern(base->type) || updates->type != base->type) {
+    VLOG(3) << "Keep " << instr->op_type << " of " << base->type << " since host_scatter doesn't support it";
+    builder->AppendInstruction(instr);
+    return;
+  }
+  const auto& outs    = builder->CustomInstr(
+      "host_scatter", {base, updates, index}, {{"kind", kind}, {"axes", axes}, {"reduce", reduce}});
+  context.MapOutToOrigin(outs.front(), instr->outputs[0]);
+}
+
+}  // namespace
+
+void scatter_assign(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 3UL) << "The " << instr->op_type << " takes the input, updates and index";
+  int axis = instr.GetAttrs<int>("axis");
+  DecomposeToHostScatter(
+      instr, context, instr->inputs[0], instr->inputs[1], instr->inputs[2], "rows", {axis}, "assign");
+}
+
+void scatter_add(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 3UL) << "The " << instr->op_type << " takes the input, updates and index";
+  int axis = instr.GetAttrs<int>("axis");
+  DecomposeToHostScatter(instr, context, instr->inputs[0], instr->inputs[1], instr->inputs[2], "rows", {axis}, "add");
+}
+
+void scatter(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 3UL) << "The " << instr->op_type << " takes the src, index and out";
+  int axis = instr.GetAttrs<int>("axis");
+  DecomposeToHostScatter(
+      instr, context, instr->inputs[2], instr->inputs[0], instr->inputs[1], "elements", {axis}, "assign");
+}
+
+void scatter_nd(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 3UL) << "The " << instr->op_type << " takes the src, index and out";
+  auto axes = instr.GetAttrs<std::vector<int>>("axes");
+  DecomposeToHostScatter(instr, context, instr->inputs[2], instr->inputs[0], instr->inputs[1], "nd", axes, "assign");
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(scatter_decomposers) {
+  // The NVGPU target keeps the scatter ops, which search the index for every element of the output.
+  CINN_DECOMPOSER_REGISTER(
+      scatter_assign, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::scatter_assign);
+  CINN_DECOMPOSER_REGISTER(scatter_add, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::scatter_add);
+  CINN_DECOMPOSER_REGISTER(scatter, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::scatter);
+  CINN_DECOMPOSER_REGISTER(scatter_nd, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::scatter_nd);
+  return true;
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+namespace cinn::frontend {
+
+namespace {
+
+// The op types of the program of scatter_add on `dtype` after decomposed for the host.
+std::vector<std::string> DecomposeScatterAdd(const std::string& dtype) {
+  NetBuilder net_builder("scatter_add_decomposer");
+  auto x       = net_builder.CreateInput(common::Str2Type(dtype), {8, 4}, "x");
+  auto updates = net_builder.CreateInput(common::Str2Type(dtype), {3, 4}, "updates");
+  auto index   = net_builder.CreateInput(Int(32), {3}, "index");
+  auto out     = net_builder.ScatterAdd(x, updates, index, 0);
+  auto program = net_builder.Build();
+
+  RunDecomposer(&program, common::DefaultHostTarget(), {"Decomposer"}, {out->id});
+  std::vector<std::string> op_types;
+  for (int i = 0; i < program.size(); ++i) {
+    op_types.push_back(program[i]->op_type);
+  }
+  return op_types;
+}
+
+}  // namespace
+
+TEST(Decomposer, scatter_add_decomposer) {
+  for (auto& dtype : {"float32", "float64", "int32", "int64"}) {
+    ASSERT_EQ(DecomposeScatterAdd(dtype), std::vector<std::string>({"host_scatter"})) << dtype;
+  }
+  // there is no host_scatter of these types, which keep the original op
+  for (auto& dtype : {"bool", "int8", "uint8", "int16", "float16"}) {
+    ASSERT_EQ(DecomposeScatterAdd(dtype), std::vector<std::string>({"scatter_add"})) << dtype;
+  }
+}
+
+}  // namespace cinn::frontend
@@ -33,10 +33,14 @@ void top_k(const Instruction& instr, const DecomposerContext& context) {
   if (axis < 0) {
     axis += x->shape.size();
   }
+  bool largest = true;
+  if (instr->attrs.count("largest")) {
+    largest = instr.GetAttrs<bool>("largest");
+  }
 
-  auto sort_tmp    = builder->Sort(x, axis, false);
+  auto sort_tmp    = builder->Sort(x, axis, !largest);
   auto sort_out    = builder->Slice(sort_tmp, {axis}, {0}, {k});
-  auto argsort_tmp = builder->ArgSort(x, axis, false).at(0);
+  auto argsort_tmp = builder->ArgSort(x, axis, !largest).at(0);
   auto argsort_out = builder->Cast(builder->Slice(argsort_tmp, {axis}, {0}, {k}), "int64");
 
   // map the the output of decomposed operator to the original.
@@ -49,6 +53,7 @@ void top_k(const Instruction& instr, const DecomposerContext& context) {
 }  // namespace cinn
 
 CINN_REGISTER_HELPER(top_k_decomposer) {
-  CINN_DECOMPOSER_REGISTER(top_k, cinn::frontend::decomposer::top_k);
+  // The host target lowers top_k natively with a partial selection, see StrategyForTopK.
+  CINN_DECOMPOSER_REGISTER(top_k, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::top_k);
   return true;
 }
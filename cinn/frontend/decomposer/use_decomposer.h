@@ -27,3 +27,7 @@ CINN_USE_REGISTER(batch_norm_decomposer)
 CINN_USE_REGISTER(batch_norm_train_decomposer)
 CINN_USE_REGISTER(batch_norm_grad_decomposer)
 CINN_USE_REGISTER(top_k_decomposer)
+CINN_USE_REGISTER(layer_norm_decomposer)
+CINN_USE_REGISTER(attention_decomposer)
+CINN_USE_REGISTER(embedding_bag_decomposer)
+CINN_USE_REGISTER(scatter_decomposers)
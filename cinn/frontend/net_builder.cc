@@ -14,6 +14,7 @@
 
 #include "cinn/frontend/net_builder.h"
 
+#include <cmath>
 #include <string>
 #include <utility>
 #include <vector>
@@ -525,6 +526,42 @@ Variable NetBuilder::LookupTable(const Variable& table, const Variable& ids, int
   return CustomInstr("lookup_table", {table, ids}, {{"padding_idx", padding_idx}}).front();
 }
 
+Variable NetBuilder::EmbeddingBag(const Variable& table,
+                                  const Variable& ids,
+                                  const std::string& mode,
+                                  int64_t padding_idx) {
+  return CustomInstr("embedding_bag", {table, ids}, {{"mode", mode}, {"padding_idx", padding_idx}}).front();
+}
+
+Variable NetBuilder::EmbeddingBag(const Variable& table,
+                                  const Variable& ids,
+                                  const Variable& offsets,
+                                  const std::string& mode,
+                                  int64_t padding_idx) {
+  return CustomInstr("embedding_bag", {table, ids, offsets}, {{"mode", mode}, {"padding_idx", padding_idx}}).front();
+}
+
+Variable NetBuilder::WeightedEmbeddingBag(const Variable& table,
+                                          const Variable& ids,
+                                          const Variable& per_sample_weights,
+                                          int64_t padding_idx) {
+  return CustomInstr("embedding_bag",
+                     {table, ids, per_sample_weights},
+                     {{"mode", std::string("sum")}, {"padding_idx", padding_idx}})
+      .front();
+}
+
+Variable NetBuilder::WeightedEmbeddingBag(const Variable& table,
+                                          const Variable& ids,
+                                          const Variable& offsets,
+                                          const Variable& per_sample_weights,
+                                          int64_t padding_idx) {
+  return CustomInstr("embedding_bag",
+                     {table, ids, offsets, per_sample_weights},
+                     {{"mode", std::string("sum")}, {"padding_idx", padding_idx}})
+      .front();
+}
+
 Variable NetBuilder::Conv2d(const Variable& a,
                             const Variable& b,
                             const std::vector<int>& strides,
@@ -803,5 +840,36 @@ std::vector<Variable> NetBuilder::TopK(const Variable& x, int k, int axis, bool
   return CustomInstr("top_k", {x}, {{"k", k}, {"axis", axis}, {"largest", largest}});
 }
 
+std::vector<Variable> NetBuilder::LayerNorm(
+    const Variable& x, const Variable& scale, const Variable& bias, float epsilon, int begin_norm_axis) {
+  return CustomInstr("layer_norm", {x, scale, bias}, {{"epsilon", epsilon}, {"begin_norm_axis", begin_norm_axis}});
+}
+
+Variable NetBuilder::RMSNorm(const Variable& x, const Variable& scale, float epsilon, int begin_norm_axis) {
+  return CustomInstr("rms_norm", {x, scale}, {{"epsilon", epsilon}, {"begin_norm_axis", begin_norm_axis}}).front();
+}
+
+namespace {
+// The scale 0 stands for the default 1 / sqrt(head_dim), which the op uses when the attribute is absent.
+AttributeMap GetAttentionAttrs(float scale, bool causal) {
+  CHECK(std::isfinite(scale) && scale >= 0.0f)
+      << "The scale of attention should be positive, or 0 for 1 / sqrt(head_dim), but received " << scale;
+  AttributeMap attrs = {{"causal", causal}};
+  if (scale > 0.0f) {
+    attrs["scale"] = scale;
+  }
+  return attrs;
+}
+}  // namespace
+
+Variable NetBuilder::Attention(const Variable& q, const Variable& k, const Variable& v, float scale, bool causal) {
+  return CustomInstr("attention", {q, k, v}, GetAttentionAttrs(scale, causal)).front();
+}
+
+Variable NetBuilder::Attention(
+    const Variable& q, const Variable& k, const Variable& v, const Variable& mask, float scale, bool causal) {
+  return CustomInstr("attention", {q, k, v, mask}, GetAttentionAttrs(scale, causal)).front();
+}
+
 }  // namespace frontend
 }  // namespace cinn
@@ -1042,6 +1042,48 @@ class NetBuilder {
    */
   Variable LookupTable(const Variable& table, const Variable& ids, int64_t padding_idx);
 
+  /**
+   * @brief Lookup the embeddings of every bag of ids and reduce them, without materializing the looked-up rows.
+   * @param table A variable with shape of lookup table parameter, [num_rows, dim].
+   * @param ids The ids of [num_bags, bag_size].
+   * @param mode How a bag is reduced, one of "sum", "mean" and "max". Default: "sum".
+   * @param padding_idx If the value is -1, it makes no effect to lookup.
+                     Otherwise the given id looks up a row of zeros like LookupTable, which still counts for "mean".
+   * @return The reduced embeddings of [num_bags, dim].
+   */
+  Variable EmbeddingBag(const Variable& table,
+                        const Variable& ids,
+                        const std::string& mode = "sum",
+                        int64_t padding_idx     = -1);
+
+  /**
+   * @brief Lookup the embeddings of the bags of variable lengths in the flattened ids and reduce every bag.
+   * @param offsets The start of every bag in the 1-D ids, the bag b ends at offsets[b + 1] or the end of ids.
+   */
+  Variable EmbeddingBag(const Variable& table,
+                        const Variable& ids,
+                        const Variable& offsets,
+                        const std::string& mode = "sum",
+                        int64_t padding_idx     = -1);
+
+  /**
+   * @brief Sum the embeddings of every bag of ids of [num_bags, bag_size] scaled by the per sample weights.
+   * @param per_sample_weights The weights of the same shape as ids.
+   */
+  Variable WeightedEmbeddingBag(const Variable& table,
+                                const Variable& ids,
+                                const Variable& per_sample_weights,
+                                int64_t padding_idx = -1);
+
+  /**
+   * @brief Sum the embeddings of the bags in the flattened ids split by offsets, scaled by the per sample weights.
+   */
+  Variable WeightedEmbeddingBag(const Variable& table,
+                                const Variable& ids,
+                                const Variable& offsets,
+                                const Variable& per_sample_weights,
+                                int64_t padding_idx = -1);
+
   /**
    * @brief Gaussian random
    * @param shape Shape of the variable to be created.
@@ -1124,6 +1166,50 @@ class NetBuilder {
    */
   std::vector<Variable> TopK(const Variable& x, int k, int axis, bool largest);
 
+  /**
+   * @brief Layer normalization over the dimensions from begin_norm_axis on.
+   * @param x Input tensor.
+   * @param scale The scale applied to the normalized x, with the number of elements of the normalized dimensions.
+   * @param bias The bias added to the normalized x, with the number of elements of the normalized dimensions.
+   * @param epsilon The small value added to the variance to prevent division by zero. Default: 1e-5f.
+   * @param begin_norm_axis The first dimension to normalize. Default: 1.
+   * @return `{y, mean, variance}`, the mean and variance hold one value for every normalized row.
+   */
+  std::vector<Variable> LayerNorm(
+      const Variable& x, const Variable& scale, const Variable& bias, float epsilon = 1e-5f, int begin_norm_axis = 1);
+
+  /**
+   * @brief Root mean square normalization over the dimensions from begin_norm_axis on, y = x / rms(x) * scale.
+   * @param x Input tensor.
+   * @param scale The scale applied to the normalized x, with the number of elements of the normalized dimensions.
+   * @param epsilon The small value added to the mean square to prevent division by zero. Default: 1e-6f.
+   * @param begin_norm_axis The first dimension to normalize. Default: -1.
+   * @return The normalized variable.
+   */
+  Variable RMSNorm(const Variable& x, const Variable& scale, float epsilon = 1e-6f, int begin_norm_axis = -1);
+
+  /**
+   * @brief Scaled dot-product attention softmax(q * k^T * scale) * v, computed without materializing the scores.
+   * @param q The query of [batch, heads, seq_q, head_dim] or [batch, seq_q, head_dim].
+   * @param k The key of [batch, heads, seq_kv, head_dim] or [batch, seq_kv, head_dim].
+   * @param v The value of the same shape as k.
+   * @param scale The positive scale of the scores. Default: 0, which stands for 1 / sqrt(head_dim).
+   * @param causal Whether the query i only attends to the keys up to i + seq_kv - seq_q. Default: false.
+   * @return The output of the same shape as q.
+   */
+  Variable Attention(const Variable& q, const Variable& k, const Variable& v, float scale = 0.0f, bool causal = false);
+
+  /**
+   * @brief Scaled dot-product attention softmax(q * k^T * scale + mask) * v with an additive mask, which is broadcast
+   * to the scores of [batch, heads, seq_q, seq_kv], such as a padding mask of [batch, 1, 1, seq_kv].
+   */
+  Variable Attention(const Variable& q,
+                     const Variable& k,
+                     const Variable& v,
+                     const Variable& mask,
+                     float scale = 0.0f,
+                     bool causal = false);
+
  private:
   CINN_DISALLOW_COPY_AND_ASSIGN(NetBuilder);
 };
@@ -78,59 +78,29 @@ void LayerNormOpMapper(const paddle::cpp::OpDesc& op_desc, const OpMapperContext
   }
   VLOG(4) << "-- [layer_norm] left = " << left << ", right = " << right;
 
-  // compute mean
   auto* builder = ctx.Builder();
 
   const auto& x_type = x->type;
   if (x_type.is_float(16)) {
     x = builder->Cast(x, "float32");
   }
-
-  std::vector<int> shape{left, right};
-  auto x_reshape = builder->Reshape(x, shape);
-  auto x_reduce  = builder->ReduceSum(x_reshape, {1});
-  auto ele_num   = builder->FillConstant(
-      {left}, static_cast<float>(right), common::UniqName("layer_norm_ele_num"), common::Type2Str(x->type));
-  auto x_mean = builder->Divide(x_reduce, ele_num);
-
-  // use `E[|x|^2] - |E[x]|^2` instead of `E[|x - E[x]|^2])` to compute variance
-  auto x2        = builder->Multiply(x_reshape, builder->Identity(x_reshape));
-  auto x2_reduce = builder->ReduceSum(x2, {1});
-  auto x2_mean   = builder->Divide(x2_reduce, ele_num);
-  auto x_mean2   = builder->Multiply(x_mean, builder->Identity(x_mean));
-  auto zero      = builder->FillConstant({left}, 0.f, common::UniqName("layer_norm_zero"), common::Type2Str(x->type));
-  auto x_var     = builder->Max(builder->Subtract(x2_mean, x_mean2), zero);
-
-  // compute x norm
-  auto x_mean_broadcast = builder->BroadcastTo(x_mean, shape, {0});
-  auto y_sub            = builder->Subtract(x_reshape, x_mean_broadcast);
-  auto epsilon_var =
-      builder->FillConstant({left}, epsilon, common::UniqName("layer_norm_epsilon"), common::Type2Str(x->type));
-  auto x_var_eps  = builder->Add(x_var, epsilon_var);
-  auto x_var_sqrt = builder->Sqrt(x_var_eps);
-  auto y_out      = builder->Divide(y_sub, builder->BroadcastTo(x_var_sqrt, shape, {0}));
-
-  // multiply scale
-  if (scale) {
-    if (scale.value()->type.is_float(16)) {
-      scale = ctx.Builder()->Cast(scale.value(), "float32");
+  // the missing scale and bias are the identity of the normalization
+  auto get_param = [&](absl::optional<Variable> param, float default_value, const std::string& name) {
+    if (!param) {
+      return builder->FillConstant({right}, default_value, common::UniqName(name), common::Type2Str(x->type));
     }
-    auto scale_broadcast = builder->BroadcastTo(*scale, shape, {1});
-    y_out                = builder->Multiply(y_out, scale_broadcast);
-  }
-
-  // add bias
-  if (bias) {
-    if (bias.value()->type.is_float(16)) {
-      bias = ctx.Builder()->Cast(bias.value(), "float32");
+    if (param.value()->type.is_float(16)) {
+      return builder->Cast(param.value(), "float32");
     }
-    auto bias_broadcast = builder->BroadcastTo(*bias, shape, {1});
-    y_out               = builder->Add(y_out, bias_broadcast);
-  }
-
-  // reshape to the original shape
-  y_out = builder->Reshape(y_out, x_shape);
+    return param.value();
+  };
+  auto scale_var = get_param(scale, 1.0f, "layer_norm_scale");
+  auto bias_var  = get_param(bias, 0.0f, "layer_norm_bias");
 
+  auto outs   = builder->LayerNorm(x, scale_var, bias_var, epsilon, begin_norm_axis);
+  auto y_out  = outs[0];
+  auto x_mean = outs[1];
+  auto x_var  = outs[2];
   if (x_type.is_float(16)) {
     y_out = builder->Cast(y_out, "float16");
   }
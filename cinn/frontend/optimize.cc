@@ -44,6 +44,12 @@ namespace frontend {
 OptimizeOptions DefaultTrainingOptimizeOptions() {
   OptimizeOptions options;
   options.program_passes.emplace_back("AutoCast");
+  // before the decomposer splits the softmax of the attention pattern
+  options.program_passes.emplace_back("AttentionRewriter");
+  // fuse the sum, mean or max pooling of the looked-up rows on the host
+  options.program_passes.emplace_back("EmbeddingBagRewriter");
+  // apply the bias, residual and relu of the NHWC conv2d in its host microkernels
+  options.program_passes.emplace_back("Conv2dEpilogueRewriter");
   options.program_passes.emplace_back("Decomposer");
   options.program_passes.emplace_back("RemoveIdentity");
 
@@ -0,0 +1,243 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <absl/types/optional.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/program_pass.h"
+#include "cinn/frontend/syntax.h"
+#include "glog/logging.h"
+
+namespace cinn {
+namespace frontend {
+namespace pass {
+
+// Pass `AttentionRewriter` rewrites the pattern
+//   scores = matmul(q, k, trans_b=true, alpha) [-> scale(scale, bias=0)] [-> elementwise_add(mask)]
+//   out    = matmul(softmax(scores, axes=[-1]), v)
+// into one `attention` op, whose host kernel never materializes the scores.
+class AttentionRewriterPass : public ProgramPass {
+ public:
+  using ProgramPass::ProgramPass;
+
+ protected:
+  void Clear() override {}
+
+  void ApplyImpl(Program* prog,
+                 const std::unordered_set<std::string>& fetch_ids,
+                 const common::Target& target) override {
+    // only the host target has a fused attention kernel, the others decompose it again
+    if (target.arch != Target::Arch::X86 || !prog->size()) {
+      return;
+    }
+    CollectInfo(*prog);
+
+    std::unordered_map<_Instruction_*, Match> matches;
+    std::unordered_set<_Instruction_*> removed_instrs;
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& instr = (*prog)[i];
+      Match match;
+      if (MatchAttention(instr, fetch_ids, &match)) {
+        removed_instrs.insert(match.instrs.begin(), match.instrs.end());
+        matches.emplace(instr.get(), match);
+      }
+    }
+    if (matches.empty()) {
+      ClearResources();
+      return;
+    }
+
+    NetBuilder builder("attention_rewriter_builder");
+    for (auto& var : prog->GetInputs()) {
+      builder.CreateInput(var);
+    }
+    std::unordered_map<_Variable_*, Variable> origin2new;
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& instr = (*prog)[i];
+      auto it     = matches.find(instr.get());
+      if (it != matches.end()) {
+        auto& match = it->second;
+        auto new_out =
+            builder.CustomInstr("attention", match.inputs, {{"scale", match.scale}, {"causal", false}}).front();
+        auto old_out = instr.GetOutput(0);
+        new_out.set_id(old_out->id);
+        origin2new.emplace(old_out.get(), new_out);
+        VLOG(4) << "Rewrite " << match.instrs.size() << " instructions into attention " << old_out->id;
+      } else if (!removed_instrs.count(instr.get())) {
+        builder.AppendInstruction(instr);
+      }
+    }
+    *prog = builder.Build(true);
+
+    // relink old outputs to new outputs
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& inputs = (*prog)[i]->inputs;
+      for (size_t j = 0; j < inputs.size(); j++) {
+        if (origin2new.count(inputs[j].get())) {
+          inputs[j] = origin2new.at(inputs[j].get());
+        }
+      }
+    }
+    ClearResources();
+  }
+
+ private:
+  struct Match {
+    std::vector<Variable> inputs;
+    float scale{1.0f};
+    // the instructions replaced by the attention, including the last matmul
+    std::vector<_Instruction_*> instrs;
+  };
+
+  void CollectInfo(const Program& prog) {
+    for (size_t i = 0; i < prog.size(); i++) {
+      auto& instr = prog[i];
+      for (auto& var : instr->outputs) {
+        output2instr_.emplace(var.get(), instr);
+      }
+      for (auto& var : instr->inputs) {
+        var_used_count_[var.get()]++;
+      }
+    }
+  }
+
+  // Get the instruction producing `var`, if `var` is only used by its consumer in the pattern.
+  const Instruction* GetProducer(const Variable& var,
+                                 const std::string& op_type,
+                                 const std::unordered_set<std::string>& fetch_ids) const {
+    auto it = output2instr_.find(var.get());
+    if (it == output2instr_.end() || it->second->op_type != op_type || it->second->outputs.size() != 1) {
+      return nullptr;
+    }
+    if (var_used_count_.at(var.get()) > 1 || fetch_ids.count(var->id)) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  template <typename T>
+  static T GetAttrOrDefault(const Instruction& instr, const std::string& name, T default_value) {
+    return instr->attrs.count(name) ? instr.GetAttrs<T>(name) : default_value;
+  }
+
+  static bool IsPlainMatmul(const Instruction& instr, bool trans_b) {
+    return !GetAttrOrDefault<bool>(instr, "trans_a", false) &&
+           GetAttrOrDefault<bool>(instr, "trans_b", false) == trans_b;
+  }
+
+  bool MatchAttention(const Instruction& instr, const std::unordered_set<std::string>& fetch_ids, Match* match) const {
+    if (instr->op_type != "matmul" || !IsPlainMatmul(instr, false) ||
+        GetAttrOrDefault<float>(instr, "alpha", 1.0f) != 1.0f) {
+      return false;
+    }
+    const auto& v = instr->inputs[1];
+    auto* softmax = GetProducer(instr->inputs[0], "softmax", fetch_ids);
+    if (!softmax) return false;
+    auto axes = GetAttrOrDefault<std::vector<int>>(*softmax, "axes", {-1});
+    int rank  = instr->inputs[0]->shape.size();
+    if (axes.size() != 1 || (axes[0] != -1 && axes[0] != rank - 1)) return false;
+    std::vector<_Instruction_*> instrs{instr.get(), softmax->get()};
+
+    // the optional mask
+    Variable scores = (*softmax)->inputs[0];
+    absl::optional<Variable> mask;
+    if (auto* add = GetProducer(scores, "elementwise_add", fetch_ids)) {
+      if (GetAttrOrDefault<int>(*add, "axis", -1) != -1) return false;
+      for (int i = 0; i < 2 && !mask; ++i) {
+        const auto& lhs = (*add)->inputs[i];
+        const auto& rhs = (*add)->inputs[1 - i];
+        if (lhs->shape == scores->shape && IsBroadcastMask(rhs, scores)) {
+          mask   = rhs;
+          scores = lhs;
+        }
+      }
+      if (!mask) return false;
+      instrs.push_back(add->get());
+    }
+
+    // the optional scale
+    float scale = 1.0f;
+    if (auto* scale_instr = GetProducer(scores, "scale", fetch_ids)) {
+      if (GetAttrOrDefault<float>(*scale_instr, "bias", 0.0f) != 0.0f) return false;
+      scale  = GetAttrOrDefault<float>(*scale_instr, "scale", 1.0f);
+      scores = (*scale_instr)->inputs[0];
+      instrs.push_back(scale_instr->get());
+    }
+
+    auto* qk = GetProducer(scores, "matmul", fetch_ids);
+    if (!qk || !IsPlainMatmul(*qk, true)) return false;
+    scale *= GetAttrOrDefault<float>(*qk, "alpha", 1.0f);
+    const auto& q = (*qk)->inputs[0];
+    const auto& k = (*qk)->inputs[1];
+    // the host kernel takes [batch, (heads,) seq, head_dim] inputs of the same batch and heads
+    if (scale <= 0.0f || !q->type.is_float(32) || (q->shape.size() != 3 && q->shape.size() != 4) ||
+        k->shape.size() != q->shape.size() || v->shape != k->shape || k->shape.back() != q->shape.back() ||
+        !std::equal(q->shape.begin(), q->shape.end() - 2, k->shape.begin())) {
+      return false;
+    }
+    instrs.push_back(qk->get());
+
+    match->inputs = {q, k, v};
+    if (mask) {
+      match->inputs.push_back(*mask);
+    }
+    match->scale  = scale;
+    match->instrs = std::move(instrs);
+    return true;
+  }
+
+  // The mask is aligned to the trailing dimensions of the scores, and broadcast except the last one.
+  static bool IsBroadcastMask(const Variable& mask, const Variable& scores) {
+    const auto& mask_shape   = mask->shape;
+    const auto& scores_shape = scores->shape;
+    if (!mask->type.is_float(32) || mask_shape.empty() || mask_shape.size() > scores_shape.size() ||
+        mask_shape.back() != scores_shape.back()) {
+      return false;
+    }
+    int offset = scores_shape.size() - mask_shape.size();
+    for (int i = 0; i < mask_shape.size(); ++i) {
+      if (mask_shape[i] != 1 && mask_shape[i] != scores_shape[offset + i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void ClearResources() {
+    output2instr_.clear();
+    var_used_count_.clear();
+  }
+
+  std::unordered_map<_Variable_*, Instruction> output2instr_;
+  std::unordered_map<_Variable_*, int> var_used_count_;
+};
+
+}  // namespace pass
+}  // namespace frontend
+}  // namespace cinn
+
+namespace fp = ::cinn::frontend::pass;
+CINN_REGISTER_HELPER(AttentionRewriter) {
+  CINN_REGISTER_PROGRAM_PASS(AttentionRewriter, fp::AttentionRewriterPass);
+
+  return true;
+}
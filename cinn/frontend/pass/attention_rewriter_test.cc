@@ -0,0 +1,89 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/pass/pass_test_helper.h"
+#include "cinn/hlir/op/use_ops.h"
+
+namespace cinn::frontend {
+
+bool HasOp(const Program& program, const std::string& op_type) {
+  for (int i = 0; i < program.size(); ++i) {
+    if (program[i]->op_type == op_type) return true;
+  }
+  return false;
+}
+
+TEST(AttentionRewriter, MaskedAttention) {
+  NetBuilder builder("net_builder");
+  auto q       = builder.CreateInput(Float(32), {2, 4, 40, 32}, "Q");
+  auto k       = builder.CreateInput(Float(32), {2, 4, 70, 32}, "K");
+  auto v       = builder.CreateInput(Float(32), {2, 4, 70, 32}, "V");
+  auto mask    = builder.CreateInput(Float(32), {2, 1, 1, 70}, "Mask");
+  auto scores  = builder.Matmul(q, k, false, true);
+  auto scaled  = builder.Scale(scores, 0.01f);
+  auto masked  = builder.Add(scaled, mask);
+  auto probs   = builder.Softmax(masked, {-1});
+  auto out     = builder.Matmul(probs, v);
+  auto program = builder.Build();
+
+  common::Target target = common::DefaultHostTarget();
+  std::vector<std::string> input_ids{q->id, k->id, v->id, mask->id};
+  auto origin_out = RunProgram(program, target, input_ids, {out->id}, {}, 123);
+
+  // matmul, scale, elementwise_add, softmax and matmul become one attention
+  auto origin_size = program.size();
+  ProgramPass::Apply(&program, {out->id}, target, {"AttentionRewriter"});
+  ASSERT_EQ(origin_size - program.size(), 4);
+  ASSERT_TRUE(HasOp(program, "attention"));
+
+  auto fused_out = RunProgram(program, target, input_ids, {out->id}, {}, 123);
+  ASSERT_EQ(origin_out.size(), fused_out.size());
+  for (size_t i = 0; i < origin_out.size(); ++i) {
+    ASSERT_NEAR(origin_out[i], fused_out[i], 1e-4 * std::abs(origin_out[i]) + 1e-4) << " i is " << i;
+  }
+}
+
+TEST(AttentionRewriter, FetchedScores) {
+  NetBuilder builder("net_builder");
+  auto q       = builder.CreateInput(Float(32), {2, 40, 32}, "Q");
+  auto k       = builder.CreateInput(Float(32), {2, 70, 32}, "K");
+  auto v       = builder.CreateInput(Float(32), {2, 70, 32}, "V");
+  auto scores  = builder.Matmul(q, k, false, true, 0.01f);
+  auto probs   = builder.Softmax(scores, {-1});
+  auto out     = builder.Matmul(probs, v);
+  auto program = builder.Build();
+
+  common::Target target = common::DefaultHostTarget();
+  // the probabilities are still needed, so the pattern is kept
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"AttentionRewriter"}};
+  std::unordered_set<std::string> fetch_ids{out->id, probs->id};
+  ASSERT_TRUE(CompareProgramPassResult(&program, target, fetch_ids, 0, passes));
+  ASSERT_FALSE(HasOp(program, "attention"));
+
+  fetch_ids.erase(probs->id);
+  ASSERT_TRUE(CompareProgramPassResult(&program, target, fetch_ids, 2, passes));
+  ASSERT_TRUE(HasOp(program, "attention"));
+}
+
+}  // namespace cinn::frontend
@@ -0,0 +1,260 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/program_pass.h"
+#include "cinn/frontend/syntax.h"
+#include "glog/logging.h"
+
+DECLARE_bool(cinn_x86_direct_nhwc_conv);
+
+namespace cinn {
+namespace frontend {
+namespace pass {
+
+// Pass `Conv2dEpilogueRewriter` rewrites the NHWC conv2d followed by its epilogue
+//   out = conv2d(x, w) [+ bias of [C_out]] [+ residual of the output shape] [-> relu]
+// into one `fused_conv2d_nhwc` op, whose host microkernels apply the epilogue before storing the output.
+class Conv2dEpilogueRewriterPass : public ProgramPass {
+ public:
+  using ProgramPass::ProgramPass;
+
+ protected:
+  void Clear() override {}
+
+  void ApplyImpl(Program* prog,
+                 const std::unordered_set<std::string>& fetch_ids,
+                 const common::Target& target) override {
+    // only the host target has the direct NHWC conv2d microkernels
+    if (!FLAGS_cinn_x86_direct_nhwc_conv || target.arch != Target::Arch::X86 || !prog->size()) {
+      return;
+    }
+    CollectInfo(*prog);
+
+    std::unordered_map<_Instruction_*, Match> matches;
+    std::unordered_set<_Instruction_*> removed_instrs;
+    // visit the consumers first, so that the longest epilogue is matched as a whole
+    for (int i = prog->size() - 1; i >= 0; i--) {
+      auto& instr = (*prog)[i];
+      Match match;
+      if (!removed_instrs.count(instr.get()) && MatchEpilogue(instr, fetch_ids, &match)) {
+        removed_instrs.insert(match.instrs.begin(), match.instrs.end());
+        matches.emplace(instr.get(), match);
+      }
+    }
+    if (matches.empty()) {
+      ClearResources();
+      return;
+    }
+
+    NetBuilder builder("conv2d_epilogue_rewriter_builder");
+    for (auto& var : prog->GetInputs()) {
+      builder.CreateInput(var);
+    }
+    std::unordered_map<_Variable_*, Variable> origin2new;
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& instr = (*prog)[i];
+      auto it     = matches.find(instr.get());
+      if (it != matches.end()) {
+        auto& match = it->second;
+        std::vector<Variable> inputs{match.x, match.w};
+        if (match.has_bias) inputs.push_back(match.bias);
+        if (match.has_residual) inputs.push_back(match.residual);
+        utils::AttributeMap attrs{{"padding", match.padding},
+                                  {"stride", match.stride},
+                                  {"dilation", match.dilation},
+                                  {"activation", std::string(match.relu ? "relu" : "")}};
+        auto old_out = instr.GetOutput(0);
+        auto new_out = builder.CustomInstr("fused_conv2d_nhwc", inputs, attrs).front();
+        new_out.set_id(old_out->id);
+        origin2new.emplace(old_out.get(), new_out);
+        VLOG(4) << "Rewrite " << match.instrs.size() << " instructions into fused_conv2d_nhwc " << old_out->id;
+      } else if (!removed_instrs.count(instr.get())) {
+        builder.AppendInstruction(instr);
+      }
+    }
+    *prog = builder.Build(true);
+
+    // relink old outputs to new outputs
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& inputs = (*prog)[i]->inputs;
+      for (size_t j = 0; j < inputs.size(); j++) {
+        if (origin2new.count(inputs[j].get())) {
+          inputs[j] = origin2new.at(inputs[j].get());
+        }
+      }
+    }
+    ClearResources();
+  }
+
+ private:
+  struct Match {
+    Variable x;
+    Variable w;
+    Variable bias;
+    Variable residual;
+    bool has_bias{false};
+    bool has_residual{false};
+    std::vector<int> padding;
+    std::vector<int> stride;
+    std::vector<int> dilation;
+    bool relu{false};
+    // the output shape of the conv2d
+    std::vector<int> out_shape;
+    // the instructions replaced by the fused_conv2d_nhwc, including the last one
+    std::vector<_Instruction_*> instrs;
+  };
+
+  void CollectInfo(const Program& prog) {
+    for (size_t i = 0; i < prog.size(); i++) {
+      auto& instr = prog[i];
+      for (auto& var : instr->outputs) {
+        output2instr_.emplace(var.get(), instr);
+      }
+      for (auto& var : instr->inputs) {
+        var_used_count_[var.get()]++;
+      }
+    }
+  }
+
+  // Get the instruction producing `var`, if `var` is only used by its consumer in the pattern.
+  const Instruction* GetProducer(const Variable& var,
+                                 const std::string& op_type,
+                                 const std::unordered_set<std::string>& fetch_ids) const {
+    auto it = output2instr_.find(var.get());
+    if (it == output2instr_.end() || it->second->op_type != op_type || it->second->outputs.size() != 1) {
+      return nullptr;
+    }
+    if (var_used_count_.at(var.get()) > 1 || fetch_ids.count(var->id)) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  template <typename T>
+  static T GetAttrOrDefault(const Instruction& instr, const std::string& name, T default_value) {
+    return instr->attrs.count(name) ? instr.GetAttrs<T>(name) : default_value;
+  }
+
+  bool MatchEpilogue(const Instruction& instr,
+                     const std::unordered_set<std::string>& fetch_ids,
+                     Match* match) const {
+    if (instr->op_type == "relu") {
+      if (!MatchAdds(instr->inputs[0], 2, fetch_ids, match)) return false;
+      match->relu = true;
+    } else if (instr->op_type == "elementwise_add") {
+      if (!MatchAdd(instr, 1, fetch_ids, match)) return false;
+    } else {
+      return false;
+    }
+    match->instrs.push_back(instr.get());
+    return true;
+  }
+
+  // Match `var` as the conv2d followed by at most `depth` additions of the bias or the residual.
+  bool MatchAdds(const Variable& var,
+                 int depth,
+                 const std::unordered_set<std::string>& fetch_ids,
+                 Match* match) const {
+    if (MatchConv2d(var, fetch_ids, match)) return true;
+    if (depth == 0) return false;
+    auto* add = GetProducer(var, "elementwise_add", fetch_ids);
+    if (!add || !MatchAdd(*add, depth - 1, fetch_ids, match)) return false;
+    match->instrs.push_back(add->get());
+    return true;
+  }
+
+  // Match the addition of the bias or the residual to the conv2d followed by at most `depth` other additions.
+  bool MatchAdd(const Instruction& add,
+                int depth,
+                const std::unordered_set<std::string>& fetch_ids,
+                Match* match) const {
+    // either input of the addition may come from the conv2d
+    for (int k : {0, 1}) {
+      Match trial              = *match;
+      const auto& addend       = add->inputs[1 - k];
+      const auto& addend_shape = addend->shape;
+      if (!MatchAdds(add->inputs[k], depth, fetch_ids, &trial) || addend->type != trial.x->type) continue;
+      int axis = GetAttrOrDefault<int>(add, "axis", -1);
+      if (!trial.has_bias && addend_shape == std::vector<int>({trial.out_shape[3]}) && (axis == -1 || axis == 3)) {
+        trial.bias     = addend;
+        trial.has_bias = true;
+      } else if (!trial.has_residual && addend_shape == trial.out_shape) {
+        trial.residual     = addend;
+        trial.has_residual = true;
+      } else {
+        continue;
+      }
+      *match = std::move(trial);
+      return true;
+    }
+    return false;
+  }
+
+  bool MatchConv2d(const Variable& var, const std::unordered_set<std::string>& fetch_ids, Match* match) const {
+    auto* conv = GetProducer(var, "conv2d", fetch_ids);
+    if (!conv) return false;
+    const auto& x = (*conv)->inputs[0];
+    const auto& w = (*conv)->inputs[1];
+    if (GetAttrOrDefault<std::string>(*conv, "data_format", "NCHW") != "NHWC" ||
+        GetAttrOrDefault<std::string>(*conv, "conv_type", "forward") != "forward" ||
+        GetAttrOrDefault<int>(*conv, "groups", 1) != 1) {
+      return false;
+    }
+    if (!(x->type.is_float(32) || x->type.is_float(64)) || x->shape.size() != 4U || w->shape.size() != 4U ||
+        x->shape[3] != w->shape[1]) {
+      return false;
+    }
+    auto padding  = GetAttrOrDefault<std::vector<int>>(*conv, "padding", {0, 0});
+    auto stride   = GetAttrOrDefault<std::vector<int>>(*conv, "stride", {1, 1});
+    auto dilation = GetAttrOrDefault<std::vector<int>>(*conv, "dilation", {1, 1});
+    if (padding.size() != 2U || stride.size() != 2U || dilation.size() != 2U) return false;
+
+    match->x         = x;
+    match->w         = w;
+    match->padding   = padding;
+    match->stride    = stride;
+    match->dilation  = dilation;
+    match->out_shape = var->shape;
+    match->instrs.push_back(conv->get());
+    return true;
+  }
+
+  void ClearResources() {
+    output2instr_.clear();
+    var_used_count_.clear();
+  }
+
+  std::unordered_map<_Variable_*, Instruction> output2instr_;
+  std::unordered_map<_Variable_*, int> var_used_count_;
+};
+
+}  // namespace pass
+}  // namespace frontend
+}  // namespace cinn
+
+namespace fp = ::cinn::frontend::pass;
+CINN_REGISTER_HELPER(Conv2dEpilogueRewriter) {
+  CINN_REGISTER_PROGRAM_PASS(Conv2dEpilogueRewriter, fp::Conv2dEpilogueRewriterPass);
+
+  return true;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/pass/pass_test_helper.h"
+#include "cinn/hlir/op/use_ops.h"
+
+namespace cinn::frontend {
+
+int CountOp(const Program& program, const std::string& op_type) {
+  int count = 0;
+  for (int i = 0; i < program.size(); ++i) {
+    count += program[i]->op_type == op_type;
+  }
+  return count;
+}
+
+TEST(Conv2dEpilogueRewriter, BiasRelu) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {2, 14, 14, 16}, "X");
+  auto w       = builder.CreateInput(Float(32), {32, 16, 3, 3}, "W");
+  auto bias    = builder.CreateInput(Float(32), {32}, "Bias");
+  auto conv    = builder.Conv2d(x, w, {1, 1}, {1, 1}, {1, 1}, 1, "NHWC");
+  auto add     = builder.Add(conv, bias, -1);
+  auto out     = builder.Relu(add);
+  auto program = builder.Build();
+
+  // conv2d, elementwise_add and relu become a fused_conv2d_nhwc
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"Conv2dEpilogueRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {out->id}, 2, passes));
+  ASSERT_EQ(CountOp(program, "fused_conv2d_nhwc"), 1);
+  ASSERT_EQ(CountOp(program, "conv2d"), 0);
+}
+
+TEST(Conv2dEpilogueRewriter, BiasResidualRelu) {
+  NetBuilder builder("net_builder");
+  auto x        = builder.CreateInput(Float(32), {1, 15, 13, 8}, "X");
+  auto w        = builder.CreateInput(Float(32), {24, 8, 3, 3}, "W");
+  auto bias     = builder.CreateInput(Float(32), {24}, "Bias");
+  auto residual = builder.CreateInput(Float(32), {1, 8, 7, 24}, "Residual");
+  auto conv     = builder.Conv2d(x, w, {2, 2}, {1, 1}, {1, 1}, 1, "NHWC");
+  auto add0     = builder.Add(conv, bias, -1);
+  auto add1     = builder.Add(residual, add0);
+  auto out      = builder.Relu(add1);
+  auto program  = builder.Build();
+
+  // the strided conv2d and the residual coming first in the addition are matched as well
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"Conv2dEpilogueRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {out->id}, 3, passes));
+  ASSERT_EQ(CountOp(program, "fused_conv2d_nhwc"), 1);
+  ASSERT_EQ(CountOp(program, "relu"), 0);
+}
+
+TEST(Conv2dEpilogueRewriter, FetchedConv2d) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {1, 10, 10, 8}, "X");
+  auto w       = builder.CreateInput(Float(32), {16, 8, 1, 1}, "W");
+  auto bias    = builder.CreateInput(Float(32), {16}, "Bias");
+  auto conv    = builder.Conv2d(x, w, {1, 1}, {0, 0}, {1, 1}, 1, "NHWC");
+  auto out     = builder.Add(conv, bias, -1);
+  auto program = builder.Build();
+
+  // the output of the conv2d is still needed, so the pattern is kept
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"Conv2dEpilogueRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {out->id, conv->id}, 0, passes));
+  ASSERT_EQ(CountOp(program, "fused_conv2d_nhwc"), 0);
+}
+
+}  // namespace cinn::frontend
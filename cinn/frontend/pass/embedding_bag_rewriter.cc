@@ -0,0 +1,216 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/program_pass.h"
+#include "cinn/frontend/syntax.h"
+#include "glog/logging.h"
+
+namespace cinn {
+namespace frontend {
+namespace pass {
+
+// Pass `EmbeddingBagRewriter` rewrites the pooling over the looked-up rows
+//   rows = lookup_table(table, ids of [..., bag_size, 1])
+//   out  = reduce_sum(rows, dim=[-2]) [-> scale(1 / bag_size)] or reduce_max(rows, dim=[-2])
+// into one `embedding_bag` op, whose host kernel never materializes the rows.
+class EmbeddingBagRewriterPass : public ProgramPass {
+ public:
+  using ProgramPass::ProgramPass;
+
+ protected:
+  void Clear() override {}
+
+  void ApplyImpl(Program* prog,
+                 const std::unordered_set<std::string>& fetch_ids,
+                 const common::Target& target) override {
+    // only the host target has a fused embedding_bag kernel, the others decompose it again
+    if (target.arch != Target::Arch::X86 || !prog->size()) {
+      return;
+    }
+    CollectInfo(*prog);
+
+    std::unordered_map<_Instruction_*, Match> matches;
+    std::unordered_set<_Instruction_*> removed_instrs;
+    // visit the consumers first, so that a reduce_sum followed by the mean scale is matched as a whole
+    for (int i = prog->size() - 1; i >= 0; i--) {
+      auto& instr = (*prog)[i];
+      Match match;
+      if (!removed_instrs.count(instr.get()) && MatchEmbeddingBag(instr, fetch_ids, &match)) {
+        removed_instrs.insert(match.instrs.begin(), match.instrs.end());
+        matches.emplace(instr.get(), match);
+      }
+    }
+    if (matches.empty()) {
+      ClearResources();
+      return;
+    }
+
+    NetBuilder builder("embedding_bag_rewriter_builder");
+    for (auto& var : prog->GetInputs()) {
+      builder.CreateInput(var);
+    }
+    std::unordered_map<_Variable_*, Variable> origin2new;
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& instr = (*prog)[i];
+      auto it     = matches.find(instr.get());
+      if (it != matches.end()) {
+        auto& match     = it->second;
+        auto old_out    = instr.GetOutput(0);
+        auto& ids_shape = match.ids->shape;
+        int bag_size    = ids_shape[ids_shape.size() - 2];
+        int num_bags    = 1;
+        for (int j = 0; j < ids_shape.size() - 2; ++j) {
+          num_bags *= ids_shape[j];
+        }
+        auto ids     = builder.Reshape(match.ids, {num_bags, bag_size});
+        auto new_out = builder.EmbeddingBag(match.table, ids, match.mode, match.padding_idx);
+        if (new_out->shape != old_out->shape) {
+          new_out = builder.Reshape(new_out, old_out->shape);
+        }
+        new_out.set_id(old_out->id);
+        origin2new.emplace(old_out.get(), new_out);
+        VLOG(4) << "Rewrite " << match.instrs.size() << " instructions into embedding_bag " << old_out->id;
+      } else if (!removed_instrs.count(instr.get())) {
+        builder.AppendInstruction(instr);
+      }
+    }
+    *prog = builder.Build(true);
+
+    // relink old outputs to new outputs
+    for (size_t i = 0; i < prog->size(); i++) {
+      auto& inputs = (*prog)[i]->inputs;
+      for (size_t j = 0; j < inputs.size(); j++) {
+        if (origin2new.count(inputs[j].get())) {
+          inputs[j] = origin2new.at(inputs[j].get());
+        }
+      }
+    }
+    ClearResources();
+  }
+
+ private:
+  struct Match {
+    Variable table;
+    Variable ids;
+    std::string mode;
+    int64_t padding_idx{-1};
+    // the instructions replaced by the embedding_bag, including the last one
+    std::vector<_Instruction_*> instrs;
+  };
+
+  void CollectInfo(const Program& prog) {
+    for (size_t i = 0; i < prog.size(); i++) {
+      auto& instr = prog[i];
+      for (auto& var : instr->outputs) {
+        output2instr_.emplace(var.get(), instr);
+      }
+      for (auto& var : instr->inputs) {
+        var_used_count_[var.get()]++;
+      }
+    }
+  }
+
+  // Get the instruction producing `var`, if `var` is only used by its consumer in the pattern.
+  const Instruction* GetProducer(const Variable& var,
+                                 const std::string& op_type,
+                                 const std::unordered_set<std::string>& fetch_ids) const {
+    auto it = output2instr_.find(var.get());
+    if (it == output2instr_.end() || it->second->op_type != op_type || it->second->outputs.size() != 1) {
+      return nullptr;
+    }
+    if (var_used_count_.at(var.get()) > 1 || fetch_ids.count(var->id)) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  template <typename T>
+  static T GetAttrOrDefault(const Instruction& instr, const std::string& name, T default_value) {
+    return instr->attrs.count(name) ? instr.GetAttrs<T>(name) : default_value;
+  }
+
+  bool MatchEmbeddingBag(const Instruction& instr,
+                         const std::unordered_set<std::string>& fetch_ids,
+                         Match* match) const {
+    const Instruction* reduce = &instr;
+    std::vector<_Instruction_*> instrs{instr.get()};
+    float mean_scale = 0.0f;
+    if (instr->op_type == "scale") {
+      if (GetAttrOrDefault<float>(instr, "bias", 0.0f) != 0.0f) return false;
+      mean_scale = GetAttrOrDefault<float>(instr, "scale", 1.0f);
+      reduce     = GetProducer(instr->inputs[0], "reduce_sum", fetch_ids);
+      if (!reduce) return false;
+      instrs.push_back(reduce->get());
+    } else if (instr->op_type != "reduce_sum" && instr->op_type != "reduce_max") {
+      return false;
+    }
+
+    auto* lookup = GetProducer((*reduce)->inputs[0], "lookup_table", fetch_ids);
+    if (!lookup) return false;
+    const auto& table = (*lookup)->inputs[0];
+    const auto& ids   = (*lookup)->inputs[1];
+    // the bags are the rows of the ids of [..., bag_size, 1], which are reduced along bag_size
+    int rank = ids->shape.size();
+    if (rank < 3 || ids->shape.back() != 1 || !(table->type.is_float(32) || table->type.is_float(64))) {
+      return false;
+    }
+    auto dim = GetAttrOrDefault<std::vector<int>>(*reduce, "dim", {});
+    if (dim.size() != 1 || (dim[0] != rank - 2 && dim[0] != -2)) {
+      return false;
+    }
+    int bag_size = ids->shape[rank - 2];
+    if (instr->op_type == "scale") {
+      // a sum scaled by 1 / bag_size is the mean
+      if (std::abs(mean_scale * bag_size - 1.0f) > 1e-6f) return false;
+      match->mode = "mean";
+    } else {
+      match->mode = instr->op_type == "reduce_sum" ? "sum" : "max";
+    }
+    instrs.push_back(lookup->get());
+
+    match->table       = table;
+    match->ids         = ids;
+    match->padding_idx = GetAttrOrDefault<int64_t>(*lookup, "padding_idx", -1);
+    match->instrs      = std::move(instrs);
+    return true;
+  }
+
+  void ClearResources() {
+    output2instr_.clear();
+    var_used_count_.clear();
+  }
+
+  std::unordered_map<_Variable_*, Instruction> output2instr_;
+  std::unordered_map<_Variable_*, int> var_used_count_;
+};
+
+}  // namespace pass
+}  // namespace frontend
+}  // namespace cinn
+
+namespace fp = ::cinn::frontend::pass;
+CINN_REGISTER_HELPER(EmbeddingBagRewriter) {
+  CINN_REGISTER_PROGRAM_PASS(EmbeddingBagRewriter, fp::EmbeddingBagRewriterPass);
+
+  return true;
+}
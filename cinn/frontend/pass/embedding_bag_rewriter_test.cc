@@ -0,0 +1,92 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/pass/pass_test_helper.h"
+#include "cinn/hlir/op/use_ops.h"
+
+namespace cinn::frontend {
+
+int CountOp(const Program& program, const std::string& op_type) {
+  int count = 0;
+  for (int i = 0; i < program.size(); ++i) {
+    count += program[i]->op_type == op_type;
+  }
+  return count;
+}
+
+TEST(EmbeddingBagRewriter, SumAndMax) {
+  NetBuilder builder("net_builder");
+  auto table   = builder.CreateInput(Float(32), {100, 16}, "Table");
+  auto ids     = builder.CreateInput(Int(64), {4, 6, 1}, "Ids");
+  auto rows0   = builder.LookupTable(table, ids, 0);
+  auto sum     = builder.ReduceSum(rows0, {1});
+  auto rows1   = builder.LookupTable(table, ids, -1);
+  auto max     = builder.ReduceMax(rows1, {1});
+  auto program = builder.Build();
+
+  // every lookup_table and reduce become a reshape of ids and an embedding_bag
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"EmbeddingBagRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {sum->id, max->id}, 0, passes));
+  ASSERT_EQ(CountOp(program, "embedding_bag"), 2);
+  ASSERT_EQ(CountOp(program, "lookup_table"), 0);
+  for (int i = 0; i < program.size(); ++i) {
+    for (auto& out : program[i]->outputs) {
+      if (out->id == sum->id || out->id == max->id) {
+        ASSERT_EQ(out->shape, std::vector<int>({4, 16}));
+      }
+    }
+  }
+}
+
+TEST(EmbeddingBagRewriter, Mean) {
+  NetBuilder builder("net_builder");
+  auto table   = builder.CreateInput(Float(32), {100, 16}, "Table");
+  auto ids     = builder.CreateInput(Int(64), {2, 3, 5, 1}, "Ids");
+  auto rows    = builder.LookupTable(table, ids, -1);
+  auto sum     = builder.ReduceSum(rows, {2});
+  auto mean    = builder.Scale(sum, 1.0f / 5);
+  auto program = builder.Build();
+
+  // lookup_table, reduce_sum and scale become a reshape of ids, an embedding_bag and a reshape of the bags
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"EmbeddingBagRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {mean->id}, 0, passes));
+  ASSERT_EQ(CountOp(program, "embedding_bag"), 1);
+  ASSERT_EQ(CountOp(program, "reduce_sum"), 0);
+  ASSERT_EQ(CountOp(program, "scale"), 0);
+}
+
+TEST(EmbeddingBagRewriter, FetchedRows) {
+  NetBuilder builder("net_builder");
+  auto table   = builder.CreateInput(Float(32), {100, 16}, "Table");
+  auto ids     = builder.CreateInput(Int(64), {4, 6, 1}, "Ids");
+  auto rows    = builder.LookupTable(table, ids, -1);
+  auto sum     = builder.ReduceSum(rows, {1});
+  auto program = builder.Build();
+
+  // the looked-up rows are still needed, so the pattern is kept
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{}, {"EmbeddingBagRewriter"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, common::DefaultHostTarget(), {sum->id, rows->id}, 0, passes));
+  ASSERT_EQ(CountOp(program, "embedding_bag"), 0);
+}
+
+}  // namespace cinn::frontend
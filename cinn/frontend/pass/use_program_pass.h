@@ -23,6 +23,9 @@ CINN_USE_REGISTER(RemoveIdentity)
 CINN_USE_REGISTER(TransposeCollapsing)
 CINN_USE_REGISTER(TransposeFoldingInput)
 CINN_USE_REGISTER(GemmRewriter)
+CINN_USE_REGISTER(AttentionRewriter)
+CINN_USE_REGISTER(EmbeddingBagRewriter)
+CINN_USE_REGISTER(Conv2dEpilogueRewriter)
 CINN_USE_REGISTER(TransposeFoldingOutput)
 CINN_USE_REGISTER(FillConstantRewriter)
 CINN_USE_REGISTER(FillConstantFolding)
@@ -14,10 +14,15 @@
 
 #include "cinn/hlir/framework/buffer.h"
 
+#include <cstdint>
+#include <utility>
+
 namespace cinn {
 namespace hlir {
 namespace framework {
 
+constexpr uint32_t Buffer::kHostDataAlignment;
+
 void Buffer::Resize(uint32_t size) {
   if (size_ > 0) {
     Free();
@@ -49,6 +54,26 @@ void Buffer::SetTarget(const common::Target& target) {
   memory_mng_cache_ = MemoryManager::Global().RetrieveSafely(target_.arch);
 }
 
+void Buffer::ShareExternalMemory(void* memory,
+                                 uint32_t size,
+                                 const common::Target& target,
+                                 std::shared_ptr<void> holder) {
+  CHECK(memory) << "Can not share the null memory";
+  if (target.arch == common::Target::Arch::X86) {
+    CHECK_EQ(reinterpret_cast<uintptr_t>(memory) % kHostDataAlignment, 0)
+        << "The host memory shared should be aligned to " << kHostDataAlignment << " bytes";
+  }
+  Free();
+  if (target.arch != target_.arch) {
+    SetTarget(target);
+  }
+  data_.memory      = reinterpret_cast<uint8_t*>(memory);
+  data_.memory_size = size;
+  size_             = size;
+  is_external_      = true;
+  external_holder_  = std::move(holder);
+}
+
 void Buffer::ResizeLazy(uint32_t size) {
   if (size <= size_) return;
   Resize(size);
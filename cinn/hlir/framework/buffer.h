@@ -53,15 +53,34 @@ struct Buffer final {
 
   void SetTarget(const common::Target& target);
 
+  /**
+   * Point to the memory of \p size bytes owned by others instead of allocating, the memory is kept alive by \p holder
+   * until the buffer is resized or freed. The host memory should be aligned to kHostDataAlignment.
+   */
+  void ShareExternalMemory(void* memory, uint32_t size, const common::Target& target, std::shared_ptr<void> holder);
+
+  //! Whether the memory is owned by others.
+  bool is_external() const { return is_external_; }
+
+  const common::Target& target() const { return target_; }
+
   const cinn_buffer_t* data() const { return &data_; }
   cinn_buffer_t* data() { return &data_; }
 
-  //! Free all the memory owned by this buffer.
+  //! Free all the memory owned by this buffer, or release the memory owned by others.
   void Free() {
     if (!data_.memory) return;
+    if (is_external_) {
+      external_holder_.reset();
+      is_external_ = false;
+      return;
+    }
     memory_mng_cache_->free(data_.memory);
   }
 
+  //! The alignment of the data the host kernels assume, see Module::Builder::AddBuffer.
+  static constexpr uint32_t kHostDataAlignment = 32;
+
  private:
   inline void* Malloc(uint32_t size) CINN_RESULT_SHOULD_USE {
     CHECK(memory_mng_cache_) << "Should set target first";
@@ -84,6 +103,10 @@ struct Buffer final {
 
   //! Hold the corresponding memory manager for speed.
   MemoryInterface* memory_mng_cache_{};
+
+  //! Whether the memory is owned by others, which is kept alive by the holder.
+  bool is_external_{false};
+  std::shared_ptr<void> external_holder_;
 };
 
 }  // namespace framework
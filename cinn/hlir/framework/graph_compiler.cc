@@ -32,6 +32,7 @@
 
 DECLARE_bool(cinn_ir_schedule);
 DECLARE_int32(cinn_parallel_compile_size);
+DECLARE_bool(cinn_lazy_compile);
 
 namespace cinn {
 namespace hlir {
@@ -75,6 +76,7 @@ Program::Program(const std::shared_ptr<Scope>& scope, std::vector<std::unique_pt
 }
 
 void Program::PreRun(const std::map<std::string, cinn_pod_value_t>* name2podargs) {
+  CHECK(!args_binding_) << "The arguments should be bound after PreRun, which removes functions of the instructions";
   for (auto& ins : prerun_instrs_) {
     ins->Run(name2podargs);
   }
@@ -220,6 +222,17 @@ void Program::Execute(const std::map<std::string, cinn_pod_value_t>* name2podarg
 #endif
 }
 
+ArgsBinding* Program::GetArgsBinding() {
+  if (!args_binding_) {
+    args_binding_ = std::make_unique<ArgsBinding>();
+    for (auto& ins : instrs_) {
+      ins->BindArgs(args_binding_.get());
+    }
+    VLOG(3) << "Bind " << args_binding_->num_slots() << " arguments of " << instrs_.size() << " instructions";
+  }
+  return args_binding_.get();
+}
+
 void Program::ExecuteTest(int repeat_) {
   cinn::utils::Timer timer1;
   for (int i = 0; i < 100; i++) {
@@ -279,6 +292,14 @@ std::string GraphCompiler::GenSourceCode() {
   return compiler_->GetSourceCode(build_module);
 }
 
+std::string GraphCompiler::GetLazyCompileReport() const {
+  if (parallel_compiler_) {
+    return parallel_compiler_->GetLazyCompileReport();
+  }
+  CHECK(compiler_) << "The graph is not compiled yet";
+  return compiler_->LazyCompileReport();
+}
+
 const std::string& GraphCompiler::GetOrGenFullFuncName(const std::string& prefix) {
   // try_emplace only insert once, so the same function
   // can get a consistent name next time
@@ -763,7 +784,8 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
     VLOG(2) << "Compile With Parallel Compiler!";
     utils::RecordEvent("GraphCompiler CompileResult", utils::EventType::kOrdinary);
     ParallelCompiler::CompileOptions option;
-    option.lowered_funcs = options.lowered_funcs;
+    option.lowered_funcs         = options.lowered_funcs;
+    option.llvm_optimize_options = options.llvm_optimize_options;
 
     parallel_compiler_ = std::make_shared<ParallelCompiler>(scope_, graph_, option, target_);
     auto instructions  = (*parallel_compiler_.get())();
@@ -780,6 +802,9 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
 
     GraphCompiler::CompilationResult compilation_result;
     compilation_result.runtime_program.reset(new Program(scope_, std::move(instructions)));
+    if (target_ == common::DefaultHostTarget()) {
+      compilation_result.host_objects = parallel_compiler_->GetObjects();
+    }
     return compilation_result;
   }
 
@@ -870,7 +895,9 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
   // compile the module
   // Need to create a new compiler for every call of Build,
   // because the underneath jit engine does't support addIRModule repeatedly now.
-  compiler_ = backends::Compiler::Create(target_);
+  backends::ExecutionOptions execution_options;
+  execution_options.lazy_compile = FLAGS_cinn_lazy_compile;
+  compiler_                      = backends::Compiler::Create(target_, execution_options);
 
   auto build_module = m_builder_.Build();
   VLOG(3) << "End of m_builder_.Build()";
@@ -884,12 +911,20 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
 
   {
     utils::RecordEvent("GraphCompiler BackendsBuild", utils::EventType::kOrdinary);
-    compiler_->Build(build_module, options.attached_code);
+    compiler_->Build(build_module, options.attached_code, options.llvm_optimize_options);
     VLOG(3) << "End of compiler_->Build";
   }
 
   auto instructions = BuildInstructions(groups, options.groups.empty() ? graph_->fusion_groups : options.groups);
   VLOG(3) << "End of BuildInstructions";
+  if (FLAGS_cinn_lazy_compile) {
+    std::vector<std::string> fn_names;
+    for (auto& instr : instructions) {
+      auto names = instr->GetFnNames();
+      fn_names.insert(fn_names.end(), names.begin(), names.end());
+    }
+    compiler_->CompileAhead(fn_names);
+  }
   if (options.remove_unused_variables) {
     RemoveInvalidVariables(instructions);
   }
@@ -65,6 +65,13 @@ class Program {
 
   void ExecuteTest(int repeat_);
 
+  /**
+   * Get the binding of the arguments of the runtime instructions, created on the first call after PreRun. The
+   * arguments rebound by it every execution take effect when executing without \p name2podargs and with the cache,
+   * which saves the lookups of all the arguments by names in each run of the instructions.
+   */
+  ArgsBinding* GetArgsBinding();
+
   /**
    * Get the number of instructions.
    */
@@ -80,6 +87,7 @@ class Program {
   std::vector<std::unique_ptr<Instruction>> prerun_instrs_;
   // only runtime instructions
   std::vector<std::unique_ptr<Instruction>> instrs_;
+  std::unique_ptr<ArgsBinding> args_binding_;
 };
 
 /**
@@ -92,6 +100,9 @@ class GraphCompiler final {
 
   struct CompilationResult {
     std::unique_ptr<Program> runtime_program;
+    // the host objects the functions of runtime_program are compiled into by the parallel compiler,
+    // which can be loaded to run them in another process, empty if compiled lazily
+    std::vector<std::string> host_objects;
   };
 
   struct CompileOptions {
@@ -105,6 +116,8 @@ class GraphCompiler final {
     // corresponding LoweredFuncs of above grouped nodes,
     // if it is empty then graph_compiler will generate for them
     std::vector<std::vector<ir::LoweredFunc>> lowered_funcs;
+    // the LLVM pipeline to optimize the host code with, e.g. a fast-compile one for the candidates of auto-tune
+    backends::OptimizeOptions llvm_optimize_options;
 
     // apply results of auto-tune to compile
     void Apply(const auto_schedule::TuningResult& tuning_result);
@@ -116,6 +129,9 @@ class GraphCompiler final {
                           void* stream                                    = nullptr);
   void ExportObject(const std::string& path) { compiler_->ExportObject(path); }
 
+  //! Report which functions have been compiled ahead and which on their first calls with FLAGS_cinn_lazy_compile.
+  std::string GetLazyCompileReport() const;
+
   std::unique_ptr<Program> Build(const std::string& code = "");
 
   std::string GenSourceCode();
@@ -105,6 +105,39 @@ void Instruction::UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>*
   }
 }
 
+void Instruction::BindArgs(ArgsBinding* binding) {
+  CHECK(finalized_flag_) << "Instruction must be finalized before binding its arguments";
+  bool init_cache = args_cached_.size() != size();
+  args_cached_.resize(size());
+
+  for (int i = 0; i < size(); ++i) {
+    std::vector<std::string> all_args = in_args_[i];
+    all_args.insert(std::end(all_args), out_args_[i].begin(), out_args_[i].end());
+    if (init_cache) {
+      args_cached_[i].resize(all_args.size());
+    }
+    CHECK_EQ(args_cached_[i].size(), all_args.size());
+
+    for (int j = 0; j < all_args.size(); ++j) {
+      binding->AddPosition(all_args[j], this, i, j);
+      auto* var = init_cache && scope_ ? scope_->FindVar(all_args[j]) : nullptr;
+      if (var) {
+        args_cached_[i][j] = cinn_pod_value_t(absl::get<Tensor>(*var)->buffer());
+      }
+    }
+  }
+}
+
+void ArgsBinding::AddPosition(const std::string& name, Instruction* instr, int fn_idx, int arg_idx) {
+  auto it = slots_.find(name);
+  if (it == slots_.end()) {
+    it = slots_.emplace(name, names_.size()).first;
+    names_.push_back(name);
+    positions_.emplace_back();
+  }
+  positions_[it->second].push_back(Position{instr, fn_idx, arg_idx});
+}
+
 void Instruction::Finalize() {
   if (fn_ptrs_.size() > 1 && fn_ptrs_.size() != in_args_.size()) {
     out_args_.back()[0] = out_args_.front()[0];
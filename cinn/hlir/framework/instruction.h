@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
+
 #include <map>
 #include <string>
 #include <utility>
@@ -31,6 +33,8 @@ namespace cinn {
 namespace hlir {
 namespace framework {
 
+class ArgsBinding;
+
 /**
  * Instruction is the basic executable element in runtime, it holds a pointer to the JIT-compiled LoweredFunc, and
  * collect the cinn_buffer of the inputs and outputs from the scope, prepare the arguments and finally pass them into
@@ -68,6 +72,16 @@ class Instruction {
   void Finalize();
 
   void UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>* name2podargs);
+
+  /**
+   * Register the position of each argument in \p binding, and keep the cached arguments for the values bound by it.
+   * The arguments found in the scope are bound to their buffers initially.
+   */
+  void BindArgs(ArgsBinding* binding);
+
+  //! Set the \p arg_idx-th argument of the \p fn_idx-th function, the inputs come before the outputs.
+  void BindArg(int fn_idx, int arg_idx, const cinn_pod_value_t& value) { args_cached_[fn_idx][arg_idx] = value; }
+
   /**
    * Run the Instruction.
    */
@@ -122,6 +136,8 @@ class Instruction {
   void ClearInArgs() { in_args_.clear(); }
   void ClearOutArgs() { out_args_.clear(); }
   std::vector<std::string> GetFnNames() { return fn_names_; }
+  std::vector<void*> GetFnPtrs() { return fn_ptrs_; }
+  std::string GetFunctionName() { return function_name_; }
   void AddInArgs(const std::vector<std::string>& in_args) { in_args_.push_back(in_args); }
   void AddOutArgs(const std::vector<std::string>& out_args) { out_args_.push_back(out_args); }
   std::vector<int> attrs;
@@ -145,6 +161,52 @@ class Instruction {
   std::vector<std::string> fn_names_;
 };
 
+/**
+ * ArgsBinding numbers the arguments of some instructions by slots once, then binds the arguments of each execution
+ * by the slots. Binding a slot writes the value into the cached arguments of the instructions taking it, so the
+ * instructions run with the cache without looking up the names in a map or the scope and rebuilding the arguments.
+ */
+class ArgsBinding {
+ public:
+  //! Get the slot of the argument \p name, -1 if no instruction takes it.
+  int GetSlot(const std::string& name) const {
+    auto it = slots_.find(name);
+    return it == slots_.end() ? -1 : it->second;
+  }
+
+  size_t num_slots() const { return names_.size(); }
+
+  const std::string& GetName(int slot) const { return names_.at(slot); }
+
+  //! Bind \p value to the argument of \p slot in all the instructions taking it for the following runs.
+  void Bind(int slot, const cinn_pod_value_t& value) {
+    CHECK(slot >= 0 && slot < positions_.size()) << "Invalid argument slot " << slot;
+    for (auto& pos : positions_[slot]) {
+      pos.instr->BindArg(pos.fn_idx, pos.arg_idx, value);
+    }
+  }
+
+  void Bind(const std::string& name, const cinn_pod_value_t& value) {
+    int slot = GetSlot(name);
+    CHECK_GE(slot, 0) << "Argument [" << name << "] is not taken by any instruction";
+    Bind(slot, value);
+  }
+
+  //! Add a position of the argument \p name, which gets a new slot when it is added for the first time.
+  void AddPosition(const std::string& name, Instruction* instr, int fn_idx, int arg_idx);
+
+ private:
+  struct Position {
+    Instruction* instr;
+    int fn_idx;
+    int arg_idx;
+  };
+
+  absl::flat_hash_map<std::string, int> slots_;
+  std::vector<std::string> names_;
+  std::vector<std::vector<Position>> positions_;
+};
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -155,6 +155,68 @@ TEST(Instruction, RunWithRawPodArgs) {
   check_equal_by_element();
 }
 
+TEST(Instruction, RunWithArgsBinding) {
+  const int M       = 10;
+  const int N       = 20;
+  const auto& shape = Shape({M, N});
+
+  auto jit    = GetLoweredFunc(M, N);
+  auto fn_ptr = jit->Lookup("fn");
+  CHECK(fn_ptr);
+  Scope scope;
+  InstantiateScope(M, N, &scope);
+  Instruction instr(common::DefaultHostTarget(), &scope, {"x", "y"}, {"z"});
+  instr.SetLoweredFunc(reinterpret_cast<void*>(fn_ptr));
+  instr.Finalize();
+
+  ArgsBinding binding;
+  instr.BindArgs(&binding);
+  ASSERT_EQ(binding.num_slots(), 3);
+  ASSERT_EQ(binding.GetSlot("y"), 1);
+  ASSERT_EQ(binding.GetName(2), "z");
+  ASSERT_EQ(binding.GetSlot("w"), -1);
+
+  // the arguments are bound to the buffers of the scope initially
+  instr.Run();
+  auto xd = reinterpret_cast<float*>(scope.GetTensor("x")->buffer()->memory);
+  auto yd = reinterpret_cast<float*>(scope.GetTensor("y")->buffer()->memory);
+  auto zd = reinterpret_cast<float*>(scope.GetTensor("z")->buffer()->memory);
+  for (int i = 0; i < M * N; ++i) {
+    ASSERT_NEAR(xd[i] + yd[i], zd[i], 1e-5);
+  }
+
+  // rebind the inputs and the output to external buffers by the slots
+  std::vector<cinn_buffer_t> args_buffer(3);
+  auto* default_memory_mng = MemoryManager::Global().RetrieveSafely(common::DefaultHostTarget().arch);
+  for (auto& buffer : args_buffer) {
+    buffer.resize(reinterpret_cast<const cinn_dimension_t*>(shape.data().data()), shape.size());
+    buffer.memory = reinterpret_cast<uint8_t*>(default_memory_mng->malloc(shape.numel() * sizeof(float)));
+    auto* data    = reinterpret_cast<float*>(buffer.memory);
+    for (int i = 0; i < M * N; i++) {
+      data[i] = (rand() * 1.f) / RAND_MAX;  // NOLINT
+    }
+  }
+  int x_slot = binding.GetSlot("x");
+  int y_slot = binding.GetSlot("y");
+  int z_slot = binding.GetSlot("z");
+  for (int k = 0; k < 2; ++k) {
+    binding.Bind(x_slot, cinn_pod_value_t(&args_buffer[k]));
+    binding.Bind(y_slot, cinn_pod_value_t(&args_buffer[1 - k]));
+    binding.Bind(z_slot, cinn_pod_value_t(&args_buffer[2]));
+    instr.Run();
+
+    auto ad = reinterpret_cast<float*>(args_buffer[0].memory);
+    auto bd = reinterpret_cast<float*>(args_buffer[1].memory);
+    auto cd = reinterpret_cast<float*>(args_buffer[2].memory);
+    for (int i = 0; i < M * N; ++i) {
+      ASSERT_NEAR(ad[i] + bd[i], cd[i], 1e-5);
+    }
+  }
+  for (auto& buffer : args_buffer) {
+    default_memory_mng->free(buffer.memory);
+  }
+}
+
 #ifdef CINN_WITH_CUDNN
 
 class TestInstruction : public Instruction {
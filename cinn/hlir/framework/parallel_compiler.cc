@@ -26,10 +26,15 @@
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/backends/nvrtc/nvrtc_util.h"
 #include "cinn/common/context.h"
+#include "cinn/hlir/framework/op_lowering_util.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/ir/module.h"
+#include "cinn/utils/multi_threading.h"
+#include "cinn/utils/timer.h"
 
 DECLARE_int32(cinn_parallel_compile_size);
+DECLARE_int32(cinn_parallel_compile_thread);
+DECLARE_bool(cinn_lazy_compile);
 
 namespace cinn {
 namespace hlir {
@@ -43,12 +48,25 @@ std::vector<std::unique_ptr<Instruction>> ParallelCompiler::operator()() {
   if (graph_->fusion_groups.size() == 0) {
     hlir::framework::ApplyPasses(graph_.get(), {"BuildNonFusedGroupsPass"});
   }
+  // All the tasks link their modules into one engine, so that only one JIT session is kept for the graph.
+  backends::ExecutionOptions execution_options;
+  execution_options.lazy_compile = FLAGS_cinn_lazy_compile;
+  engine_                        = backends::ExecutionEngine::Create(execution_options);
   // Task Spilt
   SplitTask();
   // launch task
   LaunchTask();
   // merge instruction
-  return MergeResult();
+  auto instructions = MergeResult();
+  if (FLAGS_cinn_lazy_compile) {
+    std::vector<std::string> fn_names;
+    for (auto& instr : instructions) {
+      auto names = instr->GetFnNames();
+      fn_names.insert(fn_names.end(), names.begin(), names.end());
+    }
+    engine_->CompileAhead(fn_names);
+  }
+  return instructions;
 }
 
 OpPatternKind GetOpKind(const framework::Node* node) {
@@ -66,16 +84,67 @@ OpPatternKind GetOpKind(const framework::Node* node) {
   return kind;
 }
 
+// Estimate the cost to lower and compile a group by the size of the loop nests it generates, that is the number of
+// the ops weighted by their kinds and the ranks of their outputs.
+double ParallelCompiler::EstimateCost(const std::shared_ptr<Graph::Group>& group) const {
+  auto& shape_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  double cost      = 0;
+  for (auto* node : group->CollectNodes()) {
+    double weight = 1;
+    switch (GetOpKind(node)) {
+      case framework::kReduction:
+        weight = 2;
+        break;
+      case framework::kOutFusible:
+      case framework::kNonFusible:
+        weight = 4;
+        break;
+      default:
+        break;
+    }
+    auto* node_data = GetNodeData(node);
+    int rank        = (node_data && shape_dict.count(node_data->id())) ? shape_dict.at(node_data->id()).size() : 1;
+    cost += weight * (1 + rank);
+  }
+  return cost;
+}
+
 void ParallelCompiler::SplitTask() {
   CHECK(graph_->fusion_groups.size());
   CHECK(graph_->fusion_groups.size() == option_.lowered_funcs.size() || option_.lowered_funcs.size() == 0);
-  // split task
-  int num_per_task = std::max((graph_->fusion_groups.size() - 1) / FLAGS_cinn_parallel_compile_size + 1, 16UL);
+  int num_groups = graph_->fusion_groups.size();
+  group_compile_times_.assign(num_groups, GroupCompileTime());
 
-  for (int idx = 0; idx < graph_->fusion_groups.size(); idx += num_per_task) {
-    tasks_.emplace_back(this, scope_, graph_, option_, target_);
+  std::vector<int> order(num_groups);
+  double total_cost = 0;
+  for (int idx = 0; idx < num_groups; ++idx) {
+    order[idx]                               = idx;
+    group_compile_times_[idx].group_idx      = idx;
+    group_compile_times_[idx].estimated_cost = EstimateCost(graph_->fusion_groups[idx]);
+    total_cost += group_compile_times_[idx].estimated_cost;
   }
-  VLOG(2) << "Split task to " << tasks_.size() << " sub-task!";
+  // The most expensive groups are scheduled first, so that they never start last and delay the whole compilation.
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+    return group_compile_times_[a].estimated_cost > group_compile_times_[b].estimated_cost;
+  });
+
+  // Batch the groups into modules to save the overhead of each module, but keep a module within a fraction of the
+  // work of a thread so that the pool stays balanced. An expensive group is compiled alone.
+  int num_threads   = FLAGS_cinn_parallel_compile_thread > 0 ? FLAGS_cinn_parallel_compile_thread
+                                                             : std::thread::hardware_concurrency();
+  double budget     = total_cost / (std::max(num_threads, 1) * 4);
+  double batch_cost = 0;
+  for (int idx : order) {
+    double cost = group_compile_times_[idx].estimated_cost;
+    if (tasks_.empty() || tasks_.back().gidx.size() >= FLAGS_cinn_parallel_compile_size ||
+        batch_cost + cost > budget) {
+      tasks_.emplace_back(this, scope_, graph_, option_, target_);
+      batch_cost = 0;
+    }
+    tasks_.back().gidx.push_back(idx);
+    batch_cost += cost;
+  }
+  VLOG(2) << "Split " << num_groups << " groups to " << tasks_.size() << " sub-task!";
 }
 
 void RunTask(ParallelCompiler::Task* task) {
@@ -90,16 +159,32 @@ void RunTask(ParallelCompiler::Task* task) {
 }
 
 void ParallelCompiler::LaunchTask() {
-  // start sub-task.
-  std::vector<std::thread> threads;
-  for (int idx = 1; idx < tasks_.size(); ++idx) {
-    threads.emplace_back(RunTask, &tasks_[idx]);
+  // The tasks are pulled in order by a bounded number of threads.
+  int num_threads = FLAGS_cinn_parallel_compile_thread > 0 ? FLAGS_cinn_parallel_compile_thread : -1;
+  if (num_threads < 0 || num_threads > tasks_.size()) {
+    num_threads = std::min<int>(tasks_.size(), std::thread::hardware_concurrency());
   }
+  utils::parallel_run(
+      [this](int idx) { RunTask(&tasks_[idx]); }, utils::SequenceDispatcher(0, tasks_.size()), num_threads);
 
-  RunTask(&tasks_[0]);
-  // syncthreads.
-  for (auto& worker : threads) {
-    worker.join();
+  for (auto& task : tasks_) {
+    for (int idx = 0; idx < task.gidx.size(); ++idx) {
+      auto& time                = group_compile_times_[task.gidx[idx]];
+      time.lowering_ms          = task.lowering_ms[idx];
+      time.codegen_ms           = task.codegen_ms;
+      time.num_groups_in_module = task.gidx.size();
+    }
+  }
+  if (VLOG_IS_ON(2)) {
+    auto times = group_compile_times_;
+    std::sort(times.begin(), times.end(), [](const GroupCompileTime& a, const GroupCompileTime& b) {
+      return a.lowering_ms + a.codegen_ms > b.lowering_ms + b.codegen_ms;
+    });
+    for (int idx = 0; idx < std::min<int>(times.size(), 10); ++idx) {
+      VLOG(2) << "Group " << times[idx].group_idx << " : estimated cost " << times[idx].estimated_cost << ", lowering "
+              << times[idx].lowering_ms << " ms, codegen " << times[idx].codegen_ms << " ms with "
+              << times[idx].num_groups_in_module << " groups";
+    }
   }
 }
 
@@ -121,23 +206,21 @@ void ParallelCompiler::Task::Lowering() {
   auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
 
   OpLowerer op_lowerer(dtype_dict, shape_dict, target);
-  while (true) {
-    int idx = compiler->GetGroupIdx();
-    if (idx < 0) {
-      break;
-    }
-
-    gidx.push_back(idx);
+  utils::Timer timer;
+  for (int idx : gidx) {
     if (options.lowered_funcs.size()) {
       lowered_funcs.push_back(options.lowered_funcs[idx]);
+      lowering_ms.push_back(0);
       continue;
     }
+    timer.Start();
     auto& group = graph->fusion_groups[idx];
     VLOG(1) << "=============================================";
     VLOG(1) << "Lowering Group:\n" << graph->DebugGroupedGraph(group->CollectNodes());
     VLOG(1) << "=============================================";
     lowered_funcs.emplace_back(std::move(op_lowerer.Lower(group)));
     CHECK_EQ(lowered_funcs.back().size(), 1) << "Lowerd Function Is Not Equal 1!";
+    lowering_ms.push_back(timer.Stop());
   }
 }
 
@@ -149,7 +232,10 @@ void ParallelCompiler::Task::CodegenAndJit() {
     builder.AddFunction(func[0]);
   }
 
+  utils::Timer timer;
+  timer.Start();
   auto ir_module = builder.Build();
+  auto* engine   = compiler->engine_.get();
   // codegen compile
   if (target == common::DefaultNVGPUTarget()) {
 #ifdef CINN_WITH_CUDA
@@ -181,13 +267,13 @@ void ParallelCompiler::Task::CodegenAndJit() {
       CHECK(cufunc);
       symbols.RegisterVar(fn->name + "_ptr_", reinterpret_cast<void*>(cufunc));
     }
-    engine = backends::ExecutionEngine::Create(backends::ExecutionOptions(), std::move(symbols));
-    engine->Link<backends::CodeGenCUDA_Host>(hmodule);
+    engine->RegisterModuleRuntimeSymbols(std::move(symbols));
+    engine->Link<backends::CodeGenCUDA_Host>(hmodule, options.llvm_optimize_options);
 #endif
   } else {
-    engine = backends::ExecutionEngine::Create(backends::ExecutionOptions());
-    engine->Link<backends::CodeGenX86>(ir_module);
+    engine->Link<backends::CodeGenX86>(ir_module, options.llvm_optimize_options);
   }
+  codegen_ms = timer.Stop();
 }
 
 void ParallelCompiler::Task::BuildInstruction() {
@@ -198,7 +284,7 @@ void ParallelCompiler::Task::BuildInstruction() {
     auto instr = std::unique_ptr<Instruction>(
         new Instruction(target, scope.get(), group->input_names, group->output_names, group->GetFuncName()));
 
-    auto fn_ptr = engine->Lookup(group->GetFuncName());
+    auto fn_ptr = compiler->engine_->Lookup(group->GetFuncName());
     CHECK(fn_ptr) << "Can't find jit function : " << group->GetFuncName();
     instr->SetLoweredFunc(reinterpret_cast<void*>(fn_ptr), group->GetFuncName());
 
@@ -207,15 +293,6 @@ void ParallelCompiler::Task::BuildInstruction() {
   }
 }
 
-int ParallelCompiler::GetGroupIdx() {
-  std::lock_guard<std::mutex> lock(mtx_);
-  if (index < graph_->fusion_groups.size()) {
-    return index++;
-  } else {
-    return -1;
-  }
-}
-
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
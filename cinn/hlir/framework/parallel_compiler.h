@@ -13,7 +13,6 @@
 // limitations under the License.
 #pragma once
 
-#include <mutex>
 #include <vector>
 
 #include "cinn/backends/llvm/execution_engine.h"
@@ -33,6 +32,18 @@ class ParallelCompiler {
  public:
   struct CompileOptions {
     std::vector<std::vector<ir::LoweredFunc>> lowered_funcs;
+    backends::OptimizeOptions llvm_optimize_options;
+  };
+
+  //! The time spent compiling a fusion group.
+  struct GroupCompileTime {
+    int group_idx{-1};
+    //! The estimated cost used to order the groups.
+    double estimated_cost{0};
+    float lowering_ms{0};
+    //! The time of the codegen and jit of the module the group is compiled into, with the other groups of it.
+    float codegen_ms{0};
+    int num_groups_in_module{0};
   };
 
  public:
@@ -44,7 +55,17 @@ class ParallelCompiler {
   ~ParallelCompiler() {}
   std::vector<std::unique_ptr<Instruction>> operator()();
 
+  //! Get the compile time of each fusion group after the compilation, indexed by the group index.
+  const std::vector<GroupCompileTime>& GetGroupCompileTimes() const { return group_compile_times_; }
+
+  //! Report which functions have been compiled ahead and which on their first calls with FLAGS_cinn_lazy_compile.
+  std::string GetLazyCompileReport() const { return engine_->LazyCompileReport(); }
+
+  //! Get the host objects the functions are compiled into, empty with FLAGS_cinn_lazy_compile.
+  std::vector<std::string> GetObjects() const { return engine_->GetObjects(); }
+
  private:
+  double EstimateCost(const std::shared_ptr<Graph::Group>& group) const;
   void SplitTask();
   void LaunchTask();
   std::vector<std::unique_ptr<Instruction>> MergeResult();
@@ -72,24 +93,25 @@ class ParallelCompiler {
     std::vector<int> gidx;
     std::vector<std::unique_ptr<Instruction>> instructions;
     std::vector<std::vector<ir::LoweredFunc>> lowered_funcs;
+    std::vector<float> lowering_ms;
+    float codegen_ms{0};
 
    public:
-    std::unique_ptr<backends::ExecutionEngine> engine;
 #ifdef CINN_WITH_CUDA
     std::unique_ptr<runtime::cuda::CUDAModule> cumodule;
 #endif
   };
   std::vector<Task> tasks_;
-  int GetGroupIdx();
 
  private:
-  int index{0};
-  std::mutex mtx_;
-
   const common::Target target_;
   const CompileOptions& option_;
   std::shared_ptr<Scope> scope_;
   std::shared_ptr<Graph> graph_;
+
+  //! The modules of all the tasks are linked into the engine, which owns the compiled functions.
+  std::unique_ptr<backends::ExecutionEngine> engine_;
+  std::vector<GroupCompileTime> group_compile_times_;
 };
 
 }  // namespace framework
@@ -78,6 +78,37 @@ TEST(ParallelCompilerTest, Matmul_Test_0) {
   auto runtime_program = pc();
 }
 
+TEST(ParallelCompilerTest, Host_Test_0) {
+  frontend::NetBuilder builder("Host_Test_0");
+  auto A = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto B = builder.CreateInput(Float(32), {32, 64}, "B");
+  auto C = builder.Add(A, B);
+  auto D = builder.Relu(C);
+  auto E = builder.ReduceSum(D, {1});
+  auto F = builder.Multiply(A, D);
+
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = std::make_shared<Graph>(program, target);
+  auto scope   = BuildScope(target, graph);
+
+  ParallelCompiler::CompileOptions option;
+  ParallelCompiler pc(scope, graph, option, target);
+  auto instructions = pc();
+  // every op is a group, all of them are linked into the engine of the compiler.
+  ASSERT_EQ(instructions.size(), graph->fusion_groups.size());
+  for (auto& instr : instructions) {
+    ASSERT_TRUE(instr);
+  }
+  auto& times = pc.GetGroupCompileTimes();
+  ASSERT_EQ(times.size(), graph->fusion_groups.size());
+  for (int idx = 0; idx < times.size(); ++idx) {
+    ASSERT_EQ(times[idx].group_idx, idx);
+    ASSERT_GT(times[idx].estimated_cost, 0);
+    ASSERT_GE(times[idx].num_groups_in_module, 1);
+  }
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "cinn/common/common.h"
@@ -82,6 +83,18 @@ class _Tensor_ : public Object {
     return reinterpret_cast<T*>(buffer_->data()->memory);
   }
 
+  /**
+   * Alias the memory of \p data owned by others instead of allocating, which is kept alive by \p holder. The buffer is
+   * updated in place, so the tensors sharing the buffer and the instructions reading it see the memory too.
+   */
+  inline void ShareExternalData(void* data,
+                                const Type& type,
+                                const Target& target,
+                                std::shared_ptr<void> holder = nullptr) {
+    set_type(type);
+    buffer_->ShareExternalMemory(data, shape_.numel() * type.bytes(), target, std::move(holder));
+  }
+
   template <typename T>
   const T* data() const {
     return reinterpret_cast<T*>(buffer_->data()->memory);
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -31,6 +33,35 @@ TEST(Tensor, basic) {
   }
 }
 
+TEST(Tensor, share_external_data) {
+  Tensor tensor;
+  tensor->Resize(Shape{{3, 2}});
+  tensor->mutable_data<float>(common::DefaultHostTarget());
+
+  // Another tensor sharing the buffer, like the outputs of the reshape ops.
+  Tensor alias;
+  alias->Resize(Shape{{6}});
+  alias->set_buffer(tensor->get_buffer());
+
+  alignas(Buffer::kHostDataAlignment) float external[6] = {0, 1, 2, 3, 4, 5};
+  auto holder = std::make_shared<int>(0);
+  tensor->ShareExternalData(external, Float(32), common::DefaultHostTarget(), holder);
+  ASSERT_TRUE(tensor->get_buffer()->is_external());
+  ASSERT_EQ(tensor->data<float>(), external);
+  ASSERT_EQ(alias->data<float>(), external);
+  ASSERT_EQ(holder.use_count(), 2);
+
+  // The lazy resize within the size keeps the external memory.
+  ASSERT_EQ(tensor->mutable_data<float>(common::DefaultHostTarget()), external);
+
+  // Resizing out of the external memory allocates, and releases the holder.
+  tensor->Resize(Shape{{4, 4}});
+  auto* data = tensor->mutable_data<float>(common::DefaultHostTarget());
+  ASSERT_NE(data, external);
+  ASSERT_FALSE(tensor->get_buffer()->is_external());
+  ASSERT_EQ(holder.use_count(), 1);
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -0,0 +1,228 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/attention.h"
+
+#include <gflags/gflags.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/op_util.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::CINNValue;
+using common::CINNValuePack;
+
+namespace {
+
+// The scores are viewed as [batch, heads, seq_q, seq_kv], a rank 3 input has one head.
+std::vector<int> GetAttentionDims(const std::vector<int> &q_shape, const std::vector<int> &k_shape) {
+  CHECK(q_shape.size() == 3 || q_shape.size() == 4) << "The attention only supports inputs of rank 3 or 4";
+  CHECK_EQ(q_shape.size(), k_shape.size()) << "The query and key of attention should have the same rank";
+  int rank = q_shape.size();
+  for (int i = 0; i < rank - 2; ++i) {
+    CHECK_EQ(q_shape[i], k_shape[i]) << "The query and key of attention should have the same batch and heads";
+  }
+  CHECK_EQ(q_shape.back(), k_shape.back()) << "The query and key of attention should have the same head_dim";
+  int heads = rank == 4 ? q_shape[1] : 1;
+  return {q_shape[0], heads, q_shape[rank - 2], k_shape[rank - 2], q_shape.back()};
+}
+
+std::vector<int> ToInts(const std::vector<Expr> &shape) {
+  std::vector<int> res;
+  for (auto &dim : shape) {
+    CHECK(dim.is_constant()) << "The attention only supports static shapes";
+    res.push_back(dim.as_int32());
+  }
+  return res;
+}
+
+}  // namespace
+
+ir::Tensor Attention(const ir::Tensor &q,
+                     const ir::Tensor &k,
+                     const ir::Tensor &v,
+                     const ir::Tensor *mask,
+                     const common::Target &target,
+                     poly::StageMap stages,
+                     const float &scale,
+                     const bool &causal,
+                     const std::string &output_name) {
+  CHECK(target.arch == common::Target::Arch::X86) << "Attention only supports X86, other targets use its decomposer";
+  CHECK(std::isfinite(scale) && scale > 0.0f) << "The scale of attention should be positive, but received " << scale;
+  auto dims = GetAttentionDims(ToInts(q->shape), ToInts(k->shape));
+  CHECK(ToInts(v->shape) == ToInts(k->shape)) << "The value of attention should have the same shape as the key";
+
+  std::vector<Expr> args{q, k, v};
+  std::string func_name = "attention";
+  if (mask) {
+    // align the mask to the trailing dimensions of the scores, then view it as [batch, heads, seq_q, seq_kv]
+    auto mask_shape = ToInts((*mask)->shape);
+    CHECK_LE(mask_shape.size(), q->shape.size()) << "The mask of attention has more dimensions than the scores";
+    mask_shape.insert(mask_shape.begin(), q->shape.size() - mask_shape.size(), 1);
+    if (q->shape.size() == 3) {
+      mask_shape.insert(mask_shape.begin() + 1, 1);
+    }
+    CHECK_EQ(mask_shape[3], dims[3]) << "The last dimension of mask should be seq_kv";
+    args.push_back(*mask);
+    func_name = "masked_attention";
+    for (int i = 0; i < 5; ++i) args.push_back(Expr(dims[i]));
+    for (int i = 0; i < 3; ++i) args.push_back(Expr(mask_shape[i]));
+  } else {
+    for (int i = 0; i < 5; ++i) args.push_back(Expr(dims[i]));
+  }
+  args.push_back(Expr(scale));
+  args.push_back(common::make_bool(causal));
+
+  std::string extern_name = cinn::hlir::GetExternFuncName(target, q->type(), func_name);
+  auto call               = Compute(
+      {Expr(1)}, [=]() -> Expr { return lang::CallExtern(extern_name, args); }, output_name + "_call");
+  stages->InsertLazily(call);
+  auto out  = call->TupleGet(0);
+  out->name = output_name;
+  out->set_type(q->type());
+  out->WithBuffer(q->type());
+  return out;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForAttention(const framework::NodeAttr &attrs,
+                                                            const std::vector<ir::Tensor> &inputs,
+                                                            const std::vector<Type> &out_type,
+                                                            const std::vector<std::vector<int>> &output_shapes,
+                                                            const Target &target) {
+  auto attr_store = attrs.attr_store;
+  // the scale is optional, 1 / sqrt(head_dim) by default
+  float scale = 1.0f / std::sqrt(static_cast<float>(output_shapes[0].back()));
+  bool causal = false;
+  if (attr_store.count("scale")) {
+    scale = absl::get<float>(attr_store.at("scale"));
+  }
+  if (attr_store.count("causal")) {
+    causal = absl::get<bool>(attr_store.at("causal"));
+  }
+  size_t num_inputs = inputs.size();
+  CHECK(num_inputs == 3 || num_inputs == 4) << "The attention takes q, k, v and an optional mask";
+
+  framework::CINNCompute attention_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of Attention compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), num_inputs) << num_inputs << " input tensors for Attention compute\n";
+    std::vector<ir::Tensor> tensors;
+    for (int i = 0; i < num_inputs; ++i) {
+      Expr tensor = pack_args[i];
+      CHECK(tensor.as_tensor());
+      tensors.push_back(tensor.as_tensor_ref());
+    }
+    auto stages      = CreateStages(tensors);
+    auto output_name = UniqName("Attention_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), num_inputs + 1);
+      CHECK(pack_args[num_inputs].is_string());
+      output_name = pack_args[num_inputs].operator std::string();
+    }
+    auto out = Attention(tensors[0],
+                         tensors[1],
+                         tensors[2],
+                         num_inputs == 4 ? &tensors[3] : nullptr,
+                         target,
+                         stages,
+                         scale,
+                         causal,
+                         output_name);
+    stages->InsertLazily(out);
+    std::vector<CINNValue> res{CINNValue(out), CINNValue(stages)};
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule attention_schedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of attention schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      // the tiles are scheduled by the extern call itself
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(attention_compute, attention_schedule, "strategy.attention.x86", 1);
+  return strategy;
+}
+
+std::vector<std::vector<int>> InferShapeForAttention(const std::vector<std::vector<int>> &inputs_shape,
+                                                     const framework::AttrMapType &attrs) {
+  CHECK(inputs_shape.size() == 3UL || inputs_shape.size() == 4UL)
+      << "The attention takes q, k, v and an optional mask! Please check again.";
+  GetAttentionDims(inputs_shape[0], inputs_shape[1]);
+  CHECK(inputs_shape[1] == inputs_shape[2]) << "The value of attention should have the same shape as the key";
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForAttention(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(inputs_type.size() == 3UL || inputs_type.size() == 4UL)
+      << "The attention takes q, k, v and an optional mask! Please check again.";
+  return {inputs_type[0]};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(attention_ops) {
+  CINN_REGISTER_OP(attention)
+      .describe("Scaled dot-product attention softmax(q * k^T * scale + mask) * v, the mask is optional.")
+      .set_num_inputs(4)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForAttention)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForAttention))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForAttention))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  return true;
+}
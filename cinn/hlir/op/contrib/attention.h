@@ -0,0 +1,49 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Scaled dot-product attention softmax(q * k^T * scale + mask) * v in one kernel, which never materializes
+ *        the scores. Only the host target is supported, other targets use its decomposer.
+ * @param q The query of [batch, heads, seq_q, head_dim] or [batch, seq_q, head_dim].
+ * @param k The key of [batch, heads, seq_kv, head_dim] or [batch, seq_kv, head_dim].
+ * @param v The value of the same shape as k.
+ * @param mask The optional additive mask, broadcast to the scores of [batch, heads, seq_q, seq_kv].
+ * @param causal Whether the query i only attends to the keys up to i + seq_kv - seq_q.
+ */
+ir::Tensor Attention(const ir::Tensor& q,
+                     const ir::Tensor& k,
+                     const ir::Tensor& v,
+                     const ir::Tensor* mask,
+                     const common::Target& target,
+                     poly::StageMap stages,
+                     const float& scale,
+                     const bool& causal,
+                     const std::string& output_name);
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
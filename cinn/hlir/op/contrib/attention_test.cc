@@ -0,0 +1,89 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/attention.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/common/context.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+std::string CompileAttention(const std::vector<ir::Tensor>& args, poly::StageMap stages, const Target& target) {
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_Attention", stages, args, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("Attention_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  return code;
+}
+
+TEST(GenerateCode_Cpu, Attention) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+
+  lang::Placeholder<float> q("q", {Expr(2), Expr(4), Expr(16), Expr(32)});
+  lang::Placeholder<float> k("k", {Expr(2), Expr(4), Expr(24), Expr(32)});
+  lang::Placeholder<float> v("v", {Expr(2), Expr(4), Expr(24), Expr(32)});
+  auto stages = poly::CreateStages({q, k, v});
+  auto out    = Attention(q, k, v, nullptr, target, stages, 0.125f, true, "test_out");
+  stages->InsertLazily(out);
+
+  std::string code = CompileAttention({q, k, v, out}, stages, target);
+  ASSERT_NE(code.find("cinn_host_attention_fp32(_q, _k, _v, 2, 4, 16, 24, 32"), std::string::npos);
+}
+
+TEST(GenerateCode_Cpu, MaskedAttention) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+
+  // the rank 3 inputs have a single head, and the mask [batch, 1, seq_kv] is broadcast to all the queries
+  lang::Placeholder<float> q("q", {Expr(2), Expr(16), Expr(32)});
+  lang::Placeholder<float> k("k", {Expr(2), Expr(24), Expr(32)});
+  lang::Placeholder<float> v("v", {Expr(2), Expr(24), Expr(32)});
+  lang::Placeholder<float> mask("mask", {Expr(2), Expr(1), Expr(24)});
+  auto stages = poly::CreateStages({q, k, v, mask});
+  ir::Tensor mask_tensor(mask);
+  auto out = Attention(q, k, v, &mask_tensor, target, stages, 0.125f, false, "test_out");
+  stages->InsertLazily(out);
+
+  std::string code = CompileAttention({q, k, v, mask, out}, stages, target);
+  ASSERT_NE(code.find("cinn_host_masked_attention_fp32(_q, _k, _v, _mask, 2, 1, 16, 24, 32, 2, 1, 1"),
+            std::string::npos);
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,326 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/layer_norm.h"
+
+#include <gflags/gflags.h>
+
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/op_util.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::CINNValue;
+using common::CINNValuePack;
+
+namespace {
+
+// View the shape as [rows, cols], where cols covers the dimensions from begin_norm_axis on.
+std::pair<int, int> GetNormRowsAndCols(const std::vector<Expr> &shape, int begin_norm_axis) {
+  int rows = 1, cols = 1;
+  for (int i = 0; i < shape.size(); ++i) {
+    CHECK(shape[i].is_constant()) << "The normalization ops only support static shapes";
+    (i < begin_norm_axis ? rows : cols) *= shape[i].as_int32();
+  }
+  return {rows, cols};
+}
+
+int NormalizeNormAxis(int begin_norm_axis, int rank) {
+  if (begin_norm_axis < 0) {
+    begin_norm_axis += rank;
+  }
+  CHECK(begin_norm_axis >= 0 && begin_norm_axis < rank)
+      << "begin_norm_axis should be in [-" << rank << ", " << rank << "), but received " << begin_norm_axis;
+  return begin_norm_axis;
+}
+
+// Collect the lowered exprs of the extern call, which need no schedule.
+framework::CINNSchedule MakeNormSchedule(const std::string &op_name) {
+  return framework::CINNSchedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+}
+
+}  // namespace
+
+std::vector<ir::Tensor> LayerNorm(const ir::Tensor &x,
+                                  const ir::Tensor &scale,
+                                  const ir::Tensor &bias,
+                                  const common::Target &target,
+                                  poly::StageMap stages,
+                                  const int &begin_norm_axis,
+                                  const float &epsilon,
+                                  const std::vector<std::string> &output_names) {
+  CHECK(target.arch == common::Target::Arch::X86) << "LayerNorm only supports X86, other targets use its decomposer";
+  CHECK_EQ(output_names.size(), 3UL) << "LayerNorm outputs y, mean and variance";
+  int axis         = NormalizeNormAxis(begin_norm_axis, x->shape.size());
+  auto rows_cols   = GetNormRowsAndCols(x->shape, axis);
+  std::string func = cinn::hlir::GetExternFuncName(target, x->type(), "layer_norm");
+  auto call        = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(func,
+                                {
+                                    x,                       // x
+                                    scale,                   // scale
+                                    bias,                    // bias
+                                    Expr(rows_cols.first),   // rows
+                                    Expr(rows_cols.second),  // cols
+                                    Expr(epsilon),           // epsilon
+                                });
+      },
+      output_names[0] + "_call");
+  stages->InsertLazily(call);
+
+  std::vector<ir::Tensor> outs;
+  for (int i = 0; i < output_names.size(); ++i) {
+    auto out  = call->TupleGet(i);
+    out->name = output_names[i];
+    out->set_type(x->type());
+    out->WithBuffer(x->type());
+    outs.push_back(out);
+  }
+  return outs;
+}
+
+ir::Tensor RMSNorm(const ir::Tensor &x,
+                   const ir::Tensor &scale,
+                   const common::Target &target,
+                   poly::StageMap stages,
+                   const int &begin_norm_axis,
+                   const float &epsilon,
+                   const std::string &output_name) {
+  CHECK(target.arch == common::Target::Arch::X86) << "RMSNorm only supports X86, other targets use its decomposer";
+  int axis         = NormalizeNormAxis(begin_norm_axis, x->shape.size());
+  auto rows_cols   = GetNormRowsAndCols(x->shape, axis);
+  std::string func = cinn::hlir::GetExternFuncName(target, x->type(), "rms_norm");
+  auto call        = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(func,
+                                {
+                                    x,                       // x
+                                    scale,                   // scale
+                                    Expr(rows_cols.first),   // rows
+                                    Expr(rows_cols.second),  // cols
+                                    Expr(epsilon),           // epsilon
+                                });
+      },
+      output_name + "_call");
+  stages->InsertLazily(call);
+  auto y  = call->TupleGet(0);
+  y->name = output_name;
+  y->set_type(x->type());
+  y->WithBuffer(x->type());
+  return y;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForLayerNorm(const framework::NodeAttr &attrs,
+                                                            const std::vector<ir::Tensor> &inputs,
+                                                            const std::vector<Type> &out_type,
+                                                            const std::vector<std::vector<int>> &output_shapes,
+                                                            const Target &target) {
+  auto attr_store     = attrs.attr_store;
+  float epsilon       = 1e-5f;
+  int begin_norm_axis = 1;
+  if (attr_store.count("epsilon")) {
+    epsilon = absl::get<float>(attr_store.at("epsilon"));
+  }
+  if (attr_store.count("begin_norm_axis")) {
+    begin_norm_axis = absl::get<int>(attr_store.at("begin_norm_axis"));
+  }
+
+  framework::CINNCompute layer_norm_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of LayerNorm compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 3U) << "3 input tensors for LayerNorm compute\n";
+    Expr x     = pack_args[0];
+    Expr scale = pack_args[1];
+    Expr bias  = pack_args[2];
+    CHECK(x.as_tensor() && scale.as_tensor() && bias.as_tensor());
+    auto stages = CreateStages({x.as_tensor_ref(), scale.as_tensor_ref(), bias.as_tensor_ref()});
+    std::vector<std::string> output_names{
+        UniqName("LayerNorm_out"), UniqName("LayerNorm_mean"), UniqName("LayerNorm_variance")};
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 6U);
+      for (int i = 0; i < output_names.size(); ++i) {
+        CHECK(pack_args[3 + i].is_string());
+        output_names[i] = pack_args[3 + i].operator std::string();
+      }
+    }
+    auto out = LayerNorm(x.as_tensor_ref(),
+                         scale.as_tensor_ref(),
+                         bias.as_tensor_ref(),
+                         target,
+                         stages,
+                         begin_norm_axis,
+                         epsilon,
+                         output_names);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(layer_norm_compute, MakeNormSchedule("layer_norm"), "strategy.layer_norm.x86", 1);
+  return strategy;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForRMSNorm(const framework::NodeAttr &attrs,
+                                                          const std::vector<ir::Tensor> &inputs,
+                                                          const std::vector<Type> &out_type,
+                                                          const std::vector<std::vector<int>> &output_shapes,
+                                                          const Target &target) {
+  auto attr_store     = attrs.attr_store;
+  float epsilon       = 1e-6f;
+  int begin_norm_axis = -1;
+  if (attr_store.count("epsilon")) {
+    epsilon = absl::get<float>(attr_store.at("epsilon"));
+  }
+  if (attr_store.count("begin_norm_axis")) {
+    begin_norm_axis = absl::get<int>(attr_store.at("begin_norm_axis"));
+  }
+
+  framework::CINNCompute rms_norm_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of RMSNorm compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "2 input tensors for RMSNorm compute\n";
+    Expr x     = pack_args[0];
+    Expr scale = pack_args[1];
+    CHECK(x.as_tensor() && scale.as_tensor());
+    auto stages      = CreateStages({x.as_tensor_ref(), scale.as_tensor_ref()});
+    auto output_name = UniqName("RMSNorm_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[2].is_string());
+      output_name = pack_args[2].operator std::string();
+    }
+    auto out = RMSNorm(x.as_tensor_ref(), scale.as_tensor_ref(), target, stages, begin_norm_axis, epsilon, output_name);
+    stages->InsertLazily(out);
+    std::vector<CINNValue> res{CINNValue(out), CINNValue(stages)};
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(rms_norm_compute, MakeNormSchedule("rms_norm"), "strategy.rms_norm.x86", 1);
+  return strategy;
+}
+
+std::vector<std::vector<int>> InferShapeForLayerNorm(const std::vector<std::vector<int>> &inputs_shape,
+                                                     const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 3UL) << "The input's shape size should be 3! Please check again.";
+  const auto &x_shape = inputs_shape[0];
+  int begin_norm_axis = 1;
+  if (attrs.count("begin_norm_axis")) {
+    begin_norm_axis = absl::get<int>(attrs.at("begin_norm_axis"));
+  }
+  begin_norm_axis = NormalizeNormAxis(begin_norm_axis, x_shape.size());
+  int rows = 1, cols = 1;
+  for (int i = 0; i < x_shape.size(); ++i) {
+    (i < begin_norm_axis ? rows : cols) *= x_shape[i];
+  }
+  for (int i = 1; i < 3; ++i) {
+    int size = std::accumulate(inputs_shape[i].begin(), inputs_shape[i].end(), 1, std::multiplies<int>());
+    CHECK_EQ(size, cols) << "The scale and bias of layer_norm should have " << cols << " elements";
+  }
+  return {x_shape, {rows}, {rows}};
+}
+
+std::vector<Type> InferDtypeForLayerNorm(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 3UL) << "The input's type size should be 3! Please check again.";
+  return {inputs_type[0], inputs_type[0], inputs_type[0]};
+}
+
+std::vector<std::vector<int>> InferShapeForRMSNorm(const std::vector<std::vector<int>> &inputs_shape,
+                                                   const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2UL) << "The input's shape size should be 2! Please check again.";
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForRMSNorm(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 2UL) << "The input's type size should be 2! Please check again.";
+  return {inputs_type[0]};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(layer_norm_ops) {
+  CINN_REGISTER_OP(layer_norm)
+      .describe("Normalize the dimensions from begin_norm_axis on, then apply scale and bias.")
+      .set_num_inputs(3)
+      .set_num_outputs(3)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForLayerNorm)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForLayerNorm))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForLayerNorm))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(rms_norm)
+      .describe("Divide by the root mean square of the dimensions from begin_norm_axis on, then apply scale.")
+      .set_num_inputs(2)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForRMSNorm)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForRMSNorm))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForRMSNorm))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  return true;
+}
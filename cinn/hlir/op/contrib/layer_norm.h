@@ -0,0 +1,56 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Normalize the dimensions of x from begin_norm_axis on, with one read of x for the statistics.
+ *        Only the host target is supported, other targets use its decomposer.
+ * @return The normalized y, and the mean and variance of every normalized row.
+ */
+std::vector<ir::Tensor> LayerNorm(const ir::Tensor& x,
+                                  const ir::Tensor& scale,
+                                  const ir::Tensor& bias,
+                                  const common::Target& target,
+                                  poly::StageMap stages,
+                                  const int& begin_norm_axis,
+                                  const float& epsilon,
+                                  const std::vector<std::string>& output_names);
+
+/**
+ * @brief Divide x by the root mean square of the dimensions from begin_norm_axis on, then multiply scale.
+ *        Only the host target is supported, other targets use its decomposer.
+ */
+ir::Tensor RMSNorm(const ir::Tensor& x,
+                   const ir::Tensor& scale,
+                   const common::Target& target,
+                   poly::StageMap stages,
+                   const int& begin_norm_axis,
+                   const float& epsilon,
+                   const std::string& output_name);
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
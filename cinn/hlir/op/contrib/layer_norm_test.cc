@@ -0,0 +1,95 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/layer_norm.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/common/context.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+TEST(GenerateCode_Cpu, LayerNorm) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+
+  lang::Placeholder<float> x("x", {Expr(4), Expr(8), Expr(32)});
+  lang::Placeholder<float> scale("scale", {Expr(256)});
+  lang::Placeholder<float> bias("bias", {Expr(256)});
+  auto stages = poly::CreateStages({x, scale, bias});
+  auto out    = LayerNorm(x, scale, bias, target, stages, 1, 1e-5f, {"test_y", "test_mean", "test_variance"});
+  for (auto& t : out) {
+    stages->InsertLazily(t);
+  }
+  std::vector<ir::LoweredFunc> funcs = lang::LowerVec(
+      "TestGenerateCodeCpu_LayerNorm", stages, {x, scale, bias, out[0], out[1], out[2]}, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("LayerNorm_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  // x is viewed as [4, 256] and normalized by one runtime call
+  ASSERT_NE(code.find("cinn_host_layer_norm_fp32(_x, _scale, _bias, 4, 256"), std::string::npos);
+  // and writes the outputs of the op directly
+  ASSERT_NE(code.find("_test_y, _test_mean, _test_variance)"), std::string::npos);
+}
+
+TEST(GenerateCode_Cpu, RMSNorm) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+
+  lang::Placeholder<float> x("x", {Expr(6), Expr(64)});
+  lang::Placeholder<float> scale("scale", {Expr(64)});
+  auto stages = poly::CreateStages({x, scale});
+  auto out    = RMSNorm(x, scale, target, stages, -1, 1e-6f, "test_y");
+  stages->InsertLazily(out);
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_RMSNorm", stages, {x, scale, out}, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("RMSNorm_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  ASSERT_NE(code.find("cinn_host_rms_norm_fp32(_x, _scale, 6, 64"), std::string::npos);
+  ASSERT_NE(code.find(", _test_y)"), std::string::npos);
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
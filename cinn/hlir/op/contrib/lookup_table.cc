@@ -34,6 +34,7 @@
 #include "cinn/hlir/pe/schedule.h"
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/builtin.h"
 #include "cinn/lang/compute.h"
@@ -73,6 +74,109 @@ ir::Tensor LookupTable(const ir::Tensor& table,
       common::UniqName(output_name));
 }
 
+namespace {
+
+// The mode code of cinn_host_embedding_bag.
+int EmbeddingBagModeCode(const std::string& mode) {
+  if (mode == "sum") return 0;
+  if (mode == "mean") return 1;
+  if (mode == "max") return 2;
+  LOG(FATAL) << "The mode of embedding_bag should be sum, mean or max, but got " << mode;
+  return -1;
+}
+
+// The bags are [num_bags, bag_size] ids, or the flattened ids split by offsets.
+int EmbeddingBagNumBags(const std::vector<int>& ids_shape, const std::vector<int>* offsets_shape) {
+  if (ids_shape.size() == 2UL) {
+    CHECK(!offsets_shape) << "The embedding_bag takes no offsets with the ids of [num_bags, bag_size]";
+    return ids_shape[0];
+  }
+  CHECK_EQ(ids_shape.size(), 1UL) << "The ids of embedding_bag should be [num_bags, bag_size] or flattened";
+  CHECK(offsets_shape && offsets_shape->size() == 1UL) << "The flattened ids of embedding_bag need 1-D offsets";
+  return offsets_shape->front();
+}
+
+}  // namespace
+
+ir::Tensor EmbeddingBag(const ir::Tensor& table,
+                        const ir::Tensor& ids,
+                        const ir::Tensor* offsets,
+                        const ir::Tensor* weights,
+                        const std::string& mode,
+                        const int64_t padding_idx,
+                        const common::Target& target,
+                        poly::StageMap stages,
+                        const std::string& output_name) {
+  CHECK(target.arch == common::Target::Arch::X86) << "EmbeddingBag only supports X86, other targets use its decomposer";
+  CHECK_EQ(table->shape.size(), 2UL) << "The table of embedding_bag should be [num_rows, dim]";
+  int mode_code = EmbeddingBagModeCode(mode);
+  CHECK(!weights || mode_code == 0) << "The per sample weights of embedding_bag only support the sum mode";
+
+  int num_ids = 1;
+  for (auto& dim : ids->shape) {
+    CHECK(dim.is_constant()) << "The embedding_bag only supports static shapes";
+    num_ids *= dim.as_int32();
+  }
+  // the host kernel reads int64 ids and offsets
+  ir::Tensor ids_int64 = ids;
+  if (!ids->type().is_int(64)) {
+    ids_int64 = Compute(
+        ids->shape,
+        [=](const std::vector<Expr>& idx) { return ir::Cast::Make(common::I64(), ids(idx)); },
+        output_name + "_ids");
+    stages->InsertLazily(ids_int64);
+  }
+  ir::Tensor bag_offsets;
+  if (offsets) {
+    CHECK_EQ(ids->shape.size(), 1UL) << "The embedding_bag takes offsets with the flattened ids";
+    bag_offsets = *offsets;
+    if (!bag_offsets->type().is_int(64)) {
+      bag_offsets = Compute(
+          bag_offsets->shape,
+          [=](const std::vector<Expr>& idx) { return ir::Cast::Make(common::I64(), (*offsets)(idx)); },
+          output_name + "_offsets");
+      stages->InsertLazily(bag_offsets);
+    }
+  } else {
+    // every bag of [num_bags, bag_size] ids starts at a multiple of bag_size
+    CHECK_EQ(ids->shape.size(), 2UL) << "The embedding_bag takes 2-D ids without offsets";
+    Expr bag_size = ids->shape[1];
+    bag_offsets   = Compute(
+        {ids->shape[0]},
+        [=](const std::vector<Expr>& idx) { return ir::Cast::Make(common::I64(), idx[0] * bag_size); },
+        output_name + "_offsets");
+    stages->InsertLazily(bag_offsets);
+  }
+  CHECK(bag_offsets->shape[0].is_constant()) << "The embedding_bag only supports static shapes";
+  int num_bags = bag_offsets->shape[0].as_int32();
+
+  std::vector<Expr> args{table, ids_int64, bag_offsets};
+  std::string func_name = "embedding_bag";
+  if (weights) {
+    CHECK((*weights)->type() == table->type()) << "The per sample weights of embedding_bag should have the table type";
+    args.push_back(*weights);
+    func_name = "weighted_embedding_bag";
+  }
+  args.push_back(table->shape[0]);
+  args.push_back(table->shape[1]);
+  args.push_back(Expr(num_ids));
+  args.push_back(Expr(num_bags));
+  if (!weights) {
+    args.push_back(Expr(mode_code));
+  }
+  args.push_back(Expr(padding_idx));
+
+  std::string extern_name = GetExternFuncName(target, table->type(), func_name);
+  auto call               = Compute(
+      {Expr(1)}, [=]() -> Expr { return lang::CallExtern(extern_name, args); }, output_name + "_call");
+  stages->InsertLazily(call);
+  auto out  = call->TupleGet(0);
+  out->name = output_name;
+  out->set_type(table->type());
+  out->WithBuffer(table->type());
+  return out;
+}
+
 std::shared_ptr<framework::OpStrategy> StrategyForLookupTable(const framework::NodeAttr& attrs,
                                                               const std::vector<ir::Tensor>& inputs,
                                                               const std::vector<Type>& out_type,
@@ -131,6 +235,105 @@ std::vector<Type> InferDtypeForLookupTable(const std::vector<Type>& inputs_type,
   return res;
 }
 
+std::shared_ptr<framework::OpStrategy> StrategyForEmbeddingBag(const framework::NodeAttr& attrs,
+                                                              const std::vector<ir::Tensor>& inputs,
+                                                              const std::vector<Type>& out_type,
+                                                              const std::vector<std::vector<int>>& output_shapes,
+                                                              const Target& target) {
+  const auto& attr_store = attrs.attr_store;
+  std::string mode       = "sum";
+  int64_t padding_idx    = -1;
+  if (attr_store.count("mode")) {
+    mode = absl::get<std::string>(attr_store.at("mode"));
+  }
+  if (attr_store.count("padding_idx")) {
+    padding_idx = absl::get<int64_t>(attr_store.at("padding_idx"));
+  }
+  size_t num_inputs = inputs.size();
+  CHECK_GE(num_inputs, 2UL) << "The embedding_bag takes a table and ids";
+  // 1-D ids are followed by their offsets, and the weights are the last optional input
+  bool has_offsets = inputs[1]->shape.size() == 1UL;
+  bool has_weights = num_inputs == (has_offsets ? 4UL : 3UL);
+
+  framework::CINNCompute embedding_bag_compute([=](lang::Args args, lang::RetValue* ret) {
+    CHECK(!args.empty()) << "The input arguments of EmbeddingBag compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), num_inputs) << num_inputs << " input tensors for EmbeddingBag compute\n";
+    std::vector<ir::Tensor> tensors;
+    for (int i = 0; i < num_inputs; ++i) {
+      Expr tensor = pack_args[i];
+      CHECK(tensor.as_tensor());
+      tensors.push_back(tensor.as_tensor_ref());
+    }
+    auto stages      = CreateStages(tensors);
+    auto output_name = UniqName("EmbeddingBag_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), num_inputs + 1);
+      CHECK(pack_args[num_inputs].is_string());
+      output_name = pack_args[num_inputs].operator std::string();
+    }
+    auto out = EmbeddingBag(tensors[0],
+                            tensors[1],
+                            has_offsets ? &tensors[2] : nullptr,
+                            has_weights ? &tensors.back() : nullptr,
+                            mode,
+                            padding_idx,
+                            target,
+                            stages,
+                            output_name);
+    stages->InsertLazily(out);
+    std::vector<CINNValue> res{CINNValue(out), CINNValue(stages)};
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule embedding_bag_schedule([=](lang::Args args, lang::RetValue* ret) {
+    CHECK(!args.empty()) << "The input argument of embedding_bag schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      // the bags are partitioned among the threads by the extern call itself
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(embedding_bag_compute, embedding_bag_schedule, "strategy.embedding_bag.x86", 1);
+  return strategy;
+}
+
+std::vector<framework::shape_t> InferShapeForEmbeddingBag(const std::vector<framework::shape_t>& inputs_shape,
+                                                          const framework::AttrMapType& attrs) {
+  CHECK(inputs_shape.size() >= 2UL && inputs_shape.size() <= 4UL)
+      << "The embedding_bag takes a table, ids, optional offsets and weights! Please check again.";
+  CHECK_EQ(inputs_shape[0].size(), 2UL) << "The table of embedding_bag should be [num_rows, dim]";
+  const auto& ids_shape = inputs_shape[1];
+  bool has_offsets      = ids_shape.size() == 1UL;
+
+  int num_bags = EmbeddingBagNumBags(ids_shape, has_offsets && inputs_shape.size() > 2UL ? &inputs_shape[2] : nullptr);
+  if (inputs_shape.size() == (has_offsets ? 4UL : 3UL)) {
+    CHECK(inputs_shape.back() == ids_shape) << "The per sample weights of embedding_bag should have the ids shape";
+  }
+  return {{num_bags, inputs_shape[0][1]}};
+}
+
+std::vector<Type> InferDtypeForEmbeddingBag(const std::vector<Type>& inputs_type, const framework::AttrMapType& attrs) {
+  CHECK_GE(inputs_type.size(), 2UL) << "The embedding_bag takes a table and ids! Please check again.";
+  return {inputs_type[0]};
+}
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -144,5 +347,15 @@ CINN_REGISTER_HELPER(lookup_table_ops) {
       .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForLookupTable))
       .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForLookupTable))
       .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kInjective);
+
+  CINN_REGISTER_OP(embedding_bag)
+      .describe("Gather the rows of a table and reduce every bag of them by sum, mean or max.")
+      .set_num_inputs(4)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForEmbeddingBag)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForEmbeddingBag))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForEmbeddingBag))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
   return true;
 }
@@ -22,6 +22,7 @@
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/compute.h"
+#include "cinn/poly/stage.h"
 
 namespace cinn {
 namespace hlir {
@@ -32,6 +33,26 @@ ir::Tensor LookupTable(const ir::Tensor& table,
                        const int64_t padding_idx,
                        const std::string& output_name);
 
+/**
+ * @brief Gather the rows of table selected by ids and reduce every bag of them in one kernel, so the gathered rows
+ *        are never materialized. Only the host target is supported, other targets use its decomposer.
+ * @param table The table of [num_rows, dim].
+ * @param ids The ids of [num_bags, bag_size], or the flattened ids of [num_ids] with offsets.
+ * @param offsets The optional start of every bag in the flattened ids, required by 1-D ids.
+ * @param weights The optional per sample weights of the same shape as ids, which only support the sum mode.
+ * @param mode One of "sum", "mean" and "max".
+ * @param padding_idx The id gathering a row of zeros like lookup_table, -1 means no padding.
+ */
+ir::Tensor EmbeddingBag(const ir::Tensor& table,
+                        const ir::Tensor& ids,
+                        const ir::Tensor* offsets,
+                        const ir::Tensor* weights,
+                        const std::string& mode,
+                        const int64_t padding_idx,
+                        const common::Target& target,
+                        poly::StageMap stages,
+                        const std::string& output_name);
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -97,6 +97,59 @@ TEST(GenerateCode_Gpu, LookupTable) {
   }
 }
 
+std::string CompileEmbeddingBag(const std::vector<ir::Tensor>& args, poly::StageMap stages, const Target& target) {
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_EmbeddingBag", stages, args, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("EmbeddingBag_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "codegen code: " << code;
+  return code;
+}
+
+TEST(GenerateCode_Cpu, EmbeddingBag) {
+  common::Context::Global().ResetNameId();
+
+  common::Target target = common::DefaultHostTarget();
+
+  // 8 bags of 5 ids, whose offsets are generated
+  lang::Placeholder<float> table("table", {100, 16});
+  lang::Placeholder<int64_t> ids("ids", std::vector<int32_t>{8, 5});
+  auto stages = poly::CreateStages({table, ids});
+  auto out    = EmbeddingBag(table, ids, nullptr, nullptr, "mean", 0, target, stages, "test_embedding_bag_out");
+  stages->InsertLazily(out);
+
+  std::string code = CompileEmbeddingBag({table, ids, out}, stages, target);
+  ASSERT_NE(code.find("cinn_host_embedding_bag_fp32(_table, _ids, "), std::string::npos);
+  ASSERT_NE(code.find("100, 16, 40, 8, 1, 0ll, _test_embedding_bag_out)"), std::string::npos);
+}
+
+TEST(GenerateCode_Cpu, WeightedEmbeddingBag) {
+  common::Context::Global().ResetNameId();
+
+  common::Target target = common::DefaultHostTarget();
+
+  lang::Placeholder<float> table("table", {100, 16});
+  lang::Placeholder<int64_t> ids("ids", std::vector<int32_t>{30});
+  lang::Placeholder<int64_t> offsets("offsets", std::vector<int32_t>{4});
+  lang::Placeholder<float> weights("weights", std::vector<int32_t>{30});
+  auto stages = poly::CreateStages({table, ids, offsets, weights});
+  ir::Tensor offsets_tensor(offsets), weights_tensor(weights);
+  auto out = EmbeddingBag(
+      table, ids, &offsets_tensor, &weights_tensor, "sum", -1, target, stages, "test_embedding_bag_out");
+  stages->InsertLazily(out);
+
+  std::string code = CompileEmbeddingBag({table, ids, offsets, weights, out}, stages, target);
+  ASSERT_NE(code.find("cinn_host_weighted_embedding_bag_fp32(_table, _ids, _offsets, _weights, 100, 16, 30, 4, -1ll, "),
+            std::string::npos);
+}
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
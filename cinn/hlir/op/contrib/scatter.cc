@@ -16,6 +16,7 @@
 
 #include <gflags/gflags.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "cinn/hlir/framework/node.h"
 #include "cinn/hlir/framework/op.h"
 #include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/op_util.h"
 #include "cinn/hlir/pe/elementwise.h"
 #include "cinn/hlir/pe/ir_schedule_pe.h"
 #include "cinn/hlir/pe/nn.h"
@@ -35,6 +37,7 @@
 #include "cinn/hlir/pe/transform.h"
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/builtin.h"
 #include "cinn/lang/compute.h"
@@ -169,6 +172,155 @@ ir::Tensor ScatterNd(const ir::Tensor &A,
   return res;
 }
 
+namespace {
+
+// The mode code of cinn_host_scatter.
+int HostScatterModeCode(const std::string &reduce) {
+  if (reduce == "assign") return 0;
+  if (reduce == "add") return 1;
+  if (reduce == "max") return 2;
+  LOG(FATAL) << "The reduce of host_scatter should be assign, add or max, but got " << reduce;
+  return -1;
+}
+
+int ConstantNumel(const std::vector<Expr> &shape, int begin, int end) {
+  int numel = 1;
+  for (int i = begin; i < end; ++i) {
+    CHECK(shape[i].is_constant()) << "The host_scatter only supports static shapes";
+    numel *= shape[i].as_int32();
+  }
+  return numel;
+}
+
+// Flatten the coordinates of the first coords.size() dims of shape, with -1 if any of them is out of range.
+Expr FlattenOrInvalid(const std::vector<Expr> &coords,
+                      const std::vector<Expr> &shape,
+                      const std::vector<bool> &checked) {
+  Expr offset(0);
+  Expr valid(true);
+  for (int i = 0; i < coords.size(); ++i) {
+    offset = offset * shape[i] + coords[i];
+    if (checked[i]) {
+      valid = ir::And::Make(valid, ir::And::Make(ir::GE::Make(coords[i], Expr(0)), ir::LT::Make(coords[i], shape[i])));
+    }
+  }
+  return ir::Select::Make(common::AutoSimplify(valid), common::AutoSimplify(offset), Expr(-1));
+}
+
+}  // namespace
+
+ir::Tensor HostScatter(const ir::Tensor &base,
+                       const ir::Tensor &updates,
+                       const ir::Tensor &index,
+                       const std::string &kind,
+                       const std::vector<int> &axes,
+                       const std::string &reduce,
+                       const common::Target &target,
+                       poly::StageMap stages,
+                       const std::string &output_name) {
+  CHECK(target.arch == common::Target::Arch::X86) << "HostScatter only supports X86, other targets use scatter ops";
+  CHECK(index->type().is_int(32)) << "The index of host_scatter should be int32";
+  CHECK(base->type() == updates->type()) << "The updates of host_scatter should have the base type";
+  CHECK(!axes.empty()) << "The host_scatter needs the axes to scatter along";
+  int mode_code = HostScatterModeCode(reduce);
+
+  // the offset of the destination slice of every update slice, in the slices of the base
+  int rank = base->shape.size();
+  int slice = 1, num_slices = 0, num_updates = 0;
+  ir::Tensor offsets;
+  if (kind == "rows") {
+    int axis = axes[0] < 0 ? axes[0] + rank : axes[0];
+    CHECK(axis >= 0 && axis < rank) << "The axis of host_scatter is out of range";
+    CHECK_EQ(updates->shape.size(), rank) << "The updates of host_scatter should have the base rank";
+    CHECK_EQ(index->shape.size(), 1UL) << "The index of host_scatter should be 1-D to scatter rows";
+    slice       = ConstantNumel(base->shape, axis + 1, rank);
+    num_slices  = ConstantNumel(base->shape, 0, axis + 1);
+    num_updates = ConstantNumel(updates->shape, 0, axis + 1);
+    CHECK_EQ(slice, ConstantNumel(updates->shape, axis + 1, rank)) << "The rows of host_scatter should have one size";
+    std::vector<Expr> offsets_shape(updates->shape.begin(), updates->shape.begin() + axis + 1);
+    std::vector<bool> checked(axis + 1, false);
+    checked[axis] = true;
+    offsets       = Compute(
+        offsets_shape,
+        [=](const std::vector<Expr> &idx) {
+          std::vector<Expr> coords(idx);
+          coords[axis] = index(idx[axis]);
+          return FlattenOrInvalid(coords, base->shape, checked);
+        },
+        output_name + "_offsets");
+  } else if (kind == "elements") {
+    int axis = axes[0] < 0 ? axes[0] + rank : axes[0];
+    CHECK(axis >= 0 && axis < rank) << "The axis of host_scatter is out of range";
+    CHECK_EQ(updates->shape.size(), rank) << "The updates of host_scatter should have the base rank";
+    CHECK_EQ(index->shape.size(), rank) << "The index of host_scatter should have the updates shape";
+    for (int i = 0; i < rank; ++i) {
+      CHECK_EQ(ConstantNumel(index->shape, i, i + 1), ConstantNumel(updates->shape, i, i + 1))
+          << "The index of host_scatter should have the updates shape, but they differ at dim " << i;
+    }
+    slice       = 1;
+    num_slices  = ConstantNumel(base->shape, 0, rank);
+    num_updates = ConstantNumel(updates->shape, 0, rank);
+    std::vector<bool> checked(rank, false);
+    checked[axis] = true;
+    offsets       = Compute(
+        index->shape,
+        [=](const std::vector<Expr> &idx) {
+          std::vector<Expr> coords(idx);
+          coords[axis] = index(idx);
+          return FlattenOrInvalid(coords, base->shape, checked);
+        },
+        output_name + "_offsets");
+  } else if (kind == "nd") {
+    int num_axes = axes.size();
+    CHECK_EQ(updates->shape.size() + 1, index->shape.size()) << "The index of host_scatter should be [updates, axes]";
+    CHECK_EQ(updates->shape.size() + num_axes - 1, rank) << "The updates of host_scatter miss the axes of the base";
+    std::vector<int> pos_axes;
+    for (int axis : axes) {
+      pos_axes.push_back(axis < 0 ? axis + rank : axis);
+    }
+    slice       = 1;
+    num_slices  = ConstantNumel(base->shape, 0, rank);
+    num_updates = ConstantNumel(updates->shape, 0, updates->shape.size());
+    std::vector<bool> checked(rank, false);
+    for (int axis : pos_axes) {
+      checked[axis] = true;
+    }
+    offsets = Compute(
+        updates->shape,
+        [=](const std::vector<Expr> &idx) {
+          // the dims out of the axes follow the leading dims of the updates, whose last dim enumerates the updates
+          std::vector<Expr> coords;
+          int next = 0;
+          for (int i = 0; i < rank; ++i) {
+            auto it = std::find(pos_axes.begin(), pos_axes.end(), i);
+            if (it == pos_axes.end()) {
+              coords.push_back(idx[next++]);
+            } else {
+              std::vector<Expr> index_idx(idx);
+              index_idx.push_back(Expr(static_cast<int>(it - pos_axes.begin())));
+              coords.push_back(index(index_idx));
+            }
+          }
+          return FlattenOrInvalid(coords, base->shape, checked);
+        },
+        output_name + "_offsets");
+  } else {
+    LOG(FATAL) << "The kind of host_scatter should be rows, elements or nd, but got " << kind;
+  }
+  stages->InsertLazily(offsets);
+
+  std::vector<Expr> args{base, updates, offsets, Expr(num_slices), Expr(num_updates), Expr(slice), Expr(mode_code)};
+  std::string extern_name = GetExternFuncName(target, base->type(), "scatter");
+  auto call               = Compute(
+      {Expr(1)}, [=]() -> Expr { return lang::CallExtern(extern_name, args); }, output_name + "_call");
+  stages->InsertLazily(call);
+  auto out  = call->TupleGet(0);
+  out->name = output_name;
+  out->set_type(base->type());
+  out->WithBuffer(base->type());
+  return out;
+}
+
 std::shared_ptr<framework::OpStrategy> StrategyForScatter(const framework::NodeAttr &attrs,
                                                           const std::vector<ir::Tensor> &inputs,
                                                           const std::vector<Type> &out_type,
@@ -321,6 +473,78 @@ std::shared_ptr<framework::OpStrategy> StrategyForScatterNd(const framework::Nod
   return strategy;
 }
 
+std::shared_ptr<framework::OpStrategy> StrategyForHostScatter(const framework::NodeAttr &attrs,
+                                                              const std::vector<ir::Tensor> &inputs,
+                                                              const std::vector<Type> &out_type,
+                                                              const std::vector<std::vector<int>> &output_shapes,
+                                                              const Target &target) {
+  const auto &attr_store = attrs.attr_store;
+  std::string kind       = "rows";
+  std::string reduce     = "assign";
+  std::vector<int> axes{0};
+  if (attr_store.count("kind")) {
+    kind = absl::get<std::string>(attr_store.at("kind"));
+  }
+  if (attr_store.count("reduce")) {
+    reduce = absl::get<std::string>(attr_store.at("reduce"));
+  }
+  if (attr_store.count("axes")) {
+    axes = absl::get<std::vector<int>>(attr_store.at("axes"));
+  } else if (attr_store.count("axis")) {
+    axes = {absl::get<int>(attr_store.at("axis"))};
+  }
+
+  framework::CINNCompute host_scatter_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of HostScatter compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 3U) << "3 input tensors for HostScatter compute\n";
+    std::vector<ir::Tensor> tensors;
+    for (int i = 0; i < 3; ++i) {
+      Expr tensor = pack_args[i];
+      CHECK(tensor.as_tensor());
+      tensors.push_back(tensor.as_tensor_ref());
+    }
+    auto stages      = CreateStages(tensors);
+    auto output_name = UniqName("HostScatter_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 4U);
+      CHECK(pack_args[3].is_string());
+      output_name = pack_args[3].operator std::string();
+    }
+    auto out = HostScatter(tensors[0], tensors[1], tensors[2], kind, axes, reduce, target, stages, output_name);
+    stages->InsertLazily(out);
+    std::vector<CINNValue> res{CINNValue(out), CINNValue(stages)};
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule host_scatter_schedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of host_scatter schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      // the destination slices are partitioned among the threads by the extern call itself
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(host_scatter_compute, host_scatter_schedule, "strategy.host_scatter.x86", 1);
+  return strategy;
+}
+
 std::vector<std::vector<int>> InferShapeForScatter(const std::vector<std::vector<int>> &inputs_shape,
                                                    const framework::AttrMapType &attrs) {
   CHECK_EQ(inputs_shape.size(), 3U) << "The input's shape size should be 3! Please check again.";
@@ -335,6 +559,18 @@ std::vector<Type> InferDtypeForScatter(const std::vector<Type> &inputs_type, con
   return res;
 }
 
+std::vector<std::vector<int>> InferShapeForHostScatter(const std::vector<std::vector<int>> &inputs_shape,
+                                                       const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 3U) << "The host_scatter takes the base, updates and index! Please check again.";
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForHostScatter(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 3U) << "The host_scatter takes the base, updates and index! Please check again.";
+  CHECK_EQ(inputs_type[2], Int(32)) << "The index's type should be int! Please check again.";
+  return {inputs_type[0]};
+}
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -359,5 +595,15 @@ CINN_REGISTER_HELPER(scatter_ops) {
       .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForScatter))
       .set_support_level(4);
 
+  CINN_REGISTER_OP(host_scatter)
+      .describe("Scatter the updates into a copy of the base on the host, in parallel over the destination slices.")
+      .set_num_inputs(3)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForHostScatter)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForHostScatter))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForHostScatter))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
   return true;
 }
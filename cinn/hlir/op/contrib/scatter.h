@@ -20,6 +20,7 @@
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/tensor.h"
+#include "cinn/poly/stage.h"
 
 namespace cinn {
 namespace hlir {
@@ -39,6 +40,23 @@ ir::Tensor ScatterNd(const ir::Tensor& A,
                      const std::vector<int>& axes,
                      const std::string& name);
 
+/**
+ * Scatter `updates` into a copy of `base` with the conflict-aware host kernel cinn_host_scatter.
+ * @param kind "rows" writes the slices updates[..., l, ...] to base[..., index[l], ...] along axes[0], like
+ *             scatter_assign. "elements" writes updates[p] to base[p with p[axes[0]] = index[p]], like scatter, and
+ *             "nd" writes updates[o..., k] to base at the coordinates index[o..., k, :] of the axes, like scatter_nd.
+ * @param reduce "assign", in which the last update of an element wins, "add" or "max".
+ */
+ir::Tensor HostScatter(const ir::Tensor& base,
+                       const ir::Tensor& updates,
+                       const ir::Tensor& index,
+                       const std::string& kind,
+                       const std::vector<int>& axes,
+                       const std::string& reduce,
+                       const common::Target& target,
+                       poly::StageMap stages,
+                       const std::string& output_name);
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
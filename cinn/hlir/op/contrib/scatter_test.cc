@@ -160,6 +160,40 @@ void TestGenerateCodeCpu_Scatter(void* _args, int32_t num_args)
   CHECK_EQ(utils::Trim(code), utils::Trim(target_source));
 }
 
+TEST(GenerateCode_Cpu, HostScatter) {
+  common::Context::Global().ResetNameId();
+
+  auto target = common::DefaultHostTarget();
+
+  // scatter_add of 6 rows of 8 into the 4 x 14 x 8 base along the axis 1
+  lang::Placeholder<float> base("base", {ir::Expr(4), ir::Expr(14), ir::Expr(8)});
+  lang::Placeholder<float> updates("updates", {ir::Expr(4), ir::Expr(6), ir::Expr(8)});
+  lang::Placeholder<int32_t> index("index", {ir::Expr(6)});
+  auto stages    = poly::CreateStages({base, updates, index});
+  ir::Tensor res = HostScatter(base, updates, index, "rows", {1}, "add", target, stages, "test_host_scatter_out");
+  stages->InsertLazily(res);
+
+  std::vector<ir::LoweredFunc> funcs = lang::LowerVec(
+      "TestGenerateCodeCpu_HostScatter", stages, {base, updates, index, res}, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("HostScatter_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+
+  // 56 slices of 8 floats are updated by 24 slices in the add mode
+  ASSERT_NE(code.find("cinn_host_scatter_fp32(_base, _updates, "), std::string::npos);
+  ASSERT_NE(code.find("56, 24, 8, 1, "), std::string::npos);
+  // the runtime writes the output of the op directly
+  ASSERT_NE(code.find(", _test_host_scatter_out)"), std::string::npos);
+}
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -47,18 +47,65 @@ namespace op {
 using common::CINNValue;
 using common::CINNValuePack;
 
+std::vector<ir::Tensor> ArgSortCPU(const ir::Tensor &A,
+                                   poly::StageMap stages,
+                                   const int &pos_axis,
+                                   const bool &is_ascend,
+                                   const std::string &name) {
+  // view A as [outer, size, inner] and sort every row of size elements by one extern call
+  Expr outer(1);
+  Expr inner(1);
+  for (int i = 0; i < A->shape.size(); i++) {
+    if (i < pos_axis) {
+      outer = outer * A->shape[i];
+    } else if (i > pos_axis) {
+      inner = inner * A->shape[i];
+    }
+  }
+  outer = common::AutoSimplify(outer);
+  inner = common::AutoSimplify(inner);
+
+  std::string sort_func_name = cinn::hlir::GetExternFuncName(common::DefaultHostTarget(), A->type(), "argsort");
+  auto call                  = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(sort_func_name,
+                                {
+                                    A,                             // x
+                                    outer,                         // outer
+                                    A->shape[pos_axis],            // size
+                                    inner,                         // inner
+                                    common::make_bool(is_ascend),  // is_ascend
+                                });
+      },
+      name + "_call");
+  auto index  = call->TupleGet(0);
+  index->name = name;
+  index->set_type(Int(32));
+  index->WithBuffer(Int(32));
+  stages->InsertLazily(call);
+  return {index, call};
+}
+
 std::vector<ir::Tensor> ArgSort(const ir::Tensor &A,
                                 const common::Target &target,
                                 poly::StageMap stages,
                                 const int &axis,
                                 const bool &is_ascend,
                                 const std::string &name) {
+  int pos_axis = axis;
+  if (pos_axis < 0) {
+    pos_axis += A->shape.size();
+  }
+  // the host runtime provides an O(n log n) sort, instead of ranking every element by a linear scan
+  if (target.arch == common::Target::Arch::X86) {
+    return ArgSortCPU(A, stages, pos_axis, is_ascend, name);
+  }
+
   std::string find_func_name;
   std::string index_func_name;
   if (target.arch == common::Target::Arch::NVGPU) {
     find_func_name.assign("cinn_cuda_find_int_nd");
-  } else if (target.arch == common::Target::Arch::X86) {
-    find_func_name.assign("cinn_host_find_int_nd");
   } else {
     LOG(FATAL) << "ArgSort only supports X86 and NVGPU ! Please Check.\n";
   }
@@ -67,10 +114,6 @@ std::vector<ir::Tensor> ArgSort(const ir::Tensor &A,
   } else {
     index_func_name = cinn::hlir::GetExternFuncName(target, A->type(), "gt_num");
   }
-  int pos_axis = axis;
-  if (pos_axis < 0) {
-    pos_axis += A->shape.size();
-  }
   auto positions = Compute(
       A->shape,
       [=](const std::vector<Expr> &indices) {
@@ -142,6 +185,44 @@ std::vector<ir::Tensor> Sort(const ir::Tensor &A,
   return {res, sort_index.at(0), sort_index.at(1)};
 }
 
+std::vector<ir::Tensor> TopK(const ir::Tensor &A,
+                             const common::Target &target,
+                             poly::StageMap stages,
+                             const int &k,
+                             const int &axis,
+                             const bool &largest,
+                             const std::string &values_name,
+                             const std::string &indices_name) {
+  CHECK(target.arch == common::Target::Arch::X86) << "TopK only supports X86, other targets use its decomposer";
+  int pos_axis = axis;
+  if (pos_axis < 0) {
+    pos_axis += A->shape.size();
+  }
+  std::string top_k_func_name = cinn::hlir::GetExternFuncName(target, A->type(), "top_k");
+  auto call                   = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(top_k_func_name,
+                                {
+                                    A,                           // x
+                                    Expr(pos_axis),              // axis
+                                    Expr(k),                     // k
+                                    common::make_bool(largest),  // largest
+                                });
+      },
+      values_name + "_call");
+  auto values  = call->TupleGet(0);
+  values->name = values_name;
+  values->set_type(A->type());
+  values->WithBuffer(A->type());
+  auto indices  = call->TupleGet(1);
+  indices->name = indices_name;
+  indices->set_type(Int(64));
+  indices->WithBuffer(Int(64));
+  stages->InsertLazily(call);
+  return {values, indices};
+}
+
 std::shared_ptr<framework::OpStrategy> StrategyForSort(const framework::NodeAttr &attrs,
                                                        const std::vector<ir::Tensor> &inputs,
                                                        const std::vector<Type> &out_type,
@@ -197,15 +278,13 @@ std::shared_ptr<framework::OpStrategy> StrategyForSort(const framework::NodeAttr
       ir::ModuleExpr mod_expr(vec_ast);
       ir::IRSchedule ir_sch(mod_expr);
       ir_sch.MergeExprs();
-      auto blocks = ir_sch.GetAllBlocks();
-      // TODO: remove external calls, do not use local variables, because
-      // the size will exceed the limit.
-      ir_sch.SetBuffer(blocks[0], "local");
-      ir_sch.SetBuffer(blocks[1], "local");
-
-      long prod_size = std::accumulate(output_shapes[0].begin(), output_shapes[0].end(), 1, std::multiplies<int>());
-      if (prod_size > 1 && target.arch == Target::Arch::X86) {
-        pe::IRScheduleInjectiveCPU(ir_sch, output_shapes.front(), target, true);
+      // the CPU sort is done by an extern call writing a whole buffer, nothing to schedule
+      if (target.arch == Target::Arch::NVGPU) {
+        auto blocks = ir_sch.GetAllBlocks();
+        // TODO: remove external calls, do not use local variables, because
+        // the size will exceed the limit.
+        ir_sch.SetBuffer(blocks[0], "local");
+        ir_sch.SetBuffer(blocks[1], "local");
       }
       std::vector<common::CINNValue> res{common::CINNValue(ir_sch.GetModule().GetExprs().at(0))};
       *ret = common::CINNValuePack{res};
@@ -279,15 +358,10 @@ std::shared_ptr<framework::OpStrategy> StrategyForArgSort(const framework::NodeA
       ir::ModuleExpr mod_expr(vec_ast);
       ir::IRSchedule ir_sch(mod_expr);
       ir_sch.MergeExprs();
-      auto blocks = ir_sch.GetAllBlocks();
       // TODO: remove external calls, do not use local variables, because
       // the size will exceed the limit.
       // TODO: There is a bug, setting buffer to "local" here will cause the var declared twice at CodeGen.
       // ir_sch.SetBuffer(blocks[0], "local");
-      long prod_size = std::accumulate(output_shapes[0].begin(), output_shapes[0].end(), 1, std::multiplies<int>());
-      if (prod_size > 1 && target.arch == Target::Arch::X86) {
-        pe::IRScheduleInjectiveCPU(ir_sch, output_shapes.front(), target, true);
-      }
       std::vector<common::CINNValue> res{common::CINNValue(ir_sch.GetModule().GetExprs().at(0))};
       *ret = common::CINNValuePack{res};
     } else {
@@ -304,6 +378,80 @@ std::shared_ptr<framework::OpStrategy> StrategyForArgSort(const framework::NodeA
   return strategy;
 }
 
+std::shared_ptr<framework::OpStrategy> StrategyForTopK(const framework::NodeAttr &attrs,
+                                                       const std::vector<ir::Tensor> &inputs,
+                                                       const std::vector<Type> &out_type,
+                                                       const std::vector<std::vector<int>> &output_shapes,
+                                                       const Target &target) {
+  auto attr_store = attrs.attr_store;
+  CHECK(attr_store.count("k")) << "find no attr of k";
+  CHECK(attr_store.count("axis")) << "find no attr of axis";
+  int k        = absl::get<int>(attr_store.at("k"));
+  int axis     = absl::get<int>(attr_store.at("axis"));
+  bool largest = true;
+  if (attr_store.count("largest")) {
+    largest = absl::get<bool>(attr_store.at("largest"));
+  }
+
+  framework::CINNCompute top_k_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of TopK compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 1U) << "At least 1 input tensors for TopK compute\n";
+    Expr A = pack_args[0];
+    CHECK(A.as_tensor());
+    CHECK_EQ(output_shapes.size(), 2U);
+    auto tensor_A = A.as_tensor_ref();
+    auto stages   = CreateStages({tensor_A});
+    VLOG(3) << "A shape: " << utils::Join(tensor_A->shape, ", ")
+            << ", output_shapes: " << utils::Join(output_shapes[0], ", ");
+    auto values_name  = UniqName("TopK_out");
+    auto indices_name = UniqName("TopK_index");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[1].is_string() && pack_args[2].is_string());
+      values_name  = pack_args[1].operator std::string();
+      indices_name = pack_args[2].operator std::string();
+    }
+    auto out = TopK(tensor_A, target, stages, k, axis, largest, values_name, indices_name);
+    stages->InsertLazily(out.at(0));
+    stages->InsertLazily(out.at(1));
+    CHECK(!out_type.empty()) << "Output type of TopK is empty! Please check.\n";
+    std::vector<CINNValue> res{CINNValue(out.at(0)), CINNValue(out.at(1)), CINNValue(stages)};
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule top_k_schedule([=](lang::Args args, lang::RetValue *ret) {
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK(!args.empty()) << "The input argument of top_k_schedule is empty! Please check.\n";
+      common::CINNValuePack arg_pack = args[0];
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      // the selection is done by a single extern call, which has nothing to schedule
+      std::vector<common::CINNValue> res{common::CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = common::CINNValuePack{res};
+    } else {
+      CHECK(!args.empty()) << "The input argument of top_k_schedule is empty! Please check.\n";
+      CINNValuePack arg_pack = args[0];
+      Expr out               = arg_pack[0];
+      CHECK(out.as_tensor());
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(top_k_compute, top_k_schedule, "strategy.top_k", 1);
+  return strategy;
+}
+
 std::vector<std::vector<int>> InferShapeForSort(const std::vector<std::vector<int>> &inputs_shape,
                                                 const framework::AttrMapType &attrs) {
   CHECK_EQ(inputs_shape.size(), 1UL) << "The input's shape size should be 1! Please check again.";
@@ -403,6 +551,7 @@ CINN_REGISTER_HELPER(sort_ops) {
       .describe("Find values and indices of the k largest entries for the last dimension..")
       .set_num_inputs(1)
       .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForTopK)
       .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForTopK))
       .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForTopK))
       .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
@@ -39,6 +39,20 @@ std::vector<ir::Tensor> Sort(const ir::Tensor& A,
                              const bool& is_ascend,
                              const std::string& name);
 
+/**
+ * @brief Select the k largest (or smallest) elements along the axis by partial selection,
+ *        instead of sorting the whole axis. Only the host target is supported.
+ * @return The values and their int64 indices.
+ */
+std::vector<ir::Tensor> TopK(const ir::Tensor& A,
+                             const common::Target& target,
+                             poly::StageMap stages,
+                             const int& k,
+                             const int& axis,
+                             const bool& largest,
+                             const std::string& values_name,
+                             const std::string& indices_name);
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -43,6 +43,8 @@ TEST(GenerateCode_Cpu, ArgSort) {
   lang::Placeholder<int32_t> in("in", {n, h});
   poly::StageMap stages = poly::CreateStages({in});
   ir::Tensor res        = ArgSort(in.tensor(), target, stages, 1, true, "test_arg_sort_out").at(0);
+  // the output of the extern call is the op output itself, without a copy
+  ASSERT_EQ(res->name, "test_arg_sort_out");
   stages->InsertLazily(res);
   std::vector<ir::LoweredFunc> funcs =
       lang::LowerVec("TestGenerateCodeCpu_ArgSort", stages, {in, res}, {}, {}, nullptr, target, true);
@@ -87,45 +89,43 @@ TEST(GenerateCode_Cpu, Sort) {
 
   backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
   codegen.SetInlineBuiltinCodes(false);
-  std::string code   = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
-  auto target_source = R"ROC(
-#include <cinn_runtime.h>
-#include <stdio.h>
-
-void TestGenerateCodeCpu_Sort(void* _args, int32_t num_args)
-{
-  const cinn_buffer_t* _in = cinn_pod_value_to_buffer_p(&(((cinn_pod_value_t*)(_args))[0]));
-  cinn_buffer_t* _test_sort_out = cinn_pod_value_to_buffer_p(&(((cinn_pod_value_t*)(_args))[1]));
-  cinn_buffer_t* _test_sort_out_index = cinn_buffer_t::new_((cinn_device_kind_t)(0)/*target*/, cinn_int32_t(), { 4, 28 });
-  cinn_buffer_t* _test_sort_out_index_temp = cinn_buffer_t::new_((cinn_device_kind_t)(0)/*target*/, cinn_int32_t(), { 4, 28 });
-  cinn_buffer_malloc((void*)(0), _test_sort_out);
-  cinn_buffer_malloc((void*)(0), _test_sort_out_index);
-  cinn_buffer_malloc((void*)(0), _test_sort_out_index_temp);
-  const int32_t* in = ((const int32_t*)(_in->memory));
-  int32_t* test_sort_out = ((int32_t*)(_test_sort_out->memory));
-  int32_t* test_sort_out_index = ((int32_t*)(_test_sort_out_index->memory));
-  int32_t* test_sort_out_index_temp = ((int32_t*)(_test_sort_out_index_temp->memory));
-  for (int32_t i = 0; i < 4; i += 1) {
-    for (int32_t j = 0; j < 28; j += 1) {
-      test_sort_out_index_temp[((28 * i) + j)] = cinn_host_lt_num_int32(_in, 28, in[((28 * i) + j)], (28 * i), 1);
-    };
-  };
-  for (int32_t i = 0; i < 4; i += 1) {
-    for (int32_t j = 0; j < 28; j += 1) {
-      test_sort_out_index[((28 * i) + j)] = cinn_host_find_int_nd(_test_sort_out_index_temp, 28, j, (28 * i), 1);
-    };
-  };
-  for (int32_t i = 0; i < 4; i += 1) {
-    for (int32_t j = 0; j < 28; j += 1) {
-      test_sort_out[((28 * i) + j)] = in[((28 * i) + test_sort_out_index[((28 * i) + j)])];
-    };
-  };
-  cinn_buffer_free((void*)(0), _test_sort_out_index);
-  cinn_buffer_free((void*)(0), _test_sort_out_index_temp);
-  cinn_buffer_free((void*)(0), _test_sort_out);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  // the rows are sorted by the O(n log n) runtime sort, not ranked element by element
+  ASSERT_NE(code.find("cinn_host_argsort_int32(_in, 4, 28, 1"), std::string::npos);
+  ASSERT_EQ(code.find("cinn_host_lt_num_int32"), std::string::npos);
 }
-  )ROC";
-  CHECK_EQ(utils::Trim(code), utils::Trim(target_source));
+
+TEST(GenerateCode_Cpu, TopK) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+
+  ir::Expr n(4);
+  ir::Expr h(28);
+
+  lang::Placeholder<float> in("in", {n, h});
+  auto stages = poly::CreateStages({in});
+  auto out    = TopK(in, target, stages, 5, -1, true, "test_top_k_out", "test_top_k_index");
+  stages->InsertLazily(out[0]);
+  stages->InsertLazily(out[1]);
+  std::vector<ir::LoweredFunc> funcs = lang::LowerVec(
+      "TestGenerateCodeCpu_TopK", stages, {in, out[0], out[1]}, {}, {}, nullptr, target, true);
+
+  ir::Module::Builder builder("TopK_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  // the k elements are selected by the runtime, without sorting the whole rows
+  ASSERT_NE(code.find("cinn_host_top_k_fp32(_in, 1, 5"), std::string::npos);
+  ASSERT_EQ(code.find("cinn_host_argsort_fp32"), std::string::npos);
 }
 
 }  // namespace op
@@ -29,6 +29,8 @@
 #include "cinn/poly/stage.h"
 
 DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_x86_winograd_conv);
+DECLARE_bool(cinn_x86_direct_nhwc_conv);
 
 namespace cinn {
 namespace hlir {
@@ -109,6 +111,78 @@ std::shared_ptr<OpStrategy> StrategyForRelu6(const framework::NodeAttr &attrs,
   return strategy;
 }
 
+// The tile size of the host winograd algorithm for the X86 conv2d, or 0 if the conv2d is not computed by it. The
+// winograd algorithm only pays off when its transforms are amortized over enough channels, and the larger
+// F(4x4, 3x3) tiles only when most of them are full.
+int GetHostWinogradTileSize(const std::vector<ir::Tensor> &inputs,
+                            const std::vector<int> &stride,
+                            const std::vector<int> &dilation,
+                            const std::string &data_format,
+                            int groups,
+                            bool use_mkldnn,
+                            const Target &target) {
+  if (!FLAGS_cinn_x86_winograd_conv || target.arch != Target::Arch::X86 || data_format != "NCHW" || groups != 1 ||
+      use_mkldnn || inputs.size() < 2) {
+    return 0;
+  }
+  auto type = inputs[0]->type();
+  if (!type.is_float(32) && !type.is_float(64)) return 0;
+  if (stride != std::vector<int>({1, 1}) || dilation != std::vector<int>({1, 1})) return 0;
+  const auto &input_shape  = inputs[0]->shape;
+  const auto &weight_shape = inputs[1]->shape;
+  if (input_shape.size() != 4U || weight_shape.size() != 4U) return 0;
+  for (auto &shape : {input_shape, weight_shape}) {
+    for (auto &dim : shape) {
+      if (!dim.is_constant()) return 0;
+    }
+  }
+  if (weight_shape[2].as_int32() != 3 || weight_shape[3].as_int32() != 3) return 0;
+  constexpr int kMinWinogradChannels = 8;
+  if (input_shape[1].as_int32() < kMinWinogradChannels || weight_shape[0].as_int32() < kMinWinogradChannels) return 0;
+  return input_shape[2].as_int32() >= 8 && input_shape[3].as_int32() >= 8 ? 4 : 2;
+}
+
+// The {oc_block, ow_block} tile of the host direct microkernels for the X86 NHWC conv2d, or empty if the conv2d is not
+// computed by them. A tile row holds the channels of a target vector, and the tile keeps about 6 target vectors of
+// accumulators, which leaves the registers for the weights and the broadcast inputs.
+std::vector<int> GetHostNHWCConvBlocks(const std::vector<ir::Tensor> &inputs,
+                                       const std::vector<int> &padding,
+                                       const std::vector<int> &stride,
+                                       const std::vector<int> &dilation,
+                                       const std::string &data_format,
+                                       int groups,
+                                       bool use_mkldnn,
+                                       const Target &target) {
+  if (!FLAGS_cinn_x86_direct_nhwc_conv || target.arch != Target::Arch::X86 || data_format != "NHWC" || groups != 1 ||
+      use_mkldnn || inputs.size() < 2 || padding.size() != 2U || stride.size() != 2U || dilation.size() != 2U) {
+    return {};
+  }
+  auto type = inputs[0]->type();
+  if (!type.is_float(32) && !type.is_float(64)) return {};
+  const auto &input_shape  = inputs[0]->shape;
+  const auto &weight_shape = inputs[1]->shape;
+  if (input_shape.size() != 4U || weight_shape.size() != 4U) return {};
+  for (auto &shape : {input_shape, weight_shape}) {
+    for (auto &dim : shape) {
+      if (!dim.is_constant()) return {};
+    }
+  }
+  if (input_shape[3].as_int32() != weight_shape[1].as_int32()) return {};
+  int out_w =
+      (input_shape[2].as_int32() + 2 * padding[1] - (weight_shape[3].as_int32() - 1) * dilation[1] - 1) / stride[1] + 1;
+  if (out_w <= 0) return {};
+
+  constexpr int kAccumulatorVectors = 6;
+  int lanes                         = pe::GetBasicFactor(type, target);
+  int c_out                         = weight_shape[0].as_int32();
+  int oc_block                      = 8;
+  while (oc_block < 32 && oc_block < lanes && oc_block < c_out) oc_block *= 2;
+  int ow_block = std::min(8, kAccumulatorVectors * lanes / oc_block);
+  ow_block     = ow_block >= 8 ? 8 : (ow_block >= 6 ? 6 : 4);
+  if (out_w < ow_block) ow_block = 4;
+  return {oc_block, ow_block};
+}
+
 std::shared_ptr<OpStrategy> StrategyForConv2d(const framework::NodeAttr &attrs,
                                               const std::vector<ir::Tensor> &inputs,
                                               const std::vector<Type> &out_type,
@@ -153,6 +227,9 @@ std::shared_ptr<OpStrategy> StrategyForConv2d(const framework::NodeAttr &attrs,
 #ifndef CINN_WITH_CUDNN
   CHECK_EQ(conv_type, "forward") << "cudnn is not found, backward_data/backward_filter is not supported!";
 #endif
+  int winograd_tile_size = GetHostWinogradTileSize(inputs, stride, dilation, data_format, groups, use_mkldnn, target);
+  std::vector<int> nhwc_blocks =
+      GetHostNHWCConvBlocks(inputs, padding, stride, dilation, data_format, groups, use_mkldnn, target);
 
   framework::CINNCompute conv2d_compute([=](lang::Args args, lang::RetValue *ret) {
     std::vector<CINNValue> res;
@@ -178,7 +255,10 @@ std::shared_ptr<OpStrategy> StrategyForConv2d(const framework::NodeAttr &attrs,
     if (data_format == "NCHW") {
       // A is input: [N, C, H, W], B is filter: [C_out, C_in/group, filter_h, filter_w]
       if (target.arch == Target::Arch::X86) {
-        if (groups == 1 && !use_mkldnn) {
+        if (winograd_tile_size > 0) {
+          out = pe::Conv2d_NCHW_Winograd_Host(
+              A.as_tensor_ref(), B.as_tensor_ref(), padding[0], padding[1], winograd_tile_size, tensor_name);
+        } else if (groups == 1 && !use_mkldnn) {
           out = pe::Conv2d_NCHW_5D(A.as_tensor_ref(),
                                    B.as_tensor_ref(),
                                    padding[0],
@@ -239,15 +319,32 @@ std::shared_ptr<OpStrategy> StrategyForConv2d(const framework::NodeAttr &attrs,
       }
     } else if (data_format == "NHWC") {
       // A is input: [N, H, W, C], B is filter: [C_out, C_in/group, filter_h, filter_w]
-      out = pe::Conv2d_NHWC(A.as_tensor_ref(),
-                            B.as_tensor_ref(),
-                            padding[0],
-                            padding[1],
-                            stride[0],
-                            stride[1],
-                            dilation[0],
-                            dilation[1],
-                            tensor_name);
+      if (!nhwc_blocks.empty()) {
+        out = pe::Conv2d_NHWC_Direct_Host(A.as_tensor_ref(),
+                                          B.as_tensor_ref(),
+                                          ir::Tensor(),
+                                          ir::Tensor(),
+                                          false,
+                                          padding[0],
+                                          padding[1],
+                                          stride[0],
+                                          stride[1],
+                                          dilation[0],
+                                          dilation[1],
+                                          nhwc_blocks[0],
+                                          nhwc_blocks[1],
+                                          tensor_name);
+      } else {
+        out = pe::Conv2d_NHWC(A.as_tensor_ref(),
+                              B.as_tensor_ref(),
+                              padding[0],
+                              padding[1],
+                              stride[0],
+                              stride[1],
+                              dilation[0],
+                              dilation[1],
+                              tensor_name);
+      }
     } else {
       LOG(FATAL) << "Only support NCHW and NHWC data layout\n";
     }
@@ -303,6 +400,12 @@ std::shared_ptr<OpStrategy> StrategyForConv2d(const framework::NodeAttr &attrs,
           CINN_NOT_IMPLEMENTED
         }
       } else if (target.arch == Target::Arch::X86) {
+        if (winograd_tile_size > 0 || !nhwc_blocks.empty()) {
+          // the extern call writes the output by itself, which has nothing to schedule
+          std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+          *ret = CINNValuePack{res};
+          return;
+        }
         CINN_NOT_IMPLEMENTED
       }
       LOG(FATAL) << "This target [" << target << "] is not supported yet.";
@@ -606,6 +709,154 @@ std::vector<std::vector<std::string>> InferLayoutForConv2d(const std::vector<fra
   return {{input_layouts[0], input_layouts[0], input_layouts[0], input_layouts[0]}, input_layouts};
 }
 
+std::shared_ptr<OpStrategy> StrategyForFusedConv2dNHWC(const framework::NodeAttr &attrs,
+                                                       const std::vector<ir::Tensor> &inputs,
+                                                       const std::vector<Type> &out_type,
+                                                       const std::vector<std::vector<int>> &output_shapes,
+                                                       const Target &target) {
+  std::vector<int> padding({0, 0});
+  std::vector<int> stride({1, 1});
+  std::vector<int> dilation({1, 1});
+  std::string activation;
+  if (attrs.attr_store.find("padding") != attrs.attr_store.end()) {
+    padding = absl::get<std::vector<int>>(attrs.attr_store.at("padding"));
+  }
+  if (attrs.attr_store.find("stride") != attrs.attr_store.end()) {
+    stride = absl::get<std::vector<int>>(attrs.attr_store.at("stride"));
+  }
+  if (attrs.attr_store.find("dilation") != attrs.attr_store.end()) {
+    dilation = absl::get<std::vector<int>>(attrs.attr_store.at("dilation"));
+  }
+  if (attrs.attr_store.find("activation") != attrs.attr_store.end()) {
+    activation = absl::get<std::string>(attrs.attr_store.at("activation"));
+  }
+  CHECK(activation.empty() || activation == "relu")
+      << "The activation of fused_conv2d_nhwc should be empty or relu, but got " << activation;
+  CHECK(target.arch == Target::Arch::X86) << "fused_conv2d_nhwc op is only used in x86";
+  std::vector<int> nhwc_blocks = GetHostNHWCConvBlocks(inputs, padding, stride, dilation, "NHWC", 1, false, target);
+  CHECK(!nhwc_blocks.empty()) << "The conv2d of fused_conv2d_nhwc cannot be computed by the host direct microkernels";
+  size_t num_inputs = inputs.size();
+  CHECK(num_inputs >= 2UL && num_inputs <= 4UL) << "The fused_conv2d_nhwc takes x, w, optional bias and residual";
+
+  framework::CINNCompute fused_conv2d_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of fused_conv2d_nhwc compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), num_inputs) << num_inputs << " input tensors for fused_conv2d_nhwc compute\n";
+    std::vector<ir::Tensor> tensors;
+    for (int i = 0; i < num_inputs; ++i) {
+      Expr tensor = pack_args[i];
+      CHECK(tensor.as_tensor());
+      tensors.push_back(tensor.as_tensor_ref());
+    }
+    // the 1-D bias and the 4-D residual follow x and w
+    ir::Tensor bias, residual;
+    for (int i = 2; i < num_inputs; ++i) {
+      if (tensors[i]->shape.size() == 1U) {
+        bias = tensors[i];
+      } else {
+        residual = tensors[i];
+      }
+    }
+    std::string tensor_name = UniqName("FusedConv2dNHWC_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), num_inputs + 1);
+      CHECK(pack_args[num_inputs].is_string());
+      tensor_name = pack_args[num_inputs].operator std::string();
+    }
+    auto stages = CreateStages(tensors);
+
+    auto out = pe::Conv2d_NHWC_Direct_Host(tensors[0],
+                                           tensors[1],
+                                           bias,
+                                           residual,
+                                           activation == "relu",
+                                           padding[0],
+                                           padding[1],
+                                           stride[0],
+                                           stride[1],
+                                           dilation[0],
+                                           dilation[1],
+                                           nhwc_blocks[0],
+                                           nhwc_blocks[1],
+                                           tensor_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule fused_conv2d_schedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of fused_conv2d_nhwc schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      // the rows of the output are partitioned among the threads by the extern call itself
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(fused_conv2d_compute, fused_conv2d_schedule, "strategy.fused_conv2d_nhwc.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForFusedConv2dNHWC(const std::vector<shape_t> &inputs_shape,
+                                                  const framework::AttrMapType &attrs) {
+  CHECK(inputs_shape.size() >= 2UL && inputs_shape.size() <= 4UL)
+      << "The fused_conv2d_nhwc takes x, w, optional bias and residual! Please check again.";
+  CHECK_EQ(inputs_shape[0].size(), 4UL) << "The x of fused_conv2d_nhwc should be [N, H, W, C_in]";
+  CHECK_EQ(inputs_shape[1].size(), 4UL) << "The w of fused_conv2d_nhwc should be [C_out, C_in, filter_h, filter_w]";
+  std::vector<int> padding({0, 0});
+  std::vector<int> stride({1, 1});
+  std::vector<int> dilation({1, 1});
+  if (attrs.find("padding") != attrs.end()) {
+    padding = absl::get<std::vector<int>>(attrs.at("padding"));
+  }
+  if (attrs.find("stride") != attrs.end()) {
+    stride = absl::get<std::vector<int>>(attrs.at("stride"));
+  }
+  if (attrs.find("dilation") != attrs.end()) {
+    dilation = absl::get<std::vector<int>>(attrs.at("dilation"));
+  }
+  const auto &x_shape = inputs_shape[0];
+  const auto &w_shape = inputs_shape[1];
+  CHECK_EQ(x_shape[3], w_shape[1]) << "The fused_conv2d_nhwc does not support groups";
+  shape_t output_shape = {x_shape[0],
+                          (x_shape[1] + 2 * padding[0] - (w_shape[2] - 1) * dilation[0] - 1) / stride[0] + 1,
+                          (x_shape[2] + 2 * padding[1] - (w_shape[3] - 1) * dilation[1] - 1) / stride[1] + 1,
+                          w_shape[0]};
+  for (int i = 2; i < inputs_shape.size(); ++i) {
+    if (inputs_shape[i].size() == 1UL) {
+      CHECK_EQ(inputs_shape[i][0], w_shape[0]) << "The bias of fused_conv2d_nhwc should be [C_out]";
+    } else {
+      CHECK(inputs_shape[i] == output_shape) << "The residual of fused_conv2d_nhwc should have the output shape";
+    }
+  }
+  return {output_shape};
+}
+
+std::vector<Type> InferDtypeForFusedConv2dNHWC(const std::vector<Type> &inputs_type,
+                                               const framework::AttrMapType &attrs) {
+  CHECK_GE(inputs_type.size(), 2UL) << "The fused_conv2d_nhwc takes x and w! Please check again.";
+  return {inputs_type[0]};
+}
+
 std::shared_ptr<OpStrategy> StrategyForConv2dNCHWc(const framework::NodeAttr &attrs,
                                                    const std::vector<ir::Tensor> &inputs,
                                                    const std::vector<Type> &out_type,
@@ -2304,6 +2555,16 @@ CINN_REGISTER_HELPER(nn_ops) {
       .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
       .set_support_level(4);
 
+  CINN_REGISTER_OP(fused_conv2d_nhwc)
+      .describe("Do a 2-D convolution with an NHWC layout followed by the optional bias, residual and relu.")
+      .set_num_inputs(4)  // x, w, and the optional bias and residual
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForFusedConv2dNHWC)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForFusedConv2dNHWC))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForFusedConv2dNHWC))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
   CINN_REGISTER_OP(conv2d_NCHWc)
       .describe("Do a 2-D convolution with an NCHWc layout. Input is 5D tensor and weight is 6D tensor.")
       .set_num_inputs(2)  // here we consider filter as another input
@@ -31,6 +31,7 @@
 #include "cinn/runtime/flags.h"
 
 DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_x86_winograd_conv);
 
 namespace cinn {
 namespace hlir {
@@ -508,6 +509,74 @@ TEST(Operator, Operator_Transpose_Test0) {
   ASSERT_EQ(transpose->description, "This operator implements the meta op transpose.");
 }
 
+TEST(Operator, Operator_Conv2d_Winograd_Test0) {
+  // the conv2d computed by the host winograd kernel is only lowered by the ir schedule
+  if (!FLAGS_cinn_ir_schedule) return;
+  auto conv2d   = Operator::Get("conv2d");
+  Operator temp = *conv2d;
+  auto strategy = Operator::GetAttrs<StrategyFunction>("CINNStrategy");
+
+  int n = 2, c_in = 16, h = 14, w = 13, c_out = 24;
+  Placeholder<float> A("A", {Expr(n), Expr(c_in), Expr(h), Expr(w)});
+  Placeholder<float> B("B", {Expr(c_out), Expr(c_in), Expr(3), Expr(3)});
+
+  NodeAttr attrs;
+  attrs.attr_store["padding"]  = std::vector<int>({1, 1});
+  attrs.attr_store["stride"]   = std::vector<int>({1, 1});
+  attrs.attr_store["dilation"] = std::vector<int>({1, 1});
+  std::vector<ir::Tensor> inputs{A.tensor(), B.tensor()};
+  std::vector<Type> type{Float(32)};
+  common::Target target   = common::DefaultHostTarget();
+  std::vector<int> out_sh = {n, c_out, h, w};
+
+  // the winograd kernel is chosen when the strategy is created
+  FLAGS_cinn_x86_winograd_conv = true;
+  auto impl                    = OpStrategy::SelectImpl(strategy[conv2d](attrs, inputs, type, {out_sh}, target));
+  FLAGS_cinn_x86_winograd_conv = false;
+
+  std::string func_name = "conv2d_winograd";
+  std::vector<common::CINNValue> cinn_inputs{common::CINNValue(A), common::CINNValue(B)};
+  auto module =
+      LowerToModule("Operator_Conv2d_Winograd_Test0", func_name, impl, {"A", "B"}, "C", inputs, cinn_inputs, target);
+
+  auto jit = backends::ExecutionEngine::Create({});
+  jit->Link(module);
+  auto fn = jit->Lookup("fn_" + func_name);
+  CHECK(fn);
+  auto fn_ = reinterpret_cast<void (*)(void *, int32_t)>(fn);
+
+  cinn_buffer_t *A_buf = common::BufferBuilder(Float(32), {n, c_in, h, w}).set_random().Build();
+  cinn_buffer_t *B_buf = common::BufferBuilder(Float(32), {c_out, c_in, 3, 3}).set_random().Build();
+  cinn_buffer_t *C_buf = common::BufferBuilder(Float(32), out_sh).set_random().Build();
+  cinn_pod_value_t a_arg(A_buf), b_arg(B_buf), c_arg(C_buf);
+  cinn_pod_value_t args[] = {a_arg, b_arg, c_arg};
+  fn_(args, 3);
+
+  auto input   = reinterpret_cast<float *>(A_buf->memory);
+  auto weights = reinterpret_cast<float *>(B_buf->memory);
+  auto output  = reinterpret_cast<float *>(C_buf->memory);
+  for (int b = 0; b < n; ++b) {
+    for (int oc = 0; oc < c_out; ++oc) {
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          double expect = 0;
+          for (int ic = 0; ic < c_in; ++ic) {
+            for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) {
+                int iy = y + i - 1, ix = x + j - 1;
+                if (iy < 0 || iy >= h || ix < 0 || ix >= w) continue;
+                expect += input[((b * c_in + ic) * h + iy) * w + ix] * weights[((oc * c_in + ic) * 3 + i) * 3 + j];
+              }
+            }
+          }
+          ASSERT_NEAR(output[((b * c_out + oc) * h + y) * w + x], expect, 1e-3);
+        }
+      }
+    }
+  }
+  ASSERT_EQ(impl->name, "strategy.conv2d.x86");
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -43,3 +43,5 @@ CINN_USE_REGISTER(bitcast_convert_ops)
 CINN_USE_REGISTER(op_external_api)
 CINN_USE_REGISTER(resize_ops)
 CINN_USE_REGISTER(assert_true_ops)
+CINN_USE_REGISTER(layer_norm_ops)
+CINN_USE_REGISTER(attention_ops)
@@ -0,0 +1,240 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/hlir/pass/fusion_helper_base.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+// An analytic estimate of the time to run groups as kernels, in the bytes moved from and to the memory. The
+// computation, the launch and the streams beyond what the hardware prefetches well are converted to bytes by the
+// coefficients of the target. It is rough, but enough to tell whether a fusion saves more memory traffic than the
+// recomputation it brings.
+class FusionCostEstimator {
+ public:
+  using GroupPtr = std::shared_ptr<Graph::Group>;
+  using GroupSet = std::unordered_set<GroupPtr, Graph::Group::SharedGroupHasher, Graph::Group::SharedGroupComparator>;
+
+  FusionCostEstimator(const Graph* graph, const FusionHelperBase* helper)
+      : dtype_dict_(graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype")), helper_(helper) {
+    if (helper->target_.arch == common::Target::Arch::NVGPU) {
+      // a launch takes several microseconds, in which the device could move about 1MB.
+      launch_cost_  = 1 << 20;
+      compute_cost_ = 0.125;
+      max_streams_  = 0;
+    } else {
+      launch_cost_  = 1 << 16;
+      compute_cost_ = 0.5;
+      max_streams_  = 16;
+    }
+  }
+
+  // the max number of elements of the tensors read or written by the group.
+  int64_t GetGroupSize(const GroupPtr& group) const {
+    int64_t size = 1;
+    for (auto node : group->CollectNodes()) {
+      size = std::max(size, GetNumel(helper_->GetNodeData(node)));
+      for (auto node_data : FusionHelperBase::GetProducerNodeData(node)) {
+        size = std::max(size, GetNumel(node_data));
+      }
+    }
+    return size;
+  }
+
+  // the cost of running the group as one kernel, return false if the estimate is unavailable.
+  bool GroupCost(const GroupPtr& group, double* cost) const {
+    return KernelCost(group->CollectNodes(), group->output_nodes, cost);
+  }
+
+  // the cost saved by fusing the producer into each of the consumers, which recomputes the producer in every fused
+  // kernel. It is negative if the fusion hurts, return false if the estimate is unavailable.
+  bool VerticalFusionGain(const GroupPtr& producer, const GroupSet& consumers, double* gain) const {
+    double unfused = 0.0, fused = 0.0, cost = 0.0;
+    if (!GroupCost(producer, &cost)) {
+      return false;
+    }
+    unfused += cost;
+
+    auto producer_nodes = producer->CollectNodes();
+    std::unordered_set<Node*> nodes_set(producer_nodes.begin(), producer_nodes.end());
+    for (auto& consumer : consumers) {
+      for (auto node : consumer->CollectNodes()) {
+        nodes_set.insert(node);
+      }
+    }
+    // the outputs of producer used by the others are still written, by the first fused kernel.
+    std::unordered_set<Node*> kept_outputs;
+    for (auto node : producer->output_nodes) {
+      if (helper_->output_nodes_set_.count(node)) {
+        kept_outputs.insert(node);
+        continue;
+      }
+      for (auto user : GetUsers(node)) {
+        if (!nodes_set.count(user)) {
+          kept_outputs.insert(node);
+          break;
+        }
+      }
+    }
+
+    for (auto& consumer : consumers) {
+      if (!GroupCost(consumer, &cost)) {
+        return false;
+      }
+      unfused += cost;
+
+      auto nodes = consumer->CollectNodes();
+      nodes.insert(nodes.end(), producer_nodes.begin(), producer_nodes.end());
+      auto outputs = consumer->output_nodes;
+      outputs.insert(kept_outputs.begin(), kept_outputs.end());
+      kept_outputs.clear();
+      if (!KernelCost(nodes, outputs, &cost)) {
+        return false;
+      }
+      fused += cost;
+    }
+
+    *gain = unfused - fused;
+    return true;
+  }
+
+ private:
+  bool KernelCost(const std::vector<Node*>& nodes, const std::unordered_set<Node*>& outputs, double* cost) const {
+    std::unordered_set<Node*> nodes_set(nodes.begin(), nodes.end());
+    std::unordered_set<NodeData*> inputs;
+    double bytes = 0.0;
+    for (auto node : nodes) {
+      for (auto node_data : FusionHelperBase::GetProducerNodeData(node)) {
+        if (nodes_set.count(node_data->source_node.get()) || !inputs.insert(node_data).second) {
+          continue;
+        }
+        auto size = GetBytes(node_data);
+        if (size <= 0) {
+          return false;
+        }
+        bytes += size;
+      }
+    }
+    for (auto node : outputs) {
+      auto size = GetBytes(helper_->GetNodeData(node));
+      if (size <= 0) {
+        return false;
+      }
+      bytes += size;
+    }
+
+    double compute = 0.0;
+    std::unordered_map<Node*, int64_t> evaluations;
+    for (auto node : nodes) {
+      auto times = GetEvaluations(node, nodes_set, outputs, &evaluations);
+      if (times <= 0) {
+        return false;
+      }
+      compute += times;
+    }
+
+    // the streams beyond what the prefetchers track miss the cache more.
+    int streams = inputs.size() + outputs.size();
+    if (max_streams_ > 0 && streams > max_streams_) {
+      bytes += bytes * (streams - max_streams_) / streams;
+    }
+    *cost = bytes + compute * compute_cost_ + launch_cost_;
+    return true;
+  }
+
+  // The number of times the node is evaluated in the kernel. A node used by exactly one node in the kernel is inlined
+  // into it and so evaluated once per element of its user, while the others are written to buffers.
+  int64_t GetEvaluations(Node* node,
+                         const std::unordered_set<Node*>& nodes_set,
+                         const std::unordered_set<Node*>& outputs,
+                         std::unordered_map<Node*, int64_t>* evaluations) const {
+    auto it = evaluations->find(node);
+    if (it != evaluations->end()) {
+      return it->second;
+    }
+
+    int64_t times = GetNumel(helper_->GetNodeData(node));
+    if (helper_->GetOpKind(node) == framework::kReduction) {
+      times = GetNumel(FusionHelperBase::GetProducerNodeData(node)[0]);
+    } else if (times > 0 && !outputs.count(node)) {
+      std::vector<Node*> users;
+      for (auto user : GetUsers(node)) {
+        if (nodes_set.count(user)) {
+          users.push_back(user);
+        }
+      }
+      if (users.size() == 1) {
+        times = std::max(times, GetEvaluations(users[0], nodes_set, outputs, evaluations));
+      }
+    }
+    (*evaluations)[node] = times;
+    return times;
+  }
+
+  std::vector<Node*> GetUsers(const Node* node) const {
+    std::vector<Node*> users;
+    for (auto& edge : helper_->GetNodeData(node)->outlinks()) {
+      auto user = edge->sink()->safe_as<Node>();
+      if (user && std::find(users.begin(), users.end(), user) == users.end()) {
+        users.push_back(user);
+      }
+    }
+    return users;
+  }
+
+  // return -1 if the shape is unknown or dynamic.
+  int64_t GetNumel(const NodeData* node_data) const {
+    auto it = helper_->shape_dict_.find(node_data->id());
+    if (it == helper_->shape_dict_.end()) {
+      return -1;
+    }
+    int64_t numel = 1;
+    for (auto dim : it->second) {
+      if (dim <= 0) {
+        return -1;
+      }
+      numel *= dim;
+    }
+    return numel;
+  }
+
+  // the bytes of the tensor in its own dtype, return -1 if the shape or the dtype is unknown.
+  int64_t GetBytes(const NodeData* node_data) const {
+    auto it = dtype_dict_.find(node_data->id());
+    if (it == dtype_dict_.end() || it->second.bytes() <= 0) {
+      return -1;
+    }
+    auto numel = GetNumel(node_data);
+    return numel > 0 ? numel * it->second.bytes() : -1;
+  }
+
+  const absl::flat_hash_map<std::string, common::Type>& dtype_dict_;
+  const FusionHelperBase* helper_;
+  double launch_cost_;
+  double compute_cost_;
+  int max_streams_;
+};
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
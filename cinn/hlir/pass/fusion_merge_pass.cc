@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "cinn/hlir/pass/fusion_cost_estimator.h"
 #include "cinn/hlir/pass/fusion_merge_pass_util.h"
 
 DECLARE_bool(enhance_vertical_fusion_with_recompute);
+DECLARE_int32(cinn_horizontal_fusion_max_size);
+DECLARE_bool(cinn_fusion_merge_with_cost_model);
 
 namespace cinn {
 namespace hlir {
@@ -43,7 +46,7 @@ using ConditionFunction = std::function<bool(const FusionHelperBase*, const Grou
 // code generation.
 class FusionMergePassHelper : public FusionHelperBase {
  public:
-  FusionMergePassHelper(const Graph* graph) : FusionHelperBase(graph) {
+  FusionMergePassHelper(const Graph* graph) : FusionHelperBase(graph), cost_estimator_(graph, this) {
     fusion_groups_ = graph->fusion_groups;
     // init fusion relation.
     InitFusionRelation();
@@ -68,9 +71,15 @@ class FusionMergePassHelper : public FusionHelperBase {
         VLOG(3) << "  Consumer -> " << consumer->group_id;
       }
     }
+    for (auto& decision : decisions_) {
+      VLOG(1) << decision;
+    }
     return fusion_groups_;
   }
 
+  // the vertical fusions scored by the cost estimator, in the order they were decided.
+  const std::vector<std::string>& decisions() const { return decisions_; }
+
  private:
   void DoFusionMerge() {
     VLOG(3) << "DoFusionMerge...!";
@@ -78,6 +87,33 @@ class FusionMergePassHelper : public FusionHelperBase {
     }
     while (DoVerticalFusion()) {
     }
+    if (FLAGS_cinn_horizontal_fusion_max_size > 0) {
+      FuseIndependentGroups();
+    }
+  }
+
+  // Pack the small groups without any dependency between them into one kernel, even if they share neither a producer
+  // nor an input, to save the launches of the tiny kernels. The large groups are left alone as they could fill the
+  // device by themselves.
+  bool FuseIndependentGroups() {
+    VLOG(3) << "FuseIndependentGroups...!";
+    std::unordered_set<GroupPtr, Hasher, Comparator> small_groups;
+    for (auto& group : fusion_groups_) {
+      if (group->belong_groups.size() || group->op_pattern_kind > framework::kReduction) {
+        continue;
+      }
+      if (cost_estimator_.GetGroupSize(group) > FLAGS_cinn_horizontal_fusion_max_size) {
+        continue;
+      }
+      small_groups.insert(group);
+    }
+
+    GroupPtr producer(nullptr);
+    auto updated = HorizontalFusion(producer, small_groups);
+    if (updated) {
+      UpdateFusionGroup();
+    }
+    return updated;
   }
 
   bool DoHorizontalFusion() {
@@ -431,6 +467,10 @@ class FusionMergePassHelper : public FusionHelperBase {
       RecomputeWithCostModel(producer, fusionable_consumers);
     }
 
+    if (FLAGS_cinn_fusion_merge_with_cost_model && fusionable_consumers.size() && !is_const_group(this, producer)) {
+      SelectConsumersWithCost(producer, fusionable_consumers);
+    }
+
     // if fusionable consumers exist
     if (fusionable_consumers.size()) {
       VerticalFuse(producer, fusionable_consumers);
@@ -716,6 +756,82 @@ class FusionMergePassHelper : public FusionHelperBase {
     }
   }
 
+  // Keep the consumers chosen by the rules only if fusing the producer into them saves more than the recomputation of
+  // the producer costs, the rules stand if the cost can't be estimated.
+  void SelectConsumersWithCost(const GroupPtr& producer,
+                               std::unordered_set<GroupPtr, Hasher, Comparator>& fusionable_consumers) {
+    std::vector<std::pair<double, GroupPtr>> scored_consumers;
+    for (auto& consumer : fusionable_consumers) {
+      double gain = 0.0;
+      if (!cost_estimator_.VerticalFusionGain(producer, {consumer}, &gain)) {
+        Report("fuse", producer, fusionable_consumers, "the cost is unknown");
+        return;
+      }
+      scored_consumers.emplace_back(gain, consumer);
+    }
+    std::sort(scored_consumers.begin(), scored_consumers.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first > rhs.first;
+    });
+
+    // add the consumers in the order of their own gain while the producer recomputed in them pays off.
+    std::unordered_set<GroupPtr, Hasher, Comparator> selected;
+    double best_gain = 0.0;
+    for (auto& scored : scored_consumers) {
+      auto trial = selected;
+      trial.insert(scored.second);
+      double gain = 0.0;
+      cost_estimator_.VerticalFusionGain(producer, trial, &gain);
+      if (gain > best_gain) {
+        best_gain = gain;
+        selected  = trial;
+      }
+    }
+
+    // the consumers left apart read the outputs of producer from a fused group, which can't depend on them.
+    std::unordered_set<GroupPtr, Hasher, Comparator> dropped;
+    for (auto& consumer : fusionable_consumers) {
+      if (!selected.count(consumer)) {
+        dropped.insert(consumer);
+      }
+    }
+    bool updated = dropped.size() > 0;
+    while (updated) {
+      updated = false;
+      for (auto& consumer : GroupList(selected.begin(), selected.end())) {
+        if (IsDependency(producer, consumer, dropped)) {
+          selected.erase(consumer);
+          dropped.insert(consumer);
+          updated = true;
+        }
+      }
+    }
+    if (selected.size() && !cost_estimator_.VerticalFusionGain(producer, selected, &best_gain)) {
+      best_gain = 0.0;
+    }
+
+    if (selected.size() && best_gain > 0.0) {
+      Report("fuse", producer, selected, "save " + std::to_string(static_cast<int64_t>(best_gain)) + " bytes");
+    } else {
+      dropped.insert(selected.begin(), selected.end());
+      selected.clear();
+    }
+    if (dropped.size()) {
+      Report("don't fuse", producer, dropped, "the fusion costs more than it saves");
+    }
+    fusionable_consumers = selected;
+  }
+
+  void Report(const std::string& action,
+              const GroupPtr& producer,
+              const std::unordered_set<GroupPtr, Hasher, Comparator>& consumers,
+              const std::string& reason) {
+    std::string decision = action + " producer " + producer->group_id + " into";
+    for (auto& consumer : consumers) {
+      decision += " " + consumer->group_id;
+    }
+    decisions_.push_back(decision + ": " + reason);
+  }
+
   bool IsDependency(const GroupPtr& producer_g,
                     const GroupPtr& consumer,
                     const std::unordered_set<GroupPtr, Hasher, Comparator>& consumers) {
@@ -993,6 +1109,9 @@ class FusionMergePassHelper : public FusionHelperBase {
     std::unordered_map<framework::OpPatternKind, ConditionFunction> horizontal_relation;
   };
   std::unordered_map<framework::OpPatternKind, Relation> fusion_relation_map_;
+
+  FusionCostEstimator cost_estimator_;
+  std::vector<std::string> decisions_;
 };
 
 void FusionMergePassInternal(Graph* graph) {
@@ -1002,7 +1121,8 @@ void FusionMergePassInternal(Graph* graph) {
   }
 
   FusionMergePassHelper fusion_merge_pass_helper(graph);
-  graph->fusion_groups = fusion_merge_pass_helper();
+  graph->fusion_groups                   = fusion_merge_pass_helper();
+  graph->attrs["fusion_merge_decisions"] = std::make_shared<absl::any>(fusion_merge_pass_helper.decisions());
 }
 
 }  // namespace pass
@@ -12,9 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 #include "cinn/frontend/decomposer/test_helper.h"
+#include "cinn/hlir/pass/fusion_cost_estimator.h"
+
+DECLARE_int32(cinn_horizontal_fusion_max_size);
+DECLARE_bool(cinn_fusion_merge_with_cost_model);
 
 namespace cinn {
 namespace frontend {
@@ -483,5 +488,121 @@ TEST(FusionMergePass, Reduce_Test_5) {
   CHECK_EQ(graph->fusion_groups.size(), 1);
 }
 
+TEST(FusionMergePass, Horizontal_Fusion_Independent_0) {
+  int h = 32, w = 32;
+  NetBuilder net_builder("Horizontal_Fusion_Independent_0");
+  // create model
+  {
+    auto A = net_builder.CreateInput(Float(32), {h, w}, "A");
+    auto B = net_builder.CreateInput(Float(32), {h, w}, "B");
+    auto C = net_builder.CreateInput(Float(32), {h, w}, "C");
+    auto D = net_builder.CreateInput(Float(32), {h, w}, "D");
+    auto E = net_builder.CreateInput(Float(32), {h, w}, "E");
+    auto F = net_builder.CreateInput(Float(32), {h, w}, "F");
+    auto G = net_builder.Add(A, B);
+    auto H = net_builder.Add(C, D);
+    auto I = net_builder.Multiply(E, F);
+  }
+
+  auto program = net_builder.Build();
+  auto target  = common::DefaultTarget();
+  RunDecomposer(&program, target);
+
+  auto graph = std::make_shared<hlir::framework::Graph>(program, target);
+  hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+  CHECK_EQ(graph->fusion_groups.size(), 3);
+  FLAGS_cinn_horizontal_fusion_max_size = h * w;
+  hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+  FLAGS_cinn_horizontal_fusion_max_size = 0;
+  CHECK_EQ(graph->fusion_groups.size(), 1);
+}
+
+TEST(FusionMergePass, Horizontal_Fusion_Independent_1) {
+  int h = 1024, w = 1024;
+  NetBuilder net_builder("Horizontal_Fusion_Independent_1");
+  // create model
+  {
+    auto A = net_builder.CreateInput(Float(32), {h, w}, "A");
+    auto B = net_builder.CreateInput(Float(32), {h, w}, "B");
+    auto C = net_builder.CreateInput(Float(32), {h, w}, "C");
+    auto D = net_builder.CreateInput(Float(32), {h, w}, "D");
+    auto E = net_builder.Add(A, B);
+    auto F = net_builder.Add(C, D);
+  }
+
+  auto program = net_builder.Build();
+  auto target  = common::DefaultTarget();
+  RunDecomposer(&program, target);
+
+  auto graph = std::make_shared<hlir::framework::Graph>(program, target);
+  hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+  CHECK_EQ(graph->fusion_groups.size(), 2);
+  // the large groups are left alone.
+  FLAGS_cinn_horizontal_fusion_max_size = 32 * 32;
+  hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+  FLAGS_cinn_horizontal_fusion_max_size = 0;
+  CHECK_EQ(graph->fusion_groups.size(), 2);
+}
+
+namespace {
+std::shared_ptr<hlir::framework::Graph> BuildBroadcastGraph(int h, int w) {
+  NetBuilder net_builder("Broadcast_Cost_" + std::to_string(h) + "_" + std::to_string(w));
+  // create model
+  {
+    auto A = net_builder.CreateInput(Float(32), {w}, "A");
+    auto B = net_builder.CreateInput(Float(32), {w}, "B");
+    auto C = net_builder.CreateInput(Float(32), {h, w}, "C");
+    auto D = net_builder.CreateInput(Float(32), {h, w}, "D");
+    auto E = net_builder.Add(A, B);
+    auto F = net_builder.Add(C, E);
+    auto G = net_builder.Add(D, E);
+  }
+
+  auto program = net_builder.Build();
+  auto target  = common::DefaultHostTarget();
+  RunDecomposer(&program, target);
+
+  auto graph = std::make_shared<hlir::framework::Graph>(program, target);
+  hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+  CHECK_EQ(graph->fusion_groups.size(), 3);
+  return graph;
+}
+
+// the gain of fusing E into both F and G, which recomputes E in each of them.
+double GetBroadcastFusionGain(int h, int w) {
+  auto graph = BuildBroadcastGraph(h, w);
+  hlir::pass::FusionHelperBase helper(graph.get());
+  hlir::pass::FusionCostEstimator estimator(graph.get(), &helper);
+  for (auto& group : graph->fusion_groups) {
+    if (group->consumer_groups.size() == 2) {
+      double gain = 0.0;
+      CHECK(estimator.VerticalFusionGain(group, group->consumer_groups, &gain));
+      return gain;
+    }
+  }
+  LOG(FATAL) << "Can't find the producer group!";
+  return 0.0;
+}
+}  // namespace
+
+TEST(FusionMergePass, Cost_Model_Test_0) {
+  // recomputing a small producer saves the launch and the traffic of its output.
+  CHECK_GT(GetBroadcastFusionGain(32, 32), 0.0);
+  // but not when it is recomputed for every element of large consumers.
+  CHECK_LT(GetBroadcastFusionGain(4096, 1024), 0.0);
+}
+
+TEST(FusionMergePass, Cost_Model_Test_1) {
+  auto graph                              = BuildBroadcastGraph(4096, 1024);
+  FLAGS_cinn_fusion_merge_with_cost_model = true;
+  hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+  FLAGS_cinn_fusion_merge_with_cost_model = false;
+  // F and G are fused horizontally first, in which E is computed only once.
+  CHECK_EQ(graph->fusion_groups.size(), 1);
+  auto& decisions = graph->GetAttrs<std::vector<std::string>>("fusion_merge_decisions");
+  CHECK_EQ(decisions.size(), 1);
+  CHECK_EQ(decisions[0].find("fuse producer"), 0);
+}
+
 }  // namespace frontend
 }  // namespace cinn
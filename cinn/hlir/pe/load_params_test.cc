@@ -47,6 +47,39 @@ TEST(load_x86_params, load_x86_params) {
   ASSERT_EQ(unroll_kw, 1);
 }
 
+TEST(load_x86_params, default_factors) {
+  absl::flat_hash_map<std::string, int> conv2d_factors;
+  auto target                    = common::DefaultHostTarget();
+  int lanes                      = GetBasicFactor(Float(32), target);
+  std::vector<int> shape_input   = {1, 96, 30, 30};
+  std::vector<int> shape_weights = {192, 96, 3, 3};
+  std::vector<int> strides       = {1, 1};
+  std::vector<int> pads          = {0, 0};
+  std::vector<int> dilations     = {1, 1};
+  std::string key                = GenerateX86ConvKey(shape_input, shape_weights, strides, pads, dilations);
+  ASSERT_EQ(ScheduleParam::get_x86_instance().GetParam().count(key), 0);
+  GetConv2dFactors(&conv2d_factors, 192, 96, 96, -1, 28, Float(32), target, key);
+  int oc_bn_size = conv2d_factors["oc_bn"];
+  int ow_bn_size = conv2d_factors["ow_bn"];
+  // the factors divide their axes, and the accumulators of the ow tile fit 16 vectors
+  ASSERT_EQ(192 % oc_bn_size, 0);
+  ASSERT_LE(oc_bn_size, 2 * lanes);
+  ASSERT_GE(oc_bn_size, lanes);
+  ASSERT_EQ(conv2d_factors["ic_bn"], conv2d_factors["fc_bn"]);
+  ASSERT_EQ(96 % conv2d_factors["ic_bn"], 0);
+  ASSERT_EQ(28 % ow_bn_size, 0);
+  ASSERT_LE(ow_bn_size * oc_bn_size, 16 * lanes);
+  ASSERT_GE(ow_bn_size, 4);
+
+  conv2d_factors.clear();
+  GetConv2d1x1Factors(&conv2d_factors, 16, 3, 56, 56, Float(32), target);
+  ASSERT_EQ(conv2d_factors["oc_bn"], 16);
+  ASSERT_EQ(conv2d_factors["ic_bn"], 3);
+  ASSERT_EQ(56 % conv2d_factors["ow_bn"], 0);
+  ASSERT_EQ(56 % conv2d_factors["oh_bn"], 0);
+  ASSERT_LE(conv2d_factors["oh_bn"] * conv2d_factors["ow_bn"] * 16, 16 * lanes);
+}
+
 TEST(load_cuda_params, load_cuda_params) {
   auto &res = ScheduleParam::get_cuda_instance().GetParam();
   if (res.empty()) {
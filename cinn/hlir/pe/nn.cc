@@ -371,7 +371,7 @@ std::vector<ir::Tensor> Conv2d_NCHW_5D(const ir::Tensor &input,
   auto weights_dilation = Compute(
       new_weights_shape,
       [=](Expr occ, Expr fcc, Expr yy, Expr xx, Expr fcb, Expr ocb) {
-        return weights(occ * oc_bn + ocb, fcc * ic_bn + fcb, yy, xx);
+        return weights(occ * oc_bn + ocb, fcc * fc_bn + fcb, yy, xx);
       },
       UniqName("weights_dilation_vec"));
 
@@ -488,6 +488,107 @@ std::vector<ir::Tensor> Conv2d_NCHWc(const ir::Tensor &input,
   return {packed_out, input_pad};
 }
 
+std::vector<ir::Tensor> Conv2d_NCHW_Winograd_Host(const ir::Tensor &input,
+                                                  const ir::Tensor &weights,
+                                                  int pad_h,
+                                                  int pad_w,
+                                                  int tile_size,
+                                                  const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of Conv2d_NCHW_Winograd_Host op is not 4! Please check.";
+  CHECK_EQ(weights->shape.size(), 4U) << "Weight's dimension of Conv2d_NCHW_Winograd_Host op is not 4! Please check.";
+  CHECK(is_zero(weights->shape[2] - 3) && is_zero(weights->shape[3] - 3)) << "The winograd conv2d only supports 3x3";
+  CHECK(input->type().is_float(32) || input->type().is_float(64))
+      << "The winograd conv2d only supports float32 and float64";
+  std::string func_name =
+      input->type().is_float(64) ? "cinn_host_winograd_conv2d_nchw_fp64" : "cinn_host_winograd_conv2d_nchw_fp32";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(func_name,
+                                {
+                                    input,                    // input
+                                    weights,                  // weights
+                                    Expr(input->shape[0]),    // batch_size
+                                    Expr(input->shape[1]),    // c_in
+                                    Expr(input->shape[2]),    // input_h
+                                    Expr(input->shape[3]),    // input_w
+                                    Expr(weights->shape[0]),  // c_out
+                                    Expr(pad_h),              // pad_h
+                                    Expr(pad_w),              // pad_w
+                                    Expr(tile_size)           // tile_size
+                                });
+      },
+      UniqName("conv2d_nchw_winograd_call"));
+  auto out  = call->TupleGet(0);
+  out->name = output_name;
+  out->set_type(input->type());
+  out->WithBuffer(input->type());
+  return {out, call};
+}
+
+std::vector<ir::Tensor> Conv2d_NHWC_Direct_Host(const ir::Tensor &input,
+                                                const ir::Tensor &weights,
+                                                const ir::Tensor &bias,
+                                                const ir::Tensor &residual,
+                                                bool relu,
+                                                int pad_h,
+                                                int pad_w,
+                                                int stride_h,
+                                                int stride_w,
+                                                int dilation_h,
+                                                int dilation_w,
+                                                int oc_block,
+                                                int ow_block,
+                                                const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of Conv2d_NHWC_Direct_Host op is not 4! Please check.";
+  CHECK_EQ(weights->shape.size(), 4U) << "Weight's dimension of Conv2d_NHWC_Direct_Host op is not 4! Please check.";
+  CHECK(is_zero(input->shape[3] - weights->shape[1])) << "The direct NHWC conv2d does not support groups";
+  CHECK(input->type().is_float(32) || input->type().is_float(64))
+      << "The direct NHWC conv2d only supports float32 and float64";
+  if (bias.defined()) {
+    CHECK_EQ(bias->shape.size(), 1U) << "The bias of Conv2d_NHWC_Direct_Host should be 1-D";
+  }
+  if (residual.defined()) {
+    CHECK_EQ(residual->shape.size(), 4U) << "The residual of Conv2d_NHWC_Direct_Host should be 4-D";
+  }
+  // the same flags as the epilogue of the runtime
+  int epilogue = (bias.defined() ? 1 : 0) | (residual.defined() ? 2 : 0) | (relu ? 4 : 0);
+  std::string func_name = input->type().is_float(64) ? "cinn_host_conv2d_nhwc_fp64" : "cinn_host_conv2d_nhwc_fp32";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern(func_name,
+                                {
+                                    input,                                  // input
+                                    weights,                                // weights
+                                    bias.defined() ? bias : input,          // bias, not read if absent
+                                    residual.defined() ? residual : input,  // residual, not read if absent
+                                    Expr(input->shape[0]),                  // batch
+                                    Expr(input->shape[1]),                  // input_h
+                                    Expr(input->shape[2]),                  // input_w
+                                    Expr(input->shape[3]),                  // c_in
+                                    Expr(weights->shape[0]),                // c_out
+                                    Expr(weights->shape[2]),                // filter_h
+                                    Expr(weights->shape[3]),                // filter_w
+                                    Expr(pad_h),                            // pad_h
+                                    Expr(pad_w),                            // pad_w
+                                    Expr(stride_h),                         // stride_h
+                                    Expr(stride_w),                         // stride_w
+                                    Expr(dilation_h),                       // dilation_h
+                                    Expr(dilation_w),                       // dilation_w
+                                    Expr(epilogue),                         // epilogue
+                                    Expr(oc_block),                         // oc_block
+                                    Expr(ow_block)                          // ow_block
+                                });
+      },
+      UniqName("conv2d_nhwc_direct_call"));
+  auto out  = call->TupleGet(0);
+  out->name = output_name;
+  out->set_type(input->type());
+  out->WithBuffer(input->type());
+  return {out, call};
+}
+
 #ifdef CINN_WITH_MKLDNN
 std::vector<ir::Tensor> Conv2d_NCHW_MKLDNN(const ir::Tensor &input,
                                            const ir::Tensor &weights,
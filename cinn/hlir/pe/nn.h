@@ -166,6 +166,63 @@ std::vector<ir::Tensor> Conv2d_NCHWc(const ir::Tensor &input,
                                      const std::string &output_name = UniqName("T_Conv2d_NCHWc_out"),
                                      const common::Target &target   = common::DefaultHostTarget());
 
+/**
+ * @brief Perform a 3x3 2-D convolution of stride 1 and dilation 1 with an NCHW-layout by the winograd algorithm of the
+ * host runtime, only used in X86. The transformed weights are cached by the runtime between the runs.
+ *
+ * @param input The 4-D input tensor {N, C_in, H, W}
+ * @param weights The 4-D weight tensor {C_out, C_in, 3, 3}
+ * @param pad_h padding applied to the height of the image
+ * @param pad_w padding applied to the width of the image
+ * @param tile_size The output tile size m of F(m x m, 3 x 3), 2 or 4
+ * @param output_name The name of the output tensor
+ *
+ * @return the output tensor and the call of the extern function
+ */
+std::vector<ir::Tensor> Conv2d_NCHW_Winograd_Host(const ir::Tensor &input,
+                                                  const ir::Tensor &weights,
+                                                  int pad_h,
+                                                  int pad_w,
+                                                  int tile_size,
+                                                  const std::string &output_name = UniqName("T_Conv2d_NCHW_out"));
+
+/**
+ * @brief Perform a 2-D convolution with an NHWC-layout by the direct microkernels of the host runtime, only used in
+ * X86. The channels are innermost, and each microkernel keeps a tile of ow_block output pixels by oc_block output
+ * channels in the vector registers. The bias, the residual and the relu are applied to the tile before it is stored.
+ *
+ * @param input The 4-D input tensor {N, H, W, C_in}
+ * @param weights The 4-D weight tensor {C_out, C_in, filter_h, filter_w}
+ * @param bias The 1-D bias {C_out} added to the output, or an undefined tensor
+ * @param residual The 4-D tensor {N, out_h, out_w, C_out} added to the output after the bias, or an undefined tensor
+ * @param relu Whether to apply relu at last
+ * @param pad_h padding applied to the height of the image
+ * @param pad_w padding applied to the width of the image
+ * @param stride_h striding applied to the height of the image
+ * @param stride_w striding applied to the width of the image
+ * @param dilation_h dilation applied to the height of the image
+ * @param dilation_w dilation applied to the width of the image
+ * @param oc_block The output channels of a tile, 8, 16 or 32
+ * @param ow_block The output pixels of a tile, 4, 6 or 8
+ * @param output_name The name of the output tensor
+ *
+ * @return the output tensor and the call of the extern function
+ */
+std::vector<ir::Tensor> Conv2d_NHWC_Direct_Host(const ir::Tensor &input,
+                                                const ir::Tensor &weights,
+                                                const ir::Tensor &bias,
+                                                const ir::Tensor &residual,
+                                                bool relu,
+                                                int pad_h,
+                                                int pad_w,
+                                                int stride_h,
+                                                int stride_w,
+                                                int dilation_h,
+                                                int dilation_w,
+                                                int oc_block,
+                                                int ow_block,
+                                                const std::string &output_name = UniqName("T_Conv2d_NHWC_out"));
+
 #ifdef CINN_WITH_MKLDNN
 std::vector<ir::Tensor> Conv2d_NCHW_MKLDNN(const ir::Tensor &input,
                                            const ir::Tensor &weights,
@@ -128,8 +128,12 @@ void ScheduleInjectiveCPU(poly::Stage *stage,
   if (vectorizable) {
     poly::Iterator lo;
     poly::Iterator li;
-    int last_shape   = stage->GetDimRange(dims - 1);
-    factor           = GetVectorizeFactor(last_shape, factor);
+    int last_shape = stage->GetDimRange(dims - 1);
+    // the tail of a dimension longer than the factor is vectorized by VectorizeLoops, so only the shorter ones take a
+    // narrower divisor
+    if (last_shape < factor) {
+      factor = GetVectorizeFactor(last_shape, factor);
+    }
     std::tie(lo, li) = stage->Split(stage->axis(dims - 1), factor);
     stage->Vectorize(li, factor);
     if (dims == 1) {
@@ -597,6 +601,50 @@ void PoolScheduleGPU(poly::StageMap stages, ir::Tensor &output, const common::Ta
   stages[output]->Bind(1, "threadIdx.x");
 }
 
+namespace {
+
+// The largest divisor of `extent` not larger than `limit`, the blocking factors divide their axes so that the
+// unrolled and vectorized loops have no tails.
+int GetLargestDivisor(int extent, int limit) {
+  for (int i = std::min(extent, limit); i > 1; i--) {
+    if (extent % i == 0) return i;
+  }
+  return 1;
+}
+
+// The shape-agnostic blocking of the conv2d without tuned params, which follows the params tuned in
+// load_x86_params.cc instead of the smallest legal factors:
+// - oc_inner is vectorized by up to two vectors of the target;
+// - ic_inner, the innermost reduction, holds up to four vectors of channels for the reuse of the packed weights;
+// - the accumulators of the ow (and oh) tile, each of oc_bn elements, take up to sixteen vectors, which keeps them
+//   in registers together with the loaded weights and the broadcast inputs.
+// A negative extent is unknown, and its factor is left out or is 1.
+void GetConv2dDefaultFactors(absl::flat_hash_map<std::string, int> *factors,
+                             int oc,
+                             int ic,
+                             int fc,
+                             int oh,
+                             int ow,
+                             const Type &type,
+                             const common::Target &target) {
+  const int lanes                    = GetBasicFactor(type, target);
+  const int max_accumulator_elements = 16 * lanes;
+  int oc_bn                          = oc < 1 ? lanes : GetLargestDivisor(oc, 2 * lanes);
+  (*factors)["oc_bn"]                = oc < 1 ? 1 : oc_bn;
+  (*factors)["ic_bn"]                = ic < 1 ? 1 : GetLargestDivisor(ic, 4 * lanes);
+  (*factors)["fc_bn"]                = fc < 1 ? 1 : GetLargestDivisor(fc, 4 * lanes);
+  int max_tile                       = std::max(1, max_accumulator_elements / oc_bn);
+  int ow_bn                          = ow < 1 ? 1 : GetLargestDivisor(ow, max_tile);
+  (*factors)["ow_bn"]                = ow_bn;
+  if (oh >= 1) {
+    (*factors)["oh_bn"] = GetLargestDivisor(oh, std::max(1, max_tile / ow_bn));
+  }
+  VLOG(3) << "use the default conv2d factors, oc_bn: " << (*factors)["oc_bn"] << ", ic_bn: " << (*factors)["ic_bn"]
+          << ", ow_bn: " << ow_bn;
+}
+
+}  // namespace
+
 void GetConv2dFactors(absl::flat_hash_map<std::string, int> *factors,
                       int oc,
                       int ic,
@@ -641,63 +689,7 @@ void GetConv2dFactors(absl::flat_hash_map<std::string, int> *factors,
       VLOG(3) << "Can not find saved param, key is: " << key;
     }
   }
-  int bn_base = GetBasicFactor(type, target);
-  int oc_bn   = 1;
-  for (int i = bn_base; i > 1; i--) {
-    if (oc < 1) break;
-    if (oc % i == 0) {
-      oc_bn = i;
-      break;
-    }
-  }
-  int ic_bn = 1;
-  for (int i = oc_bn; i > 1; i--) {
-    if (ic < 1) break;
-    if (ic % i == 0) {
-      ic_bn = i;
-      break;
-    }
-  }
-  int fc_bn = 1;
-  for (int i = oc_bn; i > 1; i--) {
-    if (fc < 1) break;
-    if (fc % i == 0) {
-      fc_bn = i;
-      break;
-    }
-  }
-  (*factors)["oc_bn"] = oc_bn;
-  (*factors)["ic_bn"] = ic_bn;
-  (*factors)["fc_bn"] = fc_bn;
-  int ow_bn           = 1;
-
-  if (oh < 1) {
-    for (int i = bn_base; i > 1; i--) {
-      if (ow < 1) break;
-      if (ow % i == 0) {
-        ow_bn = i;
-        break;
-      }
-    }
-    (*factors)["ow_bn"] = ow_bn;
-  } else {
-    int oh_bn = 1;
-    int begin = std::min(ow, bn_base);
-    for (int i = begin; i >= 1; i--) {
-      if (ow < 1) break;
-      if (ow % i == 0) {
-        ow_bn = i;
-        for (int j = oh; j >= 1; j--) {
-          if (oh % j == 0 && j * ow_bn <= 16) {
-            oh_bn               = j;
-            (*factors)["oh_bn"] = oh_bn;
-            (*factors)["ow_bn"] = ow_bn;
-            return;
-          }
-        }
-      }
-    }
-  }
+  GetConv2dDefaultFactors(factors, oc, ic, fc, oh, ow, type, target);
 }
 
 void GetConv2d1x1Factors(absl::flat_hash_map<std::string, int> *factors,
@@ -707,42 +699,7 @@ void GetConv2d1x1Factors(absl::flat_hash_map<std::string, int> *factors,
                          int ow,
                          const Type &type,
                          const common::Target &target) {
-  int bn_base = GetBasicFactor(type, target);
-  int oc_bn   = 1;
-  for (int i = bn_base; i > 1; i--) {
-    if (oc < 1) break;
-    if (oc % i == 0) {
-      oc_bn = i;
-      break;
-    }
-  }
-  int ic_bn = 1;
-  for (int i = oc_bn; i > 1; i--) {
-    if (ic < 1) break;
-    if (ic % i == 0) {
-      ic_bn = i;
-      break;
-    }
-  }
-  (*factors)["oc_bn"] = oc_bn;
-  (*factors)["ic_bn"] = ic_bn;
-  int ow_bn           = 1;
-  int oh_bn           = 1;
-  int begin           = std::min(ow, bn_base);
-  for (int i = begin; i >= 1; i--) {
-    if (ow < 1) break;
-    if (ow % i == 0) {
-      ow_bn = i;
-      for (int j = oh; j >= 1; j--) {
-        if (oh % j == 0 && j * ow_bn <= 16) {
-          oh_bn               = j;
-          (*factors)["oh_bn"] = oh_bn;
-          (*factors)["ow_bn"] = ow_bn;
-          return;
-        }
-      }
-    }
-  }
+  GetConv2dDefaultFactors(factors, oc, ic, ic, oh, ow, type, target);
 }
 
 std::string GenerateX86ConvKey(const std::vector<Expr> &input_shape,
@@ -846,7 +803,9 @@ void Conv2d_NCHWc_1X1_Schedule_CPU(poly::StageMap stages,
   int oh                 = h_out.as_int32();
   int ow                 = w_out.as_int32();
   int basic_split_factor = GetBasicFactor(type, target);
-  GetConv2dFactors(&conv2d_factors, -1, -1, -1, oh, ow, type, target, key);
+  // the default ow and oh tiles depend on the oc_bn the output is packed by
+  int packed_oc_bn = common::AutoSimplify(packed_out->shape.back()).as_int32();
+  GetConv2dFactors(&conv2d_factors, packed_oc_bn, -1, -1, oh, ow, type, target, key);
   int oh_bn_size = conv2d_factors["oh_bn"];
   int ow_bn_size = conv2d_factors["ow_bn"];
 
@@ -974,7 +933,9 @@ void Conv2d_NCHWc_1X1_Schedule_CPU_Nofuse(poly::StageMap stages,
   int oh                 = h_out.as_int32();
   int ow                 = w_out.as_int32();
   int basic_split_factor = GetBasicFactor(type, target);
-  GetConv2d1x1Factors(&conv2d_factors, -1, -1, oh, ow, type, target);
+  // the default ow and oh tiles depend on the oc_bn the output is packed by
+  int packed_oc_bn = common::AutoSimplify(packed_out->shape.back()).as_int32();
+  GetConv2d1x1Factors(&conv2d_factors, packed_oc_bn, -1, oh, ow, type, target);
   int oh_bn_size = conv2d_factors["oh_bn"];
   int ow_bn_size = conv2d_factors["ow_bn"];
 
@@ -1077,7 +1038,9 @@ void Conv2d_NCHWc_Schedule_CPU_Nofuse(poly::StageMap stages,
   Expr w_out             = common::AutoSimplify(packed_out->shape[3]);
   int ow                 = w_out.as_int32();
   int basic_split_factor = GetBasicFactor(type, target);
-  GetConv2dFactors(&conv2d_factors, -1, -1, -1, -1, ow, type, target);
+  // the default ow tile depends on the oc_bn the output is packed by
+  int packed_oc_bn = common::AutoSimplify(packed_out->shape.back()).as_int32();
+  GetConv2dFactors(&conv2d_factors, packed_oc_bn, -1, -1, -1, ow, type, target);
   int ow_bn_size = conv2d_factors["ow_bn"];
 
   auto input_shape = input_pad->shape;
@@ -1178,7 +1141,8 @@ void Conv2d_NCHWc_Schedule_CPU(poly::StageMap stages,
   int ic_bn_size = ic_bn.as_int32();
 
   absl::flat_hash_map<std::string, int> conv2d_factors;
-  GetConv2dFactors(&conv2d_factors, -1, -1, -1, -1, ow, type, target, key);
+  // the default ow tile depends on the oc_bn the output is packed by
+  GetConv2dFactors(&conv2d_factors, oc_bn_size, -1, -1, -1, ow, type, target, key);
   int ow_bn_size = conv2d_factors["ow_bn"];
   VLOG(3) << "ow_bn_size " << ow_bn_size;
   VLOG(3) << "oc_bn_size " << oc_bn_size;
@@ -1286,7 +1250,9 @@ void Depthwise_Conv2d_NCHWc_Schedule_CPU_Nofuse(poly::StageMap stages,
   Expr w_out             = common::AutoSimplify(packed_out->shape[3]);
   int ow                 = w_out.as_int32();
   int basic_split_factor = GetBasicFactor(type, target);
-  GetConv2dFactors(&conv2d_factors, -1, -1, -1, -1, ow, type, target);
+  // the default ow tile depends on the oc_bn the output is packed by
+  int packed_oc_bn = common::AutoSimplify(packed_out->shape.back()).as_int32();
+  GetConv2dFactors(&conv2d_factors, packed_oc_bn, -1, -1, -1, ow, type, target);
   int ow_bn_size = conv2d_factors["ow_bn"];
 
   auto input_shape = input_pad->shape;
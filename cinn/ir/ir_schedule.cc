@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <random>
 #include <set>
@@ -35,12 +36,15 @@
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule_util.h"
 #include "cinn/ir/ir_visitor.h"
+#include "cinn/ir/tensor_intrin.h"
 #include "cinn/lang/compute.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/replace_var_with_expr.h"
 #include "cinn/utils/string.h"
 
+CINN_USE_REGISTER(tensor_intrins)
+
 namespace cinn {
 namespace ir {
 
@@ -99,6 +103,14 @@ class ScheduleImpl {
   void ReverseComputeInline(const Expr& schedule_block);
   void Bind(const Expr& loop, const std::string& thread_axis);
   Expr Rfactor(const Expr& rf_loop, int rf_axis);
+  Expr Blockize(const Expr& loop);
+  void Tensorize(const Expr& loop_or_block, const std::string& intrin_name);
+  Expr DecomposeReduction(const Expr& block, const Expr& loop);
+  void TransformLayout(const Expr& block,
+                       int buffer_index,
+                       bool is_write_buffer,
+                       const std::vector<int>& split_factors,
+                       const std::vector<int>& axis_order);
   Expr AddUnitLoop(const Expr& block) const;
   void Annotate(const Expr& block, const std::string& key, const attr_t& value);
   void Unannotate(Expr& block, const std::string& key);
@@ -594,6 +606,319 @@ Expr ScheduleImpl::Rfactor(const Expr& rf_loop, int rf_axis) {
   return rf_create.CreateRfAllStmts();
 }
 
+Expr ScheduleImpl::Blockize(const Expr& loop) {
+  CHECK(loop.As<ir::For>()) << "Expr param of Blockize must be For node! Please check.";
+  std::vector<Expr> child_blocks = GetChildBlocks(loop);
+  CHECK(!child_blocks.empty()) << "There is no schedule block in the loop to be blockized! Please check.";
+  std::vector<Expr> all_loops = GetLoops(child_blocks.back());
+  auto loop_it                = std::find(all_loops.begin(), all_loops.end(), loop);
+  CHECK(loop_it != all_loops.end()) << "The loop to be blockized is not found! Please check.";
+
+  // The new block is bound to the loops outside the loop, whose vars are replaced by the iter vars of the block.
+  std::vector<Var> outer_vars;
+  std::vector<Var> iter_vars;
+  std::vector<Expr> iter_values;
+  std::vector<Expr> substitute_values;
+  for (auto it = all_loops.begin(); it != loop_it; ++it) {
+    auto* for_node = it->As<ir::For>();
+    Var iter_var(for_node->min,
+                 common::AutoSimplify(for_node->min + for_node->extent),
+                 common::UniqName(for_node->loop_var->name + "_o"),
+                 false);
+    outer_vars.push_back(for_node->loop_var);
+    iter_vars.push_back(iter_var);
+    iter_values.push_back(Expr(for_node->loop_var));
+    substitute_values.push_back(Expr(iter_var));
+  }
+  Expr body = optim::IRCopy(loop);
+  ReplaceExpr(&body, outer_vars, substitute_values);
+
+  std::string block_name =
+      child_blocks.back().As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name + "_blockize";
+  // The regions of the new block cover all the accesses of the inner blocks over the blockized loops.
+  std::vector<Expr> read_buffers  = CalculateAccessRegions(body, false);
+  std::vector<Expr> write_buffers = CalculateAccessRegions(body, true);
+  Expr new_block                  = ScheduleBlockRealize::Make(
+      iter_values,
+      ScheduleBlock::Make(iter_vars, read_buffers, write_buffers, common::UniqName(block_name), Block::Make({body})));
+  this->Replace(loop, new_block);
+  return new_block;
+}
+
+void ScheduleImpl::Tensorize(const Expr& loop_or_block, const std::string& intrin_name) {
+  const TensorIntrin* intrin = TensorIntrinRegistry::Global()->Find(intrin_name);
+  CHECK(intrin) << "Tensor intrinsic " << intrin_name << " is not registered! Please check.";
+  Expr block = loop_or_block.As<ir::For>() ? Blockize(loop_or_block) : loop_or_block;
+  CHECK(block.As<ir::ScheduleBlockRealize>())
+      << "Expr param of Tensorize must be For node or ScheduleBlockRealize node! Please check.";
+  Expr loop = block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->body;
+  if (loop.As<ir::Block>() && loop.As<ir::Block>()->stmts.size() == 1U) loop = loop.As<ir::Block>()->stmts[0];
+  CHECK(loop.As<ir::For>()) << "The block to be tensorized must be blockized from a loop! Please check.";
+
+  Expr impl = MatchTensorIntrin(*intrin, loop);
+  CHECK(impl.defined()) << "The loop nest doesn't match the tensor intrinsic " << intrin_name << "! Please check.\n"
+                        << loop;
+  Expr new_block = optim::IRCopy(block);
+  new_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->body = impl;
+  this->Replace(block, new_block);
+}
+
+Expr ScheduleImpl::DecomposeReduction(const Expr& block, const Expr& loop) {
+  CHECK(block.As<ir::ScheduleBlockRealize>())
+      << "Expr param(block) of DecomposeReduction must be ScheduleBlockRealize node! Please check.";
+  CHECK(loop.As<ir::For>()) << "Expr param(loop) of DecomposeReduction must be For node! Please check.";
+  auto* block_realize           = block.As<ir::ScheduleBlockRealize>();
+  auto* schedule_block          = block_realize->schedule_block.As<ir::ScheduleBlock>();
+  std::vector<Expr> block_loops = GetLoops(block);
+  int loop_index                = std::find(block_loops.begin(), block_loops.end(), loop) - block_loops.begin();
+  CHECK_LT(loop_index, static_cast<int>(block_loops.size()))
+      << "The loop is not a loop of the block " << schedule_block->name << "! Please check.";
+
+  // The init block is bound to the spatial iter vars of the reduction block only.
+  std::set<std::string> spatial_loop_vars;
+  std::set<std::string> reduce_loop_vars;
+  std::vector<Var> init_iter_vars;
+  std::vector<Expr> init_iter_values;
+  for (int i = 0; i < schedule_block->iter_vars.size(); ++i) {
+    bool is_reduce = schedule_block->iter_vars[i]->is_reduce_axis;
+    auto vars =
+        ir::CollectIRNodesWithoutTensor(block_realize->iter_values[i], [](const Expr* x) { return x->as_var(); });
+    for (auto& var : vars) (is_reduce ? reduce_loop_vars : spatial_loop_vars).insert(var.as_var()->name);
+    if (!is_reduce) {
+      init_iter_vars.push_back(schedule_block->iter_vars[i]);
+      init_iter_values.push_back(block_realize->iter_values[i]);
+    }
+  }
+  CHECK(!reduce_loop_vars.empty()) << "The block " << schedule_block->name << " is not a reduction! Please check.";
+  for (int i = 0; i < loop_index; ++i) {
+    CHECK(!reduce_loop_vars.count(block_loops[i].As<ir::For>()->loop_var->name))
+        << "The reduce loop " << block_loops[i].As<ir::For>()->loop_var->name
+        << " is outside the loop to decompose the reduction at! Please check.";
+  }
+
+  // Take the init value from the previous init block and remove it, or from the reduce computation of the tensor.
+  Expr store            = GetNthAccessExpr(block, 0, true);
+  Tensor tensor         = store.As<ir::Store>()->tensor.as_tensor_ref();
+  std::string init_name = GenReduceInitTensorNameOf(tensor->name);
+  Expr init_value;
+  if (HasBlock(init_name)) {
+    Expr old_init_block = GetBlock(init_name);
+    init_value          = GetNthAccessExpr(old_init_block, 0, true).As<ir::Store>()->value;
+    Expr root           = GetRootBlock(old_init_block);
+    Expr source_expr{nullptr};
+    Expr target_expr{nullptr};
+    LeafBlockRemovalPlan remove_plan(old_init_block, &source_expr, &target_expr);
+    remove_plan(&root);
+    CHECK(source_expr.defined()) << "Failed to remove the init block " << init_name << "! Please check.";
+    this->Replace(source_expr, target_expr);
+  } else {
+    CHECK(tensor->is_compute_node() && tensor->body().As<ir::Reduce>())
+        << "The init value of the reduction " << tensor->name << " is not found! Please check.";
+    init_value = tensor->body().As<ir::Reduce>()->init;
+  }
+
+  Expr init_body = optim::IRCopy(schedule_block->body);
+  auto init_stores =
+      ir::CollectIRNodesWithoutTensor(init_body, [](const Expr* x) { return x->As<ir::Store>(); }, true);
+  CHECK_EQ(init_stores.size(), 1U) << "One block should only have one Store node! Please check.";
+  Expr init_store                   = *init_stores.begin();
+  init_store.As<ir::Store>()->value = init_value;
+  Expr init_block =
+      ScheduleBlockRealize::Make(init_iter_values, ScheduleBlock::Make(init_iter_vars, {}, {}, init_name, init_body));
+
+  // Copy the spatial loops under the loop, the reduce loops are dropped.
+  Expr init_nest = init_block;
+  std::vector<Var> replaced_vars;
+  std::vector<Expr> init_loop_vars;
+  for (int i = static_cast<int>(block_loops.size()) - 1; i >= loop_index; --i) {
+    auto* for_node = block_loops[i].As<ir::For>();
+    if (!spatial_loop_vars.count(for_node->loop_var->name)) continue;
+    CHECK(!reduce_loop_vars.count(for_node->loop_var->name))
+        << "The loop " << for_node->loop_var->name << " is bound to both spatial and reduce iter vars! Please check.";
+    Var init_loop_var(for_node->loop_var->name + "_init", for_node->loop_var->type());
+    replaced_vars.push_back(for_node->loop_var);
+    init_loop_vars.push_back(Expr(init_loop_var));
+    init_nest = For::Make(init_loop_var,
+                          for_node->min,
+                          for_node->extent,
+                          for_node->for_type(),
+                          for_node->device_api,
+                          Block::Make({init_nest}),
+                          for_node->vectorize_info(),
+                          for_node->bind_info());
+  }
+  ReplaceExpr(&init_nest, replaced_vars, init_loop_vars);
+
+  // Insert the init loop nest right before the loop.
+  Expr parent = loop_index > 0 ? block_loops[loop_index - 1] : GetRootBlock(block);
+  Expr* parent_body =
+      parent.As<ir::For>() ? &parent.As<ir::For>()->body
+                           : &parent.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->body;
+  if (!parent_body->As<ir::Block>()) *parent_body = Block::Make({*parent_body});
+  auto& stmts  = parent_body->As<ir::Block>()->stmts;
+  auto stmt_it = std::find(stmts.begin(), stmts.end(), loop);
+  CHECK(stmt_it != stmts.end()) << "The loop to decompose the reduction at is not found in its parent! Please check.";
+  stmts.insert(stmt_it, init_nest);
+  return init_block;
+}
+
+// The name of the buffer accessed through a tensor, several tensors may access the same buffer, such as the tensor of a
+// reduction and that of its init.
+static std::string AccessedBufferName(const _Tensor_* tensor) {
+  return tensor->buffer.defined() ? tensor->buffer->name : tensor->name;
+}
+
+// Rewrite the accesses to a buffer after its layout is transformed, each tensor accessing the buffer is replaced by a
+// copy in the new shape.
+struct LayoutRewriter : public ir::IRMutator<> {
+ public:
+  LayoutRewriter(const std::string& buffer_name,
+                 const std::vector<Expr>& new_shape,
+                 const std::vector<int>& split_factors,
+                 const std::vector<int>& axis_order)
+      : buffer_name_(buffer_name), new_shape_(new_shape), split_factors_(split_factors), axis_order_(axis_order) {}
+
+  void operator()(Expr* expr) { IRMutator::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::ScheduleBlock* expr, Expr* op) override {
+    bool outer_accessed = accessed_;
+    accessed_           = false;
+    IRMutator::Visit(expr, op);
+    // The buffer regions accessed by the block are analyzed again when they are required.
+    if (accessed_) {
+      op->As<ir::ScheduleBlock>()->read_buffers.clear();
+      op->As<ir::ScheduleBlock>()->write_buffers.clear();
+    }
+    accessed_ = accessed_ || outer_accessed;
+  }
+
+  void Visit(const ir::Load* expr, Expr* op) override {
+    IRMutator::Visit(expr, op);
+    auto* node = op->As<ir::Load>();
+    if (node->tensor.as_tensor() && AccessedBufferName(node->tensor.as_tensor()) == buffer_name_) {
+      node->tensor  = Expr(Reshape(node->tensor.as_tensor_ref()));
+      node->indices = MapIndices(node->indices);
+      accessed_     = true;
+    }
+  }
+
+  void Visit(const ir::Store* expr, Expr* op) override {
+    IRMutator::Visit(expr, op);
+    auto* node = op->As<ir::Store>();
+    if (node->tensor.as_tensor() && AccessedBufferName(node->tensor.as_tensor()) == buffer_name_) {
+      node->tensor  = Expr(Reshape(node->tensor.as_tensor_ref()));
+      node->indices = MapIndices(node->indices);
+      accessed_     = true;
+    }
+  }
+
+  // The buffer keeps its size, only the tensors accessing it are reshaped.
+  Tensor Reshape(const Tensor& tensor) {
+    auto it = new_tensors_.find(tensor->name);
+    if (it != new_tensors_.end()) return it->second;
+    Tensor new_tensor  = optim::IRCopy(Expr(tensor)).as_tensor_ref();
+    new_tensor->buffer = tensor->buffer;
+    new_tensor->shape  = new_shape_;
+    new_tensor->domain = new_shape_;
+    new_tensors_.emplace(tensor->name, new_tensor);
+    return new_tensor;
+  }
+
+  std::vector<Expr> MapIndices(const std::vector<Expr>& indices) const {
+    CHECK_EQ(indices.size(), split_factors_.size());
+    std::vector<Expr> split_indices;
+    for (int i = 0; i < indices.size(); ++i) {
+      if (split_factors_[i] > 1) {
+        split_indices.push_back(common::AutoSimplify(Div::Make(indices[i], Expr(split_factors_[i]))));
+        split_indices.push_back(common::AutoSimplify(Mod::Make(indices[i], Expr(split_factors_[i]))));
+      } else {
+        split_indices.push_back(indices[i]);
+      }
+    }
+    std::vector<Expr> new_indices;
+    for (int axis : axis_order_) new_indices.push_back(split_indices[axis]);
+    return new_indices;
+  }
+
+  const std::string& buffer_name_;
+  const std::vector<Expr>& new_shape_;
+  const std::vector<int>& split_factors_;
+  const std::vector<int>& axis_order_;
+  std::map<std::string, Tensor> new_tensors_;
+  bool accessed_{false};
+};
+
+void ScheduleImpl::TransformLayout(const Expr& block,
+                                   int buffer_index,
+                                   bool is_write_buffer,
+                                   const std::vector<int>& split_factors,
+                                   const std::vector<int>& axis_order) {
+  CHECK(block.As<ir::ScheduleBlockRealize>())
+      << "Expr param(block) of TransformLayout must be ScheduleBlockRealize node! Please check.";
+  Expr access   = GetNthAccessExpr(block, buffer_index, is_write_buffer);
+  Tensor tensor = is_write_buffer ? access.As<ir::Store>()->tensor.as_tensor_ref()
+                                  : access.As<ir::Load>()->tensor.as_tensor_ref();
+  // Only an intermediate buffer, which is both produced and consumed in the module, can change its layout. The callers
+  // see the buffers of the function arguments, and the external calls assume the layouts of their buffers.
+  CHECK(!tensor->is_placeholder_node() && !tensor->is_call_node())
+      << "The buffer " << tensor->name
+      << " is a function argument or an external tensor, its layout can't be transformed! Please check.";
+  // The accesses are checked and rewritten by the same criterion, the name of the buffer accessed.
+  std::string buffer_name = AccessedBufferName(tensor.self());
+  auto is_target_buffer   = [&](const Expr& target) {
+    return target.as_tensor() && AccessedBufferName(target.as_tensor()) == buffer_name;
+  };
+  bool is_produced = false;
+  bool is_consumed = false;
+  for (auto& expr : module_expr_.GetExprs()) {
+    ir::CollectIRNodesWithoutTensor(expr, [&](const Expr* x) {
+      if (x->As<ir::Store>() && is_target_buffer(x->As<ir::Store>()->tensor)) is_produced = true;
+      if (x->As<ir::Load>() && is_target_buffer(x->As<ir::Load>()->tensor)) is_consumed = true;
+      return false;
+    });
+  }
+  CHECK(is_produced && is_consumed) << "The buffer " << tensor->name
+                                    << " is not an intermediate buffer of the module but a function argument, its "
+                                       "layout can't be transformed! Please check.";
+  CHECK_EQ(split_factors.size(), tensor->shape.size())
+      << "The number of split factors should be equal to the rank of the buffer " << tensor->name << "! Please check.";
+
+  std::vector<Expr> split_shape;
+  for (int i = 0; i < split_factors.size(); ++i) {
+    CHECK_GE(split_factors[i], 1) << "The split factors of TransformLayout should be positive! Please check.";
+    if (split_factors[i] == 1) {
+      split_shape.push_back(tensor->shape[i]);
+      continue;
+    }
+    CHECK(tensor->shape[i].is_constant()) << "The axis " << i << " of the buffer " << tensor->name
+                                          << " to be split should have a constant extent! Please check.";
+    int extent = tensor->shape[i].as_int32();
+    CHECK_EQ(extent % split_factors[i], 0) << "The split factor " << split_factors[i] << " doesn't divide the extent "
+                                           << extent << " of the axis " << i << "! Please check.";
+    split_shape.push_back(Expr(extent / split_factors[i]));
+    split_shape.push_back(Expr(split_factors[i]));
+  }
+
+  std::vector<int> order = axis_order;
+  if (order.empty()) {
+    for (int i = 0; i < split_shape.size(); ++i) order.push_back(i);
+  }
+  std::vector<int> sorted_order = order;
+  std::sort(sorted_order.begin(), sorted_order.end());
+  CHECK_EQ(sorted_order.size(), split_shape.size())
+      << "The axis order of TransformLayout is not a permutation of the axes after the split! Please check.";
+  for (int i = 0; i < sorted_order.size(); ++i) {
+    CHECK_EQ(sorted_order[i], i)
+        << "The axis order of TransformLayout is not a permutation of the axes after the split! Please check.";
+  }
+
+  std::vector<Expr> new_shape;
+  for (int axis : order) new_shape.push_back(split_shape[axis]);
+  LayoutRewriter rewriter(buffer_name, new_shape, split_factors, order);
+  for (auto expr : module_expr_.GetExprs()) rewriter(&expr);
+}
+
 struct CacheReadRewriter : public ir::IRMutator<> {
  public:
   static Expr Rewrite(const Expr& root, CacheBlockInfo* info) {
@@ -2206,6 +2531,42 @@ Expr IRSchedule::Rfactor(const Expr& rf_loop, int rf_axis) {
   return result;
 }
 
+Expr IRSchedule::Blockize(const Expr& loop) {
+  auto result = impl_->Blockize(loop);
+  trace_.Append(ScheduleDesc::Step("Blockize", {{"loop", std::vector<Expr>({loop})}}, {}, {result}));
+  return result;
+}
+
+void IRSchedule::Tensorize(const Expr& loop_or_block, const std::string& intrin_name) {
+  impl_->Tensorize(loop_or_block, intrin_name);
+  trace_.Append(ScheduleDesc::Step(
+      "Tensorize", {{"loop_or_block", std::vector<Expr>({loop_or_block})}}, {{"intrin_name", intrin_name}}, {}));
+}
+
+Expr IRSchedule::DecomposeReduction(const Expr& block, const Expr& loop) {
+  auto result = impl_->DecomposeReduction(block, loop);
+  trace_.Append(ScheduleDesc::Step("DecomposeReduction",
+                                   {{"block", std::vector<Expr>({block})}, {"loop", std::vector<Expr>({loop})}},
+                                   {},
+                                   {result}));
+  return result;
+}
+
+void IRSchedule::TransformLayout(const Expr& block,
+                                 int buffer_index,
+                                 bool is_write_buffer,
+                                 const std::vector<int>& split_factors,
+                                 const std::vector<int>& axis_order) {
+  impl_->TransformLayout(block, buffer_index, is_write_buffer, split_factors, axis_order);
+  trace_.Append(ScheduleDesc::Step("TransformLayout",
+                                   {{"block", std::vector<Expr>({block})}},
+                                   {{"buffer_index", buffer_index},
+                                    {"is_write_buffer", is_write_buffer},
+                                    {"split_factors", split_factors},
+                                    {"axis_order", axis_order}},
+                                   {}));
+}
+
 void IRSchedule::Annotate(const Expr& block, const std::string& key, const attr_t& value) {
   impl_->Annotate(block, key, value);
 
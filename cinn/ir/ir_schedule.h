@@ -353,6 +353,97 @@ class IRSchedule {
    */
   Expr Rfactor(const Expr& rf_loop, int rf_axis);
 
+  /**
+   * \brief Wrap the loop nest rooted at a loop into a new block. The new block is bound to the loops outside the loop,
+   * and the loop nest accesses the outer loop vars by the iter vars of the new block.
+   * @param loop The root loop of the loop nest to be blockized.
+   * @return The new block.
+   *
+   * For example, blockize the loop i_1 of:
+   * \code
+   * for (i_0, 0, 4)
+   *   for (i_1, 0, 8)
+   *     ScheduleBlock(B)
+   *       i0 = axis.bind(8 * i_0 + i_1)
+   *       B[i0] = A[i0]
+   * \endcode
+   * The result is:
+   * \code
+   * for (i_0, 0, 4)
+   *   ScheduleBlock(B_blockize)
+   *     i_0_o = axis.bind(i_0)
+   *     for (i_1, 0, 8)
+   *       ScheduleBlock(B)
+   *         i0 = axis.bind(8 * i_0_o + i_1)
+   *         B[i0] = A[i0]
+   * \endcode
+   */
+  Expr Blockize(const Expr& loop);
+
+  /**
+   * \brief Replace a loop nest with the microkernel of a tensor intrinsic registered in TensorIntrinRegistry, the loop
+   * nest must compute what the intrinsic describes. The block of the loop nest is kept and its body becomes the call
+   * of the extern function implementing the intrinsic on the tiles of the tensors accessed.
+   * @param loop_or_block The root loop of the loop nest, which is blockized first, or the block blockized from it.
+   * @param intrin_name The name of the tensor intrinsic.
+   */
+  void Tensorize(const Expr& loop_or_block, const std::string& intrin_name);
+
+  /**
+   * \brief Hoist the init of a reduction block to a new init block right before a loop of the reduction. The init
+   * block is nested in the loops outside the loop and the copies of the spatial loops under the loop, so the output
+   * tile accumulated by the loop nest is initialized just before it. The previous init block of the reduction is
+   * removed.
+   * @param block The reduction block.
+   * @param loop The loop of the reduction block to put the init block before, none of the reduce loops is outside it.
+   * @return The new init block.
+   *
+   * For example, decompose the reduction of C at the loop k_0 of:
+   * \code
+   * for (i, 0, 32)
+   *   for (j, 0, 32)
+   *     C__reduce_init[i, j] = 0
+   * for (i, 0, 32)
+   *   for (k_0, 0, 4)
+   *     for (j, 0, 32)
+   *       for (k_1, 0, 5)
+   *         C[i, j] = C[i, j] + A[i, 5 * k_0 + k_1] * B[5 * k_0 + k_1, j]
+   * \endcode
+   * The result is:
+   * \code
+   * for (i, 0, 32)
+   *   for (j_init, 0, 32)
+   *     C__reduce_init[i, j_init] = 0
+   *   for (k_0, 0, 4)
+   *     for (j, 0, 32)
+   *       for (k_1, 0, 5)
+   *         C[i, j] = C[i, j] + A[i, 5 * k_0 + k_1] * B[5 * k_0 + k_1, j]
+   * \endcode
+   */
+  Expr DecomposeReduction(const Expr& block, const Expr& loop);
+
+  /**
+   * \brief Change the layout of a buffer accessed by a block and rewrite all the accesses to it in the module. Each
+   * axis of the buffer is split by a factor into an outer axis and an inner axis, then the axes are reordered.
+   * \note Only an intermediate buffer, produced and consumed in the module, can be transformed. The buffers of the
+   * function arguments and the external tensors are rejected since the callers or the external calls see them. The
+   * accesses are identified by the buffer, so every tensor accessing it, such as the init of a reduction, is reshaped.
+   * @param block The block accessing the buffer.
+   * @param buffer_index The index of the buffer among the buffers read or written by the block.
+   * @param is_write_buffer Whether the buffer is written by the block.
+   * @param split_factors The factor to split each axis of the buffer by, 1 means not to split the axis. The factors
+   * must divide the extents of the axes.
+   * @param axis_order The order of the axes after the split, which is the identity if it is empty.
+   *
+   * For example, the buffer B[32, 64] becomes B[4, 64, 8] accessed by B[i / 8, j, i % 8] instead of B[i, j] if
+   * split_factors is {8, 1} and axis_order is {0, 2, 1}.
+   */
+  void TransformLayout(const Expr& block,
+                       int buffer_index,
+                       bool is_write_buffer,
+                       const std::vector<int>& split_factors,
+                       const std::vector<int>& axis_order);
+
   /*!
    * \brief Annotate a block with a key-value pair to set as its attribute
    * \param block The block to be annotated
@@ -361,6 +361,76 @@ std::vector<IterRange> CalculateTensorRegions(const Expr& block,
   return result;
 }
 
+std::vector<Expr> CalculateAccessRegions(const Expr& root, bool is_write) {
+  std::vector<Tensor> tensors;
+  std::map<std::string, std::vector<IterRange>> regions;
+
+  auto block_realizes = ir::CollectIRNodesInOrder(root, [&](const Expr* x) { return x->As<ScheduleBlockRealize>(); });
+  for (auto& block : block_realizes) {
+    auto* block_realize = block.As<ScheduleBlockRealize>();
+    Expr block_body     = block_realize->schedule_block.As<ScheduleBlock>()->body;
+    // the accesses of a block nested in another block, such as a blockized one, are deduced from the innermost one
+    if (!ir::CollectIRNodesWithoutTensor(block_body, [&](const Expr* x) { return x->As<ScheduleBlockRealize>(); })
+             .empty()) {
+      continue;
+    }
+    auto iter_vars   = block_realize->schedule_block.As<ScheduleBlock>()->iter_vars;
+    auto iter_values = block_realize->iter_values;
+
+    std::vector<Var> loop_vars;
+    std::vector<IterRange> loop_ranges;
+    for (auto& loop : GetLoopsOfExpr(block, root)) {
+      loop_vars.emplace_back(loop.As<For>()->loop_var);
+      loop_ranges.emplace_back(IterRange(loop.As<For>()->min, loop.As<For>()->extent));
+    }
+
+    auto accesses = ir::CollectIRNodesInOrder(
+        block_body, [&](const Expr* x) { return is_write ? x->As<Store>() != nullptr : x->As<Load>() != nullptr; });
+    for (auto& access : accesses) {
+      Tensor tensor = is_write ? access.As<Store>()->tensor.as_tensor_ref() : access.As<Load>()->tensor.as_tensor_ref();
+      auto& indices = is_write ? access.As<Store>()->indices : access.As<Load>()->indices;
+      auto& shape   = tensor->buffer.defined() ? tensor->buffer->shape : tensor->shape;
+      CHECK_EQ(shape.size(), indices.size()) << "The indices of tensor " << tensor->name << " mismatch its shape";
+
+      std::vector<IterRange> region;
+      for (int i = 0; i < indices.size(); ++i) {
+        Expr binded_index = optim::IRCopy(indices[i]);
+        ReplaceExpr(&binded_index, iter_vars, iter_values);
+        auto range = GetAccessedRange(binded_index, loop_vars, loop_ranges);
+        // the min may depend on the loops outside root, while the extent should be constant,
+        // otherwise the whole shape is used as the accessed range conservatively
+        if (!range.extent.is_constant()) range = IterRange(Expr(0), shape[i]);
+        region.emplace_back(std::move(range));
+      }
+
+      auto it = regions.find(tensor->name);
+      if (it == regions.end()) {
+        tensors.push_back(tensor);
+        regions.emplace(tensor->name, std::move(region));
+        continue;
+      }
+      for (int i = 0; i < region.size(); ++i) {
+        auto& merged = it->second[i];
+        if (utils::GetStreamCnt(merged.min) != utils::GetStreamCnt(region[i].min) ||
+            utils::GetStreamCnt(merged.extent) != utils::GetStreamCnt(region[i].extent)) {
+          merged = IterRange(Expr(0), shape[i]);
+        }
+      }
+    }
+  }
+
+  std::vector<Expr> result;
+  for (auto& tensor : tensors) {
+    std::vector<Var> ranges;
+    for (auto& range : regions.at(tensor->name)) {
+      ranges.emplace_back(
+          Var(range.min, common::AutoSimplify(range.min + range.extent), common::UniqName(tensor->name + "_region")));
+    }
+    result.emplace_back(BufferRange(tensor->buffer, ranges));
+  }
+  return result;
+}
+
 Expr GetNthAccessExpr(const Expr& block, int index, bool is_write) {
   CHECK(block.As<ScheduleBlockRealize>());
   auto compute_body = block.As<ScheduleBlockRealize>()->schedule_block.As<ScheduleBlock>()->body;
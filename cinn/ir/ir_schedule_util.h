@@ -125,6 +125,9 @@ struct FindBlocksVisitor {
         auto* schedule_block = expr->As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>();
         if (block_name_.empty() || schedule_block->name == block_name_) {
           result.emplace_back(*expr);
+        } else {
+          // The block could be nested in a block created by Blockize.
+          Visit(&(expr->As<ir::ScheduleBlockRealize>()->schedule_block));
         }
       } else {
         Visit(&(expr->As<ir::ScheduleBlockRealize>()->schedule_block));
@@ -271,6 +274,16 @@ std::vector<IterRange> CalculateTensorRegions(const Expr& block,
                                               const Tensor& tensor,
                                               const Expr& root);
 
+/**
+ * Given an AST root, return the buffer regions read(or written) by all the ScheduleBlockRealizes in it, deduced over
+ * the loops inside root. Multiple accesses to one buffer are merged, and a dimension they disagree on covers the whole
+ * shape.
+ * @param root The AST root, such as the loop to be blockized.
+ * @param is_write Whether to collect the written regions(ir::Store) or the read regions(ir::Load).
+ * @return return The BufferRanges of the accessed buffers, in the order they are first accessed.
+ */
+std::vector<Expr> CalculateAccessRegions(const Expr& root, bool is_write);
+
 /**
  * Return n-th access tensor in block
  * @param block The ScheduleBlockRealize.
@@ -420,6 +420,24 @@ CINN_BUILD_STEP_KIND(Rfactor)
     .Attrs({"rf_axis"})
     .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Rfactor)));
 
+CINN_BUILD_STEP_KIND(Blockize)
+    .Inputs({"loop"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Blockize)));
+
+CINN_BUILD_STEP_KIND(Tensorize)
+    .Inputs({"loop_or_block"})
+    .Attrs({"intrin_name"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Tensorize)));
+
+CINN_BUILD_STEP_KIND(DecomposeReduction)
+    .Inputs({"block", "loop"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::DecomposeReduction)));
+
+CINN_BUILD_STEP_KIND(TransformLayout)
+    .Inputs({"block"})
+    .Attrs({"buffer_index", "is_write_buffer", "split_factors", "axis_order"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::TransformLayout)));
+
 CINN_BUILD_STEP_KIND(MergeExprs)
     .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::MergeExprs)));
 
@@ -662,6 +662,92 @@ TEST_F(TestScheduleDesc, StepKind_Rfactor) {
   CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
 }
 
+TEST_F(TestScheduleDesc, StepKind_Blockize) {
+  lowered_funcs         = LowerCompute({32, 64}, target);
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto loops = ir_sch.GetLoops("B");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("B")}}, loops));
+  auto block = ir_sch.Blockize(loops[1]);
+  trace.Append(ScheduleDesc::Step("Blockize", {{"loop", std::vector<Expr>({loops[1]})}}, {}, {block}));
+  CheckTracingOutputs({block}, trace);
+  CheckTracingOutputs({block}, ir_sch.GetTraceDesc());
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_Tensorize) {
+  Expr M(16);
+  Expr K(64);
+  Placeholder<float> A("A", {M, K});
+  Var k(64, "k0");
+  auto C = Compute(
+      {M}, [&](Var i) { return lang::ReduceSum(A(i, k), {k}); }, "C");
+
+  lowered_funcs =
+      cinn::lang::LowerVec("test_tensorize", CreateStages({A, C}), {A, C}, {}, {}, nullptr, target, true);
+
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  auto loops            = ir_sch.GetLoops("C");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("C")}}, loops));
+  ir_sch.Tensorize(loops[1], "cpu_reduce_sum_fp32");
+  trace.Append(ScheduleDesc::Step("Tensorize",
+                                  {{"loop_or_block", std::vector<Expr>({loops[1]})}},
+                                  {{"intrin_name", std::string("cpu_reduce_sum_fp32")}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_DecomposeReduction) {
+  Expr M(32);
+  Expr N(2);
+  Expr K(16);
+
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(16, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  lowered_funcs = cinn::lang::LowerVec(
+      "test_decompose_reduction", CreateStages({A, B, C}), {A, B, C}, {}, {}, nullptr, target, true);
+
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto loops = ir_sch.GetLoops("C");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("C")}}, loops));
+  auto block = ir_sch.GetBlock("C");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("C")}}, {block}));
+  auto init_block = ir_sch.DecomposeReduction(block, loops[0]);
+  trace.Append(ScheduleDesc::Step("DecomposeReduction",
+                                  {{"block", std::vector<Expr>({block})}, {"loop", std::vector<Expr>({loops[0]})}},
+                                  {},
+                                  {init_block}));
+  CheckTracingOutputs({init_block}, trace);
+  CheckTracingOutputs({init_block}, ir_sch.GetTraceDesc());
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_TransformLayout) {
+  lowered_funcs         = LowerCompute({32, 64}, target, true);
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto block = ir_sch.GetBlock("C");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("C")}}, {block}));
+  ir_sch.TransformLayout(block, 0, false, {8, 1}, {0, 2, 1});
+  trace.Append(ScheduleDesc::Step("TransformLayout",
+                                  {{"block", std::vector<Expr>({block})}},
+                                  {{"buffer_index", 0},
+                                   {"is_write_buffer", false},
+                                   {"split_factors", std::vector<int>({8, 1})},
+                                   {"axis_order", std::vector<int>({0, 2, 1})}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
 TEST_F(TestScheduleDesc, StepKind_MergeExprs) {
   auto funcs_0 = LowerCompute({32, 128}, target);
   auto funcs_1 = LowerCompute({32, 32, 32}, target, true, "elementwise-add_const");
@@ -0,0 +1,297 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/ir/tensor_intrin.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "cinn/common/cas.h"
+#include "cinn/common/ir_util.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/lang/compute.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+// An access of a tensor in the loop nest, the flattened index is base + sum(strides[i] * loop_vars[i]).
+struct TensorAccess {
+  Tensor tensor;
+  Expr base;
+  std::vector<int> strides;
+};
+
+// The loop nest to be tensorized: the perfectly nested loops around one block computing out += f(operands).
+struct LoopNest {
+  std::vector<const ir::For*> loops;
+  std::vector<Var> loop_vars;
+  std::vector<int> extents;
+  //! The reduction init block of out and the number of the loops around it, the init block is undefined if it is out
+  //! of the loop nest.
+  Expr init_block;
+  int init_depth{-1};
+  TensorAccess out;
+  std::vector<TensorAccess> operands;
+};
+
+Expr StripCast(Expr e) {
+  while (e.As<ir::Cast>()) e = e.As<ir::Cast>()->v();
+  return e;
+}
+
+// The flattened index with the loop vars set to the given values.
+Expr IndexAt(const Expr& index, const std::vector<Var>& loop_vars, const std::vector<int>& values) {
+  Expr copied = optim::IRCopy(index);
+  std::vector<Expr> candidates(values.begin(), values.end());
+  ReplaceExpr(&copied, loop_vars, candidates);
+  return common::AutoSimplify(copied);
+}
+
+// Analyze the access of a tensor in the block, whose indices are in terms of the iter vars of the block. The index
+// must be linear in the loop vars of the nest.
+bool AnalyzeAccess(const Expr& tensor,
+                   const std::vector<Expr>& indices,
+                   const ir::ScheduleBlockRealize* block_realize,
+                   const LoopNest& nest,
+                   TensorAccess* access) {
+  auto* tensor_node = tensor.As<ir::_Tensor_>();
+  if (!tensor_node) return false;
+  Expr index = optim::IRCopy(common::IndiceToAbsOffset(tensor_node->shape, indices));
+  ReplaceExpr(&index, block_realize->schedule_block.As<ir::ScheduleBlock>()->iter_vars, block_realize->iter_values);
+
+  int num_loops = nest.loop_vars.size();
+  access->tensor = tensor.as_tensor_ref();
+  access->base   = IndexAt(index, nest.loop_vars, std::vector<int>(num_loops, 0));
+  access->strides.clear();
+  int ones_offset = 0;
+  for (int i = 0; i < num_loops; ++i) {
+    std::vector<int> values(num_loops, 0);
+    values[i]   = 1;
+    Expr stride = common::AutoSimplify(IndexAt(index, nest.loop_vars, values) - access->base);
+    if (!stride.is_constant()) return false;
+    access->strides.push_back(static_cast<int>(stride.get_constant()));
+    ones_offset += access->strides.back();
+
+    values[i]  = nest.extents[i] - 1;
+    Expr range = common::AutoSimplify(IndexAt(index, nest.loop_vars, values) - access->base);
+    if (!range.is_constant() || static_cast<int>(range.get_constant()) != access->strides.back() * values[i]) {
+      return false;
+    }
+  }
+  // there are no products of the loop vars
+  Expr ones = common::AutoSimplify(IndexAt(index, nest.loop_vars, std::vector<int>(num_loops, 1)) - access->base);
+  return ones.is_constant() && static_cast<int>(ones.get_constant()) == ones_offset;
+}
+
+bool ParseLoopNest(const Expr& loop, LoopNest* nest) {
+  Expr stmt = loop;
+  while (stmt.As<ir::For>()) {
+    auto* for_node = stmt.As<ir::For>();
+    if (!common::is_zero(for_node->min) || !for_node->extent.is_constant()) return false;
+    nest->loops.push_back(for_node);
+    nest->loop_vars.push_back(for_node->loop_var);
+    nest->extents.push_back(static_cast<int>(for_node->extent.get_constant()));
+    stmt = for_node->body;
+    if (!stmt.As<ir::Block>()) continue;
+    auto& stmts = stmt.As<ir::Block>()->stmts;
+    if (stmts.size() == 1U) {
+      stmt = stmts[0];
+    } else if (stmts.size() == 2U && !nest->init_block.defined() && stmts[0].As<ir::ScheduleBlockRealize>()) {
+      nest->init_block = stmts[0];
+      nest->init_depth = nest->loops.size();
+      stmt             = stmts[1];
+    } else {
+      return false;
+    }
+  }
+
+  auto* block_realize = stmt.As<ir::ScheduleBlockRealize>();
+  if (!block_realize) return false;
+  auto* schedule_block = block_realize->schedule_block.As<ir::ScheduleBlock>();
+  if (nest->init_block.defined() &&
+      nest->init_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name !=
+          schedule_block->name + "__reduce_init") {
+    return false;
+  }
+  Expr body = schedule_block->body;
+  if (body.As<ir::Block>() && body.As<ir::Block>()->stmts.size() == 1U) body = body.As<ir::Block>()->stmts[0];
+  auto* store = body.As<ir::Store>();
+  if (!store || !store->value.As<ir::Add>()) return false;
+
+  // out = out + operand
+  auto is_out = [&](const Expr& e) {
+    auto* load = e.As<ir::Load>();
+    return load && load->tensor.as_tensor() && load->name() == store->name();
+  };
+  Expr acc     = store->value.As<ir::Add>()->a();
+  Expr operand = store->value.As<ir::Add>()->b();
+  if (!is_out(acc)) std::swap(acc, operand);
+  if (!is_out(acc)) return false;
+  if (!AnalyzeAccess(store->tensor, store->indices, block_realize, *nest, &nest->out)) return false;
+  TensorAccess acc_access;
+  if (!AnalyzeAccess(acc.As<ir::Load>()->tensor, acc.As<ir::Load>()->indices, block_realize, *nest, &acc_access)) {
+    return false;
+  }
+  if (acc_access.strides != nest->out.strides ||
+      !common::is_zero(common::AutoSimplify(acc_access.base - nest->out.base))) {
+    return false;
+  }
+
+  std::vector<Expr> loads;
+  operand = StripCast(operand);
+  if (operand.As<ir::Mul>()) {
+    loads = {StripCast(operand.As<ir::Mul>()->a()), StripCast(operand.As<ir::Mul>()->b())};
+  } else {
+    loads = {operand};
+  }
+  for (auto& load : loads) {
+    if (!load.As<ir::Load>()) return false;
+    TensorAccess access;
+    if (!AnalyzeAccess(load.As<ir::Load>()->tensor, load.As<ir::Load>()->indices, block_realize, *nest, &access)) {
+      return false;
+    }
+    nest->operands.push_back(access);
+  }
+
+  // Only the reduction loops are in the init block, so all the inits could be done ahead of the accumulations.
+  if (nest->init_block.defined()) {
+    for (int i = 0; i < nest->loops.size(); ++i) {
+      if ((i < nest->init_depth) != (nest->out.strides[i] != 0)) return false;
+    }
+  }
+  return true;
+}
+
+bool MatchExtent(const TensorIntrin& intrin, int i, int extent) {
+  return intrin.extents.size() <= i || intrin.extents[i] < 0 || intrin.extents[i] == extent;
+}
+
+// The arguments of the extern function of the intrinsic computing the loop nest, or empty if they don't match.
+std::vector<Expr> MatchArgs(const TensorIntrin& intrin, const LoopNest& nest) {
+  const TensorAccess& out = nest.out;
+  for (auto& operand : nest.operands) {
+    if (operand.tensor->type() != intrin.input_type) return {};
+  }
+  if (out.tensor->type() != intrin.output_type) return {};
+
+  switch (intrin.kind) {
+    case TensorIntrinKind::kGemm: {
+      if (nest.loops.size() != 3U || nest.operands.size() != 2U) return {};
+      // k is the loop not in the output, n is the contiguous dimension of the output
+      int k = -1, n = -1, m = -1;
+      for (int i = 0; i < 3; ++i) {
+        if (out.strides[i] == 0) {
+          if (k >= 0) return {};
+          k = i;
+        } else if (out.strides[i] == 1) {
+          n = i;
+        } else {
+          m = i;
+        }
+      }
+      if (k < 0 || n < 0 || m < 0) return {};
+      bool swapped          = nest.operands[0].strides[m] == 0;
+      const TensorAccess& a = nest.operands[swapped ? 1 : 0];
+      const TensorAccess& b = nest.operands[swapped ? 0 : 1];
+      if (a.strides[m] == 0 || a.strides[n] != 0 || a.strides[k] != 1) return {};
+      if (b.strides[m] != 0 || b.strides[n] != 1 || b.strides[k] == 0) return {};
+      if (!MatchExtent(intrin, 0, nest.extents[m]) || !MatchExtent(intrin, 1, nest.extents[n]) ||
+          !MatchExtent(intrin, 2, nest.extents[k])) {
+        return {};
+      }
+      return {Expr(a.tensor),
+              a.base,
+              Expr(a.strides[m]),
+              Expr(b.tensor),
+              b.base,
+              Expr(b.strides[k]),
+              Expr(nest.extents[k]),
+              Expr(out.tensor),
+              out.base,
+              Expr(out.strides[m])};
+    }
+    case TensorIntrinKind::kDot: {
+      if (nest.loops.size() != 1U || nest.operands.size() != 2U) return {};
+      const TensorAccess& a = nest.operands[0];
+      const TensorAccess& b = nest.operands[1];
+      if (out.strides[0] != 0 || a.strides[0] != 1 || b.strides[0] != 1) return {};
+      if (!MatchExtent(intrin, 0, nest.extents[0])) return {};
+      return {Expr(a.tensor), a.base, Expr(b.tensor), b.base, Expr(nest.extents[0]), Expr(out.tensor), out.base};
+    }
+    case TensorIntrinKind::kReduceSum: {
+      if (nest.loops.size() != 1U || nest.operands.size() != 1U) return {};
+      const TensorAccess& a = nest.operands[0];
+      if (out.strides[0] != 0 || a.strides[0] != 1) return {};
+      if (!MatchExtent(intrin, 0, nest.extents[0])) return {};
+      return {Expr(a.tensor), a.base, Expr(nest.extents[0]), Expr(out.tensor), out.base};
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+Expr MatchTensorIntrin(const TensorIntrin& intrin, const Expr& loop) {
+  CHECK(loop.As<ir::For>()) << "The root of the loop nest to match must be For node! Please check.";
+  LoopNest nest;
+  if (!ParseLoopNest(loop, &nest)) return Expr();
+  std::vector<Expr> args = MatchArgs(intrin, nest);
+  if (args.empty()) return Expr();
+
+  Expr call = lang::CallExtern(intrin.extern_func, args);
+  if (!nest.init_block.defined()) return Block::Make({call});
+  Expr init_nest = optim::IRCopy(nest.init_block);
+  for (int i = nest.init_depth - 1; i >= 0; --i) {
+    auto* for_node = nest.loops[i];
+    init_nest      = For::Make(for_node->loop_var,
+                          for_node->min,
+                          for_node->extent,
+                          for_node->for_type(),
+                          for_node->device_api,
+                          Block::Make({init_nest}),
+                          for_node->vectorize_info(),
+                          for_node->bind_info());
+  }
+  return Block::Make({init_nest, call});
+}
+
+}  // namespace ir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(tensor_intrins) {
+  using cinn::common::Float;
+  using cinn::common::Int;
+  using cinn::ir::TensorIntrinKind;
+
+  CINN_REGISTER_TENSOR_INTRIN(cpu_gemm_8x16_fp32)
+      .set_kind(TensorIntrinKind::kGemm)
+      .set_types(Float(32), Float(32))
+      .set_extents({8, 16, -1})
+      .set_extern_func("cinn_host_gemm_8x16_fp32");
+  CINN_REGISTER_TENSOR_INTRIN(cpu_dot_int8)
+      .set_kind(TensorIntrinKind::kDot)
+      .set_types(Int(8), Int(32))
+      .set_extents({-1})
+      .set_extern_func("cinn_host_dot_int8");
+  CINN_REGISTER_TENSOR_INTRIN(cpu_reduce_sum_fp32)
+      .set_kind(TensorIntrinKind::kReduceSum)
+      .set_types(Float(32), Float(32))
+      .set_extents({-1})
+      .set_extern_func("cinn_host_reduce_sum_fp32");
+
+  return true;
+}
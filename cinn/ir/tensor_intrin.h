@@ -0,0 +1,106 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "cinn/common/macros.h"
+#include "cinn/common/type.h"
+#include "cinn/ir/ir.h"
+#include "cinn/utils/registry.h"
+
+#define CINN_REGISTER_TENSOR_INTRIN(Name)                                                                \
+  static ::cinn::ir::TensorIntrin& CINN_STR_CONCAT(__make_##TensorIntrin##_##Name##__, __COUNTER__) = \
+      ::cinn::ir::TensorIntrinRegistry::Global()->Register(#Name)
+
+namespace cinn {
+namespace ir {
+
+//! The computations of the loop nests that could be replaced with a tensor intrinsic.
+enum class TensorIntrinKind {
+  //! C[m, n] += A[m, k] * B[k, n], over the loops m, n and k
+  kGemm,
+  //! c += a[k] * b[k], over the loop k
+  kDot,
+  //! c += a[k], over the loop k
+  kReduceSum,
+};
+
+/**
+ * The description of a microkernel a loop nest could be replaced with by the Tensorize schedule primitive: the
+ * computation of the loop nest, the types of the operands and the extents of the loops the microkernel is specialized
+ * to, and the extern function implementing it.
+ */
+struct TensorIntrin {
+  std::string name;
+  TensorIntrinKind kind;
+  //! The type of the operands read.
+  common::Type input_type;
+  //! The type of the accumulated output.
+  common::Type output_type;
+  //! The extents of the loops in the order of the description of the kind, -1 stands for any extent.
+  std::vector<int> extents;
+  //! The extern function called with the tensors and the offsets and strides of the tiles accessed.
+  std::string extern_func;
+
+  inline TensorIntrin& set_kind(TensorIntrinKind kind) {
+    this->kind = kind;
+    return *this;
+  }
+
+  inline TensorIntrin& set_types(const common::Type& input_type, const common::Type& output_type) {
+    this->input_type  = input_type;
+    this->output_type = output_type;
+    return *this;
+  }
+
+  inline TensorIntrin& set_extents(const std::vector<int>& extents) {
+    this->extents = extents;
+    return *this;
+  }
+
+  inline TensorIntrin& set_extern_func(const std::string& extern_func) {
+    this->extern_func = extern_func;
+    return *this;
+  }
+};
+
+//! A registry that stores the tensor intrinsics the loop nests could be tensorized with.
+class TensorIntrinRegistry : public ::cinn::Registry<TensorIntrin> {
+ public:
+  static TensorIntrinRegistry* Global() {
+    static TensorIntrinRegistry x;
+    return &x;
+  }
+
+  TensorIntrin& Register(const std::string& name) { return __REGISTER__(name); }
+
+ private:
+  TensorIntrinRegistry() = default;
+  CINN_DISALLOW_COPY_AND_ASSIGN(TensorIntrinRegistry);
+};
+
+/**
+ * \brief Match the loop nest rooted at a loop against the description of a tensor intrinsic.
+ * @param intrin The tensor intrinsic.
+ * @param loop The root loop of the nest, whose loops are perfectly nested around one block accumulating its output.
+ * The reduction init block of the output could be in the body of one of the loops.
+ * @return The statements computing the loop nest by the intrinsic, or an undefined Expr if the loop nest doesn't
+ * compute what the intrinsic does. The reduction init block is kept in the loops over the output ahead of the call.
+ */
+Expr MatchTensorIntrin(const TensorIntrin& intrin, const Expr& loop);
+
+}  // namespace ir
+}  // namespace cinn
@@ -14,6 +14,7 @@
 
 #include "cinn/optim/lower_intrin.h"
 
+#include <set>
 #include <string>
 
 #include "cinn/backends/llvm/llvm_intrin_rule.h"
@@ -25,6 +26,16 @@
 namespace cinn {
 namespace optim {
 
+bool IsHostInlineMath(const std::string &name, const Type &type) {
+  static const std::set<std::string> inline_math_calls = {"exp", "log", "tanh", "erf"};
+  return inline_math_calls.count(name) && type.ElementOf() == Float(32);
+}
+
+std::string HostInlineMathIntrinName(const std::string &name) {
+  CHECK(IsHostInlineMath(name, Float(32))) << "No inline polynomial of " << name;
+  return kHostInlineMathPrefix + name;
+}
+
 void LowerIntrin(Expr *e, Target target) {
   if (target.arch == Target::Arch::X86) {
     codegen::RegisterCpuIntrinRule();
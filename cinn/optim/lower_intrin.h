@@ -26,7 +26,20 @@ static const std::set<std::string> kIntrinsicCalls{
     {"exp",         "exp2",       "sqrt",        "log",         "log2",        "log10", "floor",
      "ceil",        "round",      "trunc",       "cos",         "cosh",        "tan",   "tanh",
      "sin",         "sinh",       "fabs",        "isnan",       "isfinite",    "isinf", "left_shift",
-     "right_shift", "bitwise_or", "bitwise_and", "bitwise_xor", "bitwise_not", "fma",   "rsqrt"}};
+     "right_shift", "bitwise_or", "bitwise_and", "bitwise_xor", "bitwise_not", "fma",   "rsqrt",
+     "erf"}};
+
+//! The prefix of the builtin intrinsics computing the math functions by the inline polynomials on the host.
+constexpr char kHostInlineMathPrefix[] = "cinn_math_";
+
+/**
+ * Whether the call `name` of `type` is computed by an inline polynomial on the host. LowerIntrin lowers such a call to
+ * the builtin intrinsic HostInlineMathIntrinName(name), and the backend chooses its precision when emitting the code.
+ */
+bool IsHostInlineMath(const std::string &name, const Type &type);
+
+//! The name of the builtin intrinsic computing the call `name` by an inline polynomial on the host.
+std::string HostInlineMathIntrinName(const std::string &name);
 
 /**
  * Map the Call nodes to llvm intrinsic.
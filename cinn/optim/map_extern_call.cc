@@ -16,6 +16,7 @@
 
 #include "cinn/cinn.h"
 #include "cinn/ir/ir_mutator.h"
+#include "cinn/optim/lower_intrin.h"
 #include "cinn/runtime/cpu/host_intrinsics.h"
 
 namespace cinn {
@@ -61,6 +62,8 @@ void MapExternCall(Expr *e, Target target) {
     }
 
     void DealWithCpuintrinsics(ir::Call *node, Expr *expr) {
+      // Left to LowerIntrin to compute by the inline polynomials.
+      if (IsHostInlineMath(node->name, node->type())) return;
       if (kExternFp32CallsCPU.count(node->name)) {
         CHECK_GE(node->read_args.size(), 1UL);
         CHECK_EQ(node->read_args.front().type(), Float(32));
@@ -31,6 +31,7 @@
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_replace.h"
 #include "cinn/optim/ir_simplify.h"
+#include "cinn/optim/lower_intrin.h"
 #include "cinn/optim/tensor_write_tell.h"
 #include "cinn/optim/unroll_loops.h"
 #include "cinn/utils/functional.h"
@@ -645,7 +646,9 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
   void Visit(const Call *op, Expr *expr) override {
     auto it = op->attrs.find("vectorizable");
     if (it != op->attrs.end()) {
-      vectorizable_ = absl::get<bool>(it->second);
+      // The math functions computed by the inline polynomials on the host vectorize, even the extern ones like erf.
+      vectorizable_ = absl::get<bool>(it->second) ||
+                      (target.arch == Target::Arch::X86 && IsHostInlineMath(op->name, op->type()));
     }
   }
 
@@ -680,74 +683,150 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
         }
       }
 
-      if (extent_min || extent_max || !vectorizable_) {
-        // not vectorize if has tail blocks, for llvm to optimize
+      // the tail of a loop split by poly has the extent min(lanes, rest) in its last iteration
+      int tail_lanes = 0;
+      if (extent_min && target != common::DefaultNVGPUTarget()) {
+        if (extent_min->a().As<IntImm>()) tail_lanes = extent_min->a().as_int32();
+        if (extent_min->b().As<IntImm>()) tail_lanes = extent_min->b().as_int32();
+      }
+      if ((extent_min && tail_lanes <= 1) || extent_max || !vectorizable_) {
+        // not vectorize if the tail could not be split off, for llvm to optimize
         node->reset_vectorize_info();
         var_intervals.erase(forloop->loop_var->name);
         return;
       }
 
-      const int factor  = forloop->vectorize_info().factor;
-      auto _new_forloop = SplitForLoop(node, factor);
-      if (!_new_forloop.defined()) {
-        IRMutator<>::Visit(&node->body, &node->body);
-        var_intervals.erase(forloop->loop_var->name);
-        return;
+      var_intervals.erase(loopvar_name);
+      if (extent_min) {
+        Expr rest = extent_min->a().As<IntImm>() ? extent_min->b() : extent_min->a();
+        VectorizeWithScalarTail(node, tail_lanes, rest, expr);
+      } else {
+        VectorizeForLoop(node, expr);
       }
+    } else {
+      IRMutator::Visit(forloop, expr);
+    }
+    var_intervals.erase(loopvar_name);
+  }
 
+  //! Vectorize the loop of extent min(lanes, rest) in a vector body of lanes if rest >= lanes, or in a scalar loop of
+  //! rest otherwise, which is only taken by the last iteration of the loop split by poly.
+  void VectorizeWithScalarTail(For *node, int lanes, Expr rest, Expr *expr) {
+    Var tail_var(common::UniqName(node->loop_var->name + "_tail"));
+    Expr tail_body = IRCopy(node->body);
+    optim::IrReplace(&tail_body, node->loop_var, Expr(tail_var));
+    Expr tail_loop = For::Make(tail_var, make_zero(), rest, ForType::Serial, node->device_api, tail_body);
+
+    Expr vector_loop = *expr;
+    node->extent     = make_const(lanes);
+    VectorizeForLoop(node, &vector_loop);
+    VLOG(2) << "Vectorize " << node->loop_var << " with a scalar tail of extent " << rest;
+    *expr = IfThenElse::Make(LE::Make(make_const(lanes), rest), vector_loop, tail_loop);
+  }
+
+  //! Vectorize the loop of a constant extent that is not a multiple of the factor by a vector body of the largest
+  //! multiple of the factor, followed by a vector epilogue of the remaining lanes, so no lane is out of the extent.
+  void VectorizeWithVectorTail(For *node, int extent, int factor, Expr *expr) {
+    int body_extent = extent / factor * factor;
+    int tail_lanes  = extent - body_extent;
+    Var tail_var(common::UniqName(node->loop_var->name + "_tail"));
+    Expr tail_body = IRCopy(node->body);
+    optim::IrReplace(&tail_body, node->loop_var, Expr(tail_var) + make_const(body_extent));
+    Expr tail_loop = For::Make(tail_var,
+                               make_zero(),
+                               make_const(tail_lanes),
+                               tail_lanes > 1 ? ForType::Vectorized : ForType::Serial,
+                               node->device_api,
+                               tail_body,
+                               VectorizeInfo(0, tail_lanes));
+    if (tail_lanes > 1) {
+      var_intervals.emplace(tail_var->name, common::CasInterval{0, tail_lanes - 1});
+      VectorizeForLoop(tail_loop.As<For>(), &tail_loop);
+      var_intervals.erase(tail_var->name);
+    }
+
+    Expr vector_loop = *expr;
+    node->extent     = make_const(body_extent);
+    VectorizeForLoop(node, &vector_loop);
+    VLOG(2) << "Vectorize " << node->loop_var << " with a vector tail of " << tail_lanes << " lanes";
+    *expr = Block::Make({vector_loop, tail_loop});
+  }
+
+  //! Vectorize the loop whose extent is a multiple of its factor, or of a constant extent.
+  void VectorizeForLoop(For *node, Expr *expr) {
+    int factor = node->vectorize_info().factor;
+    if (target != common::DefaultNVGPUTarget() && node->extent.As<IntImm>()) {
+      int extent = node->extent.as_int32();
+      if (extent % factor != 0 && extent > factor) {
+        VectorizeWithVectorTail(node, extent, factor, expr);
+        return;
+      }
+      // a loop shorter than the factor is a single vector of its extent
+      factor = std::min(factor, extent);
+    }
+    if (factor <= 1) {
       node->reset_vectorize_info();
+      return;
+    }
 
-      auto *new_forloop = _new_forloop.As<ir::For>();
+    auto _new_forloop = SplitForLoop(node, factor);
+    if (!_new_forloop.defined()) {
+      IRMutator<>::Visit(&node->body, &node->body);
+      return;
+    }
 
-      // The forloop generated from polyhedral analysis might have a complex condition that is not something like
-      // "i<20" or "i<=20", those cases is not possible to extract the extent.
-      auto *extent_int = new_forloop->extent.As<IntImm>();
+    node->reset_vectorize_info();
 
-      if (!extent_int) {
-        IRMutator<>::Visit(&node->body, &node->body);
-        var_intervals.erase(forloop->loop_var->name);
-        return;
-      }
+    auto *new_forloop = _new_forloop.As<ir::For>();
 
-      int extent = extent_int->value;
-      CHECK_GT(extent, 0) << "Loop over " << Expr(new_forloop->loop_var) << " has extent " << new_forloop->extent
-                          << ". Can only vectorize loops over a constant extent > 1";
+    // The forloop generated from polyhedral analysis might have a complex condition that is not something like
+    // "i<20" or "i<=20", those cases is not possible to extract the extent.
+    auto *extent_int = new_forloop->extent.As<IntImm>();
 
-      VLOG(2) << "Vectorizing " << new_forloop->loop_var << " extent " << extent;
-      VLOG(2) << "before vectorize body:\n" << node->body;
+    if (!extent_int) {
+      IRMutator<>::Visit(&node->body, &node->body);
+      var_intervals.erase(new_forloop->loop_var->name);
+      var_intervals.erase(node->loop_var->name);
+      return;
+    }
 
-      if (target == common::DefaultNVGPUTarget()) {
-        CudaVectorizer cuda_vectorizer(new_forloop->loop_var, factor, &var_intervals);
-        cuda_vectorizer.Visit(&new_forloop->body);
-        // unroll the new forloop to compute each element of the vector iteratively
-        auto copied_loop = optim::IRCopy(_new_forloop);
-        copied_loop.As<ir::For>()->set_unrolled();
-        optim::UnrollLoop(&copied_loop);
-        // add cast exprs of vector type in the front of vectorized forloop,
-        // and replace original compute statements with the correspond unrolled ones
-        auto unroll_body = copied_loop.As<ir::Block>()->stmts;
-        auto cast_exprs  = cuda_vectorizer.VectorizedTypeCastExprs();
-        auto store_exprs = cuda_vectorizer.VectorizedTypeStoreExprs();
-        auto &body_stmts = new_forloop->body.As<ir::Block>()->stmts;
-        body_stmts.assign(cast_exprs.begin(), cast_exprs.end());
-        body_stmts.insert(body_stmts.end(), unroll_body.begin(), unroll_body.end());
-        body_stmts.insert(body_stmts.end(), store_exprs.begin(), store_exprs.end());
-      } else {
-        Vectorizer(new_forloop->loop_var, extent, var_intervals).Visit(&new_forloop->body);
-      }
+    int extent = extent_int->value;
+    CHECK_GT(extent, 0) << "Loop over " << Expr(new_forloop->loop_var) << " has extent " << new_forloop->extent
+                        << ". Can only vectorize loops over a constant extent > 1";
+
+    VLOG(2) << "Vectorizing " << new_forloop->loop_var << " extent " << extent;
+    VLOG(2) << "before vectorize body:\n" << node->body;
+
+    if (target == common::DefaultNVGPUTarget()) {
+      CudaVectorizer cuda_vectorizer(new_forloop->loop_var, factor, &var_intervals);
+      cuda_vectorizer.Visit(&new_forloop->body);
+      // unroll the new forloop to compute each element of the vector iteratively
+      auto copied_loop = optim::IRCopy(_new_forloop);
+      copied_loop.As<ir::For>()->set_unrolled();
+      optim::UnrollLoop(&copied_loop);
+      // add cast exprs of vector type in the front of vectorized forloop,
+      // and replace original compute statements with the correspond unrolled ones
+      auto unroll_body = copied_loop.As<ir::Block>()->stmts;
+      auto cast_exprs  = cuda_vectorizer.VectorizedTypeCastExprs();
+      auto store_exprs = cuda_vectorizer.VectorizedTypeStoreExprs();
+      auto &body_stmts = new_forloop->body.As<ir::Block>()->stmts;
+      body_stmts.assign(cast_exprs.begin(), cast_exprs.end());
+      body_stmts.insert(body_stmts.end(), unroll_body.begin(), unroll_body.end());
+      body_stmts.insert(body_stmts.end(), store_exprs.begin(), store_exprs.end());
+    } else {
+      Vectorizer(new_forloop->loop_var, extent, var_intervals).Visit(&new_forloop->body);
+    }
 
-      VLOG(2) << "after vectorize body:\n" << node->body;
+    VLOG(2) << "after vectorize body:\n" << node->body;
 
-      // Remove the forloop, the new_forloop's body is vectorized to Ramp, so no forloop is needed.
-      if (is_zero(forloop->extent - 1)) {
-        *expr = new_forloop->body;
-      } else {
-        node->body = new_forloop->body;
-      }
+    // Remove the forloop, the new_forloop's body is vectorized to Ramp, so no forloop is needed.
+    if (is_zero(node->extent - 1)) {
+      *expr = new_forloop->body;
     } else {
-      IRMutator::Visit(forloop, expr);
+      node->body = new_forloop->body;
     }
-    var_intervals.erase(loopvar_name);
+    var_intervals.erase(new_forloop->loop_var->name);
+    var_intervals.erase(node->loop_var->name);
   }
 
   //! unroll the forloop if its' extent is min type by solving the condition extent
@@ -21,6 +21,7 @@
 #include "cinn/cinn.h"
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/optimize.h"
@@ -232,6 +233,70 @@ TEST(Vectorize, single_for) {
   LOG(INFO) << "Forloop\n" << forloop;
 }
 
+// The lanes of the ramps storing into a tensor.
+std::vector<int> CollectStoreLanes(Expr expr) {
+  std::vector<int> lanes;
+  ir::CollectIRNodes(expr, [&](const Expr *x) {
+    if (auto *store = x->As<ir::Store>()) lanes.push_back(store->indices.front().type().lanes());
+    return false;
+  });
+  return lanes;
+}
+
+TEST(Vectorize, constant_extent_with_tail) {
+  Placeholder<float> A("A", std::vector<int>{{771}});
+  Placeholder<float> C("C", std::vector<int>{{771}});
+
+  Var loop_var("k0");
+  Expr body = Store::Make(ir::Tensor(C), ir::Load::Make(ir::Tensor(A), {Expr(loop_var)}), {Expr(loop_var)});
+  body      = ir::Block::Make({body});
+
+  // 771 = 48 * 16 + 3
+  auto forloop = ir::For::Make(loop_var,
+                               common::make_const(0),
+                               common::make_const(771),
+                               ir::ForType::Vectorized,
+                               ir::DeviceAPI::UNK,
+                               body,
+                               VectorizeInfo(0, 16));
+  optim::VectorizeLoops(&forloop, common::DefaultHostTarget());
+  LOG(INFO) << "Forloop\n" << forloop;
+
+  // a vector body of 16 lanes and a vector tail of 3 lanes
+  EXPECT_EQ(CollectStoreLanes(forloop), std::vector<int>({16, 3}));
+}
+
+TEST(Vectorize, min_extent_with_tail) {
+  Placeholder<float> A("A", std::vector<int>{{50}});
+  Placeholder<float> C("C", std::vector<int>{{50}});
+
+  Var outer("i");
+  Var inner("j");
+  Expr index = Expr(outer) * 16 + Expr(inner);
+  Expr body  = ir::Block::Make({Store::Make(ir::Tensor(C), ir::Load::Make(ir::Tensor(A), {index}), {index})});
+
+  // the inner loop split by poly covers min(16, 50 - 16 * i) elements
+  auto inner_loop = ir::For::Make(inner,
+                                  common::make_const(0),
+                                  ir::Min::Make(common::make_const(16), Expr(50) - Expr(outer) * 16),
+                                  ir::ForType::Vectorized,
+                                  ir::DeviceAPI::UNK,
+                                  body,
+                                  VectorizeInfo(1, 16));
+  auto forloop    = ir::For::Make(outer,
+                                  common::make_const(0),
+                                  common::make_const(4),
+                                  ir::ForType::Serial,
+                                  ir::DeviceAPI::UNK,
+                                  ir::Block::Make({inner_loop}));
+  optim::VectorizeLoops(&forloop, common::DefaultHostTarget());
+  LOG(INFO) << "Forloop\n" << forloop;
+
+  // the full iterations store a vector, and the last one runs the scalar tail
+  EXPECT_EQ(ir::CollectIRNodes(forloop, [](const Expr *x) { return x->As<ir::IfThenElse>() != nullptr; }).size(), 1UL);
+  EXPECT_EQ(CollectStoreLanes(forloop), std::vector<int>({16, 1}));
+}
+
 TEST(Vectorize, cuda_vectorize) {
   Expr M(100);
   Expr N(500);
@@ -38,7 +38,9 @@ void BindExecutionEngine(py::module *m) {
   py::class_<ExecutionOptions> options(*m, "ExecutionOptions");
   options.def(py::init<>())
       .def_readwrite("opt_level", &ExecutionOptions::opt_level)
-      .def_readwrite("enable_debug_info", &ExecutionOptions::enable_debug_info);
+      .def_readwrite("enable_debug_info", &ExecutionOptions::enable_debug_info)
+      .def_readwrite("lazy_compile", &ExecutionOptions::lazy_compile)
+      .def_readwrite("num_compile_ahead_threads", &ExecutionOptions::num_compile_ahead_threads);
 
   auto lookup = [](ExecutionEngine &self, absl::string_view name) {
     auto *function_ptr    = reinterpret_cast<void (*)(void **, int32_t)>(self.Lookup(name));
@@ -56,7 +58,7 @@ void BindExecutionEngine(py::module *m) {
       .def(py::init(py::overload_cast<const ExecutionOptions &>(&ExecutionEngine::Create)),
            py::arg("options") = ExecutionOptions())
       .def("lookup", lookup)
-      .def("link", &ExecutionEngine::Link);
+      .def("link", [](ExecutionEngine &self, const ir::Module &module) { self.Link(module); });
 
   {
     auto lookup = [](Compiler &self, absl::string_view name) {
@@ -69,8 +71,8 @@ void BindExecutionEngine(py::module *m) {
 
     py::class_<Compiler> compiler(*m, "Compiler");
     compiler
-        .def_static("create", &Compiler::Create)  //
-        .def("build", &Compiler::BuildDefault)    //
+        .def_static("create", &Compiler::Create, py::arg("target"), py::arg("options") = ExecutionOptions())  //
+        .def("build", &Compiler::BuildDefault)                                                             //
         .def("lookup", lookup);
   }
 }
@@ -26,6 +26,7 @@
 #include "cinn/hlir/framework/scope.h"
 #include "cinn/hlir/op/use_ops.h"
 #include "cinn/pybind/bind.h"
+#include "cinn/pybind/tensor_interop.h"
 #include "cinn/runtime/flags.h"
 
 DECLARE_bool(cinn_ir_schedule);
@@ -139,8 +140,17 @@ void BindFramework(pybind11::module *m) {
       .def("var_names", &Scope::var_names);
 
   py::class_<common::Shared<hlir::framework::_Tensor_>>(*m, "SharedTensor");
-  py::class_<Tensor, common::Shared<hlir::framework::_Tensor_>>(*m, "Tensor")
+  py::class_<Tensor, common::Shared<hlir::framework::_Tensor_>>(*m, "Tensor", py::buffer_protocol())
       .def(py::init<>())
+      // numpy.asarray(tensor) views the memory of a host tensor without copying.
+      .def_buffer([](hlir::framework::Tensor &self) { return TensorBufferInfo(self); })
+      .def("__dlpack__",
+           [](hlir::framework::Tensor &self, py::object stream) { return TensorToDLPack(self, stream); },
+           py::arg("stream") = py::none())
+      .def("__dlpack_device__", [](hlir::framework::Tensor &self) { return TensorDLPackDevice(self); })
+      .def("share_data",
+           [](hlir::framework::Tensor &self, py::object obj) { return ShareTensorData(self, obj); },
+           "Alias the memory of a NumPy array or a DLPack tensor, and return whether the memory is aliased or copied.")
       .def("shape", [](hlir::framework::Tensor &self) { return self->shape().data(); })
       .def("set_type", [](hlir::framework::Tensor &self, Type type) { self->set_type(type); })
       .def("numpy",
@@ -188,5 +198,12 @@ void BindFramework(pybind11::module *m) {
           CINN_NOT_IMPLEMENTED
         }
       });
+
+  m->def("from_dlpack", &TensorFromDLPack, "Create a tensor aliasing the memory of a NumPy array or a DLPack tensor.");
+  m->def("to_dlpack",
+         &TensorToDLPack,
+         py::arg("tensor"),
+         py::arg("stream") = py::none(),
+         "Export a tensor as a DLPack capsule aliasing its memory.");
 }
 }  // namespace cinn::pybind
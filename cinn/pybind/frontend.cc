@@ -35,6 +35,7 @@
 #include "cinn/hlir/framework/visualize_helper.h"
 #include "cinn/hlir/op/use_ops.h"
 #include "cinn/pybind/bind.h"
+#include "cinn/pybind/tensor_interop.h"
 #include "cinn/utils/string.h"
 #include "cinn/utils/timer.h"
 
@@ -550,6 +551,37 @@ void BindFrontend(pybind11::module *m) {
       .def("reshape", &NetBuilder::Reshape, py::arg("x"), py::arg("shape"))
       .def("transpose", &NetBuilder::Transpose, py::arg("x"), py::arg("axis"))
       .def("top_k", &NetBuilder::TopK, py::arg("x"), py::arg("k"), py::arg("axis"), py::arg("largest"))
+      .def("layer_norm",
+           &NetBuilder::LayerNorm,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("bias"),
+           py::arg("epsilon")         = 1e-5f,
+           py::arg("begin_norm_axis") = 1)
+      .def("attention",
+           static_cast<Variable (NetBuilder::*)(const Variable &, const Variable &, const Variable &, float, bool)>(
+               &NetBuilder::Attention),
+           py::arg("q"),
+           py::arg("k"),
+           py::arg("v"),
+           py::arg("scale")  = 0.0f,
+           py::arg("causal") = false)
+      .def("attention",
+           static_cast<Variable (NetBuilder::*)(
+               const Variable &, const Variable &, const Variable &, const Variable &, float, bool)>(
+               &NetBuilder::Attention),
+           py::arg("q"),
+           py::arg("k"),
+           py::arg("v"),
+           py::arg("mask"),
+           py::arg("scale")  = 0.0f,
+           py::arg("causal") = false)
+      .def("rms_norm",
+           &NetBuilder::RMSNorm,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("epsilon")         = 1e-6f,
+           py::arg("begin_norm_axis") = -1)
       .def("sort", &NetBuilder::Sort, py::arg("operand"), py::arg("axis"), py::arg("is_ascend"))
       .def("argsort", &NetBuilder::ArgSort, py::arg("operand"), py::arg("axis"), py::arg("is_ascend"))
       .def("slice",
@@ -613,6 +645,38 @@ void BindFrontend(pybind11::module *m) {
       .def("argmax", &NetBuilder::Argmax, py::arg("x"), py::arg("axis"), py::arg("keep_dim") = false)
       .def("argmin", &NetBuilder::Argmin, py::arg("x"), py::arg("axis"), py::arg("keep_dim") = false)
       .def("lookup_table", &NetBuilder::LookupTable, py::arg("table"), py::arg("ids"), py::arg("padding_idx"))
+      .def("embedding_bag",
+           static_cast<Variable (NetBuilder::*)(const Variable &, const Variable &, const std::string &, int64_t)>(
+               &NetBuilder::EmbeddingBag),
+           py::arg("table"),
+           py::arg("ids"),
+           py::arg("mode")        = "sum",
+           py::arg("padding_idx") = -1)
+      .def("embedding_bag",
+           static_cast<Variable (NetBuilder::*)(
+               const Variable &, const Variable &, const Variable &, const std::string &, int64_t)>(
+               &NetBuilder::EmbeddingBag),
+           py::arg("table"),
+           py::arg("ids"),
+           py::arg("offsets"),
+           py::arg("mode")        = "sum",
+           py::arg("padding_idx") = -1)
+      .def("weighted_embedding_bag",
+           static_cast<Variable (NetBuilder::*)(const Variable &, const Variable &, const Variable &, int64_t)>(
+               &NetBuilder::WeightedEmbeddingBag),
+           py::arg("table"),
+           py::arg("ids"),
+           py::arg("per_sample_weights"),
+           py::arg("padding_idx") = -1)
+      .def("weighted_embedding_bag",
+           static_cast<Variable (NetBuilder::*)(
+               const Variable &, const Variable &, const Variable &, const Variable &, int64_t)>(
+               &NetBuilder::WeightedEmbeddingBag),
+           py::arg("table"),
+           py::arg("ids"),
+           py::arg("offsets"),
+           py::arg("per_sample_weights"),
+           py::arg("padding_idx") = -1)
       .def("one_hot",
            &NetBuilder::OneHot,
            py::arg("indices"),
@@ -814,6 +878,22 @@ void BindFrontend(pybind11::module *m) {
           py::arg("options") = CinnComputation::DefaultCompileOptions())
       .def("get_all_tensor_names", &CinnComputation::GetAllTensorNames)
       .def("get_tensor", &CinnComputation::GetTensor)
+      .def("bind_tensor",
+           [](CinnComputation &self, const std::string &name, py::object obj) {
+             hlir::framework::Tensor tensor = self.GetTensor(name);
+             ExternalData ext               = GetExternalData(obj);
+             CheckTensorData(ext, tensor);
+             size_t size = ext.numel() * ext.type.bytes();
+             if (ext.CanAlias(tensor->get_buffer()->target())) {
+               self.BindTensorData(tensor, ext.data, size, ext.holder);
+               return true;
+             }
+             CHECK(ext.target.arch == common::Target::Arch::X86) << "Can not copy the device memory of other targets";
+             self.SetTensorData(tensor, ext.data, size);
+             return false;
+           },
+           "Bind a tensor to the memory of a NumPy array or a DLPack tensor without copying, and return whether the "
+           "memory is bound, or the data is copied in like the host memory not aligned to 32 bytes.")
       .def("execute", [](CinnComputation &self) { self.Execute(); });
 
   py::class_<PaddleModelConvertor>(*m, "PaddleModelConvertor")
@@ -0,0 +1,315 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/pybind/tensor_interop.h"
+
+#include <dlpack/dlpack.h>
+#include <glog/logging.h>
+#include <pybind11/numpy.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#ifdef CINN_WITH_CUDA
+#include "cinn/backends/cuda_util.h"
+#endif
+
+namespace cinn::pybind {
+
+using hlir::framework::Buffer;
+using hlir::framework::Shape;
+using hlir::framework::Tensor;
+
+namespace {
+
+common::Type FromDLDataType(const DLDataType &dtype) {
+  CHECK_EQ(dtype.lanes, 1) << "The vector types of DLPack are not supported";
+  switch (dtype.code) {
+    case kDLFloat:
+      if (dtype.bits == 16) return common::F16();
+      return common::Float(dtype.bits);
+    case kDLBfloat:
+      CHECK_EQ(dtype.bits, 16);
+      return common::BF16();
+    case kDLInt:
+      return common::Int(dtype.bits);
+    case kDLUInt:
+      return common::UInt(dtype.bits);
+    case kDLBool:
+      return common::Bool();
+    default:
+      LOG(FATAL) << "Not supported DLPack type code " << static_cast<int>(dtype.code);
+  }
+  return common::Type();
+}
+
+DLDataType ToDLDataType(const common::Type &type) {
+  DLDataType dtype;
+  dtype.lanes = 1;
+  dtype.bits  = type.bits();
+  if (type.is_bool()) {
+    dtype.code = kDLBool;
+    dtype.bits = 8;
+  } else if (type.is_float(16) && type.is_float(16, common::Type::specific_type_t::BF16)) {
+    dtype.code = kDLBfloat;
+  } else if (type.is_float()) {
+    dtype.code = kDLFloat;
+  } else if (type.is_int()) {
+    dtype.code = kDLInt;
+  } else if (type.is_uint()) {
+    dtype.code = kDLUInt;
+  } else {
+    LOG(FATAL) << "Can not export the tensor of " << type << " by DLPack";
+  }
+  return dtype;
+}
+
+DLDevice ToDLDevice(const common::Target &target) {
+  DLDevice device;
+  device.device_id = 0;
+  if (target.arch == common::Target::Arch::NVGPU) {
+    device.device_type = kDLCUDA;
+#ifdef CINN_WITH_CUDA
+    CUDA_CALL(cudaGetDevice(&device.device_id));
+#endif
+  } else {
+    device.device_type = kDLCPU;
+  }
+  return device;
+}
+
+//! The memory of a NumPy array, which is kept alive by a reference to the array.
+ExternalData GetNumpyData(py::array array) {
+  ExternalData ext;
+  ext.data     = const_cast<void *>(array.data());
+  ext.type     = common::Str2Type(py::str(array.dtype()));
+  ext.target   = common::DefaultHostTarget();
+  ext.compact  = array.flags() & py::array::c_style;
+  ext.writable = array.writeable();
+  for (int i = 0; i < array.ndim(); i++) {
+    ext.shape.push_back(static_cast<int>(array.shape(i)));
+  }
+  ext.holder = std::shared_ptr<void>(new py::object(array), [](void *obj) {
+    py::gil_scoped_acquire gil;
+    delete static_cast<py::object *>(obj);
+  });
+  return ext;
+}
+
+//! The memory of a DLPack tensor, whose deleter is called when the memory is no longer used.
+ExternalData GetDLPackData(py::object obj) {
+  py::object capsule = py::hasattr(obj, "__dlpack__") ? obj.attr("__dlpack__")() : obj;
+  CHECK(PyCapsule_IsValid(capsule.ptr(), "dltensor"))
+      << "Expect a NumPy array, a DLPack capsule not consumed yet, or an object with __dlpack__";
+  auto *managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule.ptr(), "dltensor"));
+  // Take the ownership of the tensor as the DLPack protocol requires, so that the capsule no longer deletes it.
+  PyCapsule_SetName(capsule.ptr(), "used_dltensor");
+
+  ExternalData ext;
+  ext.holder = std::shared_ptr<void>(managed, [](void *ptr) {
+    auto *managed = static_cast<DLManagedTensor *>(ptr);
+    if (!managed->deleter) return;
+    // The deleters of the producers in Python, like NumPy, release the Python objects.
+    py::gil_scoped_acquire gil;
+    managed->deleter(managed);
+  });
+
+  const DLTensor &dl = managed->dl_tensor;
+  ext.data           = static_cast<char *>(dl.data) + dl.byte_offset;
+  ext.type           = FromDLDataType(dl.dtype);
+  int64_t stride     = 1;
+  for (int i = dl.ndim - 1; i >= 0; i--) {
+    if (dl.strides && dl.shape[i] != 1 && dl.strides[i] != stride) ext.compact = false;
+    stride *= dl.shape[i];
+  }
+  for (int i = 0; i < dl.ndim; i++) {
+    ext.shape.push_back(static_cast<int>(dl.shape[i]));
+  }
+
+  switch (dl.device.device_type) {
+    case kDLCPU:
+    case kDLCUDAHost:
+      ext.target = common::DefaultHostTarget();
+      break;
+    case kDLCUDA:
+#ifndef CINN_WITH_CUDA
+      LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+      ext.target = common::DefaultNVGPUTarget();
+      break;
+    default:
+      LOG(FATAL) << "Not supported DLPack device type " << static_cast<int>(dl.device.device_type);
+  }
+  return ext;
+}
+
+//! The target of the memory of the tensor, or the target of `ext` if the tensor has no memory yet.
+common::Target TensorTarget(Tensor tensor, const ExternalData &ext) {
+  const common::Target &target = tensor->get_buffer()->target();
+  return target.arch == common::Target::Arch::Unk ? ext.target : target;
+}
+
+void CopyTensorData(const ExternalData &ext, Tensor tensor, const common::Target &target) {
+  size_t size = ext.numel() * ext.type.bytes();
+  void *data  = tensor->mutable_data(target, ext.type);
+  if (target.arch == common::Target::Arch::X86) {
+    CHECK(ext.target.arch == common::Target::Arch::X86) << "Can not copy the device memory to the host tensor";
+    std::memcpy(data, ext.data, size);
+  } else if (target.arch == common::Target::Arch::NVGPU) {
+#ifdef CINN_WITH_CUDA
+    auto kind = ext.target.arch == common::Target::Arch::NVGPU ? cudaMemcpyDeviceToDevice : cudaMemcpyHostToDevice;
+    CUDA_CALL(cudaMemcpy(data, ext.data, size, kind));
+#else
+    LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+  } else {
+    CINN_NOT_IMPLEMENTED
+  }
+}
+
+}  // namespace
+
+size_t ExternalData::numel() const {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+bool ExternalData::CanAlias(const common::Target &tensor_target) const {
+  if (!compact || tensor_target.arch != target.arch) return false;
+  if (target.arch == common::Target::Arch::X86) {
+    return reinterpret_cast<uintptr_t>(data) % Buffer::kHostDataAlignment == 0;
+  }
+  return true;
+}
+
+ExternalData GetExternalData(py::object obj) {
+  // The NumPy arrays of the versions before 1.22 do not export DLPack.
+  if (py::isinstance<py::array>(obj)) return GetNumpyData(py::reinterpret_borrow<py::array>(obj));
+  return GetDLPackData(obj);
+}
+
+void CheckTensorData(const ExternalData &ext, Tensor tensor) {
+  CHECK(ext.compact) << "Only the arrays stored in the row major order without gaps are supported, call "
+                        "numpy.ascontiguousarray or contiguous() first";
+  CHECK(tensor->type() == ext.type) << "The data type " << ext.type << " mismatches the tensor's " << tensor->type();
+  CHECK_EQ(ext.numel(), tensor->shape().numel()) << "The number of the elements mismatches the tensor's";
+  CHECK(ext.writable) << "The array is read-only, but the kernels may write the tensor bound to it, pass a writable "
+                        "copy like numpy.array(x) instead";
+}
+
+bool ShareTensorData(Tensor tensor, py::object obj) {
+  ExternalData ext = GetExternalData(obj);
+  if (tensor->shape().data().empty()) tensor->Resize(Shape(ext.shape));
+  if (tensor->type().is_unk()) tensor->set_type(ext.type);
+  CheckTensorData(ext, tensor);
+
+  common::Target target = TensorTarget(tensor, ext);
+  if (ext.CanAlias(target)) {
+    tensor->ShareExternalData(ext.data, ext.type, target, ext.holder);
+    return true;
+  }
+  VLOG(3) << "Copy the data which could not be aliased by the tensor";
+  CopyTensorData(ext, tensor, target);
+  return false;
+}
+
+Tensor TensorFromDLPack(py::object obj) {
+  Tensor tensor;
+  ShareTensorData(tensor, obj);
+  return tensor;
+}
+
+py::capsule TensorToDLPack(Tensor tensor, py::object stream) {
+  struct Context {
+    Tensor tensor;
+    std::vector<int64_t> shape;
+    DLManagedTensor managed;
+  };
+  CHECK(tensor->buffer()->memory) << "The tensor has no memory to export";
+  if (tensor->get_buffer()->target().arch == common::Target::Arch::NVGPU) {
+    // None and 1 are the legacy default stream the kernels run on, and -1 asks for no synchronization.
+    int64_t consumer_stream = stream.is_none() ? 1 : stream.cast<int64_t>();
+    if (consumer_stream != 1 && consumer_stream != -1) {
+#ifdef CINN_WITH_CUDA
+      CUDA_CALL(cudaDeviceSynchronize());
+#endif
+    }
+  } else {
+    CHECK(stream.is_none()) << "The stream of DLPack should be None for the host tensors";
+  }
+
+  auto *ctx   = new Context;
+  ctx->tensor = tensor;
+  ctx->shape.assign(tensor->shape().data().begin(), tensor->shape().data().end());
+
+  DLTensor &dl   = ctx->managed.dl_tensor;
+  dl.data        = tensor->buffer()->memory;
+  dl.device      = ToDLDevice(tensor->get_buffer()->target());
+  dl.ndim        = static_cast<int>(ctx->shape.size());
+  dl.dtype       = ToDLDataType(tensor->type());
+  dl.shape       = ctx->shape.data();
+  dl.strides     = nullptr;
+  dl.byte_offset = 0;
+
+  ctx->managed.manager_ctx = ctx;
+  ctx->managed.deleter     = [](DLManagedTensor *self) { delete static_cast<Context *>(self->manager_ctx); };
+
+  return py::capsule(&ctx->managed, "dltensor", [](PyObject *capsule) {
+    // The consumers rename the capsule after taking the tensor, so the capsule deletes it only if not consumed.
+    if (!PyCapsule_IsValid(capsule, "dltensor")) return;
+    auto *managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule, "dltensor"));
+    managed->deleter(managed);
+  });
+}
+
+py::tuple TensorDLPackDevice(Tensor tensor) {
+  DLDevice device = ToDLDevice(tensor->get_buffer()->target());
+  return py::make_tuple(static_cast<int>(device.device_type), device.device_id);
+}
+
+py::buffer_info TensorBufferInfo(Tensor tensor) {
+  static const std::unordered_map<std::string, std::string> formats = {{"bool", "?"},
+                                                                        {"int8", "b"},
+                                                                        {"uint8", "B"},
+                                                                        {"int16", "h"},
+                                                                        {"uint16", "H"},
+                                                                        {"int32", "i"},
+                                                                        {"uint32", "I"},
+                                                                        {"int64", "q"},
+                                                                        {"uint64", "Q"},
+                                                                        {"float16", "e"},
+                                                                        {"float32", "f"},
+                                                                        {"float64", "d"}};
+  CHECK(tensor->get_buffer()->target().arch == common::Target::Arch::X86)
+      << "Only the host tensors could be viewed by the buffer protocol";
+  CHECK(tensor->buffer()->memory) << "The tensor has no memory to view";
+  auto it = formats.find(common::Type2Str(tensor->type()));
+  CHECK(it != formats.end()) << "Can not view the tensor of " << tensor->type() << " by the buffer protocol";
+
+  ssize_t itemsize = tensor->type().bytes();
+  std::vector<ssize_t> shape(tensor->shape().data().begin(), tensor->shape().data().end());
+  std::vector<ssize_t> strides(shape.size());
+  ssize_t stride = itemsize;
+  for (int i = static_cast<int>(shape.size()) - 1; i >= 0; i--) {
+    strides[i] = stride;
+    stride *= shape[i];
+  }
+  return py::buffer_info(tensor->buffer()->memory, itemsize, it->second, shape.size(), shape, strides);
+}
+
+}  // namespace cinn::pybind
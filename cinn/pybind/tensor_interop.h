@@ -0,0 +1,80 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <memory>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/tensor.h"
+
+namespace cinn::pybind {
+
+namespace py = pybind11;
+
+/**
+ * The memory of an array owned by others, which is a NumPy array, a DLPack capsule, or an object exporting DLPack by
+ * `__dlpack__` like the tensors of PyTorch and Paddle.
+ */
+struct ExternalData {
+  void *data{};
+  common::Type type;
+  std::vector<int> shape;
+  common::Target target;
+  //! Whether the elements are stored in the row major order without gaps.
+  bool compact{true};
+  //! Whether the memory could be written, the kernels may write any tensor aliasing it.
+  bool writable{true};
+  //! Keeps the memory alive, and returns it to the owner on the destruction.
+  std::shared_ptr<void> holder;
+
+  size_t numel() const;
+  //! Whether a tensor on `tensor_target` could alias the memory, or else the data should be copied.
+  bool CanAlias(const common::Target &tensor_target) const;
+};
+
+//! Get the memory of a NumPy array or a DLPack tensor, the DLPack capsule is consumed.
+ExternalData GetExternalData(py::object obj);
+
+//! Check that `ext` holds the elements of `tensor`, with the same type and number, in a writable memory.
+void CheckTensorData(const ExternalData &ext, hlir::framework::Tensor tensor);
+
+/**
+ * Make `tensor` alias the memory of `obj` without copying, the tensors sharing its buffer see the memory too. The data
+ * is copied if the memory could not be aliased, like the host memory not aligned for the kernels.
+ * @return whether the memory is aliased.
+ */
+bool ShareTensorData(hlir::framework::Tensor tensor, py::object obj);
+
+//! Create a tensor from a NumPy array or a DLPack tensor, which aliases the memory if possible.
+hlir::framework::Tensor TensorFromDLPack(py::object obj);
+
+/**
+ * Export the tensor as a DLPack capsule aliasing its memory, which keeps the tensor alive until the consumer is done.
+ * @param stream The stream of the consumer as the DLPack protocol defines. The kernels run on the default stream, so
+ * the device is synchronized for any other CUDA stream before exporting, and only None is accepted for host tensors.
+ */
+py::capsule TensorToDLPack(hlir::framework::Tensor tensor, py::object stream = py::none());
+
+//! The DLPack device of the tensor, as the pair of the device type and the device id.
+py::tuple TensorDLPackDevice(hlir::framework::Tensor tensor);
+
+//! The buffer protocol view of a host tensor.
+py::buffer_info TensorBufferInfo(hlir::framework::Tensor tensor);
+
+}  // namespace cinn::pybind
@@ -0,0 +1,318 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_attention.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+// A task computes a block of query rows, and the keys and values are visited in tiles, so that
+// the scores of a tile stay in the L1 cache and the values of a tile are reused by all the rows.
+constexpr int kAttentionBlockQ  = 32;
+constexpr int kAttentionBlockKV = 64;
+
+template <typename T>
+struct AttentionClosure {
+  const T* q;
+  const T* k;
+  const T* v;
+  const T* mask;
+  T* out;
+  int batch;
+  int heads;
+  int seq_q;
+  int seq_kv;
+  int head_dim;
+  int mask_batch;
+  int mask_heads;
+  int mask_rows;
+  T scale;
+  bool causal;
+  int q_blocks;
+};
+
+template <typename T>
+int AttentionBlocks(int task_id, int num_task, void* datas) {
+  auto* c          = static_cast<AttentionClosure<T>*>(datas);
+  const int dim    = c->head_dim;
+  int64_t total    = static_cast<int64_t>(c->batch) * c->heads * c->q_blocks;
+  int64_t begin    = total * task_id / num_task;
+  int64_t end      = total * (task_id + 1) / num_task;
+  const T kNegInf  = -std::numeric_limits<T>::infinity();
+  const int offset = c->seq_kv - c->seq_q;
+
+  std::vector<T> scores(kAttentionBlockQ * kAttentionBlockKV);
+  std::vector<T> k_tile(dim * kAttentionBlockKV);
+  std::vector<T> acc(kAttentionBlockQ * dim);
+  std::vector<T> row_max(kAttentionBlockQ);
+  std::vector<T> row_sum(kAttentionBlockQ);
+  for (int64_t t = begin; t < end; ++t) {
+    int64_t bh = t / c->q_blocks;
+    int b      = bh / c->heads;
+    int h      = bh % c->heads;
+    int q0     = (t % c->q_blocks) * kAttentionBlockQ;
+    int rows   = std::min(kAttentionBlockQ, c->seq_q - q0);
+    const T* q = c->q + (bh * c->seq_q + q0) * dim;
+    const T* k = c->k + bh * c->seq_kv * dim;
+    const T* v = c->v + bh * c->seq_kv * dim;
+    const T* mask =
+        c->mask ? c->mask + ((c->mask_batch == 1 ? 0 : b) * c->mask_heads + (c->mask_heads == 1 ? 0 : h)) *
+                                static_cast<int64_t>(c->mask_rows) * c->seq_kv
+                : nullptr;
+
+    std::fill(row_max.begin(), row_max.end(), kNegInf);
+    std::fill(row_sum.begin(), row_sum.end(), T(0));
+    std::fill(acc.begin(), acc.end(), T(0));
+    // the keys after the last visible one of the block are skipped as a whole
+    int kv_end = c->causal ? std::max(0, std::min(c->seq_kv, q0 + rows + offset)) : c->seq_kv;
+    for (int kv0 = 0; kv0 < kv_end; kv0 += kAttentionBlockKV) {
+      int cols = std::min(kAttentionBlockKV, kv_end - kv0);
+      // transpose the keys of the tile to [dim, cols], so the scores of a row are accumulated along the keys,
+      // which vectorizes without reordering a reduction
+      for (int j = 0; j < cols; ++j) {
+        for (int d = 0; d < dim; ++d) {
+          k_tile[d * kAttentionBlockKV + j] = k[(kv0 + j) * dim + d];
+        }
+      }
+      for (int i = 0; i < rows; ++i) {
+        const T* qi  = q + i * dim;
+        T* s         = scores.data() + i * kAttentionBlockKV;
+        int visible  = c->causal ? std::max(0, std::min(cols, q0 + i + offset + 1 - kv0)) : cols;
+        T tile_max   = kNegInf;
+        const T* row = mask ? mask + (c->mask_rows == 1 ? 0 : q0 + i) * static_cast<int64_t>(c->seq_kv) + kv0 : nullptr;
+        std::fill(s, s + visible, T(0));
+        for (int d = 0; d < dim; ++d) {
+          const T* kd = k_tile.data() + d * kAttentionBlockKV;
+          T qd        = qi[d];
+          for (int j = 0; j < visible; ++j) {
+            s[j] += qd * kd[j];
+          }
+        }
+        for (int j = 0; j < visible; ++j) {
+          s[j]     = s[j] * c->scale + (row ? row[j] : T(0));
+          tile_max = std::max(tile_max, s[j]);
+        }
+        if (tile_max == kNegInf) continue;
+
+        // online softmax: rescale what is accumulated by the previous tiles to the new maximum
+        T new_max    = std::max(row_max[i], tile_max);
+        T correction = std::exp(row_max[i] - new_max);
+        T* acc_i     = acc.data() + i * dim;
+        if (correction != T(1)) {
+          row_sum[i] *= correction;
+          for (int d = 0; d < dim; ++d) {
+            acc_i[d] *= correction;
+          }
+        }
+        for (int j = 0; j < visible; ++j) {
+          s[j] = std::exp(s[j] - new_max);
+          row_sum[i] += s[j];
+        }
+        for (int j = 0; j < visible; ++j) {
+          const T* vj = v + (kv0 + j) * dim;
+          T p         = s[j];
+          for (int d = 0; d < dim; ++d) {
+            acc_i[d] += p * vj[d];
+          }
+        }
+        row_max[i] = new_max;
+      }
+    }
+
+    T* out = c->out + (bh * c->seq_q + q0) * dim;
+    for (int i = 0; i < rows; ++i) {
+      // the rows masked entirely produce zeros rather than NaN
+      T inv = row_sum[i] > T(0) ? T(1) / row_sum[i] : T(0);
+      for (int d = 0; d < dim; ++d) {
+        out[i * dim + d] = acc[i * dim + d] * inv;
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+void Attention(const cinn_buffer_t* q,
+               const cinn_buffer_t* k,
+               const cinn_buffer_t* v,
+               const cinn_buffer_t* mask,
+               int batch,
+               int heads,
+               int seq_q,
+               int seq_kv,
+               int head_dim,
+               int mask_batch,
+               int mask_heads,
+               int mask_rows,
+               float scale,
+               bool causal,
+               cinn_buffer_t* out) {
+  CHECK(mask_batch == 1 || mask_batch == batch) << "The batch of mask can not be broadcast: " << mask_batch;
+  CHECK(mask_heads == 1 || mask_heads == heads) << "The heads of mask can not be broadcast: " << mask_heads;
+  CHECK(mask_rows == 1 || mask_rows == seq_q) << "The rows of mask can not be broadcast: " << mask_rows;
+  AttentionClosure<T> closure{reinterpret_cast<const T*>(q->memory),
+                              reinterpret_cast<const T*>(k->memory),
+                              reinterpret_cast<const T*>(v->memory),
+                              mask ? reinterpret_cast<const T*>(mask->memory) : nullptr,
+                              reinterpret_cast<T*>(out->memory),
+                              batch,
+                              heads,
+                              seq_q,
+                              seq_kv,
+                              head_dim,
+                              mask_batch,
+                              mask_heads,
+                              mask_rows,
+                              static_cast<T>(scale),
+                              causal,
+                              (seq_q + kAttentionBlockQ - 1) / kAttentionBlockQ};
+  int64_t num_blocks = static_cast<int64_t>(batch) * heads * closure.q_blocks;
+  int64_t num_tasks  = std::min<int64_t>(num_blocks, max_concurrency());
+  if (num_tasks > 1) {
+    cinn_backend_parallel_launch(&AttentionBlocks<T>, &closure, static_cast<int>(num_tasks));
+  } else if (num_blocks > 0) {
+    AttentionBlocks<T>(0, 1, &closure);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_ATTENTION(TYPE_SUFFIX, TYPE)                                                             \
+  void cinn_host_attention_##TYPE_SUFFIX(const cinn_buffer_t* q,                                           \
+                                         const cinn_buffer_t* k,                                           \
+                                         const cinn_buffer_t* v,                                           \
+                                         int batch,                                                        \
+                                         int heads,                                                        \
+                                         int seq_q,                                                        \
+                                         int seq_kv,                                                       \
+                                         int head_dim,                                                     \
+                                         float scale,                                                      \
+                                         bool causal,                                                      \
+                                         cinn_buffer_t* out) {                                             \
+    Attention<TYPE>(q, k, v, nullptr, batch, heads, seq_q, seq_kv, head_dim, 1, 1, 1, scale, causal, out); \
+  }
+
+CINN_HOST_ATTENTION(fp32, float)
+CINN_HOST_ATTENTION(fp64, double)
+
+#undef CINN_HOST_ATTENTION
+
+#define CINN_HOST_MASKED_ATTENTION(TYPE_SUFFIX, TYPE)                      \
+  void cinn_host_masked_attention_##TYPE_SUFFIX(const cinn_buffer_t* q,    \
+                                                const cinn_buffer_t* k,    \
+                                                const cinn_buffer_t* v,    \
+                                                const cinn_buffer_t* mask, \
+                                                int batch,                 \
+                                                int heads,                 \
+                                                int seq_q,                 \
+                                                int seq_kv,                \
+                                                int head_dim,              \
+                                                int mask_batch,            \
+                                                int mask_heads,            \
+                                                int mask_rows,             \
+                                                float scale,               \
+                                                bool causal,               \
+                                                cinn_buffer_t* out) {      \
+    Attention<TYPE>(q,                                                     \
+                    k,                                                     \
+                    v,                                                     \
+                    mask,                                                  \
+                    batch,                                                 \
+                    heads,                                                 \
+                    seq_q,                                                 \
+                    seq_kv,                                                \
+                    head_dim,                                              \
+                    mask_batch,                                            \
+                    mask_heads,                                            \
+                    mask_rows,                                             \
+                    scale,                                                 \
+                    causal,                                                \
+                    out);                                                  \
+  }
+
+CINN_HOST_MASKED_ATTENTION(fp32, float)
+CINN_HOST_MASKED_ATTENTION(fp64, double)
+
+#undef CINN_HOST_MASKED_ATTENTION
+}
+
+CINN_REGISTER_HELPER(host_attention) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+#define _REGISTER_CINN_HOST_ATTENTION(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_attention_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                     \
+      .AddInputType<cinn_buffer_t*>()                                         \
+      .AddInputType<cinn_buffer_t*>()                                         \
+      .AddInputType<cinn_buffer_t*>()                                         \
+      .AddInputType<int>()                                                    \
+      .AddInputType<int>()                                                    \
+      .AddInputType<int>()                                                    \
+      .AddInputType<int>()                                                    \
+      .AddInputType<int>()                                                    \
+      .AddInputType<float>()                                                  \
+      .AddInputType<bool>()                                                   \
+      .AddOutputType<cinn_buffer_t*>()                                        \
+      .SetShapeInference(FunctionProto::ShapeFollowNthArgument(0))            \
+      .End();
+
+  _REGISTER_CINN_HOST_ATTENTION(fp32);
+  _REGISTER_CINN_HOST_ATTENTION(fp64);
+
+#undef _REGISTER_CINN_HOST_ATTENTION
+
+#define _REGISTER_CINN_HOST_MASKED_ATTENTION(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_masked_attention_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                            \
+      .AddInputType<cinn_buffer_t*>()                                                \
+      .AddInputType<cinn_buffer_t*>()                                                \
+      .AddInputType<cinn_buffer_t*>()                                                \
+      .AddInputType<cinn_buffer_t*>()                                                \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<int>()                                                           \
+      .AddInputType<float>()                                                         \
+      .AddInputType<bool>()                                                          \
+      .AddOutputType<cinn_buffer_t*>()                                               \
+      .SetShapeInference(FunctionProto::ShapeFollowNthArgument(0))                   \
+      .End();
+
+  _REGISTER_CINN_HOST_MASKED_ATTENTION(fp32);
+  _REGISTER_CINN_HOST_MASKED_ATTENTION(fp64);
+
+#undef _REGISTER_CINN_HOST_MASKED_ATTENTION
+
+  return true;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the fused attention functions in host device.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! Scaled dot-product attention out = softmax(q * k^T * scale + mask) * v, where q is [batch, heads, seq_q, head_dim],
+//! k and v are [batch, heads, seq_kv, head_dim]. The keys and values are streamed in tiles with an online softmax,
+//! so the [seq_q, seq_kv] scores are never materialized. With `causal`, the query i only attends to the keys up to
+//! i + seq_kv - seq_q.
+#define CINN_HOST_ATTENTION(TYPE_SUFFIX)                         \
+  void cinn_host_attention_##TYPE_SUFFIX(const cinn_buffer_t* q, \
+                                         const cinn_buffer_t* k, \
+                                         const cinn_buffer_t* v, \
+                                         int batch,              \
+                                         int heads,              \
+                                         int seq_q,              \
+                                         int seq_kv,             \
+                                         int head_dim,           \
+                                         float scale,            \
+                                         bool causal,            \
+                                         cinn_buffer_t* out);
+
+CINN_HOST_ATTENTION(fp32)
+CINN_HOST_ATTENTION(fp64)
+
+#undef CINN_HOST_ATTENTION
+
+//! The attention with an additive mask of [mask_batch, mask_heads, mask_rows, seq_kv], whose first three dimensions
+//! are either 1 and broadcast, or the same as batch, heads and seq_q. It could be a padding mask of [batch, 1, 1,
+//! seq_kv] or a full mask of [batch, heads, seq_q, seq_kv].
+#define CINN_HOST_MASKED_ATTENTION(TYPE_SUFFIX)                            \
+  void cinn_host_masked_attention_##TYPE_SUFFIX(const cinn_buffer_t* q,    \
+                                                const cinn_buffer_t* k,    \
+                                                const cinn_buffer_t* v,    \
+                                                const cinn_buffer_t* mask, \
+                                                int batch,                 \
+                                                int heads,                 \
+                                                int seq_q,                 \
+                                                int seq_kv,                \
+                                                int head_dim,              \
+                                                int mask_batch,            \
+                                                int mask_heads,            \
+                                                int mask_rows,             \
+                                                float scale,               \
+                                                bool causal,               \
+                                                cinn_buffer_t* out);
+
+CINN_HOST_MASKED_ATTENTION(fp32)
+CINN_HOST_MASKED_ATTENTION(fp64)
+
+#undef CINN_HOST_MASKED_ATTENTION
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_attention.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+// softmax(q * k^T * scale + mask) * v with the whole scores materialized
+void ReferenceAttention(const std::vector<float>& q,
+                        const std::vector<float>& k,
+                        const std::vector<float>& v,
+                        const std::vector<float>& mask,
+                        const std::vector<int>& mask_dims,
+                        int batch,
+                        int heads,
+                        int seq_q,
+                        int seq_kv,
+                        int dim,
+                        float scale,
+                        bool causal,
+                        std::vector<float>* out) {
+  for (int b = 0; b < batch; ++b) {
+    for (int h = 0; h < heads; ++h) {
+      for (int i = 0; i < seq_q; ++i) {
+        std::vector<double> scores(seq_kv, -std::numeric_limits<double>::infinity());
+        double max_score = -std::numeric_limits<double>::infinity();
+        for (int j = 0; j < seq_kv; ++j) {
+          if (causal && j > i + seq_kv - seq_q) continue;
+          double dot = 0;
+          for (int d = 0; d < dim; ++d) {
+            dot += q[((b * heads + h) * seq_q + i) * dim + d] * k[((b * heads + h) * seq_kv + j) * dim + d];
+          }
+          scores[j] = dot * scale;
+          if (!mask.empty()) {
+            int mb = mask_dims[0] == 1 ? 0 : b, mh = mask_dims[1] == 1 ? 0 : h, mr = mask_dims[2] == 1 ? 0 : i;
+            scores[j] += mask[((mb * mask_dims[1] + mh) * mask_dims[2] + mr) * seq_kv + j];
+          }
+          max_score = std::max(max_score, scores[j]);
+        }
+        double sum = 0;
+        for (auto& s : scores) {
+          s = std::isinf(max_score) ? 0 : std::exp(s - max_score);
+          sum += s;
+        }
+        for (int d = 0; d < dim; ++d) {
+          double acc = 0;
+          for (int j = 0; j < seq_kv; ++j) {
+            acc += scores[j] * v[((b * heads + h) * seq_kv + j) * dim + d];
+          }
+          out->at(((b * heads + h) * seq_q + i) * dim + d) = sum > 0 ? acc / sum : 0;
+        }
+      }
+    }
+  }
+}
+
+cinn_buffer_t* MakeBuffer(const std::vector<float>& data, const std::vector<int>& shape) {
+  auto* buf = common::BufferBuilder(Float(32), shape).Build();
+  std::copy(data.begin(), data.end(), reinterpret_cast<float*>(buf->memory));
+  return buf;
+}
+
+TEST(cinn_host_attention, online_softmax) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  struct Case {
+    int seq_q, seq_kv, dim;
+    bool causal;
+    std::vector<int> mask_dims;
+  };
+  // the sequences cover partial tiles of queries and keys, the masks cover the padding and full masks
+  std::vector<Case> cases = {{5, 7, 8, false, {}},
+                             {70, 130, 16, true, {}},
+                             {33, 33, 24, true, {2, 1, 1}},
+                             {40, 100, 32, false, {2, 3, 40}},
+                             {100, 65, 8, true, {1, 1, 100}}};
+  int batch = 2, heads = 3;
+  for (auto& c : cases) {
+    std::vector<float> q(batch * heads * c.seq_q * c.dim), k(batch * heads * c.seq_kv * c.dim), v(k.size());
+    for (auto* data : {&q, &k, &v}) {
+      for (auto& x : *data) x = dist(rng);
+    }
+    std::vector<float> mask;
+    if (!c.mask_dims.empty()) {
+      mask.resize(c.mask_dims[0] * c.mask_dims[1] * c.mask_dims[2] * c.seq_kv);
+      // mask about a quarter of the keys out
+      for (auto& x : mask) x = rng() % 4 ? dist(rng) : -std::numeric_limits<float>::infinity();
+    }
+    std::vector<float> expect(q.size());
+    ReferenceAttention(q, k, v, mask, c.mask_dims, batch, heads, c.seq_q, c.seq_kv, c.dim, 0.3f, c.causal, &expect);
+
+    auto* q_buf   = MakeBuffer(q, {batch, heads, c.seq_q, c.dim});
+    auto* k_buf   = MakeBuffer(k, {batch, heads, c.seq_kv, c.dim});
+    auto* v_buf   = MakeBuffer(v, {batch, heads, c.seq_kv, c.dim});
+    auto* out_buf = common::BufferBuilder(Float(32), {batch, heads, c.seq_q, c.dim}).set_zero().Build();
+    if (mask.empty()) {
+      cinn_host_attention_fp32(q_buf, k_buf, v_buf, batch, heads, c.seq_q, c.seq_kv, c.dim, 0.3f, c.causal, out_buf);
+    } else {
+      auto* mask_buf = MakeBuffer(mask, {c.mask_dims[0], c.mask_dims[1], c.mask_dims[2], c.seq_kv});
+      cinn_host_masked_attention_fp32(q_buf,
+                                      k_buf,
+                                      v_buf,
+                                      mask_buf,
+                                      batch,
+                                      heads,
+                                      c.seq_q,
+                                      c.seq_kv,
+                                      c.dim,
+                                      c.mask_dims[0],
+                                      c.mask_dims[1],
+                                      c.mask_dims[2],
+                                      0.3f,
+                                      c.causal,
+                                      out_buf);
+    }
+    auto* out = reinterpret_cast<float*>(out_buf->memory);
+    for (size_t i = 0; i < expect.size(); ++i) {
+      ASSERT_NEAR(out[i], expect[i], 1e-5) << "seq_q:" << c.seq_q << ", seq_kv:" << c.seq_kv << ", index:" << i;
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,401 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "cinn/runtime/cpu/host_conv2d_nhwc.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/cas.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/host_weight_cache.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+enum Conv2dEpilogue { kAddBias = 1, kAddResidual = 2, kRelu = 4 };
+
+// The cache of packed weights is dropped as a whole when it grows beyond this number of weights.
+constexpr size_t kMaxCachedWeights = 256;
+
+template <typename T>
+struct Conv2dNHWCClosure {
+  const T* input;
+  // the weights packed as [c_out / oc_block, filter_h, filter_w, c_in, oc_block], padded by zeros
+  const T* packed_weights;
+  const T* bias;
+  const T* residual;
+  T* out;
+  int batch;
+  int input_h;
+  int input_w;
+  int c_in;
+  int c_out;
+  int filter_h;
+  int filter_w;
+  int pad_h;
+  int pad_w;
+  int stride_h;
+  int stride_w;
+  int dilation_h;
+  int dilation_w;
+  int out_h;
+  int out_w;
+  int epilogue;
+  int num_oc_blocks;
+};
+
+template <typename T>
+std::vector<T> PackWeights(const T* weights, int c_out, int c_in, int filter_h, int filter_w, int oc_block) {
+  int num_oc_blocks = (c_out + oc_block - 1) / oc_block;
+  std::vector<T> packed(static_cast<int64_t>(num_oc_blocks) * filter_h * filter_w * c_in * oc_block, T(0));
+  for (int oc = 0; oc < c_out; ++oc) {
+    for (int ic = 0; ic < c_in; ++ic) {
+      for (int kh = 0; kh < filter_h; ++kh) {
+        for (int kw = 0; kw < filter_w; ++kw) {
+          int64_t src = ((static_cast<int64_t>(oc) * c_in + ic) * filter_h + kh) * filter_w + kw;
+          int64_t dst = ((static_cast<int64_t>(oc / oc_block) * filter_h + kh) * filter_w + kw) * c_in + ic;
+          packed[dst * oc_block + oc % oc_block] = weights[src];
+        }
+      }
+    }
+  }
+  return packed;
+}
+
+// The packed weights are cached since the weights of an inference model stay the same in every run.
+template <typename T>
+std::shared_ptr<const std::vector<T>> GetPackedWeights(
+    const T* weights, int c_out, int c_in, int filter_h, int filter_w, int oc_block) {
+  static cinn::runtime::cpu::HostWeightCache<T> cache(kMaxCachedWeights);
+  size_t size = static_cast<size_t>(c_out) * c_in * filter_h * filter_w;
+  return cache.Get(weights, size, {c_out, c_in, filter_h, filter_w, oc_block}, [&] {
+    return PackWeights(weights, c_out, c_in, filter_h, filter_w, oc_block);
+  });
+}
+
+// The vectors of the accumulators, the weights are loaded into vectors of the same width.
+#if defined(__AVX512F__)
+constexpr int kVectorBytes = 64;
+#else
+constexpr int kVectorBytes = 32;
+#endif
+
+// The microkernel of a tile of OWB output pixels by OCB output channels, whose OWB * OCB / kLanes accumulators are
+// kept in the registers over all the filter taps and input channels.
+template <typename T, int OCB, int OWB>
+struct Conv2dNHWCTile {
+  static constexpr int kLanes = OCB * sizeof(T) < kVectorBytes ? OCB : kVectorBytes / sizeof(T);
+  static constexpr int kVecs  = OCB / kLanes;
+  typedef T Vec __attribute__((vector_size(kLanes * sizeof(T))));
+  // the packed weights are only aligned to their elements
+  typedef T UnalignedVec __attribute__((vector_size(kLanes * sizeof(T)), aligned(sizeof(T))));
+
+  static Vec Load(const T* ptr) { return *reinterpret_cast<const UnalignedVec*>(ptr); }
+
+  // All the OWB pixels from ow read their whole receptive field in the width.
+  static void Full(const Conv2dNHWCClosure<T>& c, int n, int oh, int ow, int ob, T* out) {
+    Vec acc[OWB][kVecs] = {};
+    int64_t in_step     = static_cast<int64_t>(c.stride_w) * c.c_in;
+    for (int kh = 0; kh < c.filter_h; ++kh) {
+      int ih = oh * c.stride_h - c.pad_h + kh * c.dilation_h;
+      if (ih < 0 || ih >= c.input_h) continue;
+      const T* in_row = c.input + (static_cast<int64_t>(n) * c.input_h + ih) * c.input_w * c.c_in;
+      for (int kw = 0; kw < c.filter_w; ++kw) {
+        int64_t tap       = (static_cast<int64_t>(ob) * c.filter_h + kh) * c.filter_w + kw;
+        const T* w_tap    = c.packed_weights + tap * c.c_in * OCB;
+        const T* in_pixel = in_row + static_cast<int64_t>(ow * c.stride_w - c.pad_w + kw * c.dilation_w) * c.c_in;
+        for (int ic = 0; ic < c.c_in; ++ic) {
+          Vec wv[kVecs];
+          for (int v = 0; v < kVecs; ++v) wv[v] = Load(w_tap + ic * OCB + v * kLanes);
+          for (int w = 0; w < OWB; ++w) {
+            T x = in_pixel[w * in_step + ic];
+            for (int v = 0; v < kVecs; ++v) acc[w][v] += wv[v] * x;
+          }
+        }
+      }
+    }
+    std::memcpy(out, acc, sizeof(acc));
+  }
+
+  // The num_w pixels from ow at the borders skip the taps in the padding, one pixel after another.
+  static void Partial(const Conv2dNHWCClosure<T>& c, int n, int oh, int ow, int ob, int num_w, T* out) {
+    for (int w = 0; w < num_w; ++w) {
+      Vec acc[kVecs] = {};
+      for (int kh = 0; kh < c.filter_h; ++kh) {
+        int ih = oh * c.stride_h - c.pad_h + kh * c.dilation_h;
+        if (ih < 0 || ih >= c.input_h) continue;
+        for (int kw = 0; kw < c.filter_w; ++kw) {
+          int iw = (ow + w) * c.stride_w - c.pad_w + kw * c.dilation_w;
+          if (iw < 0 || iw >= c.input_w) continue;
+          int64_t tap       = (static_cast<int64_t>(ob) * c.filter_h + kh) * c.filter_w + kw;
+          const T* w_tap    = c.packed_weights + tap * c.c_in * OCB;
+          const T* in_pixel = c.input + ((static_cast<int64_t>(n) * c.input_h + ih) * c.input_w + iw) * c.c_in;
+          for (int ic = 0; ic < c.c_in; ++ic) {
+            for (int v = 0; v < kVecs; ++v) acc[v] += Load(w_tap + ic * OCB + v * kLanes) * in_pixel[ic];
+          }
+        }
+      }
+      std::memcpy(out + w * OCB, acc, sizeof(acc));
+    }
+  }
+};
+
+// Compute the output row oh of the image n for the oc block ob, and apply the epilogue before the only store.
+template <typename T, int OCB, int OWB>
+void ComputeRow(const Conv2dNHWCClosure<T>& c, int n, int oh, int ob) {
+  int oc0    = ob * OCB;
+  int num_oc = std::min(OCB, c.c_out - oc0);
+  // the output pixels from ow_begin to ow_end read their whole receptive field in the width without padding
+  int ow_begin = std::min(c.out_w, (c.pad_w + c.stride_w - 1) / c.stride_w);
+  int ow_end   = std::max(ow_begin, (c.input_w + c.pad_w - (c.filter_w - 1) * c.dilation_w - 1) / c.stride_w + 1);
+  ow_end       = std::min(ow_end, c.out_w);
+  for (int ow = 0; ow < c.out_w; ow += OWB) {
+    int num_w = std::min(OWB, c.out_w - ow);
+    bool full = num_w == OWB && ow >= ow_begin && ow + OWB <= ow_end;
+    T acc[OWB][OCB];
+    if (full) {
+      Conv2dNHWCTile<T, OCB, OWB>::Full(c, n, oh, ow, ob, &acc[0][0]);
+    } else {
+      Conv2dNHWCTile<T, OCB, OWB>::Partial(c, n, oh, ow, ob, num_w, &acc[0][0]);
+    }
+
+    for (int w = 0; w < num_w; ++w) {
+      int64_t offset = ((static_cast<int64_t>(n) * c.out_h + oh) * c.out_w + ow + w) * c.c_out + oc0;
+      T* out         = c.out + offset;
+      for (int j = 0; j < num_oc; ++j) {
+        T value = acc[w][j];
+        if (c.epilogue & kAddBias) value += c.bias[oc0 + j];
+        if (c.epilogue & kAddResidual) value += c.residual[offset + j];
+        if (c.epilogue & kRelu) value = std::max(value, T(0));
+        out[j] = value;
+      }
+    }
+  }
+}
+
+// The rows of all the images and oc blocks are split evenly among the tasks.
+template <typename T, int OCB, int OWB>
+int Conv2dNHWCTask(int task_id, int num_task, void* datas) {
+  auto& c          = *static_cast<Conv2dNHWCClosure<T>*>(datas);
+  int64_t num_rows = static_cast<int64_t>(c.batch) * c.out_h * c.num_oc_blocks;
+  for (int64_t row = num_rows * task_id / num_task; row < num_rows * (task_id + 1) / num_task; ++row) {
+    int ob = row % c.num_oc_blocks;
+    int oh = row / c.num_oc_blocks % c.out_h;
+    int n  = row / c.num_oc_blocks / c.out_h;
+    ComputeRow<T, OCB, OWB>(c, n, oh, ob);
+  }
+  return 0;
+}
+
+template <typename T, int OCB, int OWB>
+void LaunchConv2dNHWC(Conv2dNHWCClosure<T>* closure) {
+  int64_t num_rows = static_cast<int64_t>(closure->batch) * closure->out_h * closure->num_oc_blocks;
+  int num_tasks    = std::min<int64_t>(num_rows, max_concurrency());
+  if (num_tasks > 1) {
+    cinn_backend_parallel_launch(&Conv2dNHWCTask<T, OCB, OWB>, closure, num_tasks);
+  } else {
+    Conv2dNHWCTask<T, OCB, OWB>(0, 1, closure);
+  }
+}
+
+template <typename T, int OCB>
+void LaunchConv2dNHWC(Conv2dNHWCClosure<T>* closure, int ow_block) {
+  switch (ow_block) {
+    case 4:
+      return LaunchConv2dNHWC<T, OCB, 4>(closure);
+    case 6:
+      return LaunchConv2dNHWC<T, OCB, 6>(closure);
+    case 8:
+      return LaunchConv2dNHWC<T, OCB, 8>(closure);
+    default:
+      LOG(FATAL) << "The ow_block of conv2d_nhwc should be 4, 6 or 8, but got " << ow_block;
+  }
+}
+
+template <typename T>
+void Conv2dNHWC(const cinn_buffer_t* input,
+                const cinn_buffer_t* weights,
+                const cinn_buffer_t* bias,
+                const cinn_buffer_t* residual,
+                int batch,
+                int input_h,
+                int input_w,
+                int c_in,
+                int c_out,
+                int filter_h,
+                int filter_w,
+                int pad_h,
+                int pad_w,
+                int stride_h,
+                int stride_w,
+                int dilation_h,
+                int dilation_w,
+                int epilogue,
+                int oc_block,
+                int ow_block,
+                cinn_buffer_t* out) {
+  CHECK(oc_block == 8 || oc_block == 16 || oc_block == 32)
+      << "The oc_block of conv2d_nhwc should be 8, 16 or 32, but got " << oc_block;
+  auto weights_ptr = reinterpret_cast<const T*>(weights->memory);
+  auto packed      = GetPackedWeights(weights_ptr, c_out, c_in, filter_h, filter_w, oc_block);
+
+  Conv2dNHWCClosure<T> closure;
+  closure.input          = reinterpret_cast<const T*>(input->memory);
+  closure.packed_weights = packed->data();
+  closure.bias           = reinterpret_cast<const T*>(bias->memory);
+  closure.residual       = reinterpret_cast<const T*>(residual->memory);
+  closure.out            = reinterpret_cast<T*>(out->memory);
+  closure.batch          = batch;
+  closure.input_h        = input_h;
+  closure.input_w        = input_w;
+  closure.c_in           = c_in;
+  closure.c_out          = c_out;
+  closure.filter_h       = filter_h;
+  closure.filter_w       = filter_w;
+  closure.pad_h          = pad_h;
+  closure.pad_w          = pad_w;
+  closure.stride_h       = stride_h;
+  closure.stride_w       = stride_w;
+  closure.dilation_h     = dilation_h;
+  closure.dilation_w     = dilation_w;
+  closure.out_h          = (input_h + 2 * pad_h - (filter_h - 1) * dilation_h - 1) / stride_h + 1;
+  closure.out_w          = (input_w + 2 * pad_w - (filter_w - 1) * dilation_w - 1) / stride_w + 1;
+  closure.epilogue       = epilogue;
+  closure.num_oc_blocks  = (c_out + oc_block - 1) / oc_block;
+  CHECK_GT(closure.out_h, 0) << "The output height of conv2d_nhwc should be positive";
+  CHECK_GT(closure.out_w, 0) << "The output width of conv2d_nhwc should be positive";
+
+  if (oc_block == 8) {
+    LaunchConv2dNHWC<T, 8>(&closure, ow_block);
+  } else if (oc_block == 16) {
+    LaunchConv2dNHWC<T, 16>(&closure, ow_block);
+  } else {
+    LaunchConv2dNHWC<T, 32>(&closure, ow_block);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_CONV2D_NHWC(TYPE_SUFFIX, TYPE)                          \
+  void cinn_host_conv2d_nhwc_##TYPE_SUFFIX(const cinn_buffer_t* input,    \
+                                           const cinn_buffer_t* weights,  \
+                                           const cinn_buffer_t* bias,     \
+                                           const cinn_buffer_t* residual, \
+                                           int batch,                     \
+                                           int input_h,                   \
+                                           int input_w,                   \
+                                           int c_in,                      \
+                                           int c_out,                     \
+                                           int filter_h,                  \
+                                           int filter_w,                  \
+                                           int pad_h,                     \
+                                           int pad_w,                     \
+                                           int stride_h,                  \
+                                           int stride_w,                  \
+                                           int dilation_h,                \
+                                           int dilation_w,                \
+                                           int epilogue,                  \
+                                           int oc_block,                  \
+                                           int ow_block,                  \
+                                           cinn_buffer_t* out) {          \
+    Conv2dNHWC<TYPE>(input,                                               \
+                     weights,                                             \
+                     bias,                                                \
+                     residual,                                            \
+                     batch,                                               \
+                     input_h,                                             \
+                     input_w,                                             \
+                     c_in,                                                \
+                     c_out,                                               \
+                     filter_h,                                            \
+                     filter_w,                                            \
+                     pad_h,                                               \
+                     pad_w,                                               \
+                     stride_h,                                            \
+                     stride_w,                                            \
+                     dilation_h,                                          \
+                     dilation_w,                                          \
+                     epilogue,                                            \
+                     oc_block,                                            \
+                     ow_block,                                            \
+                     out);                                                \
+  }
+
+CINN_HOST_CONV2D_NHWC(fp32, float)
+CINN_HOST_CONV2D_NHWC(fp64, double)
+
+#undef CINN_HOST_CONV2D_NHWC
+}
+
+CINN_REGISTER_HELPER(host_conv2d_nhwc) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  // out is [batch, out_h, out_w, c_out]
+  FunctionProto::shape_inference_t inference_shape_conv2d_nhwc = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(args.size(), 20UL) << "Wrong number of arguments passed in";
+    std::vector<int> values;
+    for (int i = 4; i < 17; ++i) {
+      values.push_back(common::AutoSimplify(args[i]).as_int32());
+    }
+    // batch, input_h, input_w, c_in, c_out, filter_h, filter_w, pad_h, pad_w, stride_h, stride_w, dilation_h and
+    // dilation_w
+    int out_h = (values[1] + 2 * values[7] - (values[5] - 1) * values[11] - 1) / values[9] + 1;
+    int out_w = (values[2] + 2 * values[8] - (values[6] - 1) * values[12] - 1) / values[10] + 1;
+    return std::vector<Expr>{Expr(values[0]), Expr(out_h), Expr(out_w), Expr(values[4])};
+  };
+
+#define _REGISTER_CINN_HOST_CONV2D_NHWC(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_conv2d_nhwc_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                       \
+      .AddInputType<cinn_buffer_t*>()                                           \
+      .AddInputType<cinn_buffer_t*>()                                           \
+      .AddInputType<cinn_buffer_t*>()                                           \
+      .AddInputType<cinn_buffer_t*>()                                           \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddInputType<int>()                                                      \
+      .AddOutputType<cinn_buffer_t*>()                                          \
+      .SetShapeInference(inference_shape_conv2d_nhwc)                           \
+      .End();
+
+  _REGISTER_CINN_HOST_CONV2D_NHWC(fp32);
+  _REGISTER_CINN_HOST_CONV2D_NHWC(fp64);
+
+#undef _REGISTER_CINN_HOST_CONV2D_NHWC
+
+  return true;
+}
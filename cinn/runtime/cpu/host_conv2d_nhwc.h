@@ -0,0 +1,54 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+/**
+ * \file This file implements the direct NHWC convolution functions in host device.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! The convolution from `input` of [batch, input_h, input_w, c_in] and `weights` of [c_out, c_in, filter_h, filter_w]
+//! to `out` of [batch, out_h, out_w, c_out]. Every task computes tiles of ow_block output pixels by oc_block output
+//! channels, whose accumulators stay in the registers, with the channels innermost to be vectorized. `epilogue` is a
+//! mask of 1 to add the `bias` of [c_out], 2 to add the `residual` of the out shape and 4 to apply relu after them,
+//! the unused buffers are not read. oc_block is 8, 16 or 32 and ow_block is 4, 6 or 8.
+#define CINN_HOST_CONV2D_NHWC(TYPE_SUFFIX)                                \
+  void cinn_host_conv2d_nhwc_##TYPE_SUFFIX(const cinn_buffer_t* input,    \
+                                           const cinn_buffer_t* weights,  \
+                                           const cinn_buffer_t* bias,     \
+                                           const cinn_buffer_t* residual, \
+                                           int batch,                     \
+                                           int input_h,                   \
+                                           int input_w,                   \
+                                           int c_in,                      \
+                                           int c_out,                     \
+                                           int filter_h,                  \
+                                           int filter_w,                  \
+                                           int pad_h,                     \
+                                           int pad_w,                     \
+                                           int stride_h,                  \
+                                           int stride_w,                  \
+                                           int dilation_h,                \
+                                           int dilation_w,                \
+                                           int epilogue,                  \
+                                           int oc_block,                  \
+                                           int ow_block,                  \
+                                           cinn_buffer_t* out);
+
+CINN_HOST_CONV2D_NHWC(fp32)
+CINN_HOST_CONV2D_NHWC(fp64)
+
+#undef CINN_HOST_CONV2D_NHWC
+}
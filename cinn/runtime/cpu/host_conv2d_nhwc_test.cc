@@ -0,0 +1,143 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "cinn/runtime/cpu/host_conv2d_nhwc.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+struct Conv2dNHWCConfig {
+  int batch, input_h, input_w, c_in, c_out, filter_h, filter_w, pad, stride, dilation, epilogue, oc_block, ow_block;
+};
+
+// The weights are random ones if `weights` is null.
+void TestConv2dNHWC(const Conv2dNHWCConfig& cfg, cinn_buffer_t* weights = nullptr) {
+  int out_h = (cfg.input_h + 2 * cfg.pad - (cfg.filter_h - 1) * cfg.dilation - 1) / cfg.stride + 1;
+  int out_w = (cfg.input_w + 2 * cfg.pad - (cfg.filter_w - 1) * cfg.dilation - 1) / cfg.stride + 1;
+
+  std::vector<int> input_shape   = {cfg.batch, cfg.input_h, cfg.input_w, cfg.c_in};
+  std::vector<int> weights_shape = {cfg.c_out, cfg.c_in, cfg.filter_h, cfg.filter_w};
+  std::vector<int> out_shape     = {cfg.batch, out_h, out_w, cfg.c_out};
+  auto* input                    = common::BufferBuilder(Float(32), input_shape).set_random().Build();
+  auto* bias                     = common::BufferBuilder(Float(32), {cfg.c_out}).set_random().Build();
+  auto* residual                 = common::BufferBuilder(Float(32), out_shape).set_random().Build();
+  auto* out                      = common::BufferBuilder(Float(32), out_shape).set_random().Build();
+  if (weights == nullptr) {
+    weights = common::BufferBuilder(Float(32), weights_shape).set_random().Build();
+  }
+
+  cinn_host_conv2d_nhwc_fp32(input,
+                             weights,
+                             bias,
+                             residual,
+                             cfg.batch,
+                             cfg.input_h,
+                             cfg.input_w,
+                             cfg.c_in,
+                             cfg.c_out,
+                             cfg.filter_h,
+                             cfg.filter_w,
+                             cfg.pad,
+                             cfg.pad,
+                             cfg.stride,
+                             cfg.stride,
+                             cfg.dilation,
+                             cfg.dilation,
+                             cfg.epilogue,
+                             cfg.oc_block,
+                             cfg.ow_block,
+                             out);
+
+  auto* x = reinterpret_cast<float*>(input->memory);
+  auto* w = reinterpret_cast<float*>(weights->memory);
+  auto* b = reinterpret_cast<float*>(bias->memory);
+  auto* r = reinterpret_cast<float*>(residual->memory);
+  auto* y = reinterpret_cast<float*>(out->memory);
+  for (int n = 0; n < cfg.batch; ++n) {
+    for (int oh = 0; oh < out_h; ++oh) {
+      for (int ow = 0; ow < out_w; ++ow) {
+        for (int oc = 0; oc < cfg.c_out; ++oc) {
+          double expect = 0;
+          for (int kh = 0; kh < cfg.filter_h; ++kh) {
+            for (int kw = 0; kw < cfg.filter_w; ++kw) {
+              int ih = oh * cfg.stride - cfg.pad + kh * cfg.dilation;
+              int iw = ow * cfg.stride - cfg.pad + kw * cfg.dilation;
+              if (ih < 0 || ih >= cfg.input_h || iw < 0 || iw >= cfg.input_w) continue;
+              for (int ic = 0; ic < cfg.c_in; ++ic) {
+                expect += x[((n * cfg.input_h + ih) * cfg.input_w + iw) * cfg.c_in + ic] *
+                          w[((oc * cfg.c_in + ic) * cfg.filter_h + kh) * cfg.filter_w + kw];
+              }
+            }
+          }
+          int offset = ((n * out_h + oh) * out_w + ow) * cfg.c_out + oc;
+          if (cfg.epilogue & 1) expect += b[oc];
+          if (cfg.epilogue & 2) expect += r[offset];
+          if (cfg.epilogue & 4) expect = std::max(expect, 0.0);
+          ASSERT_NEAR(y[offset], expect, 1e-4 * (1 + std::abs(expect))) << "n: " << n << ", oh: " << oh
+                                                                         << ", ow: " << ow << ", oc: " << oc;
+        }
+      }
+    }
+  }
+}
+
+TEST(cinn_host_conv2d_nhwc, basic) {
+  // 3x3 with padding, the width covers both the full tiles and the borders
+  TestConv2dNHWC({1, 14, 20, 16, 32, 3, 3, 1, 1, 1, 0, 16, 6});
+  // 1x1 without any border
+  TestConv2dNHWC({2, 7, 7, 24, 16, 1, 1, 0, 1, 1, 0, 8, 4});
+}
+
+TEST(cinn_host_conv2d_nhwc, stride_dilation) {
+  // the output channels are not a multiple of the oc block
+  TestConv2dNHWC({1, 17, 23, 5, 20, 3, 3, 1, 2, 1, 0, 16, 8});
+  TestConv2dNHWC({1, 15, 19, 8, 12, 3, 3, 2, 1, 2, 0, 32, 6});
+  TestConv2dNHWC({2, 9, 11, 3, 7, 5, 3, 2, 2, 1, 0, 8, 4});
+}
+
+TEST(cinn_host_conv2d_nhwc, epilogue) {
+  // bias, bias + residual, and bias + residual + relu
+  TestConv2dNHWC({1, 12, 13, 16, 24, 3, 3, 1, 1, 1, 1, 16, 6});
+  TestConv2dNHWC({1, 12, 13, 16, 24, 3, 3, 1, 1, 1, 3, 16, 6});
+  TestConv2dNHWC({2, 10, 9, 8, 16, 3, 3, 1, 1, 1, 7, 8, 8});
+  // relu alone
+  TestConv2dNHWC({1, 8, 8, 4, 8, 3, 3, 0, 1, 1, 4, 8, 4});
+}
+
+TEST(cinn_host_conv2d_nhwc, cached_weights) {
+  Conv2dNHWCConfig cfg = {1, 9, 10, 8, 16, 3, 3, 1, 1, 1, 0, 16, 4};
+  auto* weights        = common::BufferBuilder(Float(32), {16, 8, 3, 3}).set_random().Build();
+  // the second call reuses the packed weights
+  TestConv2dNHWC(cfg, weights);
+  TestConv2dNHWC(cfg, weights);
+  // the refilled weights are packed again
+  auto* w = reinterpret_cast<float*>(weights->memory);
+  for (int i = 0; i < 16 * 8 * 3 * 3; ++i) w[i] = -w[i] + 0.5f;
+  TestConv2dNHWC(cfg, weights);
+  // the same weights packed by another oc block
+  cfg.oc_block = 8;
+  TestConv2dNHWC(cfg, weights);
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,265 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_embedding_bag.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+enum EmbeddingBagMode { kBagSum = 0, kBagMean = 1, kBagMax = 2 };
+
+// The rows are gathered from random places of a table much larger than the caches, so the row
+// of the id kBagPrefetchDistance ahead is prefetched while the current one is accumulated.
+constexpr int kBagPrefetchDistance = 8;
+constexpr int kCacheLineBytes      = 64;
+// Reduce bags in parallel only when there are enough gathered elements to amortize the launch.
+constexpr int64_t kParallelMinElements = 1 << 14;
+
+template <typename T>
+struct EmbeddingBagClosure {
+  const T* table;
+  const int64_t* ids;
+  const int64_t* offsets;
+  const T* weights;
+  T* out;
+  int64_t num_rows;
+  int64_t dim;
+  int64_t num_ids;
+  int64_t num_bags;
+  int mode;
+  int64_t padding_idx;
+};
+
+template <typename T>
+inline void PrefetchRow(const EmbeddingBagClosure<T>& c, int64_t i) {
+  int64_t id = c.ids[i];
+  if (id < 0 || id >= c.num_rows || id == c.padding_idx) return;
+  const char* row = reinterpret_cast<const char*>(c.table + id * c.dim);
+  for (int64_t b = 0; b < c.dim * static_cast<int64_t>(sizeof(T)); b += kCacheLineBytes) {
+    __builtin_prefetch(row + b, 0, 3);
+  }
+}
+
+// The first bag starting at or after the id `i`, so a bag always belongs to the task holding its first id.
+template <typename T>
+inline int64_t FirstBagFrom(const EmbeddingBagClosure<T>& c, int64_t i) {
+  return std::lower_bound(c.offsets, c.offsets + c.num_bags, i) - c.offsets;
+}
+
+template <typename T>
+void ReduceBag(const EmbeddingBagClosure<T>& c, int64_t bag) {
+  const int64_t dim   = c.dim;
+  int64_t begin       = c.offsets[bag];
+  int64_t end         = bag + 1 < c.num_bags ? c.offsets[bag + 1] : c.num_ids;
+  T* __restrict__ acc = c.out + bag * dim;
+  T init              = c.mode == kBagMax && end > begin ? std::numeric_limits<T>::lowest() : T(0);
+  std::fill(acc, acc + dim, init);
+
+  for (int64_t i = begin; i < end; ++i) {
+    if (i + kBagPrefetchDistance < c.num_ids) {
+      PrefetchRow(c, i + kBagPrefetchDistance);
+    }
+    int64_t id = c.ids[i];
+    if (id == c.padding_idx) {
+      // a row of zeros only changes the max
+      if (c.mode == kBagMax) {
+        for (int64_t d = 0; d < dim; ++d) acc[d] = std::max(acc[d], T(0));
+      }
+      continue;
+    }
+    CHECK(id >= 0 && id < c.num_rows) << "The id " << id << " of embedding_bag is out of the table of " << c.num_rows
+                                      << " rows";
+    const T* __restrict__ row = c.table + id * dim;
+    if (c.mode == kBagMax) {
+      for (int64_t d = 0; d < dim; ++d) acc[d] = std::max(acc[d], row[d]);
+    } else if (c.weights) {
+      T w = c.weights[i];
+      for (int64_t d = 0; d < dim; ++d) acc[d] += w * row[d];
+    } else {
+      for (int64_t d = 0; d < dim; ++d) acc[d] += row[d];
+    }
+  }
+
+  if (c.mode == kBagMean && end > begin) {
+    T inv_count = T(1) / static_cast<T>(end - begin);
+    for (int64_t d = 0; d < dim; ++d) acc[d] *= inv_count;
+  }
+}
+
+// The tasks split the ids evenly rather than the bags, so long and short bags are balanced.
+template <typename T>
+int EmbeddingBagTask(int task_id, int num_task, void* datas) {
+  auto& c           = *static_cast<EmbeddingBagClosure<T>*>(datas);
+  int64_t bag_begin = task_id == 0 ? 0 : FirstBagFrom(c, c.num_ids * task_id / num_task);
+  int64_t bag_end   = task_id + 1 == num_task ? c.num_bags : FirstBagFrom(c, c.num_ids * (task_id + 1) / num_task);
+  if (bag_begin < bag_end) {
+    int64_t first = c.offsets[bag_begin];
+    int64_t last  = std::min<int64_t>(c.num_ids, first + kBagPrefetchDistance);
+    for (int64_t i = first; i < last; ++i) PrefetchRow(c, i);
+  }
+  for (int64_t bag = bag_begin; bag < bag_end; ++bag) {
+    ReduceBag(c, bag);
+  }
+  return 0;
+}
+
+template <typename T>
+void EmbeddingBag(const cinn_buffer_t* table,
+                  const cinn_buffer_t* ids,
+                  const cinn_buffer_t* offsets,
+                  const cinn_buffer_t* weights,
+                  int num_rows,
+                  int dim,
+                  int num_ids,
+                  int num_bags,
+                  int mode,
+                  int64_t padding_idx,
+                  cinn_buffer_t* out) {
+  CHECK(mode == kBagSum || mode == kBagMean || mode == kBagMax) << "Unknown embedding_bag mode " << mode;
+  CHECK(!weights || mode == kBagSum) << "The per sample weights of embedding_bag only support the sum mode";
+  EmbeddingBagClosure<T> closure{reinterpret_cast<const T*>(table->memory),
+                                 reinterpret_cast<const int64_t*>(ids->memory),
+                                 reinterpret_cast<const int64_t*>(offsets->memory),
+                                 weights ? reinterpret_cast<const T*>(weights->memory) : nullptr,
+                                 reinterpret_cast<T*>(out->memory),
+                                 num_rows,
+                                 dim,
+                                 num_ids,
+                                 num_bags,
+                                 mode,
+                                 padding_idx};
+  for (int64_t b = 0; b < num_bags; ++b) {
+    int64_t end = b + 1 < num_bags ? closure.offsets[b + 1] : num_ids;
+    CHECK(closure.offsets[b] >= 0 && closure.offsets[b] <= end)
+        << "The offsets of embedding_bag should be ascending and within the " << num_ids << " ids";
+  }
+
+  int64_t num_tasks = std::min<int64_t>(num_bags, max_concurrency());
+  if (num_tasks > 1 && static_cast<int64_t>(num_ids) * dim >= kParallelMinElements) {
+    cinn_backend_parallel_launch(&EmbeddingBagTask<T>, &closure, static_cast<int>(num_tasks));
+  } else if (num_bags > 0) {
+    EmbeddingBagTask<T>(0, 1, &closure);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_EMBEDDING_BAG(TYPE_SUFFIX, TYPE)                                                              \
+  void cinn_host_embedding_bag_##TYPE_SUFFIX(const cinn_buffer_t* table,                                        \
+                                             const cinn_buffer_t* ids,                                          \
+                                             const cinn_buffer_t* offsets,                                      \
+                                             int num_rows,                                                      \
+                                             int dim,                                                           \
+                                             int num_ids,                                                       \
+                                             int num_bags,                                                      \
+                                             int mode,                                                          \
+                                             int64_t padding_idx,                                               \
+                                             cinn_buffer_t* out) {                                              \
+    EmbeddingBag<TYPE>(table, ids, offsets, nullptr, num_rows, dim, num_ids, num_bags, mode, padding_idx, out); \
+  }
+
+CINN_HOST_EMBEDDING_BAG(fp32, float)
+CINN_HOST_EMBEDDING_BAG(fp64, double)
+
+#undef CINN_HOST_EMBEDDING_BAG
+
+#define CINN_HOST_WEIGHTED_EMBEDDING_BAG(TYPE_SUFFIX, TYPE)                                                  \
+  void cinn_host_weighted_embedding_bag_##TYPE_SUFFIX(const cinn_buffer_t* table,                            \
+                                                      const cinn_buffer_t* ids,                              \
+                                                      const cinn_buffer_t* offsets,                          \
+                                                      const cinn_buffer_t* weights,                          \
+                                                      int num_rows,                                          \
+                                                      int dim,                                               \
+                                                      int num_ids,                                           \
+                                                      int num_bags,                                          \
+                                                      int64_t padding_idx,                                   \
+                                                      cinn_buffer_t* out) {                                  \
+    EmbeddingBag<TYPE>(table, ids, offsets, weights, num_rows, dim, num_ids, num_bags, 0, padding_idx, out); \
+  }
+
+CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp32, float)
+CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp64, double)
+
+#undef CINN_HOST_WEIGHTED_EMBEDDING_BAG
+}
+
+CINN_REGISTER_HELPER(host_embedding_bag) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  // out is [num_bags, dim]
+  auto inference_shape_embedding_bag = [](int num_args, int dim_arg) -> FunctionProto::shape_inference_t {
+    return [=](const std::vector<Expr>& args, int offset) {
+      CHECK_EQ(args.size(), num_args) << "Wrong number of arguments passed in";
+      return std::vector<Expr>{args[dim_arg + 2], args[dim_arg]};
+    };
+  };
+
+#define _REGISTER_CINN_HOST_EMBEDDING_BAG(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_embedding_bag_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                         \
+      .AddInputType<cinn_buffer_t*>()                                             \
+      .AddInputType<cinn_buffer_t*>()                                             \
+      .AddInputType<cinn_buffer_t*>()                                             \
+      .AddInputType<int>()                                                        \
+      .AddInputType<int>()                                                        \
+      .AddInputType<int>()                                                        \
+      .AddInputType<int>()                                                        \
+      .AddInputType<int>()                                                        \
+      .AddInputType<int64_t>()                                                    \
+      .AddOutputType<cinn_buffer_t*>()                                            \
+      .SetShapeInference(inference_shape_embedding_bag(9, 4))                     \
+      .End();
+
+  _REGISTER_CINN_HOST_EMBEDDING_BAG(fp32);
+  _REGISTER_CINN_HOST_EMBEDDING_BAG(fp64);
+
+#undef _REGISTER_CINN_HOST_EMBEDDING_BAG
+
+#define _REGISTER_CINN_HOST_WEIGHTED_EMBEDDING_BAG(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_weighted_embedding_bag_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                                  \
+      .AddInputType<cinn_buffer_t*>()                                                      \
+      .AddInputType<cinn_buffer_t*>()                                                      \
+      .AddInputType<cinn_buffer_t*>()                                                      \
+      .AddInputType<cinn_buffer_t*>()                                                      \
+      .AddInputType<int>()                                                                 \
+      .AddInputType<int>()                                                                 \
+      .AddInputType<int>()                                                                 \
+      .AddInputType<int>()                                                                 \
+      .AddInputType<int64_t>()                                                             \
+      .AddOutputType<cinn_buffer_t*>()                                                     \
+      .SetShapeInference(inference_shape_embedding_bag(9, 5))                              \
+      .End();
+
+  _REGISTER_CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp32);
+  _REGISTER_CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp64);
+
+#undef _REGISTER_CINN_HOST_WEIGHTED_EMBEDDING_BAG
+
+  return true;
+}
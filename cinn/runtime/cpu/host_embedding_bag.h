@@ -0,0 +1,63 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the fused embedding bag functions in host device.
+ */
+#include <stdint.h>
+
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! Gather the rows of `table` of [num_rows, dim] selected by the int64 `ids`, and reduce every bag of them into one
+//! row of `out` of [num_bags, dim] without materializing the gathered rows. The bag b holds the ids from offsets[b]
+//! to offsets[b + 1], or to num_ids for the last bag. `mode` is 0 for sum, 1 for mean and 2 for max. Like
+//! lookup_table, the id `padding_idx` gathers a row of zeros, which still counts for the mean. An empty bag is zero.
+#define CINN_HOST_EMBEDDING_BAG(TYPE_SUFFIX)                               \
+  void cinn_host_embedding_bag_##TYPE_SUFFIX(const cinn_buffer_t* table,   \
+                                             const cinn_buffer_t* ids,     \
+                                             const cinn_buffer_t* offsets, \
+                                             int num_rows,                 \
+                                             int dim,                      \
+                                             int num_ids,                  \
+                                             int num_bags,                 \
+                                             int mode,                     \
+                                             int64_t padding_idx,          \
+                                             cinn_buffer_t* out);
+
+CINN_HOST_EMBEDDING_BAG(fp32)
+CINN_HOST_EMBEDDING_BAG(fp64)
+
+#undef CINN_HOST_EMBEDDING_BAG
+
+//! The embedding bag summing the rows scaled by the per sample `weights`, which hold num_ids elements.
+#define CINN_HOST_WEIGHTED_EMBEDDING_BAG(TYPE_SUFFIX)                               \
+  void cinn_host_weighted_embedding_bag_##TYPE_SUFFIX(const cinn_buffer_t* table,   \
+                                                      const cinn_buffer_t* ids,     \
+                                                      const cinn_buffer_t* offsets, \
+                                                      const cinn_buffer_t* weights, \
+                                                      int num_rows,                 \
+                                                      int dim,                      \
+                                                      int num_ids,                  \
+                                                      int num_bags,                 \
+                                                      int64_t padding_idx,          \
+                                                      cinn_buffer_t* out);
+
+CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp32)
+CINN_HOST_WEIGHTED_EMBEDDING_BAG(fp64)
+
+#undef CINN_HOST_WEIGHTED_EMBEDDING_BAG
+}
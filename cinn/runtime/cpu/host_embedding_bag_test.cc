@@ -0,0 +1,91 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_embedding_bag.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(cinn_host_embedding_bag, reduce_bags) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  int rows = 1000, dim = 33, bags = 64, padding_idx = 7;
+  std::vector<float> table(rows * dim);
+  for (auto& v : table) v = dist(rng);
+  // bags of random lengths, including an empty bag and a long bag to unbalance the tasks
+  std::vector<int64_t> ids, offsets;
+  for (int b = 0; b < bags; ++b) {
+    offsets.push_back(ids.size());
+    int len = b == 3 ? 0 : (b == 10 ? 3000 : rng() % 8);
+    for (int i = 0; i < len; ++i) {
+      ids.push_back(rng() % 5 == 0 ? padding_idx : rng() % rows);
+    }
+  }
+  std::vector<float> weights(ids.size());
+  for (auto& v : weights) v = dist(rng);
+  int num_ids = ids.size();
+
+  auto* table_buf   = common::BufferBuilder(Float(32), {rows, dim}).Build();
+  auto* ids_buf     = common::BufferBuilder(Int(64), {num_ids}).Build();
+  auto* offsets_buf = common::BufferBuilder(Int(64), {bags}).Build();
+  auto* weights_buf = common::BufferBuilder(Float(32), {num_ids}).Build();
+  std::copy(table.begin(), table.end(), reinterpret_cast<float*>(table_buf->memory));
+  std::copy(ids.begin(), ids.end(), reinterpret_cast<int64_t*>(ids_buf->memory));
+  std::copy(offsets.begin(), offsets.end(), reinterpret_cast<int64_t*>(offsets_buf->memory));
+  std::copy(weights.begin(), weights.end(), reinterpret_cast<float*>(weights_buf->memory));
+
+  // sum, mean, max and the weighted sum
+  for (int mode : {0, 1, 2, 3}) {
+    auto* out_buf = common::BufferBuilder(Float(32), {bags, dim}).set_random().Build();
+    if (mode == 3) {
+      cinn_host_weighted_embedding_bag_fp32(
+          table_buf, ids_buf, offsets_buf, weights_buf, rows, dim, num_ids, bags, padding_idx, out_buf);
+    } else {
+      cinn_host_embedding_bag_fp32(
+          table_buf, ids_buf, offsets_buf, rows, dim, num_ids, bags, mode, padding_idx, out_buf);
+    }
+    auto* out = reinterpret_cast<float*>(out_buf->memory);
+    for (int b = 0; b < bags; ++b) {
+      int begin = offsets[b], end = b + 1 < bags ? offsets[b + 1] : num_ids;
+      for (int d = 0; d < dim; ++d) {
+        // the padding id gathers zeros, like lookup_table
+        double expect = mode == 2 && end > begin ? -1e30 : 0;
+        for (int i = begin; i < end; ++i) {
+          double v = ids[i] == padding_idx ? 0 : table[ids[i] * dim + d];
+          if (mode == 2) {
+            expect = std::max(expect, v);
+          } else {
+            expect += mode == 3 ? v * weights[i] : v;
+          }
+        }
+        if (mode == 1 && end > begin) expect /= end - begin;
+        ASSERT_NEAR(out[b * dim + d], expect, 1e-4) << "mode: " << mode << ", bag: " << b << ", dim: " << d;
+      }
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,175 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_microkernel.h"
+
+#include <cstdint>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+
+namespace {
+
+// The accumulators of a row of the GEMM tile are kept in the vectors of kGemmLanes floats.
+#if defined(__AVX512F__)
+constexpr int kGemmLanes = 16;
+#else
+constexpr int kGemmLanes = 8;
+#endif
+constexpr int kGemmTileM = 8;
+constexpr int kGemmTileN = 16;
+constexpr int kGemmVecs  = kGemmTileN / kGemmLanes;
+
+typedef float GemmVec __attribute__((vector_size(kGemmLanes * sizeof(float))));
+// the tiles are only aligned to their elements
+typedef float UnalignedGemmVec __attribute__((vector_size(kGemmLanes * sizeof(float)), aligned(sizeof(float))));
+
+// The reductions are accumulated in independent lanes, so the compiler can keep them in one SIMD register, and the
+// lanes are merged at the end.
+constexpr int kReduceLanes = 16;
+
+}  // namespace
+
+void cinn_host_gemm_8x16_fp32(const cinn_buffer_t* A,
+                              int a_offset,
+                              int lda,
+                              const cinn_buffer_t* B,
+                              int b_offset,
+                              int ldb,
+                              int k,
+                              cinn_buffer_t* C,
+                              int c_offset,
+                              int ldc) {
+  const float* a = reinterpret_cast<const float*>(A->memory) + a_offset;
+  const float* b = reinterpret_cast<const float*>(B->memory) + b_offset;
+  float* c       = reinterpret_cast<float*>(C->memory) + c_offset;
+
+  // The whole tile of C stays in the registers over k, every step is a rank-1 update by a column of A and a row of B.
+  GemmVec acc[kGemmTileM][kGemmVecs];
+  for (int i = 0; i < kGemmTileM; ++i) {
+    for (int v = 0; v < kGemmVecs; ++v) {
+      acc[i][v] = *reinterpret_cast<const UnalignedGemmVec*>(c + static_cast<int64_t>(i) * ldc + v * kGemmLanes);
+    }
+  }
+  for (int p = 0; p < k; ++p) {
+    const float* b_row = b + static_cast<int64_t>(p) * ldb;
+    GemmVec bv[kGemmVecs];
+    for (int v = 0; v < kGemmVecs; ++v) {
+      bv[v] = *reinterpret_cast<const UnalignedGemmVec*>(b_row + v * kGemmLanes);
+    }
+    for (int i = 0; i < kGemmTileM; ++i) {
+      float x = a[static_cast<int64_t>(i) * lda + p];
+      for (int v = 0; v < kGemmVecs; ++v) acc[i][v] += bv[v] * x;
+    }
+  }
+  for (int i = 0; i < kGemmTileM; ++i) {
+    for (int v = 0; v < kGemmVecs; ++v) {
+      *reinterpret_cast<UnalignedGemmVec*>(c + static_cast<int64_t>(i) * ldc + v * kGemmLanes) = acc[i][v];
+    }
+  }
+}
+
+void cinn_host_dot_int8(const cinn_buffer_t* a,
+                        int a_offset,
+                        const cinn_buffer_t* b,
+                        int b_offset,
+                        int n,
+                        cinn_buffer_t* c,
+                        int c_offset) {
+  const int8_t* x = reinterpret_cast<const int8_t*>(a->memory) + a_offset;
+  const int8_t* y = reinterpret_cast<const int8_t*>(b->memory) + b_offset;
+
+  // the products of int8 are widened to int32 lanes, which the compiler lowers to SIMD multiply-adds
+  int32_t lane_sum[kReduceLanes] = {0};
+  int steps                      = n / kReduceLanes;
+  for (int s = 0; s < steps; ++s) {
+    const int8_t* px = x + s * kReduceLanes;
+    const int8_t* py = y + s * kReduceLanes;
+    for (int l = 0; l < kReduceLanes; ++l) {
+      lane_sum[l] += static_cast<int32_t>(px[l]) * static_cast<int32_t>(py[l]);
+    }
+  }
+  int32_t sum = 0;
+  for (int l = 0; l < kReduceLanes; ++l) {
+    sum += lane_sum[l];
+  }
+  for (int i = steps * kReduceLanes; i < n; ++i) {
+    sum += static_cast<int32_t>(x[i]) * static_cast<int32_t>(y[i]);
+  }
+  reinterpret_cast<int32_t*>(c->memory)[c_offset] += sum;
+}
+
+void cinn_host_reduce_sum_fp32(const cinn_buffer_t* a, int a_offset, int n, cinn_buffer_t* c, int c_offset) {
+  const float* x = reinterpret_cast<const float*>(a->memory) + a_offset;
+
+  float lane_sum[kReduceLanes] = {0};
+  int steps                    = n / kReduceLanes;
+  for (int s = 0; s < steps; ++s) {
+    const float* p = x + s * kReduceLanes;
+    for (int l = 0; l < kReduceLanes; ++l) {
+      lane_sum[l] += p[l];
+    }
+  }
+  float sum = 0;
+  for (int l = 0; l < kReduceLanes; ++l) {
+    sum += lane_sum[l];
+  }
+  for (int i = steps * kReduceLanes; i < n; ++i) {
+    sum += x[i];
+  }
+  reinterpret_cast<float*>(c->memory)[c_offset] += sum;
+}
+
+CINN_REGISTER_HELPER(host_microkernel) {
+  using namespace cinn;  // NOLINT
+  auto host_target = common::DefaultHostTarget();
+
+  // The outputs are accumulated in place, so they are passed as the inputs of the functions without results.
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_gemm_8x16_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<cinn_buffer_t*>()  // A
+      .AddInputType<int>()             // a_offset
+      .AddInputType<int>()             // lda
+      .AddInputType<cinn_buffer_t*>()  // B
+      .AddInputType<int>()             // b_offset
+      .AddInputType<int>()             // ldb
+      .AddInputType<int>()             // k
+      .AddInputType<cinn_buffer_t*>()  // C
+      .AddInputType<int>()             // c_offset
+      .AddInputType<int>()             // ldc
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_dot_int8, host_target)
+      .SetRetType<void>()
+      .AddInputType<cinn_buffer_t*>()  // a
+      .AddInputType<int>()             // a_offset
+      .AddInputType<cinn_buffer_t*>()  // b
+      .AddInputType<int>()             // b_offset
+      .AddInputType<int>()             // n
+      .AddInputType<cinn_buffer_t*>()  // c
+      .AddInputType<int>()             // c_offset
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_reduce_sum_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<cinn_buffer_t*>()  // a
+      .AddInputType<int>()             // a_offset
+      .AddInputType<int>()             // n
+      .AddInputType<cinn_buffer_t*>()  // c
+      .AddInputType<int>()             // c_offset
+      .End();
+
+  return true;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the microkernels the loop nests tensorized by IRSchedule are replaced with in host device.
+ * Every operand is a buffer with the offset of the first element of the tile accessed, so the microkernels work on the
+ * tiles at any position of the buffers. The results are accumulated into the output.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! C[8, 16] += A[8, k] * B[k, 16] on float, the rows of the tiles of A, B and C are `lda`, `ldb` and `ldc` elements
+//! apart, and the columns of every tile are contiguous.
+void cinn_host_gemm_8x16_fp32(const cinn_buffer_t* A,
+                              int a_offset,
+                              int lda,
+                              const cinn_buffer_t* B,
+                              int b_offset,
+                              int ldb,
+                              int k,
+                              cinn_buffer_t* C,
+                              int c_offset,
+                              int ldc);
+
+//! c[0] += sum(a[i] * b[i]) of `n` contiguous int8 elements, accumulated in int32.
+void cinn_host_dot_int8(const cinn_buffer_t* a,
+                        int a_offset,
+                        const cinn_buffer_t* b,
+                        int b_offset,
+                        int n,
+                        cinn_buffer_t* c,
+                        int c_offset);
+
+//! c[0] += sum(a[i]) of `n` contiguous float elements.
+void cinn_host_reduce_sum_fp32(const cinn_buffer_t* a, int a_offset, int n, cinn_buffer_t* c, int c_offset);
+}
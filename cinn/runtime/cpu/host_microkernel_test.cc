@@ -0,0 +1,86 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_microkernel.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(cinn_host_gemm_8x16_fp32, tiles) {
+  // every 8x16 tile of C = A * B is computed by the microkernel from the offsets of the tiles
+  int M = 24, N = 48, K = 37;
+  auto* a_buf = common::BufferBuilder(Float(32), {M, K}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Float(32), {K, N}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Float(32), {M, N}).set_val(1.f).Build();
+  for (int i = 0; i < M; i += 8) {
+    for (int j = 0; j < N; j += 16) {
+      cinn_host_gemm_8x16_fp32(a_buf, i * K, K, b_buf, j, N, K, c_buf, i * N + j, N);
+    }
+  }
+
+  auto* a = reinterpret_cast<float*>(a_buf->memory);
+  auto* b = reinterpret_cast<float*>(b_buf->memory);
+  auto* c = reinterpret_cast<float*>(c_buf->memory);
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      float expect = 1.f;
+      for (int p = 0; p < K; ++p) expect += a[i * K + p] * b[p * N + j];
+      ASSERT_NEAR(c[i * N + j], expect, 1e-4) << "i: " << i << ", j: " << j;
+    }
+  }
+}
+
+TEST(cinn_host_dot_int8, basic) {
+  // the lengths with and without the tail of the lanes
+  for (int n : {5, 16, 90}) {
+    auto* a_buf = common::BufferBuilder(Int(8), {100}).set_random().Build();
+    auto* b_buf = common::BufferBuilder(Int(8), {100}).set_random().Build();
+    auto* c_buf = common::BufferBuilder(Int(32), {2}).set_zero().Build();
+    auto* a     = reinterpret_cast<int8_t*>(a_buf->memory);
+    auto* b     = reinterpret_cast<int8_t*>(b_buf->memory);
+    auto* c     = reinterpret_cast<int32_t*>(c_buf->memory);
+    c[1]        = 7;
+    cinn_host_dot_int8(a_buf, 3, b_buf, 1, n, c_buf, 1);
+
+    int32_t expect = 7;
+    for (int i = 0; i < n; ++i) expect += static_cast<int32_t>(a[i + 3]) * static_cast<int32_t>(b[i + 1]);
+    ASSERT_EQ(c[1], expect) << "n: " << n;
+    ASSERT_EQ(c[0], 0);
+  }
+}
+
+TEST(cinn_host_reduce_sum_fp32, basic) {
+  for (int n : {5, 16, 90}) {
+    auto* a_buf = common::BufferBuilder(Float(32), {100}).set_random().Build();
+    auto* c_buf = common::BufferBuilder(Float(32), {1}).set_val(0.5f).Build();
+    auto* a     = reinterpret_cast<float*>(a_buf->memory);
+    cinn_host_reduce_sum_fp32(a_buf, 2, n, c_buf, 0);
+
+    float expect = 0.5f;
+    for (int i = 0; i < n; ++i) expect += a[i + 2];
+    ASSERT_NEAR(reinterpret_cast<float*>(c_buf->memory)[0], expect, 1e-4) << "n: " << n;
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,292 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_norm.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+// The row is accumulated in independent lanes, so the compiler can keep them in
+// one SIMD register, and the lanes are merged at the end of the row.
+constexpr int kNormLanes = 8;
+// Normalize rows in parallel only when there are enough elements to amortize the launch.
+constexpr int64_t kParallelMinElements = 1 << 15;
+
+// Mean and sum of squared differences of `count` elements.
+template <typename T>
+struct WelfordStat {
+  T mean{0};
+  T m2{0};
+  int64_t count{0};
+
+  // Chan's formula to merge the statistics of two disjoint sets.
+  void Merge(T other_mean, T other_m2, int64_t other_count) {
+    if (other_count == 0) return;
+    int64_t total = count + other_count;
+    T delta       = other_mean - mean;
+    T ratio       = static_cast<T>(other_count) / static_cast<T>(total);
+    mean += delta * ratio;
+    m2 += other_m2 + delta * delta * static_cast<T>(count) * ratio;
+    count = total;
+  }
+};
+
+template <typename T>
+WelfordStat<T> RowWelford(const T* x, int64_t cols) {
+  T lane_mean[kNormLanes] = {0};
+  T lane_m2[kNormLanes]   = {0};
+  int64_t steps           = cols / kNormLanes;
+  for (int64_t s = 0; s < steps; ++s) {
+    // every lane has seen the same number of elements, so the division is shared
+    T inv_count = T(1) / static_cast<T>(s + 1);
+    const T* p  = x + s * kNormLanes;
+    for (int l = 0; l < kNormLanes; ++l) {
+      T delta = p[l] - lane_mean[l];
+      lane_mean[l] += delta * inv_count;
+      lane_m2[l] += delta * (p[l] - lane_mean[l]);
+    }
+  }
+
+  WelfordStat<T> stat;
+  for (int l = 0; l < kNormLanes; ++l) {
+    stat.Merge(lane_mean[l], lane_m2[l], steps);
+  }
+  for (int64_t j = steps * kNormLanes; j < cols; ++j) {
+    stat.Merge(x[j], T(0), 1);
+  }
+  return stat;
+}
+
+template <typename T>
+T RowSumOfSquares(const T* x, int64_t cols) {
+  T lane_sum[kNormLanes] = {0};
+  int64_t steps          = cols / kNormLanes;
+  for (int64_t s = 0; s < steps; ++s) {
+    const T* p = x + s * kNormLanes;
+    for (int l = 0; l < kNormLanes; ++l) {
+      lane_sum[l] += p[l] * p[l];
+    }
+  }
+  T sum = 0;
+  for (int l = 0; l < kNormLanes; ++l) {
+    sum += lane_sum[l];
+  }
+  for (int64_t j = steps * kNormLanes; j < cols; ++j) {
+    sum += x[j] * x[j];
+  }
+  return sum;
+}
+
+template <typename T>
+struct NormClosure {
+  const T* x;
+  const T* scale;
+  const T* bias;
+  T* y;
+  T* mean;
+  T* variance;
+  int64_t rows;
+  int64_t cols;
+  T epsilon;
+};
+
+template <typename T>
+int LayerNormRows(int task_id, int num_task, void* datas) {
+  auto* closure = static_cast<NormClosure<T>*>(datas);
+  int64_t cols  = closure->cols;
+  int64_t begin = closure->rows * task_id / num_task;
+  int64_t end   = closure->rows * (task_id + 1) / num_task;
+  for (int64_t r = begin; r < end; ++r) {
+    const T* x = closure->x + r * cols;
+    T* y       = closure->y + r * cols;
+    auto stat  = RowWelford(x, cols);
+    T variance = stat.m2 / static_cast<T>(cols);
+    T rstd     = T(1) / std::sqrt(variance + closure->epsilon);
+    for (int64_t j = 0; j < cols; ++j) {
+      y[j] = (x[j] - stat.mean) * rstd * closure->scale[j] + closure->bias[j];
+    }
+    closure->mean[r]     = stat.mean;
+    closure->variance[r] = variance;
+  }
+  return 0;
+}
+
+template <typename T>
+int RMSNormRows(int task_id, int num_task, void* datas) {
+  auto* closure = static_cast<NormClosure<T>*>(datas);
+  int64_t cols  = closure->cols;
+  int64_t begin = closure->rows * task_id / num_task;
+  int64_t end   = closure->rows * (task_id + 1) / num_task;
+  for (int64_t r = begin; r < end; ++r) {
+    const T* x = closure->x + r * cols;
+    T* y       = closure->y + r * cols;
+    T rstd     = T(1) / std::sqrt(RowSumOfSquares(x, cols) / static_cast<T>(cols) + closure->epsilon);
+    for (int64_t j = 0; j < cols; ++j) {
+      y[j] = x[j] * rstd * closure->scale[j];
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+void LaunchNormRows(FCINNParallelLambda flambda, NormClosure<T>* closure) {
+  int64_t num_tasks = std::min<int64_t>(closure->rows, max_concurrency());
+  if (num_tasks > 1 && closure->rows * closure->cols >= kParallelMinElements) {
+    cinn_backend_parallel_launch(flambda, closure, static_cast<int>(num_tasks));
+  } else {
+    flambda(0, 1, closure);
+  }
+}
+
+template <typename T>
+void LayerNorm(const cinn_buffer_t* x,
+               const cinn_buffer_t* scale,
+               const cinn_buffer_t* bias,
+               int rows,
+               int cols,
+               float epsilon,
+               cinn_buffer_t* y,
+               cinn_buffer_t* mean,
+               cinn_buffer_t* variance) {
+  CHECK_GT(cols, 0) << "The normalized size of layer_norm should be positive";
+  NormClosure<T> closure{reinterpret_cast<const T*>(x->memory),
+                         reinterpret_cast<const T*>(scale->memory),
+                         reinterpret_cast<const T*>(bias->memory),
+                         reinterpret_cast<T*>(y->memory),
+                         reinterpret_cast<T*>(mean->memory),
+                         reinterpret_cast<T*>(variance->memory),
+                         rows,
+                         cols,
+                         static_cast<T>(epsilon)};
+  LaunchNormRows(&LayerNormRows<T>, &closure);
+}
+
+template <typename T>
+void RMSNorm(const cinn_buffer_t* x, const cinn_buffer_t* scale, int rows, int cols, float epsilon, cinn_buffer_t* y) {
+  CHECK_GT(cols, 0) << "The normalized size of rms_norm should be positive";
+  NormClosure<T> closure{reinterpret_cast<const T*>(x->memory),
+                         reinterpret_cast<const T*>(scale->memory),
+                         nullptr,
+                         reinterpret_cast<T*>(y->memory),
+                         nullptr,
+                         nullptr,
+                         rows,
+                         cols,
+                         static_cast<T>(epsilon)};
+  LaunchNormRows(&RMSNormRows<T>, &closure);
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_LAYER_NORM(TYPE_SUFFIX, TYPE)                              \
+  void cinn_host_layer_norm_##TYPE_SUFFIX(const cinn_buffer_t* x,            \
+                                          const cinn_buffer_t* scale,        \
+                                          const cinn_buffer_t* bias,         \
+                                          int rows,                          \
+                                          int cols,                          \
+                                          float epsilon,                     \
+                                          cinn_buffer_t* y,                  \
+                                          cinn_buffer_t* mean,               \
+                                          cinn_buffer_t* variance) {         \
+    LayerNorm<TYPE>(x, scale, bias, rows, cols, epsilon, y, mean, variance); \
+  }
+
+CINN_HOST_LAYER_NORM(fp32, float)
+CINN_HOST_LAYER_NORM(fp64, double)
+
+#undef CINN_HOST_LAYER_NORM
+
+#define CINN_HOST_RMS_NORM(TYPE_SUFFIX, TYPE)                       \
+  void cinn_host_rms_norm_##TYPE_SUFFIX(const cinn_buffer_t* x,     \
+                                        const cinn_buffer_t* scale, \
+                                        int rows,                   \
+                                        int cols,                   \
+                                        float epsilon,              \
+                                        cinn_buffer_t* y) {         \
+    RMSNorm<TYPE>(x, scale, rows, cols, epsilon, y);                \
+  }
+
+CINN_HOST_RMS_NORM(fp32, float)
+CINN_HOST_RMS_NORM(fp64, double)
+
+#undef CINN_HOST_RMS_NORM
+}
+
+CINN_REGISTER_HELPER(host_norm) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  // y follows x, mean and variance have one element per row
+  FunctionProto::shape_inference_t inference_shape_layer_norm = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(args.size(), 6UL) << "Wrong number of arguments passed in";
+    if (offset == 0) {
+      auto* x = args[0].as_tensor();
+      CHECK(x);
+      return x->shape;
+    }
+    return std::vector<Expr>{args[3]};
+  };
+
+#define _REGISTER_CINN_HOST_LAYER_NORM(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_layer_norm_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                      \
+      .AddInputType<cinn_buffer_t*>()                                          \
+      .AddInputType<cinn_buffer_t*>()                                          \
+      .AddInputType<cinn_buffer_t*>()                                          \
+      .AddInputType<int>()                                                     \
+      .AddInputType<int>()                                                     \
+      .AddInputType<float>()                                                   \
+      .AddOutputType<cinn_buffer_t*>()                                         \
+      .AddOutputType<cinn_buffer_t*>()                                         \
+      .AddOutputType<cinn_buffer_t*>()                                         \
+      .SetShapeInference(inference_shape_layer_norm)                           \
+      .End();
+
+  _REGISTER_CINN_HOST_LAYER_NORM(fp32);
+  _REGISTER_CINN_HOST_LAYER_NORM(fp64);
+
+#undef _REGISTER_CINN_HOST_LAYER_NORM
+
+#define _REGISTER_CINN_HOST_RMS_NORM(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_rms_norm_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                    \
+      .AddInputType<cinn_buffer_t*>()                                        \
+      .AddInputType<cinn_buffer_t*>()                                        \
+      .AddInputType<int>()                                                   \
+      .AddInputType<int>()                                                   \
+      .AddInputType<float>()                                                 \
+      .AddOutputType<cinn_buffer_t*>()                                       \
+      .SetShapeInference(FunctionProto::ShapeFollowNthArgument(0))           \
+      .End();
+
+  _REGISTER_CINN_HOST_RMS_NORM(fp32);
+  _REGISTER_CINN_HOST_RMS_NORM(fp64);
+
+#undef _REGISTER_CINN_HOST_RMS_NORM
+
+  return true;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the normalization functions in host device.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! Layer normalization of `x` viewed as [rows, cols], every row is normalized independently:
+//!   y = (x - mean) / sqrt(variance + epsilon) * scale + bias
+//! `scale` and `bias` hold `cols` elements, `mean` and `variance` hold `rows` elements.
+//! The statistics are computed with Welford's algorithm in a single read of the row.
+#define CINN_HOST_LAYER_NORM(TYPE_SUFFIX)                             \
+  void cinn_host_layer_norm_##TYPE_SUFFIX(const cinn_buffer_t* x,     \
+                                          const cinn_buffer_t* scale, \
+                                          const cinn_buffer_t* bias,  \
+                                          int rows,                   \
+                                          int cols,                   \
+                                          float epsilon,              \
+                                          cinn_buffer_t* y,           \
+                                          cinn_buffer_t* mean,        \
+                                          cinn_buffer_t* variance);
+
+CINN_HOST_LAYER_NORM(fp32)
+CINN_HOST_LAYER_NORM(fp64)
+
+#undef CINN_HOST_LAYER_NORM
+
+//! Root mean square normalization of `x` viewed as [rows, cols]:
+//!   y = x / sqrt(mean(x * x) + epsilon) * scale
+#define CINN_HOST_RMS_NORM(TYPE_SUFFIX)                             \
+  void cinn_host_rms_norm_##TYPE_SUFFIX(const cinn_buffer_t* x,     \
+                                        const cinn_buffer_t* scale, \
+                                        int rows,                   \
+                                        int cols,                   \
+                                        float epsilon,              \
+                                        cinn_buffer_t* y);
+
+CINN_HOST_RMS_NORM(fp32)
+CINN_HOST_RMS_NORM(fp64)
+
+#undef CINN_HOST_RMS_NORM
+}
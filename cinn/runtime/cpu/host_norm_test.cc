@@ -0,0 +1,99 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_norm.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(cinn_host_layer_norm, welford) {
+  std::mt19937 rng(0);
+  // a large mean with a small variance, where E[x^2] - E[x]^2 loses all the precision of float
+  std::normal_distribution<float> dist(1000.f, 1.f);
+  for (int cols : {1, 7, 8, 33, 768}) {
+    int rows = 16;
+    std::vector<float> x(rows * cols), scale(cols), bias(cols);
+    for (auto& v : x) v = dist(rng);
+    for (int j = 0; j < cols; ++j) {
+      scale[j] = 0.5f + j % 3;
+      bias[j]  = 0.25f * (j % 5);
+    }
+    auto* x_buf        = common::BufferBuilder(Float(32), {rows, cols}).Build();
+    auto* scale_buf    = common::BufferBuilder(Float(32), {cols}).Build();
+    auto* bias_buf     = common::BufferBuilder(Float(32), {cols}).Build();
+    auto* y_buf        = common::BufferBuilder(Float(32), {rows, cols}).set_zero().Build();
+    auto* mean_buf     = common::BufferBuilder(Float(32), {rows}).set_zero().Build();
+    auto* variance_buf = common::BufferBuilder(Float(32), {rows}).set_zero().Build();
+    std::copy(x.begin(), x.end(), reinterpret_cast<float*>(x_buf->memory));
+    std::copy(scale.begin(), scale.end(), reinterpret_cast<float*>(scale_buf->memory));
+    std::copy(bias.begin(), bias.end(), reinterpret_cast<float*>(bias_buf->memory));
+
+    cinn_host_layer_norm_fp32(x_buf, scale_buf, bias_buf, rows, cols, 1e-5f, y_buf, mean_buf, variance_buf);
+    auto* y        = reinterpret_cast<float*>(y_buf->memory);
+    auto* mean     = reinterpret_cast<float*>(mean_buf->memory);
+    auto* variance = reinterpret_cast<float*>(variance_buf->memory);
+    for (int r = 0; r < rows; ++r) {
+      double expect_mean = 0, expect_variance = 0;
+      for (int j = 0; j < cols; ++j) expect_mean += x[r * cols + j];
+      expect_mean /= cols;
+      for (int j = 0; j < cols; ++j) expect_variance += std::pow(x[r * cols + j] - expect_mean, 2);
+      expect_variance /= cols;
+      ASSERT_NEAR(mean[r], expect_mean, 1e-3);
+      ASSERT_NEAR(variance[r], expect_variance, 1e-3 * (expect_variance + 1e-3));
+      for (int j = 0; j < cols; ++j) {
+        double expect = (x[r * cols + j] - expect_mean) / std::sqrt(expect_variance + 1e-5) * scale[j] + bias[j];
+        ASSERT_NEAR(y[r * cols + j], expect, 2e-3) << "row:" << r << ", col:" << j << ", cols:" << cols;
+      }
+    }
+  }
+}
+
+TEST(cinn_host_rms_norm, basic) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> dist(-2.0, 2.0);
+  int rows = 5, cols = 45;
+  std::vector<double> x(rows * cols), scale(cols);
+  for (auto& v : x) v = dist(rng);
+  for (auto& v : scale) v = dist(rng);
+  auto* x_buf     = common::BufferBuilder(Float(64), {rows, cols}).Build();
+  auto* scale_buf = common::BufferBuilder(Float(64), {cols}).Build();
+  auto* y_buf     = common::BufferBuilder(Float(64), {rows, cols}).set_zero().Build();
+  std::copy(x.begin(), x.end(), reinterpret_cast<double*>(x_buf->memory));
+  std::copy(scale.begin(), scale.end(), reinterpret_cast<double*>(scale_buf->memory));
+
+  cinn_host_rms_norm_fp64(x_buf, scale_buf, rows, cols, 1e-6f, y_buf);
+  auto* y = reinterpret_cast<double*>(y_buf->memory);
+  for (int r = 0; r < rows; ++r) {
+    double sum = 0;
+    for (int j = 0; j < cols; ++j) sum += x[r * cols + j] * x[r * cols + j];
+    double rstd = 1.0 / std::sqrt(sum / cols + 1e-6f);
+    for (int j = 0; j < cols; ++j) {
+      ASSERT_NEAR(y[r * cols + j], x[r * cols + j] * rstd * scale[j], 1e-9);
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,234 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "cinn/runtime/cpu/host_scatter.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+enum ScatterMode { kScatterAssign = 0, kScatterAdd = 1, kScatterMax = 2 };
+
+// Scatter in parallel only when there are enough elements to amortize the launches.
+constexpr int64_t kParallelMinElements = 1 << 15;
+
+template <typename T>
+struct ScatterClosure {
+  const T* base;
+  const T* updates;
+  const int32_t* offsets;
+  T* out;
+  int64_t num_slices;
+  int64_t num_updates;
+  int64_t slice;
+  int mode;
+  int64_t num_tasks;
+  // counts[c * num_tasks + t] is the number of updates of the chunk c going to the slices of the task t.
+  std::vector<int64_t> counts;
+  // the updates grouped by the task owning their destination, in their original order within a group.
+  std::vector<int64_t> order;
+  std::vector<int64_t> group_begin;
+};
+
+// The task t owns the destination slices [num_slices * t / num_tasks, num_slices * (t + 1) / num_tasks).
+template <typename T>
+inline int64_t SliceBegin(const ScatterClosure<T>& c, int64_t task) {
+  return c.num_slices * task / c.num_tasks;
+}
+
+template <typename T>
+inline int64_t SliceOwner(const ScatterClosure<T>& c, int64_t dst) {
+  return ((dst + 1) * c.num_tasks - 1) / c.num_slices;
+}
+
+template <typename T>
+inline bool IsValidSlice(const ScatterClosure<T>& c, int64_t dst) {
+  return dst >= 0 && dst < c.num_slices;
+}
+
+template <typename T>
+inline void ApplyUpdate(const ScatterClosure<T>& c, int64_t u) {
+  const T* __restrict__ src = c.updates + u * c.slice;
+  T* __restrict__ dst       = c.out + static_cast<int64_t>(c.offsets[u]) * c.slice;
+  if (c.mode == kScatterAdd) {
+    for (int64_t i = 0; i < c.slice; ++i) dst[i] += src[i];
+  } else if (c.mode == kScatterMax) {
+    for (int64_t i = 0; i < c.slice; ++i) dst[i] = std::max(dst[i], src[i]);
+  } else {
+    std::memcpy(dst, src, c.slice * sizeof(T));
+  }
+}
+
+template <typename T>
+inline void CopySlices(const ScatterClosure<T>& c, int64_t begin, int64_t end) {
+  if (c.out != c.base && end > begin) {
+    std::memcpy(c.out + begin * c.slice, c.base + begin * c.slice, (end - begin) * c.slice * sizeof(T));
+  }
+}
+
+// The chunk c of the updates is [num_updates * c / num_tasks, num_updates * (c + 1) / num_tasks).
+template <typename T>
+int CountTask(int task_id, int num_task, void* datas) {
+  auto& c         = *static_cast<ScatterClosure<T>*>(datas);
+  int64_t* counts = c.counts.data() + task_id * c.num_tasks;
+  for (int64_t u = c.num_updates * task_id / num_task; u < c.num_updates * (task_id + 1) / num_task; ++u) {
+    if (IsValidSlice(c, c.offsets[u])) {
+      counts[SliceOwner(c, c.offsets[u])]++;
+    }
+  }
+  return 0;
+}
+
+// After the prefix sum, counts[c * num_tasks + t] is where the chunk c puts its first update of the task t.
+template <typename T>
+int GroupTask(int task_id, int num_task, void* datas) {
+  auto& c         = *static_cast<ScatterClosure<T>*>(datas);
+  int64_t* counts = c.counts.data() + task_id * c.num_tasks;
+  for (int64_t u = c.num_updates * task_id / num_task; u < c.num_updates * (task_id + 1) / num_task; ++u) {
+    if (IsValidSlice(c, c.offsets[u])) {
+      c.order[counts[SliceOwner(c, c.offsets[u])]++] = u;
+    }
+  }
+  return 0;
+}
+
+// Copy the own slices, then apply the updates to them in their original order.
+template <typename T>
+int ApplyTask(int task_id, int num_task, void* datas) {
+  auto& c = *static_cast<ScatterClosure<T>*>(datas);
+  CopySlices(c, SliceBegin(c, task_id), SliceBegin(c, task_id + 1));
+  for (int64_t i = c.group_begin[task_id]; i < c.group_begin[task_id + 1]; ++i) {
+    ApplyUpdate(c, c.order[i]);
+  }
+  return 0;
+}
+
+template <typename T>
+void Scatter(const cinn_buffer_t* base,
+             const cinn_buffer_t* updates,
+             const cinn_buffer_t* offsets,
+             int num_slices,
+             int num_updates,
+             int slice,
+             int mode,
+             cinn_buffer_t* out) {
+  CHECK(mode == kScatterAssign || mode == kScatterAdd || mode == kScatterMax) << "Unknown scatter mode " << mode;
+  ScatterClosure<T> closure;
+  closure.base        = reinterpret_cast<const T*>(base->memory);
+  closure.updates     = reinterpret_cast<const T*>(updates->memory);
+  closure.offsets     = reinterpret_cast<const int32_t*>(offsets->memory);
+  closure.out         = reinterpret_cast<T*>(out->memory);
+  closure.num_slices  = num_slices;
+  closure.num_updates = num_updates;
+  closure.slice       = slice;
+  closure.mode        = mode;
+  if (num_slices <= 0) {
+    return;
+  }
+
+  int64_t elements  = (static_cast<int64_t>(num_slices) + num_updates) * slice;
+  closure.num_tasks = elements >= kParallelMinElements ? std::min<int64_t>(num_slices, max_concurrency()) : 1;
+  if (closure.num_tasks <= 1) {
+    closure.num_tasks = 1;
+    CopySlices(closure, 0, num_slices);
+    for (int64_t u = 0; u < num_updates; ++u) {
+      if (IsValidSlice(closure, closure.offsets[u])) {
+        ApplyUpdate(closure, u);
+      }
+    }
+    return;
+  }
+
+  // group the updates by the task owning their destination with a stable counting sort, whose counting and
+  // placing are split among the tasks by the chunks of the updates.
+  int num_tasks = static_cast<int>(closure.num_tasks);
+  closure.counts.assign(closure.num_tasks * closure.num_tasks, 0);
+  cinn_backend_parallel_launch(&CountTask<T>, &closure, num_tasks);
+  closure.group_begin.resize(closure.num_tasks + 1);
+  int64_t position = 0;
+  for (int64_t t = 0; t < closure.num_tasks; ++t) {
+    closure.group_begin[t] = position;
+    for (int64_t chunk = 0; chunk < closure.num_tasks; ++chunk) {
+      int64_t count = closure.counts[chunk * closure.num_tasks + t];
+      closure.counts[chunk * closure.num_tasks + t] = position;
+      position += count;
+    }
+  }
+  closure.group_begin[closure.num_tasks] = position;
+  closure.order.resize(position);
+  cinn_backend_parallel_launch(&GroupTask<T>, &closure, num_tasks);
+  cinn_backend_parallel_launch(&ApplyTask<T>, &closure, num_tasks);
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_SCATTER(TYPE_SUFFIX, TYPE)                                          \
+  void cinn_host_scatter_##TYPE_SUFFIX(const cinn_buffer_t* base,                     \
+                                       const cinn_buffer_t* updates,                  \
+                                       const cinn_buffer_t* offsets,                  \
+                                       int num_slices,                                \
+                                       int num_updates,                               \
+                                       int slice,                                     \
+                                       int mode,                                      \
+                                       cinn_buffer_t* out) {                          \
+    Scatter<TYPE>(base, updates, offsets, num_slices, num_updates, slice, mode, out); \
+  }
+
+CINN_HOST_SCATTER(fp32, float)
+CINN_HOST_SCATTER(fp64, double)
+CINN_HOST_SCATTER(int32, int32_t)
+CINN_HOST_SCATTER(int64, int64_t)
+
+#undef CINN_HOST_SCATTER
+}
+
+CINN_REGISTER_HELPER(host_scatter) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+#define _REGISTER_CINN_HOST_SCATTER(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_scatter_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                   \
+      .AddInputType<cinn_buffer_t*>()                                       \
+      .AddInputType<cinn_buffer_t*>()                                       \
+      .AddInputType<cinn_buffer_t*>()                                       \
+      .AddInputType<int>()                                                  \
+      .AddInputType<int>()                                                  \
+      .AddInputType<int>()                                                  \
+      .AddInputType<int>()                                                  \
+      .AddOutputType<cinn_buffer_t*>()                                      \
+      .SetShapeInference(FunctionProto::ShapeFollowNthArgument(0))          \
+      .End();
+
+  _REGISTER_CINN_HOST_SCATTER(fp32);
+  _REGISTER_CINN_HOST_SCATTER(fp64);
+  _REGISTER_CINN_HOST_SCATTER(int32);
+  _REGISTER_CINN_HOST_SCATTER(int64);
+
+#undef _REGISTER_CINN_HOST_SCATTER
+
+  return true;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+/**
+ * \file This file implements the scatter functions in host device.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! Copy `base` of num_slices slices to `out`, then scatter the num_updates slices of `updates` into it, every slice
+//! holding `slice` contiguous elements. The slice u of updates goes to the slice offsets[u] of out, and is skipped if
+//! the offset is out of range. `mode` is 0 to assign, in which the last update of a slice wins, 1 to add and 2 to
+//! take the max. The work is O(num_slices + num_updates) and partitioned among the threads by the destination slice,
+//! so no two threads write the same slice and the result is the same for any number of threads.
+#define CINN_HOST_SCATTER(TYPE_SUFFIX)                               \
+  void cinn_host_scatter_##TYPE_SUFFIX(const cinn_buffer_t* base,    \
+                                       const cinn_buffer_t* updates, \
+                                       const cinn_buffer_t* offsets, \
+                                       int num_slices,               \
+                                       int num_updates,              \
+                                       int slice,                    \
+                                       int mode,                     \
+                                       cinn_buffer_t* out);
+
+CINN_HOST_SCATTER(fp32)
+CINN_HOST_SCATTER(fp64)
+CINN_HOST_SCATTER(int32)
+CINN_HOST_SCATTER(int64)
+
+#undef CINN_HOST_SCATTER
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "cinn/runtime/cpu/host_scatter.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(cinn_host_scatter, conflicting_updates) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  // large enough to take the parallel path, with a few hot slices updated many times
+  int num_slices = 3000, num_updates = 5000, slice = 17;
+  std::vector<float> base(num_slices * slice), updates(num_updates * slice);
+  for (auto& v : base) v = dist(rng);
+  for (auto& v : updates) v = dist(rng);
+  std::vector<int32_t> offsets(num_updates);
+  for (int u = 0; u < num_updates; ++u) {
+    // the out of range offsets are skipped
+    int r      = rng() % 10;
+    offsets[u] = r == 0 ? 5 : (r == 1 ? num_slices - 1 : (r == 2 ? (u % 2 ? -1 : num_slices) : rng() % num_slices));
+  }
+
+  auto* base_buf    = common::BufferBuilder(Float(32), {num_slices, slice}).Build();
+  auto* updates_buf = common::BufferBuilder(Float(32), {num_updates, slice}).Build();
+  auto* offsets_buf = common::BufferBuilder(Int(32), {num_updates}).Build();
+  std::copy(base.begin(), base.end(), reinterpret_cast<float*>(base_buf->memory));
+  std::copy(updates.begin(), updates.end(), reinterpret_cast<float*>(updates_buf->memory));
+  std::copy(offsets.begin(), offsets.end(), reinterpret_cast<int32_t*>(offsets_buf->memory));
+
+  // assign, add and max
+  for (int mode : {0, 1, 2}) {
+    std::vector<float> expect = base;
+    for (int u = 0; u < num_updates; ++u) {
+      if (offsets[u] < 0 || offsets[u] >= num_slices) continue;
+      for (int i = 0; i < slice; ++i) {
+        float& dst = expect[offsets[u] * slice + i];
+        float src  = updates[u * slice + i];
+        dst        = mode == 0 ? src : (mode == 1 ? dst + src : std::max(dst, src));
+      }
+    }
+    auto* out_buf = common::BufferBuilder(Float(32), {num_slices, slice}).set_random().Build();
+    cinn_host_scatter_fp32(base_buf, updates_buf, offsets_buf, num_slices, num_updates, slice, mode, out_buf);
+    auto* out = reinterpret_cast<float*>(out_buf->memory);
+    for (int i = 0; i < num_slices * slice; ++i) {
+      // the updates of a slice are applied in their order, so even the sums are exact
+      ASSERT_EQ(out[i], expect[i]) << "mode: " << mode << ", index: " << i;
+    }
+  }
+}
+
+TEST(cinn_host_scatter, small_in_place) {
+  // scatter into the base itself, on the sequential path
+  std::vector<int64_t> base = {1, 2, 3, 4}, updates = {10, 20, 30};
+  std::vector<int32_t> offsets = {2, 0, 2};
+  auto* base_buf               = common::BufferBuilder(Int(64), {4}).Build();
+  auto* updates_buf            = common::BufferBuilder(Int(64), {3}).Build();
+  auto* offsets_buf            = common::BufferBuilder(Int(32), {3}).Build();
+  std::copy(base.begin(), base.end(), reinterpret_cast<int64_t*>(base_buf->memory));
+  std::copy(updates.begin(), updates.end(), reinterpret_cast<int64_t*>(updates_buf->memory));
+  std::copy(offsets.begin(), offsets.end(), reinterpret_cast<int32_t*>(offsets_buf->memory));
+
+  cinn_host_scatter_int64(base_buf, updates_buf, offsets_buf, 4, 3, 1, 1, base_buf);
+  auto* out = reinterpret_cast<int64_t*>(base_buf->memory);
+  ASSERT_EQ(std::vector<int64_t>(out, out + 4), std::vector<int64_t>({21, 2, 43, 4}));
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,424 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_sort.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+// Rows not longer than it are sorted by insertion sort, longer ones by LSD radix sort,
+// which outperforms comparison sorts from dozens of elements on.
+constexpr int kInsertionSortMaxSize = 32;
+// Sort rows in parallel only when there are enough elements to amortize the launch.
+constexpr int64_t kParallelMinElements = 1 << 15;
+
+constexpr int kRadixBits    = 8;
+constexpr int kRadixBuckets = 1 << kRadixBits;
+
+template <typename T>
+struct RadixKey {
+  using type = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+};
+
+// Map a value to an unsigned key with the same order, so that all types can be
+// compared and radix sorted as unsigned integers. Descending order is ascending
+// order of the inverted keys, which keeps equal elements stable as well.
+template <typename T>
+inline typename RadixKey<T>::type ToRadixKey(T value, bool is_ascend) {
+  using KeyT              = typename RadixKey<T>::type;
+  constexpr KeyT kSignBit = KeyT(1) << (sizeof(KeyT) * 8 - 1);
+  KeyT key;
+  std::memcpy(&key, &value, sizeof(KeyT));
+  if (std::is_floating_point<T>::value) {
+    key = (key & kSignBit) ? ~key : (key | kSignBit);
+  } else {
+    key ^= kSignBit;
+  }
+  return is_ascend ? key : ~key;
+}
+
+template <typename KeyT>
+struct SortScratch {
+  std::vector<KeyT> keys;
+  std::vector<KeyT> keys_tmp;
+  std::vector<int32_t> indices;
+  std::vector<int32_t> indices_tmp;
+
+  void Resize(int size) {
+    keys.resize(size);
+    keys_tmp.resize(size);
+    indices.resize(size);
+    indices_tmp.resize(size);
+  }
+};
+
+template <typename KeyT>
+void InsertionSort(const KeyT* keys, int32_t* indices, int size) {
+  for (int i = 1; i < size; ++i) {
+    int32_t cur = indices[i];
+    KeyT key    = keys[cur];
+    int j       = i - 1;
+    // strict compare keeps equal elements in their original order
+    for (; j >= 0 && keys[indices[j]] > key; --j) {
+      indices[j + 1] = indices[j];
+    }
+    indices[j + 1] = cur;
+  }
+}
+
+// LSD radix sort of (key, index) pairs, stable in each pass. The sorted indices
+// are left in `scratch->indices`.
+template <typename KeyT>
+void RadixSort(SortScratch<KeyT>* scratch, int size) {
+  KeyT* keys       = scratch->keys.data();
+  KeyT* keys_tmp   = scratch->keys_tmp.data();
+  int32_t* idx     = scratch->indices.data();
+  int32_t* idx_tmp = scratch->indices_tmp.data();
+  int offsets[kRadixBuckets];
+  for (int shift = 0; shift < static_cast<int>(sizeof(KeyT) * 8); shift += kRadixBits) {
+    std::fill(offsets, offsets + kRadixBuckets, 0);
+    for (int i = 0; i < size; ++i) {
+      ++offsets[(keys[i] >> shift) & (kRadixBuckets - 1)];
+    }
+    // skip the pass if all keys share the same digit
+    if (offsets[(keys[0] >> shift) & (kRadixBuckets - 1)] == size) continue;
+    int sum = 0;
+    for (int b = 0; b < kRadixBuckets; ++b) {
+      int count  = offsets[b];
+      offsets[b] = sum;
+      sum += count;
+    }
+    for (int i = 0; i < size; ++i) {
+      int pos       = offsets[(keys[i] >> shift) & (kRadixBuckets - 1)]++;
+      keys_tmp[pos] = keys[i];
+      idx_tmp[pos]  = idx[i];
+    }
+    std::swap(keys, keys_tmp);
+    std::swap(idx, idx_tmp);
+  }
+  if (idx != scratch->indices.data()) {
+    std::copy(idx, idx + size, scratch->indices.data());
+  }
+}
+
+template <typename T>
+void ArgSortRow(
+    const T* x, int size, int stride, bool is_ascend, SortScratch<typename RadixKey<T>::type>* scratch, int32_t* out) {
+  using KeyT = typename RadixKey<T>::type;
+  KeyT* keys = scratch->keys.data();
+  for (int i = 0; i < size; ++i) {
+    keys[i] = ToRadixKey(x[i * stride], is_ascend);
+  }
+  int32_t* indices = scratch->indices.data();
+  std::iota(indices, indices + size, 0);
+
+  if (size <= kInsertionSortMaxSize) {
+    InsertionSort(keys, indices, size);
+  } else {
+    RadixSort(scratch, size);
+  }
+
+  for (int i = 0; i < size; ++i) {
+    out[i * stride] = indices[i];
+  }
+}
+
+template <typename T>
+struct ArgSortClosure {
+  const T* x;
+  int32_t* out;
+  int outer;
+  int size;
+  int inner;
+  bool is_ascend;
+};
+
+template <typename T>
+int ArgSortRows(int task_id, int num_task, void* datas) {
+  auto* closure  = static_cast<ArgSortClosure<T>*>(datas);
+  int64_t rows   = static_cast<int64_t>(closure->outer) * closure->inner;
+  int64_t begin  = rows * task_id / num_task;
+  int64_t end    = rows * (task_id + 1) / num_task;
+  int64_t stride = closure->inner;
+
+  SortScratch<typename RadixKey<T>::type> scratch;
+  scratch.Resize(closure->size);
+  for (int64_t r = begin; r < end; ++r) {
+    int64_t row_offset = (r / stride) * closure->size * stride + r % stride;
+    ArgSortRow(closure->x + row_offset,
+               closure->size,
+               closure->inner,
+               closure->is_ascend,
+               &scratch,
+               closure->out + row_offset);
+  }
+  return 0;
+}
+
+template <typename T>
+void ArgSort(const cinn_buffer_t* x, int outer, int size, int inner, bool is_ascend, cinn_buffer_t* out) {
+  CHECK_EQ(x->num_elements(), static_cast<uint64_t>(outer) * size * inner);
+  CHECK_EQ(out->num_elements(), x->num_elements());
+  if (size <= 0) return;
+
+  ArgSortClosure<T> closure{reinterpret_cast<const T*>(x->memory),
+                            reinterpret_cast<int32_t*>(out->memory),
+                            outer,
+                            size,
+                            inner,
+                            is_ascend};
+  int64_t rows      = static_cast<int64_t>(outer) * inner;
+  int64_t num_tasks = std::min<int64_t>(rows, max_concurrency());
+  if (num_tasks > 1 && rows * size >= kParallelMinElements) {
+    cinn_backend_parallel_launch(&ArgSortRows<T>, &closure, static_cast<int>(num_tasks));
+  } else {
+    ArgSortRows<T>(0, 1, &closure);
+  }
+}
+
+
+// Better means a greater key, or an equal key at a smaller index, so the top k
+// are the same as the first k of a stable sort.
+template <typename KeyT>
+struct TopKItem {
+  KeyT key;
+  int32_t index;
+};
+
+struct IsBetter {
+  template <typename KeyT>
+  bool operator()(const TopKItem<KeyT>& lhs, const TopKItem<KeyT>& rhs) const {
+    return lhs.key > rhs.key || (lhs.key == rhs.key && lhs.index < rhs.index);
+  }
+};
+
+// The rows where k is small are selected by a heap of the k best items seen so
+// far, whose worst key serves as the threshold to filter the rest of the row,
+// otherwise by quickselect, which is faster once the heap is large.
+constexpr int kTopKHeapMaxK     = 2048;
+constexpr int kTopKHeapMaxRatio = 8;
+
+template <typename T>
+void TopKRow(const T* x,
+             int size,
+             int stride,
+             int k,
+             bool largest,
+             std::vector<TopKItem<typename RadixKey<T>::type>>* items,
+             T* values,
+             int64_t* indices) {
+  using KeyT = typename RadixKey<T>::type;
+  // keys of the smallest values are the greatest after inverting
+  bool is_ascend = largest;
+  auto& buffer   = *items;
+
+  if (k <= kTopKHeapMaxK && static_cast<int64_t>(k) * kTopKHeapMaxRatio <= size) {
+    buffer.resize(k);
+    for (int i = 0; i < k; ++i) {
+      buffer[i] = {ToRadixKey(x[i * stride], is_ascend), i};
+    }
+    // the top of the heap is the worst of the selected
+    std::make_heap(buffer.begin(), buffer.end(), IsBetter());
+    KeyT threshold = buffer.front().key;
+    for (int i = k; i < size; ++i) {
+      KeyT key = ToRadixKey(x[i * stride], is_ascend);
+      // the later element with an equal key is never better, so the filter is strict
+      if (key <= threshold) continue;
+      std::pop_heap(buffer.begin(), buffer.end(), IsBetter());
+      buffer.back() = {key, i};
+      std::push_heap(buffer.begin(), buffer.end(), IsBetter());
+      threshold = buffer.front().key;
+    }
+  } else {
+    buffer.resize(size);
+    for (int i = 0; i < size; ++i) {
+      buffer[i] = {ToRadixKey(x[i * stride], is_ascend), i};
+    }
+    if (k < size) {
+      std::nth_element(buffer.begin(), buffer.begin() + k - 1, buffer.end(), IsBetter());
+    }
+    buffer.resize(k);
+  }
+  std::sort(buffer.begin(), buffer.end(), IsBetter());
+
+  for (int i = 0; i < k; ++i) {
+    values[i * stride]  = x[buffer[i].index * stride];
+    indices[i * stride] = buffer[i].index;
+  }
+}
+
+template <typename T>
+struct TopKClosure {
+  const T* x;
+  T* values;
+  int64_t* indices;
+  int outer;
+  int size;
+  int inner;
+  int k;
+  bool largest;
+};
+
+template <typename T>
+int TopKRows(int task_id, int num_task, void* datas) {
+  auto* closure  = static_cast<TopKClosure<T>*>(datas);
+  int64_t rows   = static_cast<int64_t>(closure->outer) * closure->inner;
+  int64_t begin  = rows * task_id / num_task;
+  int64_t end    = rows * (task_id + 1) / num_task;
+  int64_t stride = closure->inner;
+
+  std::vector<TopKItem<typename RadixKey<T>::type>> items;
+  for (int64_t r = begin; r < end; ++r) {
+    int64_t in_offset  = (r / stride) * closure->size * stride + r % stride;
+    int64_t out_offset = (r / stride) * closure->k * stride + r % stride;
+    TopKRow(closure->x + in_offset,
+            closure->size,
+            closure->inner,
+            closure->k,
+            closure->largest,
+            &items,
+            closure->values + out_offset,
+            closure->indices + out_offset);
+  }
+  return 0;
+}
+
+template <typename T>
+void TopK(const cinn_buffer_t* x, int axis, int k, bool largest, cinn_buffer_t* values, cinn_buffer_t* indices) {
+  if (axis < 0) axis += x->dimensions;
+  CHECK(axis >= 0 && axis < x->dimensions) << "The axis of top_k is out of range: " << axis;
+  int outer = 1, inner = 1, size = x->dims[axis];
+  for (int i = 0; i < axis; ++i) outer *= x->dims[i];
+  for (int i = axis + 1; i < x->dimensions; ++i) inner *= x->dims[i];
+  CHECK(k > 0 && k <= size) << "The k of top_k should be in (0, " << size << "], but got " << k;
+  CHECK_EQ(values->num_elements(), static_cast<uint64_t>(outer) * k * inner);
+  CHECK_EQ(indices->num_elements(), values->num_elements());
+
+  TopKClosure<T> closure{reinterpret_cast<const T*>(x->memory),
+                         reinterpret_cast<T*>(values->memory),
+                         reinterpret_cast<int64_t*>(indices->memory),
+                         outer,
+                         size,
+                         inner,
+                         k,
+                         largest};
+  int64_t rows      = static_cast<int64_t>(outer) * inner;
+  int64_t num_tasks = std::min<int64_t>(rows, max_concurrency());
+  if (num_tasks > 1 && rows * size >= kParallelMinElements) {
+    cinn_backend_parallel_launch(&TopKRows<T>, &closure, static_cast<int>(num_tasks));
+  } else {
+    TopKRows<T>(0, 1, &closure);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_ARGSORT(TYPE_SUFFIX, TYPE)                                                    \
+  void cinn_host_argsort_##TYPE_SUFFIX(                                                         \
+      const cinn_buffer_t* x, int outer, int size, int inner, bool is_ascend, cinn_buffer_t* out) { \
+    ArgSort<TYPE>(x, outer, size, inner, is_ascend, out);                                       \
+  }
+
+CINN_HOST_ARGSORT(fp32, float)
+CINN_HOST_ARGSORT(fp64, double)
+CINN_HOST_ARGSORT(int32, int)
+CINN_HOST_ARGSORT(int64, int64_t)
+
+#undef CINN_HOST_ARGSORT
+
+#define CINN_HOST_TOP_K(TYPE_SUFFIX, TYPE)                                                       \
+  void cinn_host_top_k_##TYPE_SUFFIX(                                                            \
+      const cinn_buffer_t* x, int axis, int k, bool largest, cinn_buffer_t* values, cinn_buffer_t* indices) { \
+    TopK<TYPE>(x, axis, k, largest, values, indices);                                            \
+  }
+
+CINN_HOST_TOP_K(fp32, float)
+CINN_HOST_TOP_K(fp64, double)
+CINN_HOST_TOP_K(int32, int)
+CINN_HOST_TOP_K(int64, int64_t)
+
+#undef CINN_HOST_TOP_K
+}
+
+CINN_REGISTER_HELPER(host_sort) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+#define _REGISTER_CINN_HOST_ARGSORT(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_argsort_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                   \
+      .AddInputType<cinn_buffer_t*>()                                       \
+      .AddInputType<int>()                                                  \
+      .AddInputType<int>()                                                  \
+      .AddInputType<int>()                                                  \
+      .AddInputType<bool>()                                                 \
+      .AddOutputType<cinn_buffer_t*>()                                      \
+      .SetShapeInference(FunctionProto::ShapeFollowNthArgument(0))          \
+      .End();
+
+  _REGISTER_CINN_HOST_ARGSORT(fp32);
+  _REGISTER_CINN_HOST_ARGSORT(fp64);
+  _REGISTER_CINN_HOST_ARGSORT(int32);
+  _REGISTER_CINN_HOST_ARGSORT(int64);
+
+#undef _REGISTER_CINN_HOST_ARGSORT
+
+  // the shape of outputs are the same as x except the axis is k
+  FunctionProto::shape_inference_t inference_shape_top_k = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(args.size(), 4UL) << "Wrong number of arguments passed in";
+    auto* x = args[0].as_tensor();
+    CHECK(x);
+    int axis = args[1].as_int32();
+    if (axis < 0) axis += x->shape.size();
+    std::vector<Expr> shape = x->shape;
+    shape[axis]             = args[2];
+    return shape;
+  };
+
+#define _REGISTER_CINN_HOST_TOP_K(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_top_k_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                 \
+      .AddInputType<cinn_buffer_t*>()                                     \
+      .AddInputType<int>()                                                \
+      .AddInputType<int>()                                                \
+      .AddInputType<bool>()                                               \
+      .AddOutputType<cinn_buffer_t*>()                                    \
+      .AddOutputType<cinn_buffer_t*>()                                    \
+      .SetShapeInference(inference_shape_top_k)                           \
+      .End();
+
+  _REGISTER_CINN_HOST_TOP_K(fp32);
+  _REGISTER_CINN_HOST_TOP_K(fp64);
+  _REGISTER_CINN_HOST_TOP_K(int32);
+  _REGISTER_CINN_HOST_TOP_K(int64);
+
+#undef _REGISTER_CINN_HOST_TOP_K
+
+  return true;
+}
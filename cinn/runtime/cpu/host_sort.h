@@ -0,0 +1,53 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the sort and selection functions in host device.
+ */
+#include <stdint.h>
+
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! Stable argsort along an axis of `x`, which is viewed as [outer, size, inner].
+//! Every row of `size` elements is sorted independently and the row-local
+//! indices are written into the int32 buffer `out` of the same shape as `x`.
+//! Equal elements keep their original order, both ascending and descending.
+#define CINN_HOST_ARGSORT(TYPE_SUFFIX, TYPE) \
+  void cinn_host_argsort_##TYPE_SUFFIX(       \
+      const cinn_buffer_t* x, int outer, int size, int inner, bool is_ascend, cinn_buffer_t* out);
+
+CINN_HOST_ARGSORT(fp32, float)
+CINN_HOST_ARGSORT(fp64, double)
+CINN_HOST_ARGSORT(int32, int)
+CINN_HOST_ARGSORT(int64, int64_t)
+
+#undef CINN_HOST_ARGSORT
+
+//! Select the k largest (or smallest) elements along the axis of `x` in one pass,
+//! without sorting the whole rows. The values and their int64 indices are written
+//! in sorted order, equal elements are ordered by their indices.
+#define CINN_HOST_TOP_K(TYPE_SUFFIX, TYPE) \
+  void cinn_host_top_k_##TYPE_SUFFIX(      \
+      const cinn_buffer_t* x, int axis, int k, bool largest, cinn_buffer_t* values, cinn_buffer_t* indices);
+
+CINN_HOST_TOP_K(fp32, float)
+CINN_HOST_TOP_K(fp64, double)
+CINN_HOST_TOP_K(int32, int)
+CINN_HOST_TOP_K(int64, int64_t)
+
+#undef CINN_HOST_TOP_K
+}
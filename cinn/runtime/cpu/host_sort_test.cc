@@ -0,0 +1,159 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_sort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+template <typename T>
+void CheckArgSort(const T* x, const int32_t* out, int outer, int size, int inner, bool is_ascend) {
+  for (int o = 0; o < outer; ++o) {
+    for (int i = 0; i < inner; ++i) {
+      auto at = [&](int j) { return x[(o * size + j) * inner + i]; };
+      std::vector<int32_t> expected(size);
+      std::iota(expected.begin(), expected.end(), 0);
+      std::stable_sort(expected.begin(), expected.end(), [&](int32_t a, int32_t b) {
+        return is_ascend ? at(a) < at(b) : at(a) > at(b);
+      });
+      for (int j = 0; j < size; ++j) {
+        ASSERT_EQ(out[(o * size + j) * inner + i], expected[j])
+            << "outer:" << o << ", inner:" << i << ", position:" << j << ", size:" << size;
+      }
+    }
+  }
+}
+
+TEST(cinn_host_argsort, stable) {
+  std::mt19937 rng(0);
+  // sizes cover the insertion sort and the radix sort, small value ranges produce many duplicates
+  for (int size : {1, 7, 32, 33, 300, 5000}) {
+    for (int range : {5, 1 << 20}) {
+      for (bool is_ascend : {true, false}) {
+        int outer = 3, inner = 2;
+        std::vector<float> x_fp32(outer * size * inner);
+        std::vector<int64_t> x_int64(x_fp32.size());
+        for (size_t k = 0; k < x_fp32.size(); ++k) {
+          int value  = static_cast<int>(rng() % range) - range / 2;
+          x_fp32[k]  = value * 0.5f;
+          x_int64[k] = value;
+        }
+        auto* x_fp32_buf  = common::BufferBuilder(Float(32), {outer, size, inner}).Build();
+        auto* x_int64_buf = common::BufferBuilder(Int(64), {outer, size, inner}).Build();
+        auto* out_buf     = common::BufferBuilder(Int(32), {outer, size, inner}).set_zero().Build();
+        std::copy(x_fp32.begin(), x_fp32.end(), reinterpret_cast<float*>(x_fp32_buf->memory));
+        std::copy(x_int64.begin(), x_int64.end(), reinterpret_cast<int64_t*>(x_int64_buf->memory));
+
+        cinn_host_argsort_fp32(x_fp32_buf, outer, size, inner, is_ascend, out_buf);
+        CheckArgSort(x_fp32.data(), reinterpret_cast<int32_t*>(out_buf->memory), outer, size, inner, is_ascend);
+        cinn_host_argsort_int64(x_int64_buf, outer, size, inner, is_ascend, out_buf);
+        CheckArgSort(x_int64.data(), reinterpret_cast<int32_t*>(out_buf->memory), outer, size, inner, is_ascend);
+      }
+    }
+  }
+}
+
+TEST(cinn_host_argsort, special_float) {
+  std::vector<float> x = {0.f, -0.f, -1e30f, 1e-30f, -3.5f, 3.5f, -1e-30f, 1e30f};
+  auto* x_buf          = common::BufferBuilder(Float(32), {static_cast<int>(x.size())}).Build();
+  auto* out_buf        = common::BufferBuilder(Int(32), {static_cast<int>(x.size())}).set_zero().Build();
+  std::copy(x.begin(), x.end(), reinterpret_cast<float*>(x_buf->memory));
+  cinn_host_argsort_fp32(x_buf, 1, x.size(), 1, true, out_buf);
+  auto* out = reinterpret_cast<int32_t*>(out_buf->memory);
+  for (size_t i = 1; i < x.size(); ++i) {
+    ASSERT_LE(x[out[i - 1]], x[out[i]]);
+  }
+}
+
+TEST(cinn_host_top_k, partial_selection) {
+  std::mt19937 rng(0);
+  int outer = 2, size = 5000, inner = 3;
+  // k covers the heap selection and the quickselect, small value ranges produce many duplicates
+  for (int k : {1, 10, 700, 5000}) {
+    for (int range : {5, 1 << 20}) {
+      for (bool largest : {true, false}) {
+        std::vector<float> x(outer * size * inner);
+        for (auto& v : x) {
+          v = (static_cast<int>(rng() % range) - range / 2) * 0.5f;
+        }
+        auto* x_buf       = common::BufferBuilder(Float(32), {outer, size, inner}).Build();
+        auto* values_buf  = common::BufferBuilder(Float(32), {outer, k, inner}).set_zero().Build();
+        auto* indices_buf = common::BufferBuilder(Int(64), {outer, k, inner}).set_zero().Build();
+        std::copy(x.begin(), x.end(), reinterpret_cast<float*>(x_buf->memory));
+
+        cinn_host_top_k_fp32(x_buf, 1, k, largest, values_buf, indices_buf);
+        auto* values  = reinterpret_cast<float*>(values_buf->memory);
+        auto* indices = reinterpret_cast<int64_t*>(indices_buf->memory);
+        for (int o = 0; o < outer; ++o) {
+          for (int i = 0; i < inner; ++i) {
+            auto at = [&](int j) { return x[(o * size + j) * inner + i]; };
+            std::vector<int64_t> expected(size);
+            std::iota(expected.begin(), expected.end(), 0);
+            std::stable_sort(expected.begin(), expected.end(), [&](int64_t a, int64_t b) {
+              return largest ? at(a) > at(b) : at(a) < at(b);
+            });
+            for (int j = 0; j < k; ++j) {
+              int pos = (o * k + j) * inner + i;
+              ASSERT_EQ(indices[pos], expected[j])
+                  << "k:" << k << ", outer:" << o << ", inner:" << i << ", position:" << j;
+              ASSERT_EQ(values[pos], at(expected[j]));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Sort 1M elements split into rows of different widths, the time should grow about linearly with the width.
+TEST(cinn_host_argsort, benchmark) {
+  constexpr int kTotal = 1 << 20;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1e3f, 1e3f);
+  auto* x_buf   = common::BufferBuilder(Float(32), {kTotal}).Build();
+  auto* out_buf = common::BufferBuilder(Int(32), {kTotal}).set_zero().Build();
+  auto* x       = reinterpret_cast<float*>(x_buf->memory);
+  for (int i = 0; i < kTotal; ++i) {
+    x[i] = dist(rng);
+  }
+
+  for (int width = 16; width <= kTotal; width *= 4) {
+    int rows   = kTotal / width;
+    auto start = std::chrono::steady_clock::now();
+    cinn_host_argsort_fp32(x_buf, rows, width, 1, true, out_buf);
+    auto cost =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    LOG(INFO) << "argsort rows:" << rows << ", width:" << width << ", cost:" << cost << " us";
+
+    auto* out = reinterpret_cast<int32_t*>(out_buf->memory);
+    for (int i = 1; i < width; ++i) {
+      ASSERT_LE(x[out[i - 1]], x[out[i]]);
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,86 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+/**
+ * The cache of the weights transformed by a host kernel, such as the packed or the winograd transformed weights.
+ *
+ * The weights of an inference model are the same buffer filled with the same contents in every run, so a transform is
+ * cached by the buffer and the parameters of the transform, together with a copy of the weights it was computed from.
+ * A hit compares the weights with the copy, which reads them once instead of transforming them into a new allocation,
+ * and a buffer refilled with other contents gets its transform recomputed.
+ */
+template <typename T>
+class HostWeightCache {
+ public:
+  using Transform = std::function<std::vector<T>()>;
+
+  explicit HostWeightCache(size_t capacity) : capacity_(capacity) {}
+
+  //! Return the transform of the `size` weights with the `params`, which is computed by `transform` on a miss.
+  std::shared_ptr<const std::vector<T>> Get(const T* weights,
+                                            size_t size,
+                                            const std::vector<int>& params,
+                                            const Transform& transform) {
+    Key key = std::make_pair(weights, params);
+    std::shared_ptr<const Entry> entry;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      auto it = cache_.find(key);
+      if (it != cache_.end()) entry = it->second;
+    }
+    // the entries are immutable once cached, so the weights are compared out of the lock
+    if (entry && entry->source.size() == size && std::memcmp(entry->source.data(), weights, size * sizeof(T)) == 0) {
+      return entry->transformed;
+    }
+
+    auto new_entry         = std::make_shared<Entry>();
+    new_entry->source      = std::vector<T>(weights, weights + size);
+    new_entry->transformed = std::make_shared<const std::vector<T>>(transform());
+    std::lock_guard<std::mutex> lock(mu_);
+    if (cache_.size() >= capacity_ && !cache_.count(key)) {
+      cache_.clear();
+    }
+    cache_[key] = new_entry;
+    return new_entry->transformed;
+  }
+
+ private:
+  using Key = std::pair<const T*, std::vector<int>>;
+  struct Entry {
+    std::vector<T> source;
+    std::shared_ptr<const std::vector<T>> transformed;
+  };
+
+  size_t capacity_;
+  std::mutex mu_;
+  std::map<Key, std::shared_ptr<const Entry>> cache_;
+};
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,362 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_winograd_conv.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/backends/function_prototype.h"
+#include "cinn/common/cas.h"
+#include "cinn/common/target.h"
+#include "cinn/runtime/cpu/host_weight_cache.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace {
+
+// The transform matrices of F(2x2, 3x3) and F(4x4, 3x3) from "Fast Algorithms for Convolutional Neural Networks",
+// the transformed tile is of alpha x alpha with alpha = tile_size + 2.
+constexpr int kMaxAlpha = 6;
+
+// clang-format off
+constexpr double kBT2[] = {1,  0, -1,  0,
+                           0,  1,  1,  0,
+                           0, -1,  1,  0,
+                           0,  1,  0, -1};
+constexpr double kG2[]  = {1,    0,   0,
+                           0.5,  0.5, 0.5,
+                           0.5, -0.5, 0.5,
+                           0,    0,   1};
+constexpr double kAT2[] = {1, 1,  1,  0,
+                           0, 1, -1, -1};
+
+constexpr double kBT4[] = {4,  0, -5,  0, 1, 0,
+                           0, -4, -4,  1, 1, 0,
+                           0,  4, -4, -1, 1, 0,
+                           0, -2, -1,  2, 1, 0,
+                           0,  2, -1, -2, 1, 0,
+                           0,  4,  0, -5, 0, 1};
+constexpr double kG4[]  = { 1.0 / 4,        0,       0,
+                           -1.0 / 6, -1.0 / 6, -1.0 / 6,
+                           -1.0 / 6,  1.0 / 6, -1.0 / 6,
+                            1.0 / 24, 1.0 / 12, 1.0 / 6,
+                            1.0 / 24, -1.0 / 12, 1.0 / 6,
+                                   0,        0,       1};
+constexpr double kAT4[] = {1, 1,  1, 1,  1, 0,
+                           0, 1, -1, 2, -2, 0,
+                           0, 1,  1, 4,  4, 0,
+                           0, 1, -1, 8, -8, 1};
+// clang-format on
+
+// The tiles are transformed, multiplied and transformed back by blocks of kTileBlock tiles, so the transformed input
+// and products of a block stay in the caches.
+constexpr int kTileBlock = 32;
+// The cache of transformed weights is dropped as a whole when it grows beyond this number of weights.
+constexpr size_t kMaxCachedWeights = 256;
+
+template <typename T>
+struct WinogradClosure {
+  const T* input;
+  const T* transformed_weights;
+  T* out;
+  int batch;
+  int c_in;
+  int input_h;
+  int input_w;
+  int c_out;
+  int pad_h;
+  int pad_w;
+  int out_h;
+  int out_w;
+  int tiles_h;
+  int tiles_w;
+  int64_t num_tiles;
+  int m;
+  int alpha;
+  T BT[kMaxAlpha * kMaxAlpha];
+  T AT[kMaxAlpha * kMaxAlpha];
+};
+
+// U = G * g * G^T of every [c_out, c_in] 3x3 kernel g, stored as [alpha * alpha, c_out, c_in].
+template <typename T>
+std::vector<T> TransformWeights(const T* weights, int c_out, int c_in, int alpha, const double* G) {
+  int64_t num_kernels = static_cast<int64_t>(c_out) * c_in;
+  std::vector<T> res(alpha * alpha * num_kernels);
+  double tmp[kMaxAlpha][3];
+  for (int64_t kc = 0; kc < num_kernels; ++kc) {
+    const T* g = weights + kc * 9;
+    for (int i = 0; i < alpha; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        tmp[i][j] = G[i * 3] * g[j] + G[i * 3 + 1] * g[3 + j] + G[i * 3 + 2] * g[6 + j];
+      }
+    }
+    for (int i = 0; i < alpha; ++i) {
+      for (int j = 0; j < alpha; ++j) {
+        double u = tmp[i][0] * G[j * 3] + tmp[i][1] * G[j * 3 + 1] + tmp[i][2] * G[j * 3 + 2];
+        res[(i * alpha + j) * num_kernels + kc] = static_cast<T>(u);
+      }
+    }
+  }
+  return res;
+}
+
+// The transform of the weights is cached since the weights of an inference model stay the same in every run.
+template <typename T>
+std::shared_ptr<const std::vector<T>> GetTransformedWeights(
+    const T* weights, int c_out, int c_in, int m, const double* G) {
+  static cinn::runtime::cpu::HostWeightCache<T> cache(kMaxCachedWeights);
+  size_t size = static_cast<size_t>(c_out) * c_in * 9;
+  return cache.Get(weights, size, {c_out, c_in, m}, [&] { return TransformWeights(weights, c_out, c_in, m + 2, G); });
+}
+
+// V = B^T * d * B of the input tiles d, stored as [alpha * alpha, c_in, kTileBlock].
+template <typename T>
+void TransformInput(const WinogradClosure<T>& c, int64_t tile_begin, int num_tiles, T* V) {
+  const int alpha         = c.alpha;
+  const int64_t xi_stride = static_cast<int64_t>(c.c_in) * kTileBlock;
+  T d[kMaxAlpha][kMaxAlpha];
+  T tmp[kMaxAlpha][kMaxAlpha];
+  for (int p = 0; p < num_tiles; ++p) {
+    int64_t tile = tile_begin + p;
+    int n        = tile / (c.tiles_h * c.tiles_w);
+    int rest     = tile % (c.tiles_h * c.tiles_w);
+    int y0       = rest / c.tiles_w * c.m - c.pad_h;
+    int x0       = rest % c.tiles_w * c.m - c.pad_w;
+    for (int ic = 0; ic < c.c_in; ++ic) {
+      const T* plane = c.input + (static_cast<int64_t>(n) * c.c_in + ic) * c.input_h * c.input_w;
+      for (int i = 0; i < alpha; ++i) {
+        int y = y0 + i;
+        for (int j = 0; j < alpha; ++j) {
+          int x   = x0 + j;
+          d[i][j] = y >= 0 && y < c.input_h && x >= 0 && x < c.input_w ? plane[y * c.input_w + x] : T(0);
+        }
+      }
+      for (int i = 0; i < alpha; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+          T sum = 0;
+          for (int k = 0; k < alpha; ++k) sum += c.BT[i * alpha + k] * d[k][j];
+          tmp[i][j] = sum;
+        }
+      }
+      T* v = V + static_cast<int64_t>(ic) * kTileBlock + p;
+      for (int i = 0; i < alpha; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+          T sum = 0;
+          for (int k = 0; k < alpha; ++k) sum += tmp[i][k] * c.BT[j * alpha + k];
+          v[(i * alpha + j) * xi_stride] = sum;
+        }
+      }
+    }
+  }
+}
+
+// M[xi] = U[xi] * V[xi] for every element xi of the transformed tiles, stored as [alpha * alpha, c_out, kTileBlock].
+template <typename T>
+void MultiplyTransformed(const WinogradClosure<T>& c, int num_tiles, const T* V, T* M) {
+  const int64_t num_kernels = static_cast<int64_t>(c.c_out) * c.c_in;
+  for (int xi = 0; xi < c.alpha * c.alpha; ++xi) {
+    const T* U_xi = c.transformed_weights + xi * num_kernels;
+    const T* V_xi = V + static_cast<int64_t>(xi) * c.c_in * kTileBlock;
+    for (int oc = 0; oc < c.c_out; ++oc) {
+      T* __restrict__ acc = M + (static_cast<int64_t>(xi) * c.c_out + oc) * kTileBlock;
+      std::fill(acc, acc + num_tiles, T(0));
+      const T* u = U_xi + static_cast<int64_t>(oc) * c.c_in;
+      for (int ic = 0; ic < c.c_in; ++ic) {
+        const T* __restrict__ v = V_xi + static_cast<int64_t>(ic) * kTileBlock;
+        T w                     = u[ic];
+        for (int p = 0; p < num_tiles; ++p) acc[p] += w * v[p];
+      }
+    }
+  }
+}
+
+// Y = A^T * M * A of the products, clipped to the output.
+template <typename T>
+void TransformOutput(const WinogradClosure<T>& c, int64_t tile_begin, int num_tiles, const T* M) {
+  const int alpha         = c.alpha;
+  const int m             = c.m;
+  const int64_t xi_stride = static_cast<int64_t>(c.c_out) * kTileBlock;
+  T tmp[kMaxAlpha][kMaxAlpha];
+  for (int p = 0; p < num_tiles; ++p) {
+    int64_t tile = tile_begin + p;
+    int n        = tile / (c.tiles_h * c.tiles_w);
+    int rest     = tile % (c.tiles_h * c.tiles_w);
+    int y0       = rest / c.tiles_w * m;
+    int x0       = rest % c.tiles_w * m;
+    int rows     = std::min(m, c.out_h - y0);
+    int cols     = std::min(m, c.out_w - x0);
+    for (int oc = 0; oc < c.c_out; ++oc) {
+      const T* mm = M + static_cast<int64_t>(oc) * kTileBlock + p;
+      for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < alpha; ++j) {
+          T sum = 0;
+          for (int k = 0; k < alpha; ++k) sum += c.AT[i * alpha + k] * mm[(k * alpha + j) * xi_stride];
+          tmp[i][j] = sum;
+        }
+      }
+      T* plane = c.out + (static_cast<int64_t>(n) * c.c_out + oc) * c.out_h * c.out_w;
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          T sum = 0;
+          for (int k = 0; k < alpha; ++k) sum += tmp[i][k] * c.AT[j * alpha + k];
+          plane[(y0 + i) * c.out_w + x0 + j] = sum;
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+int WinogradConvTask(int task_id, int num_task, void* datas) {
+  auto& c            = *static_cast<WinogradClosure<T>*>(datas);
+  int64_t num_blocks = (c.num_tiles + kTileBlock - 1) / kTileBlock;
+  int64_t blk_begin  = num_blocks * task_id / num_task;
+  int64_t blk_end    = num_blocks * (task_id + 1) / num_task;
+  if (blk_begin >= blk_end) return 0;
+  std::vector<T> V(static_cast<int64_t>(c.alpha) * c.alpha * c.c_in * kTileBlock);
+  std::vector<T> M(static_cast<int64_t>(c.alpha) * c.alpha * c.c_out * kTileBlock);
+  for (int64_t blk = blk_begin; blk < blk_end; ++blk) {
+    int64_t tile_begin = blk * kTileBlock;
+    int num_tiles      = std::min<int64_t>(kTileBlock, c.num_tiles - tile_begin);
+    TransformInput(c, tile_begin, num_tiles, V.data());
+    MultiplyTransformed(c, num_tiles, V.data(), M.data());
+    TransformOutput(c, tile_begin, num_tiles, M.data());
+  }
+  return 0;
+}
+
+template <typename T>
+void WinogradConv2d(const cinn_buffer_t* input,
+                    const cinn_buffer_t* weights,
+                    int batch,
+                    int c_in,
+                    int input_h,
+                    int input_w,
+                    int c_out,
+                    int pad_h,
+                    int pad_w,
+                    int tile_size,
+                    cinn_buffer_t* out) {
+  CHECK(tile_size == 2 || tile_size == 4)
+      << "The winograd conv2d only supports the tile size 2 or 4, but got " << tile_size;
+  const double* BT = tile_size == 2 ? kBT2 : kBT4;
+  const double* G  = tile_size == 2 ? kG2 : kG4;
+  const double* AT = tile_size == 2 ? kAT2 : kAT4;
+  auto weights_ptr = reinterpret_cast<const T*>(weights->memory);
+  auto transformed = GetTransformedWeights(weights_ptr, c_out, c_in, tile_size, G);
+
+  WinogradClosure<T> closure;
+  closure.input               = reinterpret_cast<const T*>(input->memory);
+  closure.transformed_weights = transformed->data();
+  closure.out                 = reinterpret_cast<T*>(out->memory);
+  closure.batch               = batch;
+  closure.c_in                = c_in;
+  closure.input_h             = input_h;
+  closure.input_w             = input_w;
+  closure.c_out               = c_out;
+  closure.pad_h               = pad_h;
+  closure.pad_w               = pad_w;
+  closure.out_h               = input_h + 2 * pad_h - 2;
+  closure.out_w               = input_w + 2 * pad_w - 2;
+  closure.m                   = tile_size;
+  closure.alpha               = tile_size + 2;
+  closure.tiles_h             = (closure.out_h + tile_size - 1) / tile_size;
+  closure.tiles_w             = (closure.out_w + tile_size - 1) / tile_size;
+  closure.num_tiles           = static_cast<int64_t>(batch) * closure.tiles_h * closure.tiles_w;
+  CHECK_GT(closure.out_h, 0) << "The output height of winograd conv2d should be positive";
+  CHECK_GT(closure.out_w, 0) << "The output width of winograd conv2d should be positive";
+  for (int i = 0; i < closure.alpha * closure.alpha; ++i) closure.BT[i] = static_cast<T>(BT[i]);
+  for (int i = 0; i < tile_size * closure.alpha; ++i) closure.AT[i] = static_cast<T>(AT[i]);
+
+  int64_t num_blocks = (closure.num_tiles + kTileBlock - 1) / kTileBlock;
+  int num_tasks      = std::min<int64_t>(num_blocks, max_concurrency());
+  if (num_tasks > 1) {
+    cinn_backend_parallel_launch(&WinogradConvTask<T>, &closure, num_tasks);
+  } else {
+    WinogradConvTask<T>(0, 1, &closure);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+#define CINN_HOST_WINOGRAD_CONV2D_NCHW(TYPE_SUFFIX, TYPE)                                                     \
+  void cinn_host_winograd_conv2d_nchw_##TYPE_SUFFIX(const cinn_buffer_t* input,                               \
+                                                    const cinn_buffer_t* weights,                             \
+                                                    int batch,                                                \
+                                                    int c_in,                                                 \
+                                                    int input_h,                                              \
+                                                    int input_w,                                              \
+                                                    int c_out,                                                \
+                                                    int pad_h,                                                \
+                                                    int pad_w,                                                \
+                                                    int tile_size,                                            \
+                                                    cinn_buffer_t* out) {                                     \
+    WinogradConv2d<TYPE>(input, weights, batch, c_in, input_h, input_w, c_out, pad_h, pad_w, tile_size, out); \
+  }
+
+CINN_HOST_WINOGRAD_CONV2D_NCHW(fp32, float)
+CINN_HOST_WINOGRAD_CONV2D_NCHW(fp64, double)
+
+#undef CINN_HOST_WINOGRAD_CONV2D_NCHW
+}
+
+CINN_REGISTER_HELPER(host_winograd_conv) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  // out is [batch, c_out, input_h + 2 * pad_h - 2, input_w + 2 * pad_w - 2]
+  FunctionProto::shape_inference_t inference_shape_winograd_conv2d = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(args.size(), 10UL) << "Wrong number of arguments passed in";
+    int input_h = common::AutoSimplify(args[4]).as_int32();
+    int input_w = common::AutoSimplify(args[5]).as_int32();
+    int pad_h   = common::AutoSimplify(args[7]).as_int32();
+    int pad_w   = common::AutoSimplify(args[8]).as_int32();
+    return std::vector<Expr>{common::AutoSimplify(args[2]),
+                             common::AutoSimplify(args[6]),
+                             Expr(input_h + 2 * pad_h - 2),
+                             Expr(input_w + 2 * pad_w - 2)};
+  };
+
+#define _REGISTER_CINN_HOST_WINOGRAD_CONV2D_NCHW(TYPE_SUFFIX)                            \
+  REGISTER_EXTERN_FUNC_HELPER(cinn_host_winograd_conv2d_nchw_##TYPE_SUFFIX, host_target) \
+      .SetRetType<void>()                                                                \
+      .AddInputType<cinn_buffer_t*>()                                                    \
+      .AddInputType<cinn_buffer_t*>()                                                    \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddInputType<int>()                                                               \
+      .AddOutputType<cinn_buffer_t*>()                                                   \
+      .SetShapeInference(inference_shape_winograd_conv2d)                                \
+      .End();
+
+  _REGISTER_CINN_HOST_WINOGRAD_CONV2D_NCHW(fp32);
+  _REGISTER_CINN_HOST_WINOGRAD_CONV2D_NCHW(fp64);
+
+#undef _REGISTER_CINN_HOST_WINOGRAD_CONV2D_NCHW
+
+  return true;
+}
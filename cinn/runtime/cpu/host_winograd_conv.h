@@ -0,0 +1,44 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+/**
+ * \file This file implements the winograd convolution functions in host device.
+ */
+#include "cinn/runtime/cinn_runtime.h"
+
+extern "C" {
+
+//! The 3x3 convolution of stride 1 and dilation 1 from `input` of [batch, c_in, input_h, input_w] and `weights` of
+//! [c_out, c_in, 3, 3] to `out` of [batch, c_out, input_h + 2 * pad_h - 2, input_w + 2 * pad_w - 2], computed by the
+//! winograd algorithm F(tile_size x tile_size, 3 x 3) with `tile_size` 2 or 4. The transformed weights are cached
+//! between the calls, and are transformed again only when the contents of `weights` change.
+#define CINN_HOST_WINOGRAD_CONV2D_NCHW(TYPE_SUFFIX)                               \
+  void cinn_host_winograd_conv2d_nchw_##TYPE_SUFFIX(const cinn_buffer_t* input,   \
+                                                    const cinn_buffer_t* weights, \
+                                                    int batch,                    \
+                                                    int c_in,                     \
+                                                    int input_h,                  \
+                                                    int input_w,                  \
+                                                    int c_out,                    \
+                                                    int pad_h,                    \
+                                                    int pad_w,                    \
+                                                    int tile_size,                \
+                                                    cinn_buffer_t* out);
+
+CINN_HOST_WINOGRAD_CONV2D_NCHW(fp32)
+CINN_HOST_WINOGRAD_CONV2D_NCHW(fp64)
+
+#undef CINN_HOST_WINOGRAD_CONV2D_NCHW
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/host_winograd_conv.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "cinn/common/test_helper.h"
+#include "cinn/runtime/cpu/host_weight_cache.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+
+std::vector<double> ReferenceConv2d(const float* input,
+                                    const float* weights,
+                                    int batch,
+                                    int c_in,
+                                    int h,
+                                    int w,
+                                    int c_out,
+                                    int pad_h,
+                                    int pad_w) {
+  int out_h = h + 2 * pad_h - 2, out_w = w + 2 * pad_w - 2;
+  std::vector<double> out(batch * c_out * out_h * out_w, 0);
+  for (int n = 0; n < batch; ++n) {
+    for (int oc = 0; oc < c_out; ++oc) {
+      for (int y = 0; y < out_h; ++y) {
+        for (int x = 0; x < out_w; ++x) {
+          double sum = 0;
+          for (int ic = 0; ic < c_in; ++ic) {
+            for (int i = 0; i < 3; ++i) {
+              for (int j = 0; j < 3; ++j) {
+                int iy = y + i - pad_h, ix = x + j - pad_w;
+                if (iy < 0 || iy >= h || ix < 0 || ix >= w) continue;
+                sum += static_cast<double>(input[((n * c_in + ic) * h + iy) * w + ix]) *
+                       weights[((oc * c_in + ic) * 3 + i) * 3 + j];
+              }
+            }
+          }
+          out[((n * c_out + oc) * out_h + y) * out_w + x] = sum;
+        }
+      }
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(cinn_host_winograd_conv2d_nchw, compare_with_direct_conv) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  // batch, c_in, h, w, c_out, pad_h, pad_w, the last two have partial tiles at the bottom and right
+  std::vector<std::vector<int>> shapes = {{1, 3, 8, 8, 4, 1, 1}, {2, 16, 15, 13, 8, 0, 1}, {1, 32, 30, 30, 40, 1, 1}};
+  for (auto& s : shapes) {
+    int batch = s[0], c_in = s[1], h = s[2], w = s[3], c_out = s[4], pad_h = s[5], pad_w = s[6];
+    int out_h = h + 2 * pad_h - 2, out_w = w + 2 * pad_w - 2;
+    auto* input_buf   = common::BufferBuilder(Float(32), {batch, c_in, h, w}).set_random().Build();
+    auto* weights_buf = common::BufferBuilder(Float(32), {c_out, c_in, 3, 3}).set_random().Build();
+    auto* input       = reinterpret_cast<float*>(input_buf->memory);
+    auto* weights     = reinterpret_cast<float*>(weights_buf->memory);
+    for (int tile_size : {2, 4}) {
+      // the second run refills the weights, which should not use the stale transformed weights
+      for (int run = 0; run < 2; ++run) {
+        if (run == 1) {
+          std::generate(weights, weights + c_out * c_in * 9, [&] { return dist(rng); });
+        }
+        auto expect   = ReferenceConv2d(input, weights, batch, c_in, h, w, c_out, pad_h, pad_w);
+        auto* out_buf = common::BufferBuilder(Float(32), {batch, c_out, out_h, out_w}).set_random().Build();
+        cinn_host_winograd_conv2d_nchw_fp32(
+            input_buf, weights_buf, batch, c_in, h, w, c_out, pad_h, pad_w, tile_size, out_buf);
+        auto* out = reinterpret_cast<float*>(out_buf->memory);
+        for (size_t i = 0; i < expect.size(); ++i) {
+          ASSERT_NEAR(out[i], expect[i], 1e-3) << "tile_size: " << tile_size << ", run: " << run << ", index: " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(HostWeightCache, compare_with_cached_weights) {
+  HostWeightCache<float> cache(4);
+  std::vector<float> weights(64, 1.f);
+  int num_transforms = 0;
+  auto transform     = [&] {
+    ++num_transforms;
+    return std::vector<float>(weights.begin(), weights.end());
+  };
+  auto first = cache.Get(weights.data(), weights.size(), {8, 8}, transform);
+  ASSERT_EQ(cache.Get(weights.data(), weights.size(), {8, 8}, transform), first);
+  ASSERT_EQ(num_transforms, 1);
+
+  // any refilled element, whatever a hash of the contents would be, makes the cached transform stale
+  weights[37] = 2.f;
+  auto second = cache.Get(weights.data(), weights.size(), {8, 8}, transform);
+  ASSERT_EQ(num_transforms, 2);
+  ASSERT_EQ((*second)[37], 2.f);
+  ASSERT_EQ((*first)[37], 1.f);
+
+  // the same buffer transformed with other parameters is another entry
+  cache.Get(weights.data(), weights.size(), {4, 16}, transform);
+  ASSERT_EQ(num_transforms, 3);
+  ASSERT_EQ(cache.Get(weights.data(), weights.size(), {8, 8}, transform), second);
+  ASSERT_EQ(num_transforms, 3);
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
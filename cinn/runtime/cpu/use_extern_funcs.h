@@ -17,6 +17,14 @@
 #include "cinn/backends/extern_func_jit_register.h"
 
 CINN_USE_REGISTER(host_intrinsics)
+CINN_USE_REGISTER(host_sort)
+CINN_USE_REGISTER(host_norm)
+CINN_USE_REGISTER(host_attention)
+CINN_USE_REGISTER(host_embedding_bag)
+CINN_USE_REGISTER(host_winograd_conv)
+CINN_USE_REGISTER(host_scatter)
+CINN_USE_REGISTER(host_conv2d_nhwc)
+CINN_USE_REGISTER(host_microkernel)
 #ifdef CINN_WITH_MKL_CBLAS
 CINN_USE_REGISTER(mkl_math)
 CINN_USE_REGISTER(cinn_cpu_mkl)
@@ -37,7 +37,22 @@ DEFINE_string(cinn_x86_builtin_code_root, StringFromEnv("FLAGS_cinn_x86_builtin_
 DEFINE_int32(cinn_parallel_compile_size,
              // Revert changes in PR #990 to pass the model unittests
              Int32FromEnv("FLAGS_cinn_parallel_compile_size", 8),
-             "When use parallel compile, set the number of group compiled by each thread.");
+             "When use parallel compile, set the max number of groups compiled into one module by a thread, "
+             "0 means disable parallel compile.");
+
+DEFINE_int32(cinn_parallel_compile_thread,
+             Int32FromEnv("FLAGS_cinn_parallel_compile_thread", -1),
+             "The number of threads used by parallel compile, -1 means the number of the hardware threads.");
+
+DEFINE_bool(cinn_lazy_compile,
+            BoolFromEnv("FLAGS_cinn_lazy_compile", false),
+            "Whether to JIT compile each host function on its first call, while a background thread compiles the "
+            "functions ahead in the order of the instructions.");
+
+DEFINE_string(cinn_tuning_llvm_optimize_profile,
+              StringFromEnv("FLAGS_cinn_tuning_llvm_optimize_profile", "fast-compile"),
+              "The LLVM optimize profile of the candidates measured by the auto-tuner, fast-compile, balanced or "
+              "max-perf.");
 
 DEFINE_bool(cinn_use_op_fusion, BoolFromEnv("FLAGS_cinn_use_op_fusion", true), "Whether to use op fusion pass.");
 
@@ -116,6 +131,41 @@ DEFINE_bool(enhance_vertical_fusion_with_recompute,
             BoolFromEnv("FLAGS_enhance_vertical_fusion_with_recompute", true),
             "Whether to enhance check logic on vertical fusion with recompute");
 
+DEFINE_int32(cinn_horizontal_fusion_max_size,
+             Int32FromEnv("FLAGS_cinn_horizontal_fusion_max_size", 0),
+             "The max number of elements of the independent small groups which FusionMergePass packs into one kernel, "
+             "0 disables the fusion of the groups without a common producer or input.");
+
+DEFINE_bool(cinn_fusion_merge_with_cost_model,
+            BoolFromEnv("FLAGS_cinn_fusion_merge_with_cost_model", false),
+            "Whether FusionMergePass estimates the memory traffic and the computation of the vertical fusions chosen by "
+            "the rules, and gives up those which cost more than they save.");
+
+DEFINE_int32(cinn_cas_simplify_cache_capacity,
+             Int32FromEnv("FLAGS_cinn_cas_simplify_cache_capacity", 65536),
+             "The max number of expressions memoized by common::AutoSimplify, 0 disables the cache.");
+
+DEFINE_int64(cinn_cas_simplify_step_budget,
+             Int64FromEnv("FLAGS_cinn_cas_simplify_step_budget", 1000000L),
+             "The max number of simplification steps a single common::AutoSimplify call may take, when it runs out the "
+             "call gives up and returns the input expression unchanged, 0 means unlimited.");
+
+DEFINE_bool(cinn_x86_winograd_conv,
+            BoolFromEnv("FLAGS_cinn_x86_winograd_conv", false),
+            "Whether to compute the 3x3 conv2d of stride 1 on x86 by the host winograd kernel, which is faster but "
+            "rounds differently from the direct convolution.");
+
+DEFINE_bool(cinn_x86_direct_nhwc_conv,
+            BoolFromEnv("FLAGS_cinn_x86_direct_nhwc_conv", true),
+            "Whether to compute the NHWC conv2d on x86 by the register blocked microkernels of the host runtime, "
+            "instead of the generic compute of the NHWC conv2d.");
+
+DEFINE_bool(cinn_llvm_buffer_noalias,
+            BoolFromEnv("FLAGS_cinn_llvm_buffer_noalias", false),
+            "Whether to mark the loads and stores of the different argument buffers of a host kernel as not aliased, "
+            "which asserts that the callers never bind two arguments to overlapping memory. The temporary buffers of "
+            "a kernel are always marked as not aliased with the other buffers.");
+
 DEFINE_bool(verbose_function_register,
             BoolFromEnv("FLAGS_verbose_function_register", false),
             "Whether to verbose function regist log. This will only work if CINN build with flag -DWITH_DEBUG=ON.");
@@ -0,0 +1,23 @@
+include(ExternalProject)
+
+set(DLPACK_SOURCE_DIR ${THIRD_PARTY_PATH}/dlpack)
+
+ExternalProject_Add(
+  extern_dlpack
+  ${EXTERNAL_PROJECT_LOG_ARGS}
+  GIT_REPOSITORY "https://github.com/dmlc/dlpack.git"
+  GIT_TAG v0.8
+  PREFIX ${THIRD_PARTY_PATH}/dlpack
+  SOURCE_DIR ${DLPACK_SOURCE_DIR}
+  CONFIGURE_COMMAND ""
+  PATCH_COMMAND ""
+  BUILD_COMMAND ""
+  UPDATE_COMMAND ""
+  INSTALL_COMMAND ""
+  TEST_COMMAND ""
+)
+
+include_directories(${DLPACK_SOURCE_DIR}/include)
+
+add_library(dlpack INTERFACE)
+add_dependencies(dlpack extern_dlpack)
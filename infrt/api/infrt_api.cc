@@ -68,10 +68,10 @@ class PredictExecutor : public MlirToRuntimeTranslator {
  public:
   CoreRuntimeBuilder core_runtime;
 
-  PredictExecutor(mlir::ModuleOp module, KernelRegistry* registry, TensorMap* map)
+  PredictExecutor(mlir::ModuleOp module, KernelRegistry* registry, TensorMap* map, int num_threads = 1)
       : core_runtime(registry), MlirToRuntimeTranslator(module, &core_runtime), registry_(registry) {
     CHECK(registry_);
-    Init(map);
+    Init(map, num_threads);
   }
 
   void Run() {
@@ -89,7 +89,7 @@ class PredictExecutor : public MlirToRuntimeTranslator {
   DenseHostTensor* GetOutput(int i) { return outputs_[i]; }
 
  private:
-  void Init(TensorMap* map) {
+  void Init(TensorMap* map, int num_threads) {
     EmitFunctions();
     llvm::Optional<mlir::FuncOp> predict_func_ = llvm::None;
     for (auto func_op : impl_->module.getOps<mlir::FuncOp>()) {
@@ -103,6 +103,7 @@ class PredictExecutor : public MlirToRuntimeTranslator {
     }
     auto& predict_func   = predict_func_.getValue();
     function_executable_ = new MlirFunctionExecutable(predict_func, registry_, impl_->func_defs);
+    function_executable_->SetNumThreads(num_threads);
 
     // process parammeters
     for (int i = 0; i < predict_func.getNumArguments(); ++i) {
@@ -200,7 +201,7 @@ int CinnRtPredictor::Init(const CinnRtConfig& config) {
   TensorMap* tensor_map = LoadParams(config.model_dir());
 
   // Create PredictExecutor
-  impl_->executor.reset(new PredictExecutor(impl_->module_ref.get(), registry, tensor_map));
+  impl_->executor.reset(new PredictExecutor(impl_->module_ref.get(), registry, tensor_map, config.num_threads()));
   return 0;
 }
 
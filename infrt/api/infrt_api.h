@@ -10,6 +10,7 @@ class CinnRtConfig {
   std::string model_dir_;
   std::string mlir_path_;
   std::vector<std::string> shared_libs_;
+  int num_threads_{1};
 
  public:
   CinnRtConfig() = default;
@@ -22,6 +23,10 @@ class CinnRtConfig {
   void set_shared_libs(const std::vector<std::string>& shared_libs) { shared_libs_ = shared_libs; };
   const std::vector<std::string>& shared_libs() const { return shared_libs_; }
 
+  // Run the independent kernels concurrently with a dataflow executor if more than one thread is set.
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; };
+  int num_threads() const { return num_threads_; }
+
   virtual ~CinnRtConfig() = default;
 };
 
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "infrt/host_context/dataflow_executor.h"
 #include "infrt/host_context/kernel_registry.h"
 #include "infrt/host_context/op_executable.h"
 #include "infrt/host_context/symbol_table.h"
@@ -17,6 +18,10 @@ struct CoreRuntime::Impl {
   std::vector<OpExecutableBuilder> op_executables;
 
   mutable std::vector<ValueRef> results;
+
+  //! Run the ops with a DataflowExecutor if more than one thread is set.
+  int num_threads{1};
+  std::unique_ptr<DataflowExecutor> dataflow_executor;
 };
 
 SymbolTable* CoreRuntime::symbol_table() { return &impl_->symbol_table; }
@@ -25,6 +30,17 @@ CoreRuntime::CoreRuntime(CoreRuntime::Impl* impl) : impl_(impl) { CHECK(impl); }
 
 void CoreRuntime::Execute() {
   // std::cout << "CoreRuntime::Execute" << std::endl;
+  if (impl_->num_threads > 1) {
+    // The executor is built once the program is complete, and rebuilt only if more ops are appended later.
+    if (!impl_->dataflow_executor || impl_->dataflow_executor->num_ops() != impl_->op_executables.size()) {
+      std::vector<OpExecutable*> ops;
+      for (auto& op : impl_->op_executables) ops.push_back(&op);
+      impl_->dataflow_executor.reset(new DataflowExecutor(ops, impl_->num_threads));
+    }
+    impl_->dataflow_executor->Run();
+    return;
+  }
+
   int op_offset = 0;
   for (auto& op : impl_->op_executables) {
     VLOG(3) << "running op " << op_offset++ << " " << op.name();
@@ -36,8 +52,17 @@ KernelRegistry* CoreRuntime::kernel_registry() const { return impl_->kernel_regi
 
 size_t CoreRuntime::num_ops() const { return impl_->op_executables.size(); }
 
+void CoreRuntime::SetNumThreads(int num_threads) {
+  CHECK_GE(num_threads, 1);
+  if (num_threads != impl_->num_threads) impl_->dataflow_executor.reset();
+  impl_->num_threads = num_threads;
+}
+
+int CoreRuntime::num_threads() const { return impl_->num_threads; }
+
 CoreRuntimeBuilder::CoreRuntimeBuilder(KernelRegistry* kernel_registry) : CoreRuntime(new Impl) {
   impl_->kernel_registry = kernel_registry ? kernel_registry : GetCpuKernelRegistry();
+  impl_->num_threads     = GetDefaultExecutorThreads();
 }
 
 OpExecutableBuilder* CoreRuntimeBuilder::NewOpExecutable(absl::string_view op_name) {
@@ -19,6 +19,7 @@ class SymbolTable;
  * CoreRuntime encapsulate the execution for a sequence of ops.
  * Each function call will bind to a CoreRuntime instance, push the argument Values in to the argument-list, and get the
  * result Values from the return-list.
+ * The ops are executed sequentially by default, or by a DataflowExecutor if more than one thread is set.
  */
 class CoreRuntime : public std::enable_shared_from_this<CoreRuntime> {
  public:
@@ -28,6 +29,10 @@ class CoreRuntime : public std::enable_shared_from_this<CoreRuntime> {
   //! Return the number of ops.
   size_t num_ops() const;
 
+  //! Set the number of threads to execute the ops, independent ops run concurrently if it is larger than 1.
+  void SetNumThreads(int num_threads);
+  int num_threads() const;
+
   //! Get the results of the execution.
   llvm::SmallVector<ValueRef, 4>  //
   GetResults(llvm::ArrayRef<absl::string_view> arg_names);
@@ -0,0 +1,219 @@
+#include "infrt/host_context/dataflow_executor.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "infrt/host_context/kernel_frame.h"
+#include "infrt/host_context/op_executable.h"
+
+namespace infrt::host_context {
+
+namespace {
+std::atomic<int> default_executor_threads{1};
+}  // namespace
+
+void SetDefaultExecutorThreads(int num_threads) {
+  CHECK_GE(num_threads, 1);
+  default_executor_threads = num_threads;
+}
+
+int GetDefaultExecutorThreads() { return default_executor_threads; }
+
+class DataflowExecutor::Impl {
+ public:
+  Impl(llvm::ArrayRef<OpExecutable*> ops, int num_threads) : ops_(ops.begin(), ops.end()) {
+    CHECK_GE(num_threads, 1);
+    BuildGraph();
+
+    pending_.reset(new std::atomic<int>[ops_.size()]);
+    for (int i = 0; i < num_threads; i++) workers_.emplace_back(new Worker);
+    for (int i = 0; i < num_threads; i++) threads_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& t : threads_) t.join();
+  }
+
+  void Run() {
+    if (ops_.empty()) return;
+    for (size_t i = 0; i < ops_.size(); i++) pending_[i] = predecessors_[i].size();
+    num_finished_ = 0;
+
+    for (size_t i = 0; i < roots_.size(); i++) {
+      Push(i % workers_.size(), roots_[i]);
+    }
+
+    std::unique_lock<std::mutex> lock(mu_);
+    done_cv_.wait(lock, [this] { return num_finished_.load() == static_cast<int>(ops_.size()); });
+  }
+
+  size_t num_ops() const { return ops_.size(); }
+  int num_threads() const { return workers_.size(); }
+  const std::vector<int>& predecessors(int i) const { return predecessors_[i]; }
+
+ private:
+  struct Worker {
+    std::mutex mu;
+    std::deque<int> tasks;
+  };
+
+  void BuildGraph() {
+    predecessors_.resize(ops_.size());
+    successors_.resize(ops_.size());
+
+    // The op writes a Value last, and the ops read it after that write.
+    absl::flat_hash_map<const Value*, int> last_writer;
+    absl::flat_hash_map<const Value*, std::vector<int>> readers;
+    int last_side_effect = -1;
+
+    for (int i = 0; i < ops_.size(); i++) {
+      const KernelFrame& frame = ops_[i]->frame();
+      // Ops without results could only take effect by writing their arguments.
+      bool writes_args               = frame.GetNumResults() <= 0;
+      llvm::ArrayRef<Value*> results = writes_args ? llvm::ArrayRef<Value*>() : frame.GetResults();
+
+      std::set<int> deps;
+      auto add_write_deps = [&](const Value* value) {
+        auto it = last_writer.find(value);
+        if (it != last_writer.end()) deps.insert(it->second);
+        auto rit = readers.find(value);
+        if (rit != readers.end()) deps.insert(rit->second.begin(), rit->second.end());
+      };
+
+      for (const Value* arg : frame.GetArguments()) {
+        if (writes_args) {
+          add_write_deps(arg);
+        } else {
+          auto it = last_writer.find(arg);
+          if (it != last_writer.end()) deps.insert(it->second);
+        }
+      }
+      for (const Value* res : results) add_write_deps(res);
+      if (writes_args) {
+        if (last_side_effect >= 0) deps.insert(last_side_effect);
+        last_side_effect = i;
+      }
+      deps.erase(i);
+
+      for (const Value* arg : frame.GetArguments()) {
+        if (writes_args) {
+          last_writer[arg] = i;
+          readers[arg].clear();
+        } else {
+          readers[arg].push_back(i);
+        }
+      }
+      for (const Value* res : results) {
+        last_writer[res] = i;
+        readers[res].clear();
+      }
+
+      predecessors_[i].assign(deps.begin(), deps.end());
+      for (int dep : deps) successors_[dep].push_back(i);
+      if (deps.empty()) roots_.push_back(i);
+    }
+    VLOG(3) << "DataflowExecutor analysed " << ops_.size() << " ops with " << roots_.size() << " roots";
+  }
+
+  void Push(int worker_id, int task) {
+    {
+      std::lock_guard<std::mutex> lock(workers_[worker_id]->mu);
+      workers_[worker_id]->tasks.push_back(task);
+    }
+    num_queued_++;
+    {
+      // Take the lock to avoid losing the wake up of a worker checking `num_queued_`.
+      std::lock_guard<std::mutex> lock(mu_);
+    }
+    wake_cv_.notify_one();
+  }
+
+  //! Pop from the back of its own queue, or steal from the front of the others'.
+  bool TryPop(int worker_id, int* task) {
+    for (int k = 0; k < workers_.size(); k++) {
+      int victim   = (worker_id + k) % workers_.size();
+      auto& worker = *workers_[victim];
+      std::lock_guard<std::mutex> lock(worker.mu);
+      if (worker.tasks.empty()) continue;
+      if (k == 0) {
+        *task = worker.tasks.back();
+        worker.tasks.pop_back();
+      } else {
+        *task = worker.tasks.front();
+        worker.tasks.pop_front();
+      }
+      num_queued_--;
+      return true;
+    }
+    return false;
+  }
+
+  void RunTask(int worker_id, int task) {
+    ops_[task]->Execute();
+    for (int succ : successors_[task]) {
+      if (--pending_[succ] == 0) Push(worker_id, succ);
+    }
+    if (++num_finished_ == static_cast<int>(ops_.size())) {
+      std::lock_guard<std::mutex> lock(mu_);
+      done_cv_.notify_all();
+    }
+  }
+
+  void WorkerLoop(int worker_id) {
+    while (true) {
+      int task;
+      if (TryPop(worker_id, &task)) {
+        RunTask(worker_id, task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mu_);
+      wake_cv_.wait(lock, [this] { return stop_ || num_queued_.load() > 0; });
+      if (stop_) return;
+    }
+  }
+
+  std::vector<OpExecutable*> ops_;
+  std::vector<std::vector<int>> predecessors_;
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> roots_;
+
+  //! The number of unfinished predecessors of each op in the current run.
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  std::atomic<int> num_finished_{0};
+  std::atomic<int> num_queued_{0};
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex mu_;
+  std::condition_variable wake_cv_;
+  std::condition_variable done_cv_;
+  bool stop_{false};
+};
+
+DataflowExecutor::DataflowExecutor(llvm::ArrayRef<OpExecutable*> ops, int num_threads)
+    : impl_(new Impl(ops, num_threads)) {}
+
+DataflowExecutor::~DataflowExecutor() {}
+
+void DataflowExecutor::Run() { impl_->Run(); }
+
+size_t DataflowExecutor::num_ops() const { return impl_->num_ops(); }
+
+int DataflowExecutor::num_threads() const { return impl_->num_threads(); }
+
+const std::vector<int>& DataflowExecutor::predecessors(int i) const { return impl_->predecessors(i); }
+
+}  // namespace infrt::host_context
@@ -0,0 +1,47 @@
+#pragma once
+#include <llvm/ADT/ArrayRef.h>
+
+#include <memory>
+#include <vector>
+
+namespace infrt::host_context {
+
+class OpExecutable;
+
+/**
+ * DataflowExecutor runs the ops of a CoreRuntime concurrently following their def-use edges.
+ *
+ * The dependency graph is analysed once when the executor is built: an op depends on the ops producing the Values it
+ * reads. Ops without results (e.g. `dt.fill_tensor_with_constant` or the external kernels writing into their last
+ * argument) are treated as writing all their arguments, and they keep their relative program order so that the side
+ * effects such as printing stay deterministic.
+ *
+ * Each run resets a per-op ready counter and pushes the ready ops to a work-stealing pool, an op is scheduled as soon
+ * as its counter drops to zero. The KernelFrames built by the OpExecutables and the counters are reused by every run.
+ *
+ * NOTE A DataflowExecutor should not be run by multiple threads at the same time.
+ */
+class DataflowExecutor {
+ public:
+  DataflowExecutor(llvm::ArrayRef<OpExecutable*> ops, int num_threads);
+  ~DataflowExecutor();
+
+  //! Run all the ops once, return after all of them finished.
+  void Run();
+
+  size_t num_ops() const;
+  int num_threads() const;
+
+  //! Get the ops that the i-th op depends on.
+  const std::vector<int>& predecessors(int i) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+//! Set the number of threads used by the CoreRuntimes created afterwards, 1 keeps the sequential execution.
+void SetDefaultExecutorThreads(int num_threads);
+int GetDefaultExecutorThreads();
+
+}  // namespace infrt::host_context
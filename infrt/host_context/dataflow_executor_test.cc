@@ -0,0 +1,140 @@
+#include "infrt/host_context/dataflow_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "infrt/host_context/core_runtime.h"
+#include "infrt/host_context/kernel_registry.h"
+#include "infrt/host_context/kernel_utils.h"
+#include "infrt/host_context/op_executable.h"
+#include "infrt/host_context/symbol_table.h"
+
+namespace infrt {
+namespace host_context {
+
+int add(int a, int b) { return a + b; }
+int sub(int a, int b) { return a - b; }
+// The sums computed by the logged kernels, in the order they finish.
+std::mutex log_mu;
+std::vector<int> sum_log;
+int logged_add(int a, int b) {
+  std::lock_guard<std::mutex> lock(log_mu);
+  sum_log.push_back(a + b);
+  return a + b;
+}
+int slow_add(int a, int b) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  return logged_add(a, b);
+}
+// Write the argument in place, just like the external kernels without results.
+void inc(int* a) { *a += 1; }
+
+void RegisterKernels(KernelRegistry* registry) {
+  registry->AddKernel("cinn.test.addi32", CINN_KERNEL(add));
+  registry->AddKernel("cinn.test.subi32", CINN_KERNEL(sub));
+  registry->AddKernel("cinn.test.slow_addi32", CINN_KERNEL(slow_add));
+  registry->AddKernel("cinn.test.logged_addi32", CINN_KERNEL(logged_add));
+  registry->AddKernel("cinn.test.inci32", CINN_KERNEL(inc));
+}
+
+TEST(DataflowExecutor, diamond) {
+  KernelRegistry registry;
+  RegisterKernels(&registry);
+
+  CoreRuntimeBuilder builder(&registry);
+  builder.SetNumThreads(4);
+  auto* table = builder.symbol_table();
+  table->Register("a", 1);
+  table->Register("b", 2);
+
+  // c = a + b, d = a - b, e = c + d
+  auto* op0 = builder.NewOpExecutable("cinn.test.addi32");
+  op0->AppendArgument("a");
+  op0->AppendArgument("b");
+  op0->SetResults({"c"});
+  auto* op1 = builder.NewOpExecutable("cinn.test.subi32");
+  op1->AppendArgument("a");
+  op1->AppendArgument("b");
+  op1->SetResults({"d"});
+  auto* op2 = builder.NewOpExecutable("cinn.test.addi32");
+  op2->AppendArgument("c");
+  op2->AppendArgument("d");
+  op2->SetResults({"e"});
+  // a += 1 after all the reads of a, then f = a + e
+  auto* op3 = builder.NewOpExecutable("cinn.test.inci32");
+  op3->AppendArgument("a");
+  op3->SetResults(llvm::ArrayRef<std::string>());
+  auto* op4 = builder.NewOpExecutable("cinn.test.addi32");
+  op4->AppendArgument("a");
+  op4->AppendArgument("e");
+  op4->SetResults({"f"});
+
+  builder.Execute();
+  ASSERT_EQ(table->GetValue("e")->get<int>(), 2);
+  ASSERT_EQ(table->GetValue("f")->get<int>(), 4);
+
+  // The executor and the frames are reused by the following runs.
+  table->GetValue("a")->set(1);
+  builder.Execute();
+  ASSERT_EQ(table->GetValue("f")->get<int>(), 4);
+}
+
+TEST(DataflowExecutor, concurrency) {
+  KernelRegistry registry;
+  RegisterKernels(&registry);
+
+  auto build = [&](CoreRuntimeBuilder* builder) {
+    auto* table = builder->symbol_table();
+    table->Register("zero", 0);
+    table->Register("hundred", 100);
+    // 8 independent slow kernels r_i = i + 0, then s = r_7 + 100 depending on the last one.
+    for (int i = 0; i < 8; i++) {
+      table->Register("i" + std::to_string(i), i);
+      auto* op = builder->NewOpExecutable("cinn.test.slow_addi32");
+      op->AppendArgument("i" + std::to_string(i));
+      op->AppendArgument("zero");
+      op->SetResults({"r" + std::to_string(i)});
+    }
+    auto* op = builder->NewOpExecutable("cinn.test.logged_addi32");
+    op->AppendArgument("r7");
+    op->AppendArgument("hundred");
+    op->SetResults({"s"});
+  };
+
+  CoreRuntimeBuilder sequential(&registry);
+  build(&sequential);
+  CoreRuntimeBuilder dataflow(&registry);
+  dataflow.SetNumThreads(8);
+  build(&dataflow);
+
+  sum_log.clear();
+  sequential.Execute();
+  std::vector<int> sequential_log = sum_log;
+  sum_log.clear();
+  dataflow.Execute();
+  std::vector<int> dataflow_log = sum_log;
+
+  // The same results as the sequential run.
+  for (int i = 0; i < 8; i++) {
+    auto name = "r" + std::to_string(i);
+    ASSERT_EQ(dataflow.symbol_table()->GetValue(name)->get<int>(),
+              sequential.symbol_table()->GetValue(name)->get<int>());
+  }
+  ASSERT_EQ(dataflow.symbol_table()->GetValue("s")->get<int>(), 107);
+
+  // Every kernel runs once, and s runs after r_7 it depends on.
+  ASSERT_EQ(dataflow_log.size(), sequential_log.size());
+  ASSERT_TRUE(std::is_permutation(dataflow_log.begin(), dataflow_log.end(), sequential_log.begin()));
+  auto r7_pos = std::find(dataflow_log.begin(), dataflow_log.end(), 7);
+  auto s_pos  = std::find(dataflow_log.begin(), dataflow_log.end(), 107);
+  ASSERT_LT(r7_pos, s_pos);
+  ASSERT_NE(s_pos, dataflow_log.end());
+}
+
+}  // namespace host_context
+}  // namespace infrt
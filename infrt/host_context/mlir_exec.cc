@@ -6,6 +6,7 @@
 #include "infrt/common/global.h"
 #include "infrt/dialect/mlir_loader.h"
 #include "infrt/host_context/core_runtime.h"
+#include "infrt/host_context/dataflow_executor.h"
 #include "infrt/host_context/kernel_registry.h"
 #include "infrt/host_context/mlir_to_runtime_translate.h"
 #include "infrt/kernel/basic_kernels.h"
@@ -21,12 +22,19 @@ static llvm::cl::list<std::string> cl_shared_libs(  // NOLINT
     llvm::cl::ZeroOrMore,
     llvm::cl::MiscFlags::CommaSeparated);
 
+static llvm::cl::opt<int> cl_num_threads(  // NOLINT
+    "num_threads",
+    llvm::cl::desc("Number of threads to run the independent kernels concurrently, 1 for the sequential execution."),
+    llvm::cl::init(1));
+
 int main(int argc, char** argv) {
   using namespace llvm;   // NOLINT
   using namespace infrt;  // NOLINT
   cl::opt<std::string> input_file("i", cl::desc("Specify input filename"), cl::value_desc("input file name"));
   cl::ParseCommandLineOptions(argc, argv);
 
+  host_context::SetDefaultExecutorThreads(cl_num_threads);
+
   mlir::MLIRContext* context = infrt::Global::getMLIRContext();
   auto module                = dialect::LoadMlirFile(input_file.c_str(), context);
 
@@ -37,6 +37,9 @@ class MlirFunctionExecutable : public Function, public MlirToRuntimeTranslator {
    */
   void Execute(llvm::ArrayRef<Value*> arguments, llvm::MutableArrayRef<ValueRef> results, bool is_region = false) const;
 
+  //! Set the number of threads to execute the ops of this function, see CoreRuntime::SetNumThreads.
+  void SetNumThreads(int num_threads) { core_runtime_builder_.SetNumThreads(num_threads); }
+
  private:
   /**
    * Build the runtime executables once the function call arguments and results are passed in.
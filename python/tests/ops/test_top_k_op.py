@@ -39,18 +39,19 @@ class TestTopKOp(OpTest):
         }
         self.k = 1
         self.axis = 1
+        self.largest = True
 
     def build_paddle_program(self, target):
         axis = -1
         x1 = paddle.to_tensor(self.inputs["x1"], stop_gradient=True)
-        out = paddle.topk(x1, self.k, self.axis)
+        out = paddle.topk(x1, self.k, self.axis, largest=self.largest)
 
         self.paddle_outputs = [out[0], out[1]]
 
     def build_cinn_program(self, target):
         builder = NetBuilder("sum")
         x1 = builder.create_input(Float(32), self.inputs["x1"].shape, "x1")
-        out = builder.top_k(x1, self.k, self.axis, False)
+        out = builder.top_k(x1, self.k, self.axis, self.largest)
         prog = builder.build()
         forward_res = self.get_cinn_output(
             prog, target, [x1], [self.inputs["x1"]], [out[0], out[1]])
@@ -71,6 +72,7 @@ class TestTopKCase1(TestTopKOp):
         }
         self.k = 2
         self.axis = 1
+        self.largest = True
 
 
 class TestTopKCase2(TestTopKOp):
@@ -83,6 +85,20 @@ class TestTopKCase2(TestTopKOp):
         }
         self.k = 1
         self.axis = 0
+        self.largest = True
+
+
+class TestTopKCase3(TestTopKOp):
+    def init_case(self):
+        self.inputs = {
+            "x1": np.random.random([
+                2,
+                4,
+            ]).astype("float32")
+        }
+        self.k = 2
+        self.axis = 1
+        self.largest = False
 
 
 if __name__ == "__main__":
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2023 CINN Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from cinn.common import *
+from cinn.framework import *
+from cinn.frontend import *
+
+
+def aligned_empty(shape, dtype, alignment=32, offset=0):
+    size = int(np.prod(shape)) * np.dtype(dtype).itemsize
+    raw = np.empty(size + 2 * alignment, dtype=np.uint8)
+    begin = (-raw.ctypes.data) % alignment + offset
+    return raw[begin:begin + size].view(dtype).reshape(shape)
+
+
+class TestTensorInterop(unittest.TestCase):
+    def setUp(self):
+        self.target = DefaultHostTarget()
+        self.shape = [4, 32]
+        builder = NetBuilder("test_tensor_interop")
+        a = builder.create_input(Float(32), self.shape, "A")
+        b = builder.create_input(Float(32), self.shape, "B")
+        self.out_name = str(builder.add(a, b))
+        self.computation = Computation.build_and_compile(
+            self.target, builder)
+
+    def test_bind_tensor(self):
+        a = aligned_empty(self.shape, "float32")
+        b = aligned_empty(self.shape, "float32")
+        out = aligned_empty(self.shape, "float32")
+        a[:] = np.random.random(self.shape)
+        b[:] = np.random.random(self.shape)
+
+        self.assertTrue(self.computation.bind_tensor("A", a))
+        self.assertTrue(self.computation.bind_tensor("B", b))
+        self.assertTrue(self.computation.bind_tensor(self.out_name, out))
+        self.computation.execute()
+        self.assertTrue(np.allclose(out, a + b))
+
+        # The following executions read the arrays written in place.
+        a += 1.0
+        self.computation.execute()
+        self.assertTrue(np.allclose(out, a + b))
+
+    def test_bind_misaligned_tensor(self):
+        a = aligned_empty(self.shape, "float32", offset=4)
+        b = aligned_empty(self.shape, "float32")
+        a[:] = np.random.random(self.shape)
+        b[:] = np.random.random(self.shape)
+
+        # The host memory not aligned for the kernels is copied in.
+        self.assertFalse(self.computation.bind_tensor("A", a))
+        self.assertTrue(self.computation.bind_tensor("B", b))
+        self.computation.execute()
+        out = self.computation.get_tensor(self.out_name).numpy(self.target)
+        self.assertTrue(np.allclose(out, a + b))
+
+    def test_buffer_view(self):
+        a = np.random.random(self.shape).astype("float32")
+        b = np.random.random(self.shape).astype("float32")
+        self.computation.get_tensor("A").from_numpy(a, self.target)
+        self.computation.get_tensor("B").from_numpy(b, self.target)
+
+        out = np.asarray(self.computation.get_tensor(self.out_name))
+        self.computation.execute()
+        self.assertTrue(np.allclose(out, a + b))
+
+    def test_dlpack(self):
+        a = aligned_empty(self.shape, "float32")
+        a[:] = np.random.random(self.shape)
+        tensor = Tensor()
+        self.assertTrue(tensor.share_data(a))
+        self.assertEqual(np.asarray(tensor).ctypes.data, a.ctypes.data)
+
+        alias = from_dlpack(to_dlpack(tensor))
+        self.assertEqual(alias.shape(), self.shape)
+        self.assertEqual(np.asarray(alias).ctypes.data, a.ctypes.data)
+        self.assertEqual(tensor.__dlpack_device__(), (1, 0))
+
+        if hasattr(np, "from_dlpack"):
+            view = np.from_dlpack(alias)
+            self.assertEqual(view.ctypes.data, a.ctypes.data)
+            self.assertTrue(np.array_equal(view, a))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -17,6 +17,8 @@
 #include "cinn/cinn.h"
 #include "cinn/hlir/framework/node.h"
 
+DECLARE_bool(cinn_llvm_buffer_noalias);
+
 namespace cinn {
 namespace tests {
 
@@ -47,5 +49,27 @@ TEST(test_elementwise_add, default_int32) {
   add_tester.Compare<int>();
 }
 
+// Compare the host kernel compiled with and without the alias scopes of its argument buffers.
+TEST(test_elementwise_add, buffer_noalias_fp32) {
+  int M = 1024;
+  int N = 1024;
+  std::vector<std::vector<int>> input_shapes{{M, N}, {M, N}};
+  std::string op_name = "elementwise_add";
+  hlir::framework::NodeAttr attrs;
+  std::vector<Type> input_types{Float(32), Float(32)};
+  std::vector<Type> output_types{Float(32)};
+  for (bool noalias : {false, true}) {
+    FLAGS_cinn_llvm_buffer_noalias = noalias;
+    ElementwiseAddTester add_tester(op_name, input_shapes);
+    auto input_tensors = add_tester.CreateInputTensors<float>();
+    add_tester.TestOp(noalias ? "elementwise_add_noalias_fp32" : "elementwise_add_may_alias_fp32",
+                      input_tensors,
+                      attrs,
+                      input_types,
+                      output_types);
+  }
+  FLAGS_cinn_llvm_buffer_noalias = false;
+}
+
 }  // namespace tests
 }  // namespace cinn